@@ -0,0 +1,265 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ADSBSbsParser.h"
+
+#include <QtCore/QtNumeric>
+
+#include <cstring>
+
+void ADSB::TrackUpdate::merge(const TrackUpdate &other)
+{
+    if (other.availableFlags & LocationAvailable) {
+        latitude = other.latitude;
+        longitude = other.longitude;
+    }
+    if (other.availableFlags & AltitudeAvailable) {
+        altitude = other.altitude;
+    }
+    if (other.availableFlags & HeadingAvailable) {
+        heading = other.heading;
+    }
+    if (other.availableFlags & VelocityAvailable) {
+        velocity = other.velocity;
+    }
+    if (other.availableFlags & VerticalVelAvailable) {
+        verticalVel = other.verticalVel;
+    }
+    if (other.availableFlags & AlertAvailable) {
+        alert = other.alert;
+    }
+    if (other.availableFlags & CallsignAvailable) {
+        (void) memcpy(callsign, other.callsign, sizeof(callsign));
+    }
+
+    availableFlags |= other.availableFlags;
+}
+
+ADSB::VehicleInfo_t ADSB::TrackUpdate::toVehicleInfo() const
+{
+    VehicleInfo_t vehicleInfo;
+    vehicleInfo.icaoAddress = icaoAddress;
+    vehicleInfo.availableFlags = availableFlags;
+    if (availableFlags & LocationAvailable) {
+        vehicleInfo.location.setLatitude(latitude);
+        vehicleInfo.location.setLongitude(longitude);
+    }
+    if (availableFlags & AltitudeAvailable) {
+        vehicleInfo.location.setAltitude(altitude);
+    }
+    vehicleInfo.heading = heading;
+    vehicleInfo.velocity = velocity;
+    vehicleInfo.verticalVel = verticalVel;
+    vehicleInfo.alert = alert;
+    if (availableFlags & CallsignAvailable) {
+        vehicleInfo.callsign = QString::fromLatin1(callsign);
+    }
+
+    return vehicleInfo;
+}
+
+/*===========================================================================*/
+
+qsizetype ADSBSbsParser::parseLines(QByteArrayView data, ADSBUpdateQueue &queue)
+{
+    ADSB::TrackUpdate update;
+    qsizetype pos = 0;
+    for (;;) {
+        const qsizetype newline = data.indexOf('\n', pos);
+        if (newline < 0) {
+            break;
+        }
+
+        QByteArrayView line = data.sliced(pos, newline - pos);
+        if (line.endsWith('\r')) {
+            line.chop(1);
+        }
+        if (parseLine(line, update)) {
+            (void) queue.push(update);
+        }
+
+        pos = newline + 1;
+    }
+
+    return pos;
+}
+
+qsizetype ADSBSbsParser::splitFields(QByteArrayView line, QByteArrayView *fields, qsizetype maxFields)
+{
+    qsizetype count = 0;
+    qsizetype start = 0;
+    while (count < maxFields) {
+        const qsizetype comma = line.indexOf(',', start);
+        if ((comma < 0) || (count == (maxFields - 1))) {
+            fields[count++] = line.sliced(start);
+            break;
+        }
+
+        fields[count++] = line.sliced(start, comma - start);
+        start = comma + 1;
+    }
+
+    return count;
+}
+
+bool ADSBSbsParser::parseLine(QByteArrayView line, ADSB::TrackUpdate &update)
+{
+    if ((line.size() <= 4) || !line.startsWith("MSG")) {
+        return false;
+    }
+
+    QByteArrayView fields[kMaxFields];
+    const qsizetype count = splitFields(line, fields, kMaxFields);
+    if (count <= 4) {
+        return false;
+    }
+
+    bool ok = false;
+    const int msgType = fields[1].toInt(&ok);
+    // Skip unsupported message types to avoid parsing
+    if (!ok || (msgType < ADSB::IdentificationAndCategory) || (msgType == ADSB::SurfacePosition) || (msgType > ADSB::SurveillanceId)) {
+        return false;
+    }
+
+    update = ADSB::TrackUpdate();
+    update.icaoAddress = fields[4].toUInt(&ok, 16);
+    if (!ok) {
+        return false;
+    }
+
+    switch (msgType) {
+    case ADSB::IdentificationAndCategory:
+    case ADSB::SurveillanceAltitude:
+    case ADSB::SurveillanceId:
+    {
+        if (count <= 10) {
+            return false;
+        }
+
+        const QByteArrayView callsign = fields[10].trimmed();
+        if (callsign.isEmpty()) {
+            return false;
+        }
+
+        const qsizetype len = qMin<qsizetype>(callsign.size(), sizeof(update.callsign) - 1);
+        (void) memcpy(update.callsign, callsign.data(), static_cast<size_t>(len));
+        update.callsign[len] = '\0';
+        update.availableFlags = ADSB::CallsignAvailable;
+        return true;
+    }
+    case ADSB::AirbornePosition:
+    {
+        if (count <= 19) {
+            return false;
+        }
+
+        // Altitude is either Barometric - based on pressure, in ft
+        // or HAE - as reported by GPS - based on WGS84 Ellipsoid, in ft
+        // If altitude ends with H, we have HAE
+        // There's a slight difference between Barometric alt and HAE, but it would require
+        // knowledge about Geoid shape in particular Lat, Lon. It's not worth complicating the code
+        QByteArrayView altitudeStr = fields[11];
+        if (altitudeStr.endsWith('H')) {
+            altitudeStr.chop(1);
+        }
+
+        bool altOk, latOk, lonOk, alertOk;
+        const int modeCAltitude = altitudeStr.toInt(&altOk);
+        const double lat = fields[14].toDouble(&latOk);
+        const double lon = fields[15].toDouble(&lonOk);
+        const int alert = fields[19].toInt(&alertOk);
+        if (!altOk || !latOk || !lonOk || !alertOk) {
+            return false;
+        }
+
+        if (qFuzzyIsNull(lat) && qFuzzyIsNull(lon)) {
+            return false;
+        }
+
+        update.latitude = lat;
+        update.longitude = lon;
+        update.altitude = modeCAltitude * 0.3048;
+        update.alert = (alert == 1);
+        update.availableFlags = ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable;
+        return true;
+    }
+    case ADSB::AirborneVelocity:
+    {
+        if (count <= 13) {
+            return false;
+        }
+
+        bool headingOk = false, speedOk = false;
+        const double heading = fields[13].toDouble(&headingOk);
+        const double speedKnots = fields[12].toDouble(&speedOk);
+        if (!headingOk || !speedOk) {
+            return false;
+        }
+
+        update.heading = heading;
+        update.velocity = speedKnots * 0.514444;
+        update.availableFlags = ADSB::HeadingAvailable | ADSB::VelocityAvailable;
+
+        if (count > 16) {
+            bool vertOk = false;
+            const double verticalRate = fields[16].toDouble(&vertOk);
+            if (vertOk) {
+                update.verticalVel = verticalRate * 0.00508;
+                update.availableFlags |= ADSB::VerticalVelAvailable;
+            }
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+/*===========================================================================*/
+
+ADSBUpdateQueue::ADSBUpdateQueue(qsizetype capacity)
+    : _capacity(qMax<qsizetype>(capacity, 1))
+{
+    _updates.reserve(_capacity);
+    _index.reserve(_capacity);
+}
+
+bool ADSBUpdateQueue::push(const ADSB::TrackUpdate &update)
+{
+    const auto it = _index.constFind(update.icaoAddress);
+    if (it != _index.constEnd()) {
+        _updates[it.value()].merge(update);
+        _pushedCount++;
+        return true;
+    }
+
+    if (_updates.count() >= _capacity) {
+        _droppedCount++;
+        return false;
+    }
+
+    _index.insert(update.icaoAddress, _updates.count());
+    _updates.append(update);
+    _pushedCount++;
+
+    return true;
+}
+
+void ADSBUpdateQueue::takeAll(QList<ADSB::VehicleInfo_t> &vehicleInfos)
+{
+    vehicleInfos.clear();
+    vehicleInfos.reserve(_updates.count());
+    for (const ADSB::TrackUpdate &update : std::as_const(_updates)) {
+        vehicleInfos.append(update.toVehicleInfo());
+    }
+
+    // Both keep their storage for the next round
+    _updates.clear();
+    _index.clear();
+}
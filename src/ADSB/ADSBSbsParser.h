@@ -0,0 +1,95 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArrayView>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+
+#include "ADSB.h"
+
+namespace ADSB {
+
+/// Fields of one or more SBS-1 messages about a single aircraft. Plain data, so parsing allocates nothing.
+struct TrackUpdate {
+    uint32_t icaoAddress = 0;
+    AvailableInfoTypes availableFlags = AvailableInfoType();
+    double latitude = 0.;
+    double longitude = 0.;
+    double altitude = 0.;
+    double heading = 0.;
+    double velocity = 0.;
+    double verticalVel = 0.;
+    bool alert = false;
+    char callsign[9]{};     ///< Nul terminated
+
+    /// Takes over the fields which are available in other
+    void merge(const TrackUpdate &other);
+
+    VehicleInfo_t toVehicleInfo() const;
+};
+
+} // namespace ADSB
+
+/*===========================================================================*/
+
+class ADSBUpdateQueue;
+
+/// Parses the SBS-1 (BaseStation) text format sent by dump1090 and friends on port 30003.
+/// Fields are picked out of the line in place, nothing is copied.
+class ADSBSbsParser
+{
+public:
+    /// Parses every complete line in data and pushes the supported messages to queue
+    ///     @return Number of bytes consumed, the remainder is an incomplete line
+    static qsizetype parseLines(QByteArrayView data, ADSBUpdateQueue &queue);
+
+    /// @param line Single line without its line ending
+    /// @return false: Not a supported message, update is undefined
+    static bool parseLine(QByteArrayView line, ADSB::TrackUpdate &update);
+
+    /// Splits line at the commas
+    ///     @return Number of fields found, fields beyond maxFields are not split off
+    static qsizetype splitFields(QByteArrayView line, QByteArrayView *fields, qsizetype maxFields);
+
+    static constexpr qsizetype kMaxFields = 22;
+    static constexpr qsizetype kMaxLineLength = 512;    ///< Longer lines are garbage, not SBS-1
+};
+
+/*===========================================================================*/
+
+/// Updates waiting to be handed to the main thread, coalesced per ICAO address in order of first arrival.
+/// The queue holds at most capacity aircraft, updates for further aircraft are dropped until it is taken.
+class ADSBUpdateQueue
+{
+public:
+    explicit ADSBUpdateQueue(qsizetype capacity = kDefaultCapacity);
+
+    /// @return false: Queue is full and update is for an aircraft which isn't queued yet
+    bool push(const ADSB::TrackUpdate &update);
+
+    /// Moves the queued updates to vehicleInfos and empties the queue
+    void takeAll(QList<ADSB::VehicleInfo_t> &vehicleInfos);
+
+    qsizetype count() const { return _updates.count(); }
+    bool isEmpty() const { return _updates.isEmpty(); }
+    qsizetype capacity() const { return _capacity; }
+    quint64 pushedCount() const { return _pushedCount; }
+    quint64 droppedCount() const { return _droppedCount; }
+
+    static constexpr qsizetype kDefaultCapacity = 4096;
+
+private:
+    const qsizetype _capacity;
+    QList<ADSB::TrackUpdate> _updates;
+    QHash<uint32_t, qsizetype> _index;  ///< ICAO address to position in _updates
+    quint64 _pushedCount = 0;
+    quint64 _droppedCount = 0;
+};
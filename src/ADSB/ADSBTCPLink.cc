@@ -11,18 +11,28 @@
 // #include "DeviceInfo.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtNetwork/QTcpSocket>
 
 QGC_LOGGING_CATEGORY(ADSBTCPLinkLog, "qgc.adsb.adsbtcplink")
 
-ADSBTCPLink::ADSBTCPLink(const QHostAddress &hostAddress, quint16 port, QObject *parent)
+ADSBTCPLinkWorker::ADSBTCPLinkWorker(QObject *parent)
     : QObject(parent)
-    , _hostAddress(hostAddress)
-    , _port(port)
-    , _socket(new QTcpSocket(this))
-    , _processTimer(new QTimer(this))
 {
+    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
+}
+
+ADSBTCPLinkWorker::~ADSBTCPLinkWorker()
+{
+    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
+}
+
+void ADSBTCPLinkWorker::setup()
+{
+    _socket = new QTcpSocket(this);
+    _flushTimer = new QTimer(this);
+
     if (ADSBTCPLinkLog().isDebugEnabled()) {
         (void) connect(_socket, &QTcpSocket::stateChanged, this, [](QTcpSocket::SocketState state) {
             switch (state) {
@@ -50,198 +60,108 @@ ADSBTCPLink::ADSBTCPLink(const QHostAddress &hostAddress, quint16 port, QObject
         emit errorOccurred(_socket->errorString(), false);
     }, Qt::AutoConnection);
 
-    (void) connect(_socket, &QTcpSocket::readyRead, this, &ADSBTCPLink::_readBytes);
+    (void) connect(_socket, &QTcpSocket::readyRead, this, &ADSBTCPLinkWorker::_readBytes);
 
-    _processTimer->setInterval(_processInterval); // Set an interval for processing lines
-    (void) connect(_processTimer, &QTimer::timeout, this, &ADSBTCPLink::_processLines);
+    _flushTimer->setInterval(kFlushIntervalMSecs);
+    (void) connect(_flushTimer, &QTimer::timeout, this, &ADSBTCPLinkWorker::_flush);
 
-    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
+    _readBuffer.reserve(ADSBSbsParser::kMaxLineLength * 16);
 }
 
-ADSBTCPLink::~ADSBTCPLink()
+void ADSBTCPLinkWorker::connectToHost(const QHostAddress &hostAddress, quint16 port)
 {
-    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
+    _socket->connectToHost(hostAddress, port);
 }
 
-bool ADSBTCPLink::init()
+void ADSBTCPLinkWorker::_readBytes()
 {
-    /* if (!QGCDeviceInfo::isInternetAvailable()) {
-        return false;
-    } */
-
-    if (_hostAddress.isNull()) {
-        return false;
+    const qint64 available = _socket->bytesAvailable();
+    if (available <= 0) {
+        return;
     }
 
-    _socket->connectToHost(_hostAddress, _port);
-
-    return true;
-}
-
-void ADSBTCPLink::_readBytes()
-{
-    while (_socket && _socket->canReadLine()) {
-        const QByteArray bytes = _socket->readLine();
-        (void) _lineBuffer.append(QString::fromLocal8Bit(bytes));
-    }
+    const qsizetype previousSize = _readBuffer.size();
+    _readBuffer.resize(previousSize + available);
+    const qint64 bytesRead = _socket->read(_readBuffer.data() + previousSize, available);
+    _readBuffer.resize(previousSize + qMax<qint64>(bytesRead, 0));
 
-    // Start or restart the timer to process lines
-    if (!_processTimer->isActive()) {
-        _processTimer->start();
-    }
-}
+    const qsizetype consumed = ADSBSbsParser::parseLines(_readBuffer, _queue);
+    (void) _readBuffer.remove(0, consumed);
 
-void ADSBTCPLink::_processLines()
-{
-    int linesProcessed = 0;
-    while (!_lineBuffer.isEmpty() && (linesProcessed < _maxLinesToProcess)) {
-        const QString line = _lineBuffer.takeFirst();
-        _parseLine(line);
-        ++linesProcessed;
+    if (_readBuffer.size() > ADSBSbsParser::kMaxLineLength) {
+        qCDebug(ADSBTCPLinkLog) << "Discarding" << _readBuffer.size() << "bytes without line ending";
+        _readBuffer.clear();
     }
 
-    // Stop the timer if there are no more lines to process
-    if (_lineBuffer.isEmpty()) {
-        _processTimer->stop();
+    if (!_queue.isEmpty() && !_flushTimer->isActive()) {
+        _flushTimer->start();
     }
 }
 
-void ADSBTCPLink::_parseLine(const QString &line)
+void ADSBTCPLinkWorker::_flush()
 {
-    if (line.size() <= 4) {
-        return;
-    }
-
-    if (!line.startsWith(QStringLiteral("MSG"))) {
-        return;
+    if (_queue.droppedCount() != _reportedDroppedCount) {
+        qCWarning(ADSBTCPLinkLog) << "ADSB queue full, dropped" << (_queue.droppedCount() - _reportedDroppedCount) << "updates";
+        _reportedDroppedCount = _queue.droppedCount();
     }
 
-    const int msgType = line.at(4).digitValue();
-    if (msgType == ADSB::Unsupported) {
-        qCDebug(ADSBTCPLinkLog) << "ADSB Invalid message type" << msgType;
+    // Stop the timer until more data arrives
+    if (_queue.isEmpty()) {
+        _flushTimer->stop();
         return;
     }
 
-    // Skip unsupported mesg types to avoid parsing
-    if ((msgType == ADSB::SurfacePosition) || (msgType > ADSB::SurveillanceId)) {
-        return;
-    }
-
-    qCDebug(ADSBTCPLinkLog) << "ADSB SBS-1" << line;
+    _queue.takeAll(_batch);
+    emit adsbVehiclesUpdated(_batch);
+}
 
-    const QStringList values = line.split(QChar(','));
-    if (values.size() <= 4) {
-        return;
-    }
+/*===========================================================================*/
 
-    bool icaoOk;
-    const uint32_t icaoAddress = values.at(4).toUInt(&icaoOk, 16);
-    if (!icaoOk) {
-        return;
-    }
+ADSBTCPLink::ADSBTCPLink(const QHostAddress &hostAddress, quint16 port, QObject *parent)
+    : QObject(parent)
+    , _hostAddress(hostAddress)
+    , _port(port)
+    , _worker(new ADSBTCPLinkWorker())
+    , _workerThread(new QThread(this))
+{
+    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
 
-    ADSB::VehicleInfo_t adsbInfo;
-    adsbInfo.icaoAddress = icaoAddress;
-
-    switch (msgType) {
-    case ADSB::IdentificationAndCategory:
-    case ADSB::SurveillanceAltitude:
-    case ADSB::SurveillanceId:
-        _parseAndEmitCallsign(adsbInfo, values);
-        break;
-    case ADSB::AirbornePosition:
-        _parseAndEmitLocation(adsbInfo, values);
-        break;
-    case ADSB::AirborneVelocity:
-        _parseAndEmitHeading(adsbInfo, values);
-        break;
-    default:
-        break;
-    }
-}
+    _workerThread->setObjectName(QStringLiteral("ADSB"));
 
-void ADSBTCPLink::_parseAndEmitCallsign(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values)
-{
-    if (values.size() <= 10) {
-        return;
-    }
+    _worker->moveToThread(_workerThread);
 
-    const QString callsign = values.at(10).trimmed();
-    if (callsign.isEmpty()) {
-        return;
-    }
+    (void) connect(_workerThread, &QThread::started, _worker, &ADSBTCPLinkWorker::setup);
+    (void) connect(_workerThread, &QThread::finished, _worker, &QObject::deleteLater);
 
-    adsbInfo.callsign = callsign;
-    adsbInfo.availableFlags = ADSB::CallsignAvailable;
+    (void) connect(_worker, &ADSBTCPLinkWorker::adsbVehiclesUpdated, this, &ADSBTCPLink::adsbVehiclesUpdated, Qt::QueuedConnection);
+    (void) connect(_worker, &ADSBTCPLinkWorker::errorOccurred, this, &ADSBTCPLink::errorOccurred, Qt::QueuedConnection);
 
-    emit adsbVehicleUpdate(adsbInfo);
+    _workerThread->start();
 }
 
-void ADSBTCPLink::_parseAndEmitLocation(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values)
+ADSBTCPLink::~ADSBTCPLink()
 {
-    if (values.size() <= 19) {
-        return;
+    _workerThread->quit();
+    if (!_workerThread->wait()) {
+        qCWarning(ADSBTCPLinkLog) << "Failed to wait for ADSB thread to close";
     }
 
-    // Altitude is either Barometric - based on pressure, in ft
-    // or HAE - as reported by GPS - based on WGS84 Ellipsoid, in ft
-    // If altitude ends with H, we have HAE
-    // There's a slight difference between Barometric alt and HAE, but it would require
-    // knowledge about Geoid shape in particular Lat, Lon. It's not worth complicating the code
-    QString altitudeStr = values.at(11);
-    if (altitudeStr.endsWith('H')) {
-        (void) altitudeStr.chop(1);
-    }
-
-    bool altOk, latOk, lonOk, alertOk;
-    const int modeCAltitude = altitudeStr.toInt(&altOk);
-    const double lat = values.at(14).toDouble(&latOk);
-    const double lon = values.at(15).toDouble(&lonOk);
-    const int alert = values.at(19).toInt(&alertOk);
-
-    if (!altOk || !latOk || !lonOk || !alertOk) {
-        return;
-    }
-
-    if (qFuzzyIsNull(lat) && qFuzzyIsNull(lon)) {
-        return;
-    }
-
-    const double altitude = modeCAltitude * 0.3048;
-    const QGeoCoordinate location(lat, lon, altitude);
-
-    adsbInfo.location = location;
-    adsbInfo.alert = (alert == 1);
-    adsbInfo.availableFlags = ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable;
-
-    emit adsbVehicleUpdate(adsbInfo);
+    // qCDebug(ADSBTCPLinkLog) << Q_FUNC_INFO << this;
 }
 
-void ADSBTCPLink::_parseAndEmitHeading(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values)
+bool ADSBTCPLink::init()
 {
-    if (values.size() <= 13) {
-        return;
-    }
+    /* if (!QGCDeviceInfo::isInternetAvailable()) {
+        return false;
+    } */
 
-    bool headingOk = false, speedOk = false;
-    const double heading = values.at(13).toDouble(&headingOk);
-    const double speedKnots = values.at(12).toDouble(&speedOk);
-    if (!headingOk || !speedOk) {
-        return;
+    if (_hostAddress.isNull()) {
+        return false;
     }
 
-    adsbInfo.heading = heading;
-    adsbInfo.velocity = speedKnots * 0.514444;
-    adsbInfo.availableFlags = ADSB::HeadingAvailable | ADSB::VelocityAvailable;
-
-    if (values.size() > 16) {
-        bool vertOk = false;
-        const double verticalRate = values.at(16).toDouble(&vertOk);
-        if (vertOk) {
-            adsbInfo.verticalVel = verticalRate * 0.00508;
-            adsbInfo.availableFlags |= ADSB::VerticalVelAvailable;
-        }
-    }
+    (void) QMetaObject::invokeMethod(_worker, [worker = _worker, hostAddress = _hostAddress, port = _port]() {
+        worker->connectToHost(hostAddress, port);
+    }, Qt::QueuedConnection);
 
-    emit adsbVehicleUpdate(adsbInfo);
+    return true;
 }
@@ -9,19 +9,59 @@
 
 #pragma once
 
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
 #include <QtNetwork/QHostAddress>
 
 #include "ADSB.h"
+#include "ADSBSbsParser.h"
 
 Q_DECLARE_LOGGING_CATEGORY(ADSBTCPLinkLog)
 
 class QTcpSocket;
+class QThread;
 class QTimer;
 
+/// Lives on the ADS-B thread, reads and parses the SBS-1 stream and hands out coalesced batches
+class ADSBTCPLinkWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ADSBTCPLinkWorker(QObject *parent = nullptr);
+    ~ADSBTCPLinkWorker();
+
+    static constexpr int kFlushIntervalMSecs = 50;  ///< Interval at which queued updates go to the main thread
+
+public slots:
+    void setup();
+    void connectToHost(const QHostAddress &hostAddress, quint16 port);
+
+signals:
+    void adsbVehiclesUpdated(const QList<ADSB::VehicleInfo_t> &vehicleInfos);
+    void errorOccurred(const QString &errorMsg, bool stopped = false);
+
+private slots:
+    void _readBytes();
+    void _flush();
+
+private:
+    QTcpSocket *_socket = nullptr;
+    QTimer *_flushTimer = nullptr;
+    QByteArray _readBuffer;             ///< Reused, holds at most one incomplete line between reads
+    ADSBUpdateQueue _queue;
+    QList<ADSB::VehicleInfo_t> _batch;
+    quint64 _reportedDroppedCount = 0;
+};
+
+/*===========================================================================*/
+
 /// The ADSBTCPLink class handles the TCP connection to an ADS-B server
 /// and processes incoming ADS-B data.
+/// Reading and parsing happen on a dedicated thread, updates arrive on the main thread in batches
+/// with at most one entry per aircraft.
 class ADSBTCPLink : public QObject
 {
     Q_OBJECT
@@ -40,48 +80,18 @@ class ADSBTCPLink : public QObject
     bool init();
 
 signals:
-    /// Emitted when an ADS-B vehicle update is received.
-    ///     @param vehicleInfo The updated vehicle information.
-    void adsbVehicleUpdate(const ADSB::VehicleInfo_t &vehicleInfo);
+    /// Emitted periodically with the ADS-B vehicle updates received since the last batch.
+    ///     @param vehicleInfos The updated vehicle information, one entry per aircraft.
+    void adsbVehiclesUpdated(const QList<ADSB::VehicleInfo_t> &vehicleInfos);
 
     /// Emitted when an error occurs.
     ///     @param errorMsg The error message.
     void errorOccurred(const QString &errorMsg, bool stopped = false);
 
-private slots:
-    /// Reads bytes from the TCP socket.
-    void _readBytes();
-
-    /// Processes buffered lines of ADS-B data.
-    void _processLines();
-
 private:
-    /// Parses a line of ADS-B data.
-    ///     @param line The line to parse.
-    void _parseLine(const QString &line);
-
-    /// Parses and emits the callsign from ADS-B data.
-    ///     @param adsbInfo The ADS-B vehicle info structure to update.
-    ///     @param values The values parsed from the line.
-    void _parseAndEmitCallsign(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values);
-
-    /// Parses and emits the location from ADS-B data.
-    ///     @param adsbInfo The ADS-B vehicle info structure to update.
-    ///     @param values The values parsed from the line.
-    void _parseAndEmitLocation(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values);
-
-    /// Parses and emits the heading from ADS-B data.
-    ///     @param adsbInfo The ADS-B vehicle info structure to update.
-    ///     @param values The values parsed from the line.
-    void _parseAndEmitHeading(ADSB::VehicleInfo_t &adsbInfo, const QStringList &values);
-
     QHostAddress _hostAddress;
     quint16 _port = 30003;
 
-    QTcpSocket *_socket = nullptr;     ///< Pointer to the TCP socket used for connection
-    QTimer *_processTimer = nullptr;   ///< Timer for periodic processing of ADS-B data
-    QStringList _lineBuffer;           ///< Buffer for storing incoming lines of ADS-B data
-
-    static constexpr int _processInterval = 50;     ///< Interval for processing lines
-    static constexpr int _maxLinesToProcess = 100;  ///< Maximum number of lines to process per timer timeout
+    ADSBTCPLinkWorker *_worker = nullptr;
+    QThread *_workerThread = nullptr;
 };
@@ -0,0 +1,285 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ADSBTrafficIndex.h"
+
+#include <QtCore/QtMath>
+
+#include <algorithm>
+
+namespace
+{
+
+constexpr double kEarthRadius = 6371000.;
+
+} // namespace
+
+ADSBTrafficIndex::ADSBTrafficIndex(qint64 expirationMs, double cellSize)
+    : _expirationMs(expirationMs)
+    , _cellSize(cellSize)
+    , _lonCells(qMax(1, qCeil(360. / cellSize)))
+{
+
+}
+
+void ADSBTrafficIndex::update(const ADSB::Track &track, qint64 nowMs)
+{
+    const uint32_t icaoAddress = track.icaoAddress;
+    const quint64 cell = _cellKey(_latIndex(track.latitude), _lonIndex(track.longitude));
+
+    auto it = _entries.find(icaoAddress);
+    if (it == _entries.end()) {
+        Entry entry;
+        entry.track = track;
+        entry.cell = cell;
+        entry.lastUpdateMs = nowMs;
+        entry.scheduledMs = nowMs;
+        (void) _entries.insert(icaoAddress, entry);
+        _cells[cell].append(icaoAddress);
+        _expiry.push(ExpiryRecord(nowMs, icaoAddress));
+        return;
+    }
+
+    if (it->cell != cell) {
+        _removeFromCell(it->cell, icaoAddress);
+        _cells[cell].append(icaoAddress);
+        it->cell = cell;
+    }
+
+    // The expiry record is left alone, takeExpired reschedules it when it comes due
+    it->track = track;
+    it->lastUpdateMs = nowMs;
+}
+
+bool ADSBTrafficIndex::remove(uint32_t icaoAddress)
+{
+    const auto it = _entries.constFind(icaoAddress);
+    if (it == _entries.constEnd()) {
+        return false;
+    }
+
+    // Its expiry record goes stale and is skipped once it comes due
+    _removeFromCell(it->cell, icaoAddress);
+    (void) _entries.erase(it);
+
+    return true;
+}
+
+void ADSBTrafficIndex::clear()
+{
+    _entries.clear();
+    _cells.clear();
+    _expiry = decltype(_expiry)();
+}
+
+QList<uint32_t> ADSBTrafficIndex::takeExpired(qint64 nowMs)
+{
+    QList<uint32_t> expired;
+
+    const qint64 cutoffMs = nowMs - _expirationMs;
+    while (!_expiry.empty() && (_expiry.top().first < cutoffMs)) {
+        const ExpiryRecord record = _expiry.top();
+        _expiry.pop();
+
+        const uint32_t icaoAddress = record.second;
+        auto it = _entries.find(icaoAddress);
+        if ((it == _entries.end()) || (it->scheduledMs != record.first)) {
+            continue;
+        }
+
+        if (it->lastUpdateMs < cutoffMs) {
+            _removeFromCell(it->cell, icaoAddress);
+            (void) _entries.erase(it);
+            expired.append(icaoAddress);
+        } else {
+            it->scheduledMs = it->lastUpdateMs;
+            _expiry.push(ExpiryRecord(it->lastUpdateMs, icaoAddress));
+        }
+    }
+
+    return expired;
+}
+
+void ADSBTrafficIndex::query(const QGeoCoordinate &center, double radius, double altitudeWindow, QList<uint32_t> &icaoAddresses) const
+{
+    icaoAddresses.clear();
+    if (!center.isValid() || _entries.isEmpty()) {
+        return;
+    }
+
+    const double latitude = center.latitude();
+    const double longitude = center.longitude();
+    const double radiusSquared = radius * radius;
+    const bool checkAltitude = !qIsNaN(altitudeWindow) && !qIsNaN(center.altitude());
+
+    const auto match = [&](uint32_t icaoAddress, const Entry &entry) {
+        const ADSB::Track &track = entry.track;
+        if (checkAltitude && !qIsNaN(track.altitude) && (qAbs(track.altitude - center.altitude()) > altitudeWindow)) {
+            return;
+        }
+
+        double east, north;
+        localOffset(latitude, longitude, track.latitude, track.longitude, east, north);
+        if (((east * east) + (north * north)) <= radiusSquared) {
+            icaoAddresses.append(icaoAddress);
+        }
+    };
+
+    const double latSpanDegrees = qRadiansToDegrees(radius / kEarthRadius);
+    const double cosLatitude = qCos(qDegreesToRadians(latitude));
+    const int latSpan = qCeil(latSpanDegrees / _cellSize);
+    const int lonSpan = (cosLatitude > 0.01) ? qMin(qCeil(latSpanDegrees / cosLatitude / _cellSize), _lonCells) : _lonCells;
+    const bool allLongitudes = ((2 * lonSpan) + 1) >= _lonCells;
+    const qint64 cellsToVisit = static_cast<qint64>((2 * latSpan) + 1) * (allLongitudes ? _lonCells : ((2 * lonSpan) + 1));
+
+    // Large radius or sparse traffic, looking at every aircraft is cheaper than visiting the cells
+    if (cellsToVisit >= _cells.count()) {
+        for (auto it = _entries.constBegin(); it != _entries.constEnd(); ++it) {
+            match(it.key(), it.value());
+        }
+        return;
+    }
+
+    const int centerLat = _latIndex(latitude);
+    const int centerLon = _lonIndex(longitude);
+    const int latCells = qCeil(180. / _cellSize);
+    for (int lat = qMax(0, centerLat - latSpan); lat <= qMin(latCells - 1, centerLat + latSpan); lat++) {
+        const int lonFirst = allLongitudes ? 0 : (centerLon - lonSpan);
+        const int lonLast = allLongitudes ? (_lonCells - 1) : (centerLon + lonSpan);
+        for (int lon = lonFirst; lon <= lonLast; lon++) {
+            const int wrappedLon = ((lon % _lonCells) + _lonCells) % _lonCells;
+            const auto cellIt = _cells.constFind(_cellKey(lat, wrappedLon));
+            if (cellIt == _cells.constEnd()) {
+                continue;
+            }
+
+            for (const uint32_t icaoAddress : cellIt.value()) {
+                match(icaoAddress, *_entries.constFind(icaoAddress));
+            }
+        }
+    }
+}
+
+void ADSBTrafficIndex::conflicts(const ADSB::Track &own, const ADSB::ConflictThresholds &thresholds, QList<ADSB::TrafficConflict> &conflicts) const
+{
+    conflicts.clear();
+
+    // Anything further out can't close in to the horizontal separation within the lookahead time
+    const double searchRadius = thresholds.horizontalSeparation + ((qAbs(own.velocity) + kMaxTrafficVelocity) * thresholds.lookahead);
+
+    QList<uint32_t> candidates;
+    query(QGeoCoordinate(own.latitude, own.longitude), searchRadius, qQNaN(), candidates);
+
+    for (const uint32_t icaoAddress : std::as_const(candidates)) {
+        const ADSB::TrafficConflict conflict = closestPointOfApproach(own, _entries.constFind(icaoAddress)->track, thresholds.lookahead);
+        if (conflict.horizontalDistanceAtCpa > thresholds.horizontalSeparation) {
+            continue;
+        }
+        // Unknown altitude is treated as a conflict
+        if (!qIsNaN(conflict.verticalDistanceAtCpa) && (conflict.verticalDistanceAtCpa > thresholds.verticalSeparation)) {
+            continue;
+        }
+
+        conflicts.append(conflict);
+    }
+
+    std::sort(conflicts.begin(), conflicts.end(), [](const ADSB::TrafficConflict &a, const ADSB::TrafficConflict &b) {
+        return (a.timeToCpa < b.timeToCpa);
+    });
+}
+
+ADSB::TrafficConflict ADSBTrafficIndex::closestPointOfApproach(const ADSB::Track &own, const ADSB::Track &traffic, double maxTime)
+{
+    ADSB::TrafficConflict conflict;
+    conflict.icaoAddress = traffic.icaoAddress;
+
+    // Relative position and velocity of the traffic in a local east/north frame centered on own
+    double east, north;
+    localOffset(own.latitude, own.longitude, traffic.latitude, traffic.longitude, east, north);
+
+    const double ownHeading = qDegreesToRadians(own.heading);
+    const double trafficHeading = qDegreesToRadians(traffic.heading);
+    const double velEast = (traffic.velocity * qSin(trafficHeading)) - (own.velocity * qSin(ownHeading));
+    const double velNorth = (traffic.velocity * qCos(trafficHeading)) - (own.velocity * qCos(ownHeading));
+
+    const double velSquared = (velEast * velEast) + (velNorth * velNorth);
+    double time = 0.;
+    if (velSquared > 1e-6) {
+        time = qBound(0., -((east * velEast) + (north * velNorth)) / velSquared, maxTime);
+    }
+
+    conflict.timeToCpa = time;
+    conflict.horizontalDistance = qSqrt((east * east) + (north * north));
+    const double eastAtCpa = east + (velEast * time);
+    const double northAtCpa = north + (velNorth * time);
+    conflict.horizontalDistanceAtCpa = qSqrt((eastAtCpa * eastAtCpa) + (northAtCpa * northAtCpa));
+
+    if (!qIsNaN(own.altitude) && !qIsNaN(traffic.altitude)) {
+        conflict.verticalDistanceAtCpa = qAbs((traffic.altitude - own.altitude) + ((traffic.verticalVel - own.verticalVel) * time));
+    }
+
+    return conflict;
+}
+
+void ADSBTrafficIndex::localOffset(double fromLatitude, double fromLongitude, double toLatitude, double toLongitude, double &east, double &north)
+{
+    double deltaLon = toLongitude - fromLongitude;
+    if (deltaLon > 180.) {
+        deltaLon -= 360.;
+    } else if (deltaLon < -180.) {
+        deltaLon += 360.;
+    }
+
+    const double meanLatitude = qDegreesToRadians((fromLatitude + toLatitude) / 2.);
+    east = qDegreesToRadians(deltaLon) * qCos(meanLatitude) * kEarthRadius;
+    north = qDegreesToRadians(toLatitude - fromLatitude) * kEarthRadius;
+}
+
+const ADSB::Track *ADSBTrafficIndex::track(uint32_t icaoAddress) const
+{
+    const auto it = _entries.constFind(icaoAddress);
+    return ((it == _entries.constEnd()) ? nullptr : &it->track);
+}
+
+quint64 ADSBTrafficIndex::_cellKey(int latIndex, int lonIndex) const
+{
+    return ((static_cast<quint64>(static_cast<uint32_t>(latIndex)) << 32) | static_cast<uint32_t>(lonIndex));
+}
+
+int ADSBTrafficIndex::_latIndex(double latitude) const
+{
+    const int latCells = qCeil(180. / _cellSize);
+    return qBound(0, qFloor((latitude + 90.) / _cellSize), latCells - 1);
+}
+
+int ADSBTrafficIndex::_lonIndex(double longitude) const
+{
+    const int index = qFloor((longitude + 180.) / _cellSize);
+    return (((index % _lonCells) + _lonCells) % _lonCells);
+}
+
+void ADSBTrafficIndex::_removeFromCell(quint64 cell, uint32_t icaoAddress)
+{
+    const auto it = _cells.find(cell);
+    if (it == _cells.end()) {
+        return;
+    }
+
+    QList<uint32_t> &icaoAddresses = it.value();
+    const qsizetype index = icaoAddresses.indexOf(icaoAddress);
+    if (index >= 0) {
+        // Order within a cell doesn't matter
+        icaoAddresses.swapItemsAt(index, icaoAddresses.count() - 1);
+        icaoAddresses.removeLast();
+    }
+
+    if (icaoAddresses.isEmpty()) {
+        (void) _cells.erase(it);
+    }
+}
@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QtNumeric>
+#include <QtPositioning/QGeoCoordinate>
+
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace ADSB {
+
+/// Position and motion of an aircraft, angles in degrees, distances in meters, speeds in m/s
+struct Track {
+    uint32_t icaoAddress = 0;
+    double latitude = 0.;
+    double longitude = 0.;
+    double altitude = qQNaN();  ///< NaN: Unknown
+    double heading = 0.;
+    double velocity = 0.;
+    double verticalVel = 0.;
+};
+
+/// Closest point of approach between our vehicle and a traffic aircraft
+struct TrafficConflict {
+    uint32_t icaoAddress = 0;
+    double timeToCpa = 0.;                  ///< Seconds from now, 0 if the aircraft are already diverging
+    double horizontalDistance = 0.;         ///< Current horizontal distance
+    double horizontalDistanceAtCpa = 0.;
+    double verticalDistanceAtCpa = qQNaN(); ///< NaN: Altitude of either aircraft unknown
+};
+
+/// Separation which counts as a conflict
+struct ConflictThresholds {
+    double horizontalSeparation = 1000.;    ///< Meters
+    double verticalSeparation = 150.;       ///< Meters, about 500 ft
+    double lookahead = 60.;                 ///< Seconds
+};
+
+} // namespace ADSB
+
+/// Spatial index over the tracked ADS-B traffic.
+///
+/// Aircraft are binned into a uniform latitude/longitude grid, updating a track only moves it between cells
+/// when it crosses a cell edge. Radius queries only visit the cells overlapping the radius, so they cost
+/// in proportion to the nearby traffic instead of all of it. Expiry is driven by a min-heap on the time of
+/// the last update which holds a single entry per aircraft, so checking for expired traffic is O(log n) per
+/// aircraft per expiry period instead of a scan of all traffic.
+class ADSBTrafficIndex
+{
+public:
+    /// @param expirationMs Aircraft without an update for longer than this are expired
+    /// @param cellSize Grid cell size in degrees
+    explicit ADSBTrafficIndex(qint64 expirationMs = kDefaultExpirationMs, double cellSize = kDefaultCellSize);
+
+    /// Adds or updates the track of an aircraft
+    ///     @param nowMs Monotonic time, used for expiry
+    void update(const ADSB::Track &track, qint64 nowMs);
+
+    /// @return false: Aircraft is not in the index
+    bool remove(uint32_t icaoAddress);
+    void clear();
+
+    /// Removes the aircraft which have not been updated for longer than the expiration
+    ///     @return ICAO addresses of the removed aircraft
+    QList<uint32_t> takeExpired(qint64 nowMs);
+
+    /// Finds the aircraft within radius of center
+    ///     @param altitudeWindow Maximum altitude difference, NaN for any. Aircraft with unknown altitude always match.
+    void query(const QGeoCoordinate &center, double radius, double altitudeWindow, QList<uint32_t> &icaoAddresses) const;
+
+    /// Computes the closest point of approach to own for the aircraft which may come closer than the thresholds
+    /// within the lookahead time.
+    ///     @param conflicts Sorted by time to closest point of approach
+    void conflicts(const ADSB::Track &own, const ADSB::ConflictThresholds &thresholds, QList<ADSB::TrafficConflict> &conflicts) const;
+
+    /// Closest point of approach assuming both aircraft keep their current velocity
+    ///     @param maxTime Time to the closest point of approach is limited to this
+    static ADSB::TrafficConflict closestPointOfApproach(const ADSB::Track &own, const ADSB::Track &traffic, double maxTime);
+
+    /// Local east/north offset in meters of to from from, accurate over the short distances used here
+    static void localOffset(double fromLatitude, double fromLongitude, double toLatitude, double toLongitude, double &east, double &north);
+
+    bool contains(uint32_t icaoAddress) const { return _entries.contains(icaoAddress); }
+    qsizetype count() const { return _entries.count(); }
+    qsizetype cellCount() const { return _cells.count(); }
+    const ADSB::Track *track(uint32_t icaoAddress) const;
+
+    static constexpr qint64 kDefaultExpirationMs = 120000;  ///< Aircraft without an update for two minutes are removed
+    static constexpr double kDefaultCellSize = 0.1;         ///< About 11 km north-south
+    static constexpr double kMaxTrafficVelocity = 300.;     ///< m/s, bounds the search radius of the conflict check
+
+private:
+    struct Entry {
+        ADSB::Track track;
+        quint64 cell = 0;
+        qint64 lastUpdateMs = 0;
+        qint64 scheduledMs = 0;     ///< Time of the entry's record in _expiry
+    };
+
+    using ExpiryRecord = std::pair<qint64, uint32_t>;   ///< Time of last update, ICAO address
+
+    quint64 _cellKey(int latIndex, int lonIndex) const;
+    int _latIndex(double latitude) const;
+    int _lonIndex(double longitude) const;
+    void _removeFromCell(quint64 cell, uint32_t icaoAddress);
+
+    const qint64 _expirationMs;
+    const double _cellSize;
+    const int _lonCells;
+    QHash<uint32_t, Entry> _entries;
+    QHash<quint64, QList<uint32_t>> _cells;
+    std::priority_queue<ExpiryRecord, std::vector<ExpiryRecord>, std::greater<ExpiryRecord>> _expiry;
+};
@@ -94,6 +94,4 @@ void ADSBVehicle::update(const ADSB::VehicleInfo_t &vehicleInfo)
             emit alertChanged();
         }
     }
-
-    _lastUpdateTimer.start();
 }
@@ -9,7 +9,6 @@
 
 #pragma once
 
-#include <QtCore/QElapsedTimer>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QtNumeric>
 #include <QtCore/QObject>
@@ -48,7 +47,6 @@ class ADSBVehicle : public QObject
     double verticalVel() const { return _info.verticalVel; }
     uint16_t squawk() const { return _info.squawk; }
     bool alert() const { return _info.alert; }
-    bool expired() const { return _lastUpdateTimer.hasExpired(_expirationTimeoutMs); }
     void update(const ADSB::VehicleInfo_t &vehicleInfo);
 
 signals:
@@ -63,7 +61,4 @@ class ADSBVehicle : public QObject
 
 private:
     ADSB::VehicleInfo_t _info{};
-    QElapsedTimer _lastUpdateTimer;
-
-    static constexpr qint64 _expirationTimeoutMs = 120000; ///< timeout with no update in ms after which the vehicle is removed.
 };
@@ -13,13 +13,17 @@
 #include "ADSBVehicleManagerSettings.h"
 #include "ADSBTCPLink.h"
 #include "ADSBVehicle.h"
+#include "MultiVehicleManager.h"
 #include "QmlObjectListModel.h"
+#include "Vehicle.h"
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/qapplicationstatic.h>
 #include <QtCore/QTimer>
 #include <qassert.h>
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(ADSBVehicleManagerLog, "qgc.adsb.adsbvehiclemanager")
 
 Q_APPLICATION_STATIC(ADSBVehicleManager, _adsbVehicleManager, SettingsManager::instance()->adsbVehicleManagerSettings());
@@ -37,6 +41,9 @@ ADSBVehicleManager::ADSBVehicleManager(ADSBVehicleManagerSettings *settings, QOb
     _adsbVehicleCleanupTimer->setSingleShot(false);
     _adsbVehicleCleanupTimer->setInterval(1000);
     (void) connect(_adsbVehicleCleanupTimer, &QTimer::timeout, this, &ADSBVehicleManager::_cleanupStaleVehicles);
+    (void) connect(_adsbVehicleCleanupTimer, &QTimer::timeout, this, &ADSBVehicleManager::_updateTrafficConflicts);
+
+    _trafficClock.start();
 
     Fact* const adsbEnabled = _adsbSettings->adsbServerConnectEnabled();
     Fact* const hostAddress = _adsbSettings->adsbServerHostAddress();
@@ -127,7 +134,7 @@ void ADSBVehicleManager::_handleADSBVehicle(const mavlink_message_t &message)
 
     if (adsbVehicleMsg.flags & ADSB_FLAGS_VERTICAL_VELOCITY_VALID) {
         vehicleInfo.availableFlags |= ADSB::VerticalVelAvailable;
-        vehicleInfo.verticalVel = adsbVehicleMsg.ver_velocity;
+        vehicleInfo.verticalVel = adsbVehicleMsg.ver_velocity / 1e2;
     }
 
     if (adsbVehicleMsg.flags & ADSB_FLAGS_BARO_VALID) {
@@ -147,16 +154,38 @@ void ADSBVehicleManager::_handleADSBVehicle(const mavlink_message_t &message)
 void ADSBVehicleManager::adsbVehicleUpdate(const ADSB::VehicleInfo_t &vehicleInfo)
 {
     const uint32_t icaoAddress = vehicleInfo.icaoAddress;
-    if (_adsbICAOMap.contains(icaoAddress)) {
-        _adsbICAOMap[icaoAddress]->update(vehicleInfo);
-        return;
-    }
-
-    if (vehicleInfo.availableFlags & ADSB::LocationAvailable) {
-        ADSBVehicle* const adsbVehicle = new ADSBVehicle(vehicleInfo, this);
+    ADSBVehicle *adsbVehicle = _adsbICAOMap.value(icaoAddress);
+    if (adsbVehicle) {
+        adsbVehicle->update(vehicleInfo);
+    } else if (vehicleInfo.availableFlags & ADSB::LocationAvailable) {
+        adsbVehicle = new ADSBVehicle(vehicleInfo, this);
         _adsbICAOMap[icaoAddress] = adsbVehicle;
         _adsbVehicles->append(adsbVehicle);
         qCDebug(ADSBVehicleManagerLog) << "Added" << QString::number(adsbVehicle->icaoAddress());
+
+        // Traffic reported by vehicles over MAVLink expires and is checked for conflicts as well
+        if (!_adsbVehicleCleanupTimer->isActive()) {
+            _adsbVehicleCleanupTimer->start();
+        }
+    } else {
+        return;
+    }
+
+    ADSB::Track track;
+    track.icaoAddress = icaoAddress;
+    track.latitude = adsbVehicle->coordinate().latitude();
+    track.longitude = adsbVehicle->coordinate().longitude();
+    track.altitude = adsbVehicle->altitude();
+    track.heading = adsbVehicle->heading();
+    track.velocity = adsbVehicle->velocity();
+    track.verticalVel = adsbVehicle->verticalVel();
+    _trafficIndex.update(track, _trafficClock.elapsed());
+}
+
+void ADSBVehicleManager::adsbVehicleUpdates(const QList<ADSB::VehicleInfo_t> &vehicleInfos)
+{
+    for (const ADSB::VehicleInfo_t &vehicleInfo : vehicleInfos) {
+        adsbVehicleUpdate(vehicleInfo);
     }
 }
 
@@ -173,7 +202,7 @@ void ADSBVehicleManager::_start(const QString &hostAddress, quint16 port)
     }
 
     _adsbTcpLink = adsbTcpLink;
-    (void) connect(_adsbTcpLink, &ADSBTCPLink::adsbVehicleUpdate, this, &ADSBVehicleManager::adsbVehicleUpdate, Qt::AutoConnection);
+    (void) connect(_adsbTcpLink, &ADSBTCPLink::adsbVehiclesUpdated, this, &ADSBVehicleManager::adsbVehicleUpdates, Qt::AutoConnection);
     (void) connect(_adsbTcpLink, &ADSBTCPLink::errorOccurred, this, &ADSBVehicleManager::_linkError, Qt::AutoConnection);
 
     _adsbVehicleCleanupTimer->start();
@@ -189,19 +218,111 @@ void ADSBVehicleManager::_stop()
 
     _adsbVehicles->clearAndDeleteContents();
     _adsbICAOMap.clear();
+    _trafficIndex.clear();
+
+    const QList<int> vehicleIds = _trafficConflicts.keys();
+    _trafficConflicts.clear();
+    for (const int vehicleId : vehicleIds) {
+        emit trafficConflictsChanged(vehicleId);
+    }
 }
 
 void ADSBVehicleManager::_cleanupStaleVehicles()
 {
-    for (qsizetype i = _adsbVehicles->count() - 1; i >= 0; i--) {
-        ADSBVehicle* const adsbVehicle = _adsbVehicles->value<ADSBVehicle*>(i);
-        if (adsbVehicle->expired()) {
-            qCDebug(ADSBVehicleManagerLog) << "Expired" << QString::number(adsbVehicle->icaoAddress());
-            (void) _adsbVehicles->removeAt(i);
-            (void) _adsbICAOMap.remove(adsbVehicle->icaoAddress());
-            adsbVehicle->deleteLater();
+    const QList<uint32_t> expired = _trafficIndex.takeExpired(_trafficClock.elapsed());
+    for (const uint32_t icaoAddress : expired) {
+        ADSBVehicle* const adsbVehicle = _adsbICAOMap.take(icaoAddress);
+        if (!adsbVehicle) {
+            continue;
+        }
+
+        qCDebug(ADSBVehicleManagerLog) << "Expired" << QString::number(icaoAddress);
+        (void) _adsbVehicles->removeOne(adsbVehicle);
+        adsbVehicle->deleteLater();
+    }
+}
+
+QList<ADSBVehicle*> ADSBVehicleManager::trafficNear(const QGeoCoordinate &center, double radius, double altitudeWindow) const
+{
+    QList<uint32_t> icaoAddresses;
+    _trafficIndex.query(center, radius, altitudeWindow, icaoAddresses);
+
+    QList<ADSBVehicle*> adsbVehicles;
+    adsbVehicles.reserve(icaoAddresses.count());
+    for (const uint32_t icaoAddress : std::as_const(icaoAddresses)) {
+        adsbVehicles.append(_adsbICAOMap.value(icaoAddress));
+    }
+
+    return adsbVehicles;
+}
+
+QList<ADSBVehicle*> ADSBVehicleManager::trafficNear(Vehicle *vehicle, double radius, double altitudeWindow) const
+{
+    const ADSB::Track track = _vehicleTrack(vehicle);
+    return trafficNear(QGeoCoordinate(track.latitude, track.longitude, track.altitude), radius, altitudeWindow);
+}
+
+ADSB::Track ADSBVehicleManager::_vehicleTrack(Vehicle *vehicle)
+{
+    const QGeoCoordinate coordinate = vehicle->coordinate();
+
+    ADSB::Track track;
+    track.latitude = coordinate.latitude();
+    track.longitude = coordinate.longitude();
+    track.altitude = vehicle->altitudeAMSL()->rawValue().toDouble();
+    track.heading = vehicle->heading()->rawValue().toDouble();
+    track.velocity = vehicle->groundSpeed()->rawValue().toDouble();
+    track.verticalVel = vehicle->climbRate()->rawValue().toDouble();
+
+    // Facts without data yet are NaN
+    if (qIsNaN(track.heading) || qIsNaN(track.velocity)) {
+        track.heading = 0.;
+        track.velocity = 0.;
+    }
+    if (qIsNaN(track.verticalVel)) {
+        track.verticalVel = 0.;
+    }
+
+    return track;
+}
+
+void ADSBVehicleManager::_updateTrafficConflicts()
+{
+    QHash<int, QList<ADSB::TrafficConflict>> previousConflicts = std::move(_trafficConflicts);
+    _trafficConflicts.clear();
+
+    if (_trafficIndex.count() > 0) {
+        const QmlObjectListModel* const vehicles = MultiVehicleManager::instance()->vehicles();
+        QList<ADSB::TrafficConflict> conflicts;
+        for (qsizetype i = 0; i < vehicles->count(); i++) {
+            Vehicle* const vehicle = vehicles->value<Vehicle*>(i);
+            if (!vehicle->coordinate().isValid()) {
+                continue;
+            }
+
+            _trafficIndex.conflicts(_vehicleTrack(vehicle), _conflictThresholds, conflicts);
+            if (!conflicts.isEmpty()) {
+                _trafficConflicts.insert(vehicle->id(), conflicts);
+            }
         }
     }
+
+    const auto sameAircraft = [](const QList<ADSB::TrafficConflict> &a, const QList<ADSB::TrafficConflict> &b) {
+        return std::equal(a.cbegin(), a.cend(), b.cbegin(), b.cend(), [](const ADSB::TrafficConflict &x, const ADSB::TrafficConflict &y) {
+            return (x.icaoAddress == y.icaoAddress);
+        });
+    };
+
+    for (auto it = _trafficConflicts.constBegin(); it != _trafficConflicts.constEnd(); ++it) {
+        const QList<ADSB::TrafficConflict> previous = previousConflicts.take(it.key());
+        if (!sameAircraft(previous, it.value())) {
+            qCDebug(ADSBVehicleManagerLog) << "Vehicle" << it.key() << "traffic conflicts" << it.value().count();
+            emit trafficConflictsChanged(it.key());
+        }
+    }
+    for (auto it = previousConflicts.constBegin(); it != previousConflicts.constEnd(); ++it) {
+        emit trafficConflictsChanged(it.key());
+    }
 }
 
 void ADSBVehicleManager::_linkError(const QString &errorMsg, bool stopped)
@@ -9,10 +9,14 @@
 
 #pragma once
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QList>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
 
 #include "ADSB.h"
+#include "ADSBTrafficIndex.h"
 #include "MAVLinkLib.h"
 
 Q_DECLARE_LOGGING_CATEGORY(ADSBVehicleManagerLog)
@@ -22,6 +26,7 @@ class ADSBVehicle;
 class QmlObjectListModel;
 class QTimer;
 class ADSBVehicleManagerSettings;
+class Vehicle;
 
 class ADSBVehicleManager : public QObject
 {
@@ -40,23 +45,49 @@ class ADSBVehicleManager : public QObject
 
     void mavlinkMessageReceived(const mavlink_message_t &message);
 
+    /// Finds the traffic near a position
+    ///     @param radius Horizontal distance in meters
+    ///     @param altitudeWindow Maximum altitude difference in meters, NaN for any. Traffic with unknown altitude always matches.
+    QList<ADSBVehicle*> trafficNear(const QGeoCoordinate &center, double radius, double altitudeWindow = qQNaN()) const;
+
+    /// Finds the traffic near one of our vehicles, altitudeWindow is compared against its AMSL altitude
+    QList<ADSBVehicle*> trafficNear(Vehicle *vehicle, double radius, double altitudeWindow = qQNaN()) const;
+
+    /// @return Traffic which comes within the conflict thresholds of the vehicle, sorted by time to closest point of approach.
+    ///         Updated once a second.
+    QList<ADSB::TrafficConflict> trafficConflicts(int vehicleId) const { return _trafficConflicts.value(vehicleId); }
+
+    const ADSB::ConflictThresholds &conflictThresholds() const { return _conflictThresholds; }
+    void setConflictThresholds(const ADSB::ConflictThresholds &thresholds) { _conflictThresholds = thresholds; }
+
+signals:
+    /// The traffic conflicts of a vehicle appeared, went away or changed aircraft
+    void trafficConflictsChanged(int vehicleId);
+
 public slots:
     void adsbVehicleUpdate(const ADSB::VehicleInfo_t &vehicleInfo);
+    void adsbVehicleUpdates(const QList<ADSB::VehicleInfo_t> &vehicleInfos);
 
 private slots:
     void _cleanupStaleVehicles();
+    void _updateTrafficConflicts();
     void _linkError(const QString &errorMsg, bool stopped = false);
 
 private:
     void _start(const QString &hostAddress, quint16 port);
     void _stop();
     void _handleADSBVehicle(const mavlink_message_t &message);
+    static ADSB::Track _vehicleTrack(Vehicle *vehicle);
 
     ADSBVehicleManagerSettings *_adsbSettings = nullptr;
     QTimer *_adsbVehicleCleanupTimer = nullptr;
     QmlObjectListModel *_adsbVehicles = nullptr;
 
-    QMap<uint32_t, ADSBVehicle*> _adsbICAOMap;
+    QHash<uint32_t, ADSBVehicle*> _adsbICAOMap;
+    ADSBTrafficIndex _trafficIndex;
+    QElapsedTimer _trafficClock;                                ///< Time base of _trafficIndex
+    ADSB::ConflictThresholds _conflictThresholds;
+    QHash<int, QList<ADSB::TrafficConflict>> _trafficConflicts; ///< Vehicle id to its current conflicts
     ADSBTCPLink *_adsbTcpLink = nullptr;
 
     static constexpr uint8_t kMaxTimeSinceLastSeen = 15;
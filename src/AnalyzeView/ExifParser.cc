@@ -12,6 +12,7 @@
 
 #include <QtCore/QByteArray>
 #include <QtCore/QDateTime>
+#include <QtCore/QIODevice>
 
 #include <exiv2/exiv2.hpp>
 
@@ -77,6 +78,66 @@ QDateTime readTime(const QByteArray &buf)
     }
 }
 
+QByteArray readHeader(QIODevice &device)
+{
+    static constexpr uchar kMarkerStart = 0xFF;
+    static constexpr uchar kStartOfImage = 0xD8;
+    static constexpr uchar kEndOfImage = 0xD9;
+    static constexpr uchar kStartOfScan = 0xDA;
+
+    QByteArray header = device.read(2);
+    if ((header.size() != 2) || (static_cast<uchar>(header[0]) != kMarkerStart) || (static_cast<uchar>(header[1]) != kStartOfImage)) {
+        return QByteArray();
+    }
+
+    // Segments are a marker followed by a big endian length which includes the length itself.
+    // The metadata lives in the APPn segments, all in front of the first scan.
+    while (true) {
+        const QByteArray segment = device.read(4);
+        if ((segment.size() < 2) || (static_cast<uchar>(segment[0]) != kMarkerStart)) {
+            return QByteArray();
+        }
+
+        const uchar marker = static_cast<uchar>(segment[1]);
+        if ((marker == kStartOfScan) || (marker == kEndOfImage)) {
+            break;
+        }
+
+        if (segment.size() != 4) {
+            return QByteArray();
+        }
+
+        const qint64 length = (static_cast<uchar>(segment[2]) << 8) | static_cast<uchar>(segment[3]);
+        if (length < 2) {
+            return QByteArray();
+        }
+
+        const QByteArray payload = device.read(length - 2);
+        if (payload.size() != (length - 2)) {
+            return QByteArray();
+        }
+
+        (void) header.append(segment);
+        (void) header.append(payload);
+    }
+
+    (void) header.append(static_cast<char>(kMarkerStart));
+    (void) header.append(static_cast<char>(kEndOfImage));
+
+    return header;
+}
+
+QDateTime readTime(QIODevice &device)
+{
+    const QByteArray header = readHeader(device);
+    if (header.isEmpty()) {
+        qCWarning(ExifParserLog) << "Not a JPEG image.";
+        return QDateTime();
+    }
+
+    return readTime(header);
+}
+
 bool write(QByteArray &buf, const GeoTagWorker::CameraFeedbackPacket &geotag)
 {
     try {
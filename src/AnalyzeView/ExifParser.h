@@ -14,6 +14,7 @@
 #include "GeoTagWorker.h"
 
 class QByteArray;
+class QIODevice;
 
 Q_DECLARE_LOGGING_CATEGORY(ExifParserLog)
 
@@ -21,5 +22,10 @@ namespace ExifParser
 {
     void init();
     QDateTime readTime(const QByteArray &buf);
+    /// Reads only the JPEG header from device, not the image data behind it
+    QDateTime readTime(QIODevice &device);
+    /// Reads the JPEG segments in front of the image data, which hold the metadata
+    ///     @return The segments as a JPEG without image data, empty if device doesn't hold a JPEG
+    QByteArray readHeader(QIODevice &device);
     bool write(QByteArray &buf, const GeoTagWorker::CameraFeedbackPacket &geotag);
 }
@@ -44,7 +44,8 @@ GeoTagController::~GeoTagController()
 
 void GeoTagController::cancelTagging()
 {
-    (void) QMetaObject::invokeMethod(_worker, "cancelTagging", Qt::AutoConnection);
+    // Called directly, a queued call would only arrive once the worker is done
+    _worker->cancelTagging();
     (void) QMetaObject::invokeMethod(_workerThread, "quit", Qt::AutoConnection);
 
     _workerThread->wait();
@@ -16,6 +16,10 @@
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QEventLoop>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
 
 QGC_LOGGING_CATEGORY(GeoTagWorkerLog, "qgc.analyzeview.geotagworker")
 
@@ -94,29 +98,42 @@ bool GeoTagWorker::_parseExif()
 {
     _imageTimestamps.clear();
 
-    // TODO: QtConcurrent::mapped?
-    for (const QFileInfo& fileInfo : _imageList) {
+    // Only the header in front of the image data is read, the time stamps come from several images at once
+    QFuture<ImageTime> future = QtConcurrent::mapped(_imageList, [this](const QFileInfo &fileInfo) {
+        ImageTime imageTime;
         if (_cancel) {
-            emit error(tr("Tagging cancelled"));
-            return false;
+            return imageTime;
         }
 
         QFile file(fileInfo.absoluteFilePath());
         if (!file.open(QIODevice::ReadOnly)) {
-            emit error(tr("Geotagging failed. Couldn't open image: %1").arg(fileInfo.fileName()));
-            return false;
+            imageTime.errorString = tr("Geotagging failed. Couldn't open image: %1").arg(fileInfo.fileName());
+            return imageTime;
+        }
+
+        imageTime.time = ExifParser::readTime(file);
+        if (!imageTime.time.isValid()) {
+            imageTime.errorString = tr("Geotagging failed. Couldn't extract time from image: %1").arg(fileInfo.fileName());
         }
 
-        const QByteArray imageBuffer = file.readAll();
-        file.close();
+        return imageTime;
+    });
+    _waitForStage(QFuture<void>(future), 1);
 
-        const QDateTime imageTime = ExifParser::readTime(imageBuffer);
-        if (!imageTime.isValid()) {
-            emit error(tr("Geotagging failed. Couldn't extract time from image: %1").arg(fileInfo.fileName()));
+    if (_cancel) {
+        emit error(tr("Tagging cancelled"));
+        return false;
+    }
+
+    const QList<ImageTime> imageTimes = future.results();
+    _imageTimestamps.reserve(imageTimes.size());
+    for (const ImageTime &imageTime : imageTimes) {
+        if (!imageTime.errorString.isEmpty()) {
+            emit error(imageTime.errorString);
             return false;
         }
 
-        (void) _imageTimestamps.append(imageTime.toSecsSinceEpoch());
+        (void) _imageTimestamps.append(imageTime.time.toSecsSinceEpoch());
     }
 
     emit progressChanged(2.0 * (100.0 / kSteps));
@@ -134,8 +151,10 @@ bool GeoTagWorker::_parseLogs()
         return false;
     }
 
-    const QByteArray log = file.readAll();
-    file.close();
+    // Map the log instead of copying it, logs of long flights are hundreds of megabytes
+    const qint64 logSize = file.size();
+    const uchar* const logData = file.map(0, logSize);
+    const QByteArray log = logData ? QByteArray::fromRawData(reinterpret_cast<const char*>(logData), logSize) : file.readAll();
 
     bool parseComplete = false;
     QString errorString;
@@ -145,6 +164,8 @@ bool GeoTagWorker::_parseLogs()
         parseComplete = PX4LogParser::getTagsFromLog(log, _triggerList);
     }
 
+    file.close();
+
     if (!parseComplete) {
         emit error(errorString.isEmpty() ? tr("Log parsing failed") : errorString);
         return false;
@@ -204,49 +225,80 @@ bool GeoTagWorker::_tagImages()
 {
     const qsizetype maxIndex = std::min(_imageIndices.count(), _triggerIndices.count());
     for (int i = 0; i < maxIndex; i++) {
-        if (_cancel) {
-            emit error(tr("Tagging cancelled"));
+        if (_imageIndices[i] >= _imageList.count()) {
+            emit error(tr("Geotagging failed. Requesting image #%1, but only %2 images present.").arg(_imageIndices[i]).arg(_imageList.count()));
             return false;
         }
+    }
 
-        const int imageIndex = _imageIndices[i];
-        if (imageIndex >= _imageList.count()) {
-            emit error(tr("Geotagging failed. Requesting image #%1, but only %2 images present.").arg(imageIndex).arg(_imageList.count()));
-            return false;
+    const QString saveDirectory = _saveDirectory.isEmpty() ? (_imageDirectory + "/TAGGED") : _saveDirectory;
+
+    // Images are tagged in parallel, but only a few at a time since each one is held in memory
+    QThreadPool writerPool;
+    writerPool.setMaxThreadCount(qBound(1, QThread::idealThreadCount(), kMaxParallelWrites));
+
+    const QList<int> imageIndices = _imageIndices.mid(0, maxIndex);
+    QFuture<QString> future = QtConcurrent::mapped(&writerPool, imageIndices, [this, &saveDirectory](int imageIndex) {
+        if (_cancel) {
+            return QString();
         }
 
         const QFileInfo &imageInfo = _imageList.at(imageIndex);
         QFile fileRead(imageInfo.absoluteFilePath());
         if (!fileRead.open(QIODevice::ReadOnly)) {
-            emit error(tr("Geotagging failed. Couldn't open an image."));
-            return false;
+            return tr("Geotagging failed. Couldn't open an image.");
         }
 
         QByteArray imageBuffer = fileRead.readAll();
         fileRead.close();
 
         if (!ExifParser::write(imageBuffer, _triggerList[imageIndex])) {
-            emit error(tr("Geotagging failed. Couldn't write to image: %1").arg(imageInfo.fileName()));
-            return false;
+            return tr("Geotagging failed. Couldn't write to image: %1").arg(imageInfo.fileName());
         }
 
-        QFile fileWrite;
-        if (_saveDirectory.isEmpty()) {
-            fileWrite.setFileName(_imageDirectory + "/TAGGED/" + imageInfo.fileName());
-        } else {
-            fileWrite.setFileName(_saveDirectory + "/" + imageInfo.fileName());
+        QFile fileWrite(saveDirectory + "/" + imageInfo.fileName());
+        if (!fileWrite.open(QFile::WriteOnly) || (fileWrite.write(imageBuffer) != imageBuffer.size())) {
+            return tr("Geotagging failed. Couldn't write to image: %1").arg(imageInfo.fileName());
         }
+        fileWrite.close();
+
+        return QString();
+    });
+    _waitForStage(QFuture<void>(future), 4);
+
+    if (_cancel) {
+        emit error(tr("Tagging cancelled"));
+        return false;
+    }
 
-        if (!fileWrite.open(QFile::WriteOnly)) {
-            emit error(tr("Geotagging failed. Couldn't write to image: %1").arg(imageInfo.fileName()));
+    for (const QString &errorString : future.results()) {
+        if (!errorString.isEmpty()) {
+            emit error(errorString);
             return false;
         }
+    }
 
-        fileWrite.write(imageBuffer);
-        fileWrite.close();
+    return true;
+}
 
-        emit progressChanged(4. * (100. / kSteps) + ((100. / kSteps) / maxIndex) * i);
+void GeoTagWorker::_waitForStage(QFuture<void> future, int stage)
+{
+    // This thread's event loop is blocked in process(), run a local one for the watcher
+    QEventLoop eventLoop;
+    QFutureWatcher<void> watcher;
+    (void) connect(&watcher, &QFutureWatcherBase::progressValueChanged, this, [this, &watcher, stage](int progressValue) {
+        const int progressMaximum = watcher.progressMaximum();
+        if (progressMaximum > 0) {
+            emit progressChanged((stage + (static_cast<double>(progressValue) / progressMaximum)) * (100. / kSteps));
+        }
+    });
+    (void) connect(&watcher, &QFutureWatcherBase::finished, &eventLoop, &QEventLoop::quit);
+    watcher.setFuture(future);
+
+    if (!watcher.isFinished()) {
+        (void) eventLoop.exec();
     }
 
-    return true;
+    // Quitting the thread also ends the local event loop, the remaining items skip their work once cancelled
+    future.waitForFinished();
 }
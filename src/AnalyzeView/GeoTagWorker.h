@@ -9,11 +9,15 @@
 
 #pragma once
 
+#include <QtCore/QDateTime>
 #include <QtCore/QFileInfoList>
+#include <QtCore/QFuture>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
 #include <QtCore/QString>
 
+#include <atomic>
+
 Q_DECLARE_LOGGING_CATEGORY(GeoTagWorkerLog)
 
 class GeoTagWorker : public QObject
@@ -50,16 +54,26 @@ class GeoTagWorker : public QObject
 
 public slots:
     bool process();
+    /// Thread safe, may be called directly while process() runs
     void cancelTagging() { _cancel = true; }
 
 private:
+    /// Result of reading the time stamp of one image
+    struct ImageTime {
+        QDateTime time;
+        QString errorString;    ///< Set if the image couldn't be read
+    };
+
     bool _loadImages();
     bool _parseExif();
     bool _parseLogs();
     bool _calibrate();
     bool _tagImages();
+    /// Waits for a parallel stage to finish while reporting its progress
+    ///     @param stage Index of the stage, progress runs from stage to stage + 1 fifths
+    void _waitForStage(QFuture<void> future, int stage);
 
-    bool _cancel = false;
+    std::atomic_bool _cancel = false;
     QString _logFile;
     QString _imageDirectory;
     QString _saveDirectory;
@@ -71,4 +85,5 @@ public slots:
     QList<int> _triggerIndices;
 
     static constexpr double kSteps = 5.;
+    static constexpr int kMaxParallelWrites = 4;    ///< Every write holds a whole image in memory
 };
@@ -9,6 +9,7 @@
 
 #include "LogDownloadController.h"
 #include "AppSettings.h"
+#include "LogDownloadWriter.h"
 #include "LogEntry.h"
 #include "MAVLinkProtocol.h"
 #include "MultiVehicleManager.h"
@@ -20,6 +21,7 @@
 #include "Vehicle.h"
 
 #include <QtCore/qapplicationstatic.h>
+#include <QtCore/QFile>
 #include <QtCore/QTimer>
 
 QGC_LOGGING_CATEGORY(LogDownloadControllerLog, "qgc.analyzeview.logdownloadcontroller")
@@ -29,12 +31,22 @@ Q_APPLICATION_STATIC(LogDownloadController, _logDownloadControllerInstance);
 LogDownloadController::LogDownloadController(QObject *parent)
     : QObject(parent)
     , _timer(new QTimer(this))
+    , _writer(new LogDownloadWriter(this))
     , _logEntriesModel(new QmlObjectListModel(this))
 {
     // qCDebug(LogDownloadControllerLog) << Q_FUNC_INFO << this;
 
     (void) connect(MultiVehicleManager::instance(), &MultiVehicleManager::activeVehicleChanged, this, &LogDownloadController::_setActiveVehicle);
     (void) connect(_timer, &QTimer::timeout, this, &LogDownloadController::_processDownload);
+    (void) connect(_writer, &LogDownloadWriter::writeFailed, this, [this](const QString &fileName, const QString &errorString) {
+        qCWarning(LogDownloadControllerLog) << "Log file write failed:" << fileName << errorString;
+        if (_downloadData && (_downloadData->filePath == fileName)) {
+            _downloadData->entry->setStatus(tr("Error"));
+            _downloadData->pending.clear();
+            _writer->discard();
+            _receivedAllData();
+        }
+    });
 
     _timer->setSingleShot(false);
 
@@ -246,94 +258,110 @@ void LogDownloadController::_logData(uint32_t ofs, uint16_t id, uint8_t count, c
         return;
     }
 
-    bool result = false;
-    if (ofs <= _downloadData->entry->size()) {
-        const uint32_t chunk = ofs / LogDownloadData::kChunkSize;
-        // qCDebug(LogDownloadControllerLog) << "Received data - Offset:" << ofs << "Chunk:" << chunk;
-        if (chunk != _downloadData->current_chunk) {
-            qCWarning(LogDownloadControllerLog) << "Ignored packet for out of order chunk actual:expected" << chunk << _downloadData->current_chunk;
-            return;
-        }
+    const uint32_t bin = ofs / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    if (bin >= _downloadData->numBins()) {
+        qCWarning(LogDownloadControllerLog) << "Received log offset greater than expected";
+        _downloadData->entry->setStatus(tr("Error"));
+        return;
+    }
 
-        const uint16_t bin = (ofs - (chunk * LogDownloadData::kChunkSize)) / MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
-        if (bin >= _downloadData->chunk_table.size()) {
-            qCWarning(LogDownloadControllerLog) << "Out of range bin received";
-        } else {
-            _downloadData->chunk_table.setBit(bin);
-        }
+    _retries = 0;
+    _timer->start(kTimeOutMs);
 
-        if (_downloadData->file.pos() != ofs) {
-            if (!_downloadData->file.seek(ofs)) {
-                qCWarning(LogDownloadControllerLog) << "Error while seeking log file offset";
-                return;
-            }
-        }
+    if (!_downloadData->setReceived(bin)) {
+        // Data of a request which was replaced while it was in flight
+        return;
+    }
 
-        if (_downloadData->file.write(reinterpret_cast<const char*>(data), count)) {
-            _downloadData->written += count;
-            _downloadData->rate_bytes += count;
-            _updateDataRate();
-
-            result = true;
-            _retries = 0;
-
-            _timer->start(kTimeOutMs);
-            if (_logComplete()) {
-                _downloadData->entry->setStatus(tr("Downloaded"));
-                _receivedAllData();
-            } else if (_chunkComplete()) {
-                _downloadData->advanceChunk();
-                _requestLogData(_downloadData->ID,
-                                _downloadData->current_chunk * LogDownloadData::kChunkSize,
-                                _downloadData->chunk_table.size() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-            } else if ((bin < (_downloadData->chunk_table.size() - 1)) && _downloadData->chunk_table.at(bin + 1)) {
-                // Likely to be grabbing fragments and got to the end of a gap
-                _findMissingData();
-            }
-        } else {
-            qCWarning(LogDownloadControllerLog) << "Error while writing log file chunk";
-        }
-    } else {
-        qCWarning(LogDownloadControllerLog) << "Received log offset greater than expected";
+    _bufferData(ofs, data, count);
+    _downloadData->written += count;
+    _downloadData->rate_bytes += count;
+    _updateDataRate();
+
+    if (_downloadData->complete()) {
+        _finishLog();
+        return;
     }
 
-    if (!result) {
-        _downloadData->entry->setStatus(tr("Error"));
+    // Only data of the outstanding request tells us where the vehicle is, anything else was already in flight
+    if ((bin < _downloadData->request_start) || (bin >= _downloadData->request_end)) {
+        return;
+    }
+
+    const bool drained = ((bin + 1) >= _downloadData->request_end);
+    const bool caughtUp = !drained && _downloadData->received(bin + 1);
+    if (drained || caughtUp || _downloadData->shouldSlide(bin)) {
+        _requestNextRange();
     }
 }
 
-void LogDownloadController::_findMissingData()
+void LogDownloadController::_bufferData(uint32_t ofs, const uint8_t *data, uint8_t count)
 {
-    if (_logComplete()) {
-        _receivedAllData();
+    if (!_downloadData->pending.isEmpty() && (ofs != (_downloadData->pending_offset + _downloadData->pending.size()))) {
+        _flushPending();
+    }
+
+    if (_downloadData->pending.isEmpty()) {
+        _downloadData->pending_offset = ofs;
+        _downloadData->pending.reserve(LogDownloadWriter::kBlockSize + MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
+    }
+
+    (void) _downloadData->pending.append(reinterpret_cast<const char*>(data), count);
+    if (_downloadData->pending.size() >= LogDownloadWriter::kBlockSize) {
+        _flushPending();
+    }
+}
+
+void LogDownloadController::_flushPending()
+{
+    if (!_downloadData || _downloadData->pending.isEmpty()) {
         return;
     }
 
-    if (_chunkComplete()) {
-        _downloadData->advanceChunk();
+    _writer->write(_downloadData->pending_offset, _downloadData->pending);
+    _downloadData->pending.clear();
+}
+
+void LogDownloadController::_findMissingData()
+{
+    if (_downloadData->complete()) {
+        _finishLog();
+        return;
     }
 
+    // The link stalled, don't hold on to received data any longer
+    _flushPending();
+
     _retries++;
 
     _updateDataRate();
 
-    uint16_t start = 0, end = 0;
-    const int size = _downloadData->chunk_table.size();
-    for (; start < size; start++) {
-        if (!_downloadData->chunk_table.testBit(start)) {
-            break;
-        }
-    }
+    _requestNextRange();
+}
 
-    for (end = start; end < size; end++) {
-        if (_downloadData->chunk_table.testBit(end)) {
-            break;
-        }
-    }
+void LogDownloadController::_requestNextRange()
+{
+    uint32_t start = 0, end = 0;
+    _downloadData->filling_gap = _downloadData->nextRequest(start, end);
+    _downloadData->request_start = start;
+    _downloadData->request_end = end;
 
-    const uint32_t pos = (_downloadData->current_chunk * LogDownloadData::kChunkSize) + (start * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-    const uint32_t len = (end - start) * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
-    _requestLogData(_downloadData->ID, pos, len, _retries);
+    _requestLogData(_downloadData->ID, start * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN, (end - start) * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN, _retries);
+}
+
+void LogDownloadController::_finishLog()
+{
+    _flushPending();
+    _writer->close();
+
+    const qreal throughput = _downloadData->throughput();
+    qCDebug(LogDownloadControllerLog) << "Downloaded" << _downloadData->filePath << _downloadData->written << "bytes in" << _downloadData->started.elapsed() << "ms" << throughput << "bytes/s";
+
+    _downloadData->entry->setThroughput(throughput);
+    _downloadData->entry->setStatus(tr("Downloaded (%1/s)").arg(qgcApp()->bigSizeToString(throughput)));
+
+    // Straight on to the next selected log while this one is still being written out
+    _receivedAllData();
 }
 
 void LogDownloadController::_updateDataRate()
@@ -353,23 +381,19 @@ void LogDownloadController::_updateDataRate()
     _downloadData->elapsed.start();
 }
 
-bool LogDownloadController::_chunkComplete() const
-{
-    return _downloadData->chunkEquals(true);
-}
-
-bool LogDownloadController::_logComplete() const
-{
-    return (_chunkComplete() && ((_downloadData->current_chunk + 1) == _downloadData->numChunks()));
-}
-
 void LogDownloadController::_receivedAllData()
 {
     _timer->stop();
     if (_prepareLogDownload()) {
-        _requestLogData(_downloadData->ID, 0, _downloadData->chunk_table.size() * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
+        if (_downloadData->complete()) {
+            _finishLog();
+            return;
+        }
+
+        _requestNextRange();
         _timer->start(kTimeOutMs);
     } else {
+        _writer->waitForIdle();
         _resetSelection();
         _setDownloading(false);
     }
@@ -404,40 +428,26 @@ bool LogDownloadController::_prepareLogDownload()
         _downloadData->filename += ".bin";
     }
 
-    _downloadData->file.setFileName(_downloadPath + _downloadData->filename);
+    _downloadData->filePath = _downloadPath + _downloadData->filename;
 
-    if (_downloadData->file.exists()) {
+    if (QFile::exists(_downloadData->filePath)) {
         uint32_t numDups = 0;
         const QStringList filename_spl = _downloadData->filename.split('.');
         do {
             numDups += 1;
             const QString filename = filename_spl[0] + '_' + QString::number(numDups) + '.' + filename_spl[1];
-            _downloadData->file.setFileName(filename);
-        } while ( _downloadData->file.exists());
-    }
-
-    bool result = false;
-    if (!_downloadData->file.open(QIODevice::WriteOnly)) {
-        qCWarning(LogDownloadControllerLog) << "Failed to create log file:" <<  _downloadData->filename;
-    } else if (!_downloadData->file.resize(entry->size())) {
-        qCWarning(LogDownloadControllerLog) << "Failed to allocate space for log file:" <<  _downloadData->filename;
-    } else {
-        _downloadData->current_chunk = 0;
-        _downloadData->chunk_table = QBitArray(_downloadData->chunkBins(), false);
-        _downloadData->elapsed.start();
-        result = true;
+            _downloadData->filePath = _downloadPath + filename;
+        } while (QFile::exists(_downloadData->filePath));
     }
 
-    if (!result) {
-        if (_downloadData->file.exists()) {
-            (void) _downloadData->file.remove();
-        }
+    // Failures to create the file are reported back through writeFailed
+    _writer->open(_downloadData->filePath, entry->size());
 
-        _downloadData->entry->setStatus(QStringLiteral("Error"));
-        _downloadData.reset();
-    }
+    _downloadData->bin_table = QBitArray(_downloadData->numBins(), false);
+    _downloadData->elapsed.start();
+    _downloadData->started.start();
 
-    return result;
+    return true;
 }
 
 void LogDownloadController::refresh()
@@ -470,10 +480,8 @@ void LogDownloadController::cancel()
 
     if (_downloadData) {
         _downloadData->entry->setStatus(QStringLiteral("Canceled"));
-        if (_downloadData->file.exists()) {
-            (void) _downloadData->file.remove();
-        }
-
+        _downloadData->pending.clear();
+        _writer->discard();
         _downloadData.reset();
     }
 
@@ -16,6 +16,7 @@
 Q_DECLARE_LOGGING_CATEGORY(LogDownloadControllerLog)
 
 struct LogDownloadData;
+class LogDownloadWriter;
 class QGCLogEntry;
 class QmlObjectListModel;
 class QTimer;
@@ -63,17 +64,19 @@ private slots:
     bool _getRequestingList() const { return _requestingLogEntries; }
     bool _getDownloadingLogs() const { return _downloadingLogs; }
 
-    bool _chunkComplete() const;
     bool _entriesComplete() const;
-    bool _logComplete() const;
     bool _prepareLogDownload();
+    void _bufferData(uint32_t ofs, const uint8_t *data, uint8_t count);
     void _downloadToDirectory(const QString &dir);
     void _findMissingData();
     void _findMissingEntries();
+    void _finishLog();
+    void _flushPending();
     void _receivedAllData();
     void _receivedAllEntries();
     void _requestLogData(uint16_t id, uint32_t offset, uint32_t count, int retryCount = 0);
     void _requestLogList(uint32_t start, uint32_t end);
+    void _requestNextRange();
     void _requestLogEnd();
     void _resetSelection(bool canceled = false);
     void _setDownloading(bool active);
@@ -83,6 +86,7 @@ private slots:
     QGCLogEntry *_getNextSelected() const;
 
     QTimer *_timer = nullptr;
+    LogDownloadWriter *_writer = nullptr;
     QmlObjectListModel *_logEntriesModel = nullptr;
 
     bool _downloadingLogs = false;
@@ -0,0 +1,147 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "LogDownloadWriter.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QThread>
+
+QGC_LOGGING_CATEGORY(LogDownloadWriterLog, "qgc.analyzeview.logdownloadwriter")
+
+LogDownloadWorker::LogDownloadWorker(QObject *parent)
+    : QObject(parent)
+    , _file(new QFile(this))
+{
+    // qCDebug(LogDownloadWriterLog) << Q_FUNC_INFO << this;
+}
+
+LogDownloadWorker::~LogDownloadWorker()
+{
+    // qCDebug(LogDownloadWriterLog) << Q_FUNC_INFO << this;
+}
+
+void LogDownloadWorker::open(const QString &fileName, qint64 size)
+{
+    close();
+
+    _failed = false;
+    _file->setFileName(fileName);
+    if (!_file->open(QIODevice::WriteOnly)) {
+        qCWarning(LogDownloadWriterLog) << "Failed to create log file:" << fileName << _file->errorString();
+        _fail();
+    } else if (!_file->resize(size)) {
+        qCWarning(LogDownloadWriterLog) << "Failed to allocate space for log file:" << fileName << _file->errorString();
+        _fail();
+    }
+}
+
+void LogDownloadWorker::write(qint64 offset, const QByteArray &data)
+{
+    if (!_file->isOpen() || _failed) {
+        return;
+    }
+
+    if ((_file->pos() != offset) && !_file->seek(offset)) {
+        qCWarning(LogDownloadWriterLog) << "Error while seeking log file offset" << offset << _file->errorString();
+        _fail();
+    } else if (_file->write(data) != data.size()) {
+        qCWarning(LogDownloadWriterLog) << "Error while writing log file" << _file->errorString();
+        _fail();
+    }
+}
+
+void LogDownloadWorker::close()
+{
+    if (_file->isOpen()) {
+        _file->close();
+    }
+}
+
+void LogDownloadWorker::discard()
+{
+    close();
+
+    if (!_file->fileName().isEmpty() && _file->exists()) {
+        (void) _file->remove();
+    }
+}
+
+void LogDownloadWorker::_fail()
+{
+    _failed = true;
+    emit writeFailed(_file->fileName(), _file->errorString());
+}
+
+/*===========================================================================*/
+
+LogDownloadWriter::LogDownloadWriter(QObject *parent)
+    : QObject(parent)
+    , _worker(new LogDownloadWorker())
+    , _workerThread(new QThread(this))
+{
+    // qCDebug(LogDownloadWriterLog) << Q_FUNC_INFO << this;
+
+    _workerThread->setObjectName(QStringLiteral("LogDownload"));
+
+    _worker->moveToThread(_workerThread);
+
+    (void) connect(_workerThread, &QThread::finished, _worker, &QObject::deleteLater);
+    (void) connect(_worker, &LogDownloadWorker::writeFailed, this, &LogDownloadWriter::writeFailed, Qt::QueuedConnection);
+
+    _workerThread->start();
+}
+
+LogDownloadWriter::~LogDownloadWriter()
+{
+    // Anything still queued must reach the disk before the thread goes away
+    (void) QMetaObject::invokeMethod(_worker, [this]() {
+        _worker->close();
+    }, Qt::BlockingQueuedConnection);
+
+    _workerThread->quit();
+    if (!_workerThread->wait()) {
+        qCWarning(LogDownloadWriterLog) << "Failed to wait for log download thread to close";
+    }
+
+    // qCDebug(LogDownloadWriterLog) << Q_FUNC_INFO << this;
+}
+
+void LogDownloadWriter::open(const QString &fileName, qint64 size)
+{
+    (void) QMetaObject::invokeMethod(_worker, [this, fileName, size]() {
+        _worker->open(fileName, size);
+    }, Qt::QueuedConnection);
+}
+
+void LogDownloadWriter::write(qint64 offset, const QByteArray &data)
+{
+    (void) QMetaObject::invokeMethod(_worker, [this, offset, data]() {
+        _worker->write(offset, data);
+    }, Qt::QueuedConnection);
+}
+
+void LogDownloadWriter::close()
+{
+    (void) QMetaObject::invokeMethod(_worker, [this]() {
+        _worker->close();
+    }, Qt::QueuedConnection);
+}
+
+void LogDownloadWriter::discard()
+{
+    (void) QMetaObject::invokeMethod(_worker, [this]() {
+        _worker->discard();
+    }, Qt::QueuedConnection);
+}
+
+void LogDownloadWriter::waitForIdle()
+{
+    (void) QMetaObject::invokeMethod(_worker, []() {}, Qt::BlockingQueuedConnection);
+}
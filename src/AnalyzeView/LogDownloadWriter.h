@@ -0,0 +1,82 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+class QFile;
+class QThread;
+
+Q_DECLARE_LOGGING_CATEGORY(LogDownloadWriterLog)
+
+/// Lives on the log download thread and does the actual file io
+class LogDownloadWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LogDownloadWorker(QObject *parent = nullptr);
+    ~LogDownloadWorker();
+
+    void open(const QString &fileName, qint64 size);
+    void write(qint64 offset, const QByteArray &data);
+    void close();
+
+    /// Closes and deletes the file
+    void discard();
+
+signals:
+    void writeFailed(const QString &fileName, const QString &errorString);
+
+private:
+    void _fail();
+
+    QFile *_file = nullptr;
+    bool _failed = false;
+};
+
+/*===========================================================================*/
+
+/// Writes downloaded logs on a dedicated thread so the disk never stalls the link.
+/// All calls are queued in order, a file may be closed while the next one is already being written.
+class LogDownloadWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LogDownloadWriter(QObject *parent = nullptr);
+    ~LogDownloadWriter();
+
+    /// Creates the file and allocates its full size
+    void open(const QString &fileName, qint64 size);
+
+    /// Writes data at offset, blocks may arrive in any order
+    void write(qint64 offset, const QByteArray &data);
+
+    void close();
+
+    /// Closes and deletes the file
+    void discard();
+
+    /// Waits until everything queued so far has been written
+    void waitForIdle();
+
+    static constexpr qsizetype kBlockSize = 64 * 1024;  ///< Contiguous data is collected into blocks of this size before it is queued
+
+signals:
+    void writeFailed(const QString &fileName, const QString &errorString);
+
+private:
+    LogDownloadWorker *_worker = nullptr;
+    QThread *_workerThread = nullptr;
+};
@@ -27,27 +27,71 @@ LogDownloadData::~LogDownloadData()
     // qCDebug(LogEntryLog) << Q_FUNC_INFO << this;
 }
 
-void LogDownloadData::advanceChunk()
+uint32_t LogDownloadData::numBins() const
 {
-    ++current_chunk;
-    chunk_table = QBitArray(chunkBins(), false);
+    const qreal num = static_cast<qreal>(entry->size()) / static_cast<qreal>(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
+    return qCeil(num);
 }
 
-uint32_t LogDownloadData::chunkBins() const
+bool LogDownloadData::setReceived(uint32_t bin)
 {
-    const qreal num = static_cast<qreal>((entry->size() - (current_chunk * kChunkSize))) / static_cast<qreal>(MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN);
-    return qMin(static_cast<uint32_t>(qCeil(num)), kTableBins);
+    if (bin_table.testBit(bin)) {
+        return false;
+    }
+
+    bin_table.setBit(bin);
+    stream_end = qMax(stream_end, bin + 1);
+
+    const uint32_t bins = numBins();
+    while ((first_missing < bins) && bin_table.testBit(first_missing)) {
+        first_missing++;
+    }
+
+    return true;
 }
 
-uint32_t LogDownloadData::numChunks() const
+uint32_t LogDownloadData::windowEnd() const
 {
-    const qreal num = static_cast<qreal>(entry->size()) / static_cast<qreal>(kChunkSize);
-    return qCeil(num);
+    return qMin(first_missing + kWindowBins, numBins());
 }
 
-bool LogDownloadData::chunkEquals(const bool val) const
+bool LogDownloadData::nextRequest(uint32_t &startBin, uint32_t &endBin) const
 {
-    return (chunk_table == QBitArray(chunk_table.size(), val));
+    const uint32_t end = windowEnd();
+    const uint32_t remaining = numBins() - stream_end;
+    if ((stream_end < end) && ((end - stream_end) >= qMin(kTableBins, remaining))) {
+        startBin = stream_end;
+        endBin = end;
+        return false;
+    }
+
+    // The window is blocked by the gap at first_missing, which always ends before stream_end
+    startBin = first_missing;
+    endBin = startBin + 1;
+    while ((endBin < stream_end) && !bin_table.testBit(endBin)) {
+        endBin++;
+    }
+
+    return true;
+}
+
+bool LogDownloadData::shouldSlide(uint32_t bin) const
+{
+    if (filling_gap || (bin < request_start) || ((bin + 1) >= request_end)) {
+        return false;
+    }
+
+    const uint32_t end = windowEnd();
+    return (((request_end - (bin + 1)) <= kSlideBins) && (end > request_end) && ((end - request_end) >= qMin(kTableBins, numBins() - request_end)));
+}
+
+qreal LogDownloadData::throughput() const
+{
+    if (!started.isValid() || (started.elapsed() <= 0)) {
+        return 0.;
+    }
+
+    return (written / (started.elapsed() / 1000.0));
 }
 
 /*===========================================================================*/
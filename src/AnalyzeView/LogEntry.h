@@ -10,6 +10,7 @@
 #pragma once
 
 #include <QtCore/QBitArray>
+#include <QtCore/QByteArray>
 #include <QtCore/QDateTime>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QLoggingCategory>
@@ -23,36 +24,67 @@ class QGCLogEntry;
 
 Q_DECLARE_LOGGING_CATEGORY(LogEntryLog)
 
+/// Download state of a single log.
+///
+/// Received data is tracked per MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bin over the whole file, so packets are accepted
+/// in any order. Requests stream forward through a window of kWindowChunks chunks which starts at the first missing
+/// bin, gaps are filled once the window can no longer slide forward.
 struct LogDownloadData
 {
     explicit LogDownloadData(QGCLogEntry * const entry);
     ~LogDownloadData();
 
-    void advanceChunk();
+    /// The number of MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bins in the file
+    uint32_t numBins() const;
 
-    /// The number of MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN bins in the current chunk
-    uint32_t chunkBins() const;
+    /// Marks the bin as received
+    ///     @return false: Bin was already received
+    bool setReceived(uint32_t bin);
 
-    /// The number of kChunkSize chunks in the file
-    uint32_t numChunks() const;
+    bool received(uint32_t bin) const { return bin_table.testBit(bin); }
+    bool complete() const { return (first_missing >= numBins()); }
 
-    /// True if all bins in the chunk have been set to val
-    bool chunkEquals(const bool val) const;
+    /// One past the last bin which may be requested before the gap at first_missing is filled
+    uint32_t windowEnd() const;
+
+    /// Picks the bins to request next: streams forward from the highest bin received while the window has room,
+    /// otherwise fills the first gap.
+    ///     @param[out] startBin First bin to request
+    ///     @param[out] endBin One past the last bin to request
+    ///     @return true: Range is a gap below the highest bin received
+    bool nextRequest(uint32_t &startBin, uint32_t &endBin) const;
+
+    /// True if the forward stream is close enough to the end of its request that it should be extended
+    ///     @param bin Bin which was just received
+    bool shouldSlide(uint32_t bin) const;
+
+    /// Average rate since the download started, in bytes per second
+    qreal throughput() const;
 
     uint ID = 0;
     QGCLogEntry *const entry = nullptr;
 
-    QBitArray chunk_table;
-    uint32_t current_chunk = 0;
-    QFile file;
+    QBitArray bin_table;
+    uint32_t first_missing = 0;     ///< Lowest bin not received yet
+    uint32_t stream_end = 0;        ///< One past the highest bin received
+    uint32_t request_start = 0;     ///< Bins of the outstanding request
+    uint32_t request_end = 0;
+    bool filling_gap = false;       ///< Outstanding request is a gap fill rather than the forward stream
+    QByteArray pending;             ///< Contiguous received data not yet handed to the writer
+    uint32_t pending_offset = 0;    ///< File offset of pending
     QString filename;
+    QString filePath;
     uint written = 0;
     size_t rate_bytes = 0;
     qreal rate_avg = 0.;
     QElapsedTimer elapsed;
+    QElapsedTimer started;
 
     static constexpr uint32_t kTableBins = 512;
     static constexpr uint32_t kChunkSize = kTableBins * MAVLINK_MSG_LOG_DATA_FIELD_DATA_LEN;
+    static constexpr uint32_t kWindowChunks = 8;
+    static constexpr uint32_t kWindowBins = kWindowChunks * kTableBins;
+    static constexpr uint32_t kSlideBins = kTableBins / 2;  ///< Stream is extended when it gets this close to the end of its request
 };
 
 /*===========================================================================*/
@@ -69,6 +101,7 @@ class QGCLogEntry : public QObject
     Q_PROPERTY(bool         received    READ received                       NOTIFY receivedChanged)
     Q_PROPERTY(bool         selected    READ selected   WRITE setSelected   NOTIFY selectedChanged)
     Q_PROPERTY(QString      status      READ status                         NOTIFY statusChanged)
+    Q_PROPERTY(qreal        throughput  READ throughput                     NOTIFY throughputChanged)
 
 public:
     explicit QGCLogEntry(uint logId, const QDateTime &dateTime = QDateTime(), uint logSize = 0, bool received = false, QObject *parent = nullptr);
@@ -81,6 +114,8 @@ class QGCLogEntry : public QObject
     bool received() const { return _received; }
     bool selected() const { return _selected; }
     QString status() const { return _status; }
+    /// Effective download rate of the last download, in bytes per second
+    qreal throughput() const { return _throughput; }
 
     void setId(uint id) { if (id != _logID) { _logID = id; emit idChanged(); } }
     void setSize(uint size) { if (size != _logSize) { _logSize = size; emit sizeChanged(); } }
@@ -88,6 +123,7 @@ class QGCLogEntry : public QObject
     void setReceived(bool rec) { if (rec != _received) { _received = rec; emit receivedChanged(); } }
     void setSelected(bool sel) { if (sel != _selected) { _selected = sel; emit selectedChanged(); } }
     void setStatus(const QString &stat) { if (stat != _status) { _status = stat; emit statusChanged(); } }
+    void setThroughput(qreal throughput) { if (throughput != _throughput) { _throughput = throughput; emit throughputChanged(); } }
 
 signals:
     void idChanged();
@@ -96,6 +132,7 @@ class QGCLogEntry : public QObject
     void receivedChanged();
     void selectedChanged();
     void statusChanged();
+    void throughputChanged();
 
 private:
     uint _logID = 0;
@@ -104,4 +141,5 @@ class QGCLogEntry : public QObject
     bool _received = false;
     bool _selected = false;
     QString _status = QStringLiteral("Pending");
+    qreal _throughput = 0.;
 };
@@ -0,0 +1,146 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkChartBuffer.h"
+
+#include <QtCore/QtNumeric>
+
+#include <cmath>
+
+MAVLinkChartBuffer::MAVLinkChartBuffer(qsizetype capacity)
+    : _x(static_cast<size_t>(qMax<qsizetype>(capacity, 1)))
+    , _y(_x.size())
+{
+
+}
+
+void MAVLinkChartBuffer::clear()
+{
+    _count = 0;
+    _appended = 0;
+    _minQueue.clear();
+    _maxQueue.clear();
+}
+
+void MAVLinkChartBuffer::append(qreal x, qreal y)
+{
+    const quint64 seq = _appended++;
+    const size_t slot = _slot(seq);
+    _x[slot] = x;
+    _y[slot] = y;
+    _count = qMin(_count + 1, capacity());
+
+    // The sample which was just overwritten can only be at the front of the queues
+    const quint64 oldest = _oldest();
+    if (!_minQueue.empty() && (_minQueue.front() < oldest)) {
+        _minQueue.pop_front();
+    }
+    if (!_maxQueue.empty() && (_maxQueue.front() < oldest)) {
+        _maxQueue.pop_front();
+    }
+
+    if (qIsNaN(y)) {
+        return;
+    }
+
+    while (!_minQueue.empty() && (_y[_slot(_minQueue.back())] >= y)) {
+        _minQueue.pop_back();
+    }
+    _minQueue.push_back(seq);
+
+    while (!_maxQueue.empty() && (_y[_slot(_maxQueue.back())] <= y)) {
+        _maxQueue.pop_back();
+    }
+    _maxQueue.push_back(seq);
+}
+
+qsizetype MAVLinkChartBuffer::lowerBound(qreal x) const
+{
+    qsizetype first = 0;
+    qsizetype len = _count;
+    while (len > 0) {
+        const qsizetype half = len / 2;
+        if (this->x(first + half) < x) {
+            first += half + 1;
+            len -= half + 1;
+        } else {
+            len = half;
+        }
+    }
+
+    return first;
+}
+
+void MAVLinkChartBuffer::decimate(qreal xMin, qreal xMax, qsizetype buckets, QList<QPointF> &points) const
+{
+    points.clear();
+    if (isEmpty() || (buckets <= 0) || (xMax <= xMin)) {
+        return;
+    }
+
+    const qsizetype start = lowerBound(xMin);
+    const qsizetype first = qMax<qsizetype>(start - 1, 0);
+    qsizetype last = lowerBound(xMax);
+    if ((last < _count) && (x(last) <= xMax)) {
+        last++;
+    }
+
+    const qsizetype windowCount = last - first;
+    if (windowCount <= (2 * buckets)) {
+        points.reserve(windowCount);
+        for (qsizetype i = first; i < last; i++) {
+            points.append(QPointF(x(i), y(i)));
+        }
+        return;
+    }
+
+    points.reserve((2 * buckets) + 1);
+    if (first < start) {
+        points.append(QPointF(x(first), y(first)));
+    }
+
+    const qreal bucketWidth = (xMax - xMin) / static_cast<qreal>(buckets);
+    qsizetype bucket = -1;
+    qsizetype minIndex = 0;
+    qsizetype maxIndex = 0;
+
+    const auto flush = [this, &points](qsizetype minI, qsizetype maxI) {
+        const qsizetype a = qMin(minI, maxI);
+        const qsizetype b = qMax(minI, maxI);
+        points.append(QPointF(x(a), y(a)));
+        if (b != a) {
+            points.append(QPointF(x(b), y(b)));
+        }
+    };
+
+    for (qsizetype i = start; i < last; i++) {
+        const qsizetype b = qBound<qsizetype>(0, static_cast<qsizetype>(std::floor((x(i) - xMin) / bucketWidth)), buckets - 1);
+        if (b != bucket) {
+            if (bucket >= 0) {
+                flush(minIndex, maxIndex);
+            }
+            bucket = b;
+            minIndex = i;
+            maxIndex = i;
+            continue;
+        }
+
+        const qreal v = y(i);
+        if (v < y(minIndex)) {
+            minIndex = i;
+        }
+        if (v > y(maxIndex)) {
+            maxIndex = i;
+        }
+    }
+
+    if (bucket >= 0) {
+        flush(minIndex, maxIndex);
+    }
+}
@@ -0,0 +1,65 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QPointF>
+
+#include <deque>
+#include <vector>
+
+/// Fixed capacity time series of a charted field.
+///
+/// Sample times and values are kept in separate columns of a ring, once full the oldest sample is overwritten.
+/// The minimum and maximum of the buffered values are tracked in monotonic queues, which costs O(1) amortized
+/// per sample instead of a rescan of the whole buffer. Sample times are expected to be non-decreasing.
+class MAVLinkChartBuffer
+{
+public:
+    explicit MAVLinkChartBuffer(qsizetype capacity = kDefaultCapacity);
+
+    void append(qreal x, qreal y);
+    void clear();
+
+    qsizetype capacity() const { return static_cast<qsizetype>(_x.size()); }
+    qsizetype count() const { return _count; }
+    bool isEmpty() const { return (_count == 0); }
+
+    /// Sample i counting from the oldest
+    qreal x(qsizetype i) const { return _x[_slot(_oldest() + static_cast<quint64>(i))]; }
+    qreal y(qsizetype i) const { return _y[_slot(_oldest() + static_cast<quint64>(i))]; }
+
+    /// @return false: No buffered value is a number, min and max are meaningless
+    bool hasRange() const { return !_minQueue.empty(); }
+    qreal min() const { return (hasRange() ? _y[_slot(_minQueue.front())] : 0.); }
+    qreal max() const { return (hasRange() ? _y[_slot(_maxQueue.front())] : 0.); }
+
+    /// @return Index of the first sample at or after x, count() if there is none
+    qsizetype lowerBound(qreal x) const;
+
+    /// Reduces the samples between xMin and xMax to the minimum and maximum of each of the buckets, in time order.
+    /// The sample before xMin is included so the line runs in from the edge. Windows which hold no more than
+    /// two points per bucket are copied as is.
+    ///     @param[out] points Replaced by at most 2 * buckets + 1 points
+    void decimate(qreal xMin, qreal xMax, qsizetype buckets, QList<QPointF> &points) const;
+
+    static constexpr qsizetype kDefaultCapacity = 60 * 250;  ///< One minute of data at 250Hz
+
+private:
+    size_t _slot(quint64 seq) const { return static_cast<size_t>(seq % _x.size()); }
+    quint64 _oldest() const { return (_appended - static_cast<quint64>(_count)); }
+
+    std::vector<qreal> _x;
+    std::vector<qreal> _y;
+    qsizetype _count = 0;
+    quint64 _appended = 0;              ///< Sequence number of the next sample
+    std::deque<quint64> _minQueue;      ///< Sequence numbers with increasing values, front is the minimum
+    std::deque<quint64> _maxQueue;      ///< Sequence numbers with decreasing values, front is the maximum
+};
@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkFieldDecoder.h"
+
+#include <QtCore/QtEndian>
+
+#include <memory>
+#include <unordered_map>
+
+namespace
+{
+
+template<typename T>
+double _decodeValue(const uint8_t *data)
+{
+    return static_cast<double>(qFromUnaligned<T>(data));
+}
+
+double _decodeNothing(const uint8_t *data)
+{
+    Q_UNUSED(data);
+    return 0.;
+}
+
+MAVLinkFieldDecoder::DecodeFn _decodeFn(mavlink_message_type_t type)
+{
+    switch (type) {
+    case MAVLINK_TYPE_UINT8_T:  return &_decodeValue<uint8_t>;
+    case MAVLINK_TYPE_INT8_T:   return &_decodeValue<int8_t>;
+    case MAVLINK_TYPE_UINT16_T: return &_decodeValue<uint16_t>;
+    case MAVLINK_TYPE_INT16_T:  return &_decodeValue<int16_t>;
+    case MAVLINK_TYPE_UINT32_T: return &_decodeValue<uint32_t>;
+    case MAVLINK_TYPE_INT32_T:  return &_decodeValue<int32_t>;
+    case MAVLINK_TYPE_FLOAT:    return &_decodeValue<float>;
+    case MAVLINK_TYPE_DOUBLE:   return &_decodeValue<double>;
+    case MAVLINK_TYPE_UINT64_T: return &_decodeValue<uint64_t>;
+    case MAVLINK_TYPE_INT64_T:  return &_decodeValue<int64_t>;
+    case MAVLINK_TYPE_CHAR:
+    default:
+        return &_decodeNothing;
+    }
+}
+
+} // namespace
+
+MAVLinkFieldDecoder::MAVLinkFieldDecoder(const mavlink_message_info_t *msgInfo)
+{
+    if (!msgInfo) {
+        return;
+    }
+
+    _fields.reserve(msgInfo->num_fields);
+    for (unsigned int i = 0; i < msgInfo->num_fields; ++i) {
+        const mavlink_field_info_t &fieldInfo = msgInfo->fields[i];
+        Field &field = _fields.emplace_back();
+        field.decode = _decodeFn(fieldInfo.type);
+        field.offset = static_cast<uint16_t>(fieldInfo.wire_offset);
+        field.numeric = (fieldInfo.type != MAVLINK_TYPE_CHAR);
+    }
+}
+
+const MAVLinkFieldDecoder *MAVLinkFieldDecoder::forMessage(uint32_t msgid)
+{
+    static std::unordered_map<uint32_t, std::unique_ptr<MAVLinkFieldDecoder>> decoders;
+
+    const auto it = decoders.find(msgid);
+    if (it != decoders.end()) {
+        return it->second.get();
+    }
+
+    const mavlink_message_info_t *const msgInfo = mavlink_get_message_info_by_id(msgid);
+    std::unique_ptr<MAVLinkFieldDecoder> decoder = msgInfo ? std::make_unique<MAVLinkFieldDecoder>(msgInfo) : nullptr;
+    const MAVLinkFieldDecoder *const result = decoder.get();
+    (void) decoders.emplace(msgid, std::move(decoder));
+
+    return result;
+}
+
+double MAVLinkFieldDecoder::decode(const mavlink_message_t &message, qsizetype index) const
+{
+    const uint8_t *const payload = reinterpret_cast<const uint8_t*>(&message.payload64[0]);
+    const Field &f = field(index);
+    return f.decode(payload + f.offset);
+}
+
+void MAVLinkFieldDecoder::decode(const mavlink_message_t &message, double *values) const
+{
+    const uint8_t *const payload = reinterpret_cast<const uint8_t*>(&message.payload64[0]);
+    for (const Field &f : _fields) {
+        *values++ = f.decode(payload + f.offset);
+    }
+}
@@ -0,0 +1,51 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QtTypes>
+
+#include <vector>
+
+#include "MAVLinkLib.h"
+
+/// Decodes the fields of one MAVLink message type into doubles.
+///
+/// The field types are looked up in the message info once, when the decoder is built, and turned into a table of
+/// typed accessors. Decoding a message is then a straight pass over the table without any type switch. Arrays
+/// decode their first element, char fields decode as 0.
+class MAVLinkFieldDecoder
+{
+public:
+    using DecodeFn = double (*)(const uint8_t *data);
+
+    struct Field {
+        DecodeFn decode = nullptr;
+        uint16_t offset = 0;    ///< Wire offset in the payload
+        bool numeric = false;   ///< false: char field which can't be charted
+    };
+
+    explicit MAVLinkFieldDecoder(const mavlink_message_info_t *msgInfo);
+
+    /// Shared decoder of the message type, built on first use. Not thread safe.
+    ///     @return nullptr: Unknown message id
+    static const MAVLinkFieldDecoder *forMessage(uint32_t msgid);
+
+    qsizetype count() const { return static_cast<qsizetype>(_fields.size()); }
+    const Field &field(qsizetype index) const { return _fields[static_cast<size_t>(index)]; }
+
+    double decode(const mavlink_message_t &message, qsizetype index) const;
+
+    /// Decodes every field of message
+    ///     @param values Receives count() values
+    void decode(const mavlink_message_t &message, double *values) const;
+
+private:
+    std::vector<Field> _fields;
+};
@@ -43,6 +43,7 @@ MAVLinkInspectorController::Range_st::Range_st(const QString &label_, qreal rang
 MAVLinkInspectorController::MAVLinkInspectorController(QObject *parent)
     : QObject(parent)
     , _updateFrequencyTimer(new QTimer(this))
+    , _snapshotTimer(new QTimer(this))
     , _systems(new QmlObjectListModel(this))
     , _charts(new QmlObjectListModel(this))
 {
@@ -61,6 +62,11 @@ MAVLinkInspectorController::MAVLinkInspectorController(QObject *parent)
     _updateFrequencyTimer->setSingleShot(false);
     _updateFrequencyTimer->start();
 
+    (void) connect(_snapshotTimer, &QTimer::timeout, this, &MAVLinkInspectorController::_publishSnapshots);
+    _snapshotTimer->setInterval(kSnapshotIntervalMs);
+    _snapshotTimer->setSingleShot(false);
+    _snapshotTimer->start();
+
     _timeScaleSt.append(new TimeScale_st(tr("5 Sec"),   5 * 1000));
     _timeScaleSt.append(new TimeScale_st(tr("10 Sec"), 10 * 1000));
     _timeScaleSt.append(new TimeScale_st(tr("30 Sec"), 30 * 1000));
@@ -157,12 +163,29 @@ void MAVLinkInspectorController::_refreshFrequency()
     }
 }
 
+void MAVLinkInspectorController::_publishSnapshots()
+{
+    for (int i = 0; i < _systems->count(); i++) {
+        QGCMAVLinkSystem *const system = qobject_cast<QGCMAVLinkSystem*>(_systems->get(i));
+        if (!system) {
+            continue;
+        }
+
+        for (int j = 0; j < system->messages()->count(); j++) {
+            QGCMAVLinkMessage *const msg = qobject_cast<QGCMAVLinkMessage*>(system->messages()->get(j));
+            if (msg) {
+                msg->publishSnapshot();
+            }
+        }
+    }
+}
+
 void MAVLinkInspectorController::_vehicleAdded(Vehicle *vehicle)
 {
     QGCMAVLinkSystem *sys = _findVehicle(static_cast<uint8_t>(vehicle->id()));
 
     if (sys) {
-        sys->messages()->clearAndDeleteContents();
+        sys->clearMessages();
     } else {
         sys = new QGCMAVLinkSystem(static_cast<uint8_t>(vehicle->id()), this);
         _systems->append(sys);
@@ -87,6 +87,7 @@ class MAVLinkInspectorController : public QObject
 private slots:
     void _receiveMessage(LinkInterface *link, const mavlink_message_t &message);
     void _refreshFrequency();
+    void _publishSnapshots();
     void _setActiveVehicle(Vehicle *vehicle);
     void _vehicleAdded(Vehicle *vehicle);
     void _vehicleRemoved(const Vehicle *vehicle);
@@ -103,6 +104,9 @@ private slots:
     QList<Range_st*> _rangeSt;
     QGCMAVLinkSystem *_activeSystem = nullptr;
     QTimer *_updateFrequencyTimer = nullptr;
+    QTimer *_snapshotTimer = nullptr;
     QmlObjectListModel *_systems = nullptr;     ///< List of QGCMAVLinkSystem
     QmlObjectListModel *_charts = nullptr;      ///< List of MAVLinkCharts
+
+    static constexpr int kSnapshotIntervalMs = 1000 / 10;  ///< Message counts and values are shown at 10Hz
 };
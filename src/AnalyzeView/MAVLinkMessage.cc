@@ -8,10 +8,12 @@
  ****************************************************************************/
 
 #include "MAVLinkMessage.h"
+#include "MAVLinkFieldDecoder.h"
 #include "MAVLinkMessageField.h"
 #include "QGCLoggingCategory.h"
 #include "QmlObjectListModel.h"
 
+#include <QtCore/QtEndian>
 #include <QtCore/QTimeZone>
 
 QGC_LOGGING_CATEGORY(MAVLinkMessageLog, "qgc.analyzeview.mavlinkmessage")
@@ -31,6 +33,10 @@ QGCMAVLinkMessage::QGCMAVLinkMessage(const mavlink_message_t &message, QObject *
     }
 
     _name = QString(msgInfo->name);
+    _decoder = MAVLinkFieldDecoder::forMessage(message.msgid);
+    if (_decoder) {
+        _values.resize(static_cast<size_t>(_decoder->count()));
+    }
     qCDebug(MAVLinkMessageLog) << "New Message:" << _name;
 
     for (unsigned int i = 0; i < msgInfo->num_fields; ++i) {
@@ -49,7 +55,10 @@ QGCMAVLinkMessage::QGCMAVLinkMessage(const mavlink_message_t &message, QObject *
             case MAVLINK_TYPE_INT64_T:  type = QString("int64_t");  break;
         }
 
-        QGCMAVLinkMessageField *const field = new QGCMAVLinkMessageField(msgInfo->fields[i].name, type, this);
+        QGCMAVLinkMessageField *const field = new QGCMAVLinkMessageField(msgInfo->fields[i].name, type, static_cast<int>(i), this);
+        if (msgInfo->fields[i].type == MAVLINK_TYPE_CHAR) {
+            field->setSelectable(false);
+        }
         _fields->append(field);
     }
 }
@@ -61,16 +70,16 @@ QGCMAVLinkMessage::~QGCMAVLinkMessage()
 
 void QGCMAVLinkMessage::updateFieldSelection()
 {
-    bool sel = false;
-
+    _chartedFields.clear();
     for (int i = 0; i < _fields->count(); ++i) {
-        const QGCMAVLinkMessageField *const field = qobject_cast<const QGCMAVLinkMessageField*>(_fields->get(i));
+        QGCMAVLinkMessageField *const field = qobject_cast<QGCMAVLinkMessageField*>(_fields->get(i));
         if (field && field->selected()) {
-            sel = true;
-            break;
+            _chartedFields.append(field);
         }
     }
 
+    const bool sel = !_chartedFields.isEmpty();
+
     if (sel != _fieldSelected) {
         _fieldSelected = sel;
         emit fieldSelectedChanged();
@@ -92,7 +101,7 @@ void QGCMAVLinkMessage::setSelected(bool sel)
 {
     if (sel != _selected) {
         _selected = sel;
-        _updateFields();
+        _invalidateFields();
         emit selectedChanged();
     }
 }
@@ -109,230 +118,103 @@ void QGCMAVLinkMessage::update(const mavlink_message_t &message)
 {
     _count++;
     _message = message;
-
-    if (_fieldSelected) {
-        // Don't update field info unless selected to reduce perf hit of message processing
-        _updateFields();
+    _countChanged = true;
+    _valuesChanged = true;
+
+    // Charts get every sample, everything else only follows at the snapshot rate
+    if (_fieldSelected && _decoder) {
+        _decoder->decode(_message, _values.data());
+        for (QGCMAVLinkMessageField *const field : _chartedFields) {
+            field->appendSample(_values[static_cast<size_t>(field->index())]);
+        }
     }
-    emit countChanged();
 }
 
-void QGCMAVLinkMessage::_updateFields()
+void QGCMAVLinkMessage::publishSnapshot()
 {
-    const mavlink_message_info_t *msgInfo = mavlink_get_message_info(&_message);
-    if (!msgInfo) {
-        qCWarning(MAVLinkMessageLog) << "QGCMAVLinkMessage::update NULL msgInfo msgid" << _message.msgid;
-        return;
+    if (_countChanged) {
+        _countChanged = false;
+        emit countChanged();
     }
 
-    if (_fields->count() != static_cast<int>(msgInfo->num_fields)) {
-        qCWarning(MAVLinkMessageLog) << "QGCMAVLinkMessage::update msgInfo field count mismatch msgid" << _message.msgid;
-        return;
+    if (_selected && _valuesChanged) {
+        _valuesChanged = false;
+        _invalidateFields();
     }
+}
 
-    uint8_t *const msg = reinterpret_cast<uint8_t*>(&_message.payload64[0]);
-    for (unsigned int i = 0; i < msgInfo->num_fields; ++i) {
-        QGCMAVLinkMessageField *const field = qobject_cast<QGCMAVLinkMessageField*>(_fields->get(static_cast<int>(i)));
-        if (!field) {
-            continue;
+void QGCMAVLinkMessage::_invalidateFields()
+{
+    for (int i = 0; i < _fields->count(); ++i) {
+        QGCMAVLinkMessageField *const field = qobject_cast<QGCMAVLinkMessageField*>(_fields->get(i));
+        if (field) {
+            field->invalidateValue();
         }
+    }
+}
 
-        const unsigned int offset = msgInfo->fields[i].wire_offset;
-        const unsigned int array_length = msgInfo->fields[i].array_length;
-        static const unsigned int array_buffer_length = (MAVLINK_MAX_PAYLOAD_LEN + MAVLINK_NUM_CHECKSUM_BYTES + 7);
+template<typename T>
+QString QGCMAVLinkMessage::_formatValues(const uint8_t *data, unsigned int count)
+{
+    QString string;
+    for (unsigned int j = 0; j < count; ++j) {
+        if (j > 0) {
+            string += QStringLiteral(", ");
+        }
+        string += QString::number(qFromUnaligned<T>(data + (j * sizeof(T))));
+    }
 
-        switch (msgInfo->fields[i].type) {
-        case MAVLINK_TYPE_CHAR:
-            field->setSelectable(false);
-            if (array_length > 0) {
-                char *const str = reinterpret_cast<char*>(msg + offset);
-                str[array_length - 1] = '\0';
-                const QString v(str);
-                field->updateValue(v, 0);
-            } else {
-                char b = *(reinterpret_cast<char*>(msg + offset));
-                const QString v(b);
-                field->updateValue(v, 0);
-            }
-            break;
-        case MAVLINK_TYPE_UINT8_T:
-            if (array_length > 0) {
-                const uint8_t *const nums = msg + offset;
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                const uint8_t u = *(msg + offset);
-                field->updateValue(QString::number(u), static_cast<qreal>(u));
-            }
-            break;
-        case MAVLINK_TYPE_INT8_T:
-            if (array_length > 0) {
-                const int8_t *const nums = reinterpret_cast<int8_t*>(msg + offset);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                const int8_t n = *(reinterpret_cast<int8_t*>(msg + offset));
-                field->updateValue(QString::number(n), static_cast<qreal>(n));
-            }
-            break;
-        case MAVLINK_TYPE_UINT16_T:
-            if (array_length > 0) {
-                uint16_t nums[array_buffer_length / sizeof(uint16_t)]{};
-                (void) memcpy(nums, msg + offset,  sizeof(uint16_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                uint16_t n = 0;
-                (void) memcpy(&n, msg + offset, sizeof(uint16_t));
-                field->updateValue(QString::number(n), static_cast<qreal>(n));
-            }
-            break;
-        case MAVLINK_TYPE_INT16_T:
-            if (array_length > 0) {
-                int16_t nums[array_buffer_length / sizeof(int16_t)]{};
-                (void) memcpy(nums, msg + offset, sizeof(int16_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                int16_t n;
-                memcpy(&n, msg + offset, sizeof(int16_t));
-                field->updateValue(QString::number(n), static_cast<qreal>(n));
-            }
-            break;
-        case MAVLINK_TYPE_UINT32_T:
-            if (array_length > 0) {
-                uint32_t nums[array_buffer_length / sizeof(uint32_t)]{};
-                (void) memcpy(nums, msg + offset, sizeof(uint32_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                uint32_t n;
-                (void) memcpy(&n, msg + offset, sizeof(uint32_t));
-                if (_message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME) {
-                    const QDateTime d = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(n), QTimeZone::utc());
-                    field->updateValue(d.toString("HH:mm:ss"), static_cast<qreal>(n));
-                } else {
-                    field->updateValue(QString::number(n), static_cast<qreal>(n));
-                }
-            }
-            break;
-        case MAVLINK_TYPE_INT32_T:
-            if (array_length > 0) {
-                int32_t nums[array_buffer_length / sizeof(int32_t)]{};
-                (void) memcpy(nums, msg + offset,  sizeof(int32_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                int32_t n;
-                (void) memcpy(&n, msg + offset, sizeof(int32_t));
-                field->updateValue(QString::number(n), static_cast<qreal>(n));
-            }
-            break;
-        case MAVLINK_TYPE_FLOAT:
-            if (array_length > 0) {
-                float nums[array_buffer_length / sizeof(float)]{};
-                (void) memcpy(nums, msg + offset,  sizeof(float) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                   string += tmp.arg(static_cast<double>(nums[j]));
-                }
-                string += QString::number(static_cast<double>(nums[array_length - 1]));
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                float fv;
-                (void) memcpy(&fv, msg + offset, sizeof(float));
-                field->updateValue(QString::number(static_cast<double>(fv)), static_cast<qreal>(fv));
-            }
-            break;
-        case MAVLINK_TYPE_DOUBLE:
-            if (array_length > 0) {
-                double nums[array_buffer_length / sizeof(double)]{};
-                (void) memcpy(nums, msg + offset, sizeof(double) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(static_cast<double>(nums[array_length - 1]));
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                double d;
-                (void) memcpy(&d, msg + offset, sizeof(double));
-                field->updateValue(QString::number(d), static_cast<qreal>(d));
-            }
-            break;
-        case MAVLINK_TYPE_UINT64_T:
-            if (array_length > 0) {
-                uint64_t nums[array_buffer_length / sizeof(uint64_t)]{};
-                (void) memcpy(nums, msg + offset, sizeof(uint64_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                uint64_t n;
-                (void) memcpy(&n, msg + offset, sizeof(uint64_t));
-                if(_message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME) {
-                    const QDateTime d = QDateTime::fromMSecsSinceEpoch(n / 1000, QTimeZone::utc());
-                    field->updateValue(d.toString("yyyy MM dd HH:mm:ss"), static_cast<qreal>(n));
-                } else {
-                    field->updateValue(QString::number(n), static_cast<qreal>(n));
-                }
-            }
-            break;
-        case MAVLINK_TYPE_INT64_T:
-            if (array_length > 0) {
-                int64_t nums[array_buffer_length / sizeof(int64_t)]{};
-                (void) memcpy(nums, msg + offset,  sizeof(int64_t) * array_length);
-                const QString tmp("%1, ");
-                QString string;
-                for (unsigned int j = 0; j < array_length - 1; ++j) {
-                    string += tmp.arg(nums[j]);
-                }
-                string += QString::number(nums[array_length - 1]);
-                field->updateValue(string, static_cast<qreal>(nums[0]));
-            } else {
-                int64_t n;
-                (void) memcpy(&n, msg + offset, sizeof(int64_t));
-                field->updateValue(QString::number(n), static_cast<qreal>(n));
-            }
-            break;
-        default:
-            break;
+    return string;
+}
+
+QString QGCMAVLinkMessage::formatField(int index) const
+{
+    const mavlink_message_info_t *const msgInfo = mavlink_get_message_info(&_message);
+    if (!msgInfo || (index < 0) || (index >= static_cast<int>(msgInfo->num_fields))) {
+        return QString();
+    }
+
+    const mavlink_field_info_t &fieldInfo = msgInfo->fields[index];
+    const uint8_t *const data = reinterpret_cast<const uint8_t*>(&_message.payload64[0]) + fieldInfo.wire_offset;
+    const unsigned int array_length = fieldInfo.array_length;
+    const unsigned int count = qMax(array_length, 1u);
+
+    switch (fieldInfo.type) {
+    case MAVLINK_TYPE_CHAR:
+        if (array_length > 0) {
+            const char *const str = reinterpret_cast<const char*>(data);
+            return QString::fromUtf8(str, static_cast<qsizetype>(qstrnlen(str, array_length)));
+        }
+        return QString(QLatin1Char(static_cast<char>(*data)));
+    case MAVLINK_TYPE_UINT8_T:
+        return _formatValues<uint8_t>(data, count);
+    case MAVLINK_TYPE_INT8_T:
+        return _formatValues<int8_t>(data, count);
+    case MAVLINK_TYPE_UINT16_T:
+        return _formatValues<uint16_t>(data, count);
+    case MAVLINK_TYPE_INT16_T:
+        return _formatValues<int16_t>(data, count);
+    case MAVLINK_TYPE_UINT32_T:
+        if ((array_length == 0) && (_message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME)) {
+            const QDateTime d = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(qFromUnaligned<uint32_t>(data)), QTimeZone::utc());
+            return d.toString("HH:mm:ss");
+        }
+        return _formatValues<uint32_t>(data, count);
+    case MAVLINK_TYPE_INT32_T:
+        return _formatValues<int32_t>(data, count);
+    case MAVLINK_TYPE_FLOAT:
+        return _formatValues<float>(data, count);
+    case MAVLINK_TYPE_DOUBLE:
+        return _formatValues<double>(data, count);
+    case MAVLINK_TYPE_UINT64_T:
+        if ((array_length == 0) && (_message.msgid == MAVLINK_MSG_ID_SYSTEM_TIME)) {
+            const QDateTime d = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(qFromUnaligned<uint64_t>(data) / 1000), QTimeZone::utc());
+            return d.toString("yyyy MM dd HH:mm:ss");
         }
+        return _formatValues<uint64_t>(data, count);
+    case MAVLINK_TYPE_INT64_T:
+        return _formatValues<int64_t>(data, count);
+    default:
+        return QString();
     }
 }
@@ -9,13 +9,18 @@
 
 #pragma once
 
+#include <QtCore/QList>
 #include <QtCore/QObject>
 #include <QtCore/QString>
 #include <QtCore/QLoggingCategory>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include <vector>
+
 #include "MAVLinkLib.h"
 
+class MAVLinkFieldDecoder;
+class QGCMAVLinkMessageField;
 class QmlObjectListModel;
 
 Q_DECLARE_LOGGING_CATEGORY(MAVLinkMessageLog)
@@ -52,8 +57,14 @@ class QGCMAVLinkMessage : public QObject
     bool fieldSelected() const { return _fieldSelected; }
     bool selected() const { return _selected; }
 
+    /// Text of the field in the last message received
+    QString formatField(int index) const;
+
     void updateFieldSelection();
     void update(const mavlink_message_t &message);
+
+    /// Lets the UI catch up with the messages received since the last snapshot
+    void publishSnapshot();
     void updateFreq();
     void setSelected(bool sel);
     void setTargetRateHz(int32_t rate);
@@ -66,9 +77,15 @@ class QGCMAVLinkMessage : public QObject
     void selectedChanged();
 
 private:
-    void _updateFields();
+    void _invalidateFields();
+
+    template<typename T>
+    static QString _formatValues(const uint8_t *data, unsigned int count);
 
     mavlink_message_t _message{};
+    const MAVLinkFieldDecoder *_decoder = nullptr;
+    std::vector<double> _values;                        ///< Decoded fields of the last message, only kept up to date while charted
+    QList<QGCMAVLinkMessageField*> _chartedFields;
     QmlObjectListModel *_fields = nullptr;
     QString _name;
     qreal _actualRateHz = 0.0;
@@ -77,4 +94,6 @@ class QGCMAVLinkMessage : public QObject
     uint64_t _lastCount = 0;
     bool _fieldSelected = false;
     bool _selected = false;
+    bool _countChanged = false;
+    bool _valuesChanged = false;
 };
@@ -18,11 +18,12 @@
 
 QGC_LOGGING_CATEGORY(MAVLinkMessageFieldLog, "qgc.analyzeview.mavlinkmessagefield")
 
-QGCMAVLinkMessageField::QGCMAVLinkMessageField(const QString &name, const QString &type, QGCMAVLinkMessage *parent)
+QGCMAVLinkMessageField::QGCMAVLinkMessageField(const QString &name, const QString &type, int index, QGCMAVLinkMessage *parent)
     : QObject(parent)
     , _type(type)
     , _name(name)
     , _msg(parent)
+    , _index(index)
 {
     // qCDebug(MAVLinkMessageFieldLog) << Q_FUNC_INFO << this;
 
@@ -42,9 +43,9 @@ void QGCMAVLinkMessageField::addSeries(MAVLinkChartController *chart, QAbstractS
 
     _chart = chart;
     _pSeries = series;
+    _values = std::make_unique<MAVLinkChartBuffer>();
     emit seriesChanged();
 
-    _dataIndex = 0;
     _msg->updateFieldSelection();
 }
 
@@ -54,9 +55,9 @@ void QGCMAVLinkMessageField::delSeries()
         return;
     }
 
-    _values.clear();
+    _values.reset();
     QLineSeries *const lineSeries = static_cast<QLineSeries*>(_pSeries);
-    lineSeries->replace(_values);
+    lineSeries->clear();
     _pSeries = nullptr;
     _chart = nullptr;
     emit seriesChanged();
@@ -85,45 +86,38 @@ int QGCMAVLinkMessageField::chartIndex() const
     return 0;
 }
 
-void QGCMAVLinkMessageField::updateValue(const QString &newValue, qreal v)
+QString QGCMAVLinkMessageField::value() const
 {
-    if (_value != newValue) {
-        _value = newValue;
+    if (_valueStale) {
+        _value = _msg->formatField(_index);
+        _valueStale = false;
+    }
+
+    return _value;
+}
+
+void QGCMAVLinkMessageField::invalidateValue()
+{
+    if (!_valueStale) {
+        _valueStale = true;
         emit valueChanged();
     }
+}
 
-    if (!_pSeries || !_chart) {
+void QGCMAVLinkMessageField::appendSample(qreal v)
+{
+    if (!_pSeries || !_chart || !_values) {
         return;
     }
 
-    const int count = _values.count();
-    if (count < (50 * 60)) { ///< Arbitrary limit of 1 minute of data at 50Hz for now
-        const QPointF p(qgcApp()->msecsSinceBoot(), v);
-        _values.append(p);
-    } else {
-        if (_dataIndex >= count) {
-            _dataIndex = 0;
-        }
-        _values[_dataIndex].setX(qgcApp()->msecsSinceBoot());
-        _values[_dataIndex].setY(v);
-        _dataIndex++;
-    }
+    _values->append(qgcApp()->msecsSinceBoot(), v);
 
-    if (_chart->rangeYIndex() != 0) {
+    if ((_chart->rangeYIndex() != 0) || !_values->hasRange()) {
         return;
     }
 
-    qreal vmin = std::numeric_limits<qreal>::max();
-    qreal vmax = std::numeric_limits<qreal>::min();
-    for (const QPointF &point : _values) {
-        const qreal v = point.y();
-        if (vmax < v) {
-            vmax = v;
-        }
-        if (vmin > v) {
-            vmin = v;
-        }
-    }
+    const qreal vmin = _values->min();
+    const qreal vmax = _values->max();
 
     bool changed = false;
     if (std::abs(_rangeMin - vmin) > 0.000001) {
@@ -143,23 +137,17 @@ void QGCMAVLinkMessageField::updateValue(const QString &newValue, qreal v)
 
 void QGCMAVLinkMessageField::updateSeries()
 {
-    const int count = _values.count();
-    if (count <= 1) {
+    if (!_pSeries || !_chart || !_values || (_values->count() <= 1)) {
         return;
     }
 
-    QList<QPointF> s;
-    s.reserve(count);
-    int idx = _dataIndex;
-    for (int i = 0; i < count; i++, idx++) {
-        if (idx >= count) {
-            idx = 0;
-        }
-
-        const QPointF p(_values[idx]);
-        s.append(p);
-    }
+    // Only the visible window is handed to the series, reduced to what the chart can actually show
+    QList<QPointF> points;
+    _values->decimate(static_cast<qreal>(_chart->rangeXMin().toMSecsSinceEpoch()),
+                      static_cast<qreal>(_chart->rangeXMax().toMSecsSinceEpoch()),
+                      kChartBuckets,
+                      points);
 
     QLineSeries *const lineSeries = static_cast<QLineSeries*>(_pSeries);
-    lineSeries->replace(s);
+    lineSeries->replace(points);
 }
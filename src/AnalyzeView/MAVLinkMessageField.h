@@ -11,10 +11,13 @@
 
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
-#include <QtCore/QPointF>
 #include <QtCore/QString>
 #include <QtQmlIntegration/QtQmlIntegration>
 
+#include <memory>
+
+#include "MAVLinkChartBuffer.h"
+
 Q_DECLARE_LOGGING_CATEGORY(MAVLinkMessageFieldLog)
 
 class QGCMAVLinkMessage;
@@ -35,28 +38,39 @@ class QGCMAVLinkMessageField : public QObject
     Q_PROPERTY(const QAbstractSeries    *series     READ series     NOTIFY seriesChanged)
 
 public:
-    QGCMAVLinkMessageField(const QString &name, const QString &type, QGCMAVLinkMessage *parent = nullptr);
+    /// @param index Index of the field in the MAVLink message info
+    QGCMAVLinkMessageField(const QString &name, const QString &type, int index, QGCMAVLinkMessage *parent = nullptr);
     ~QGCMAVLinkMessageField();
 
     QString name() const { return _name;  }
     QString label() const;
     QString type() const { return _type;  }
-    QString value() const { return _value; }
+    /// Formatted on first use after the value changed
+    QString value() const;
     bool selectable() const { return _selectable; }
     bool selected() const { return !!_pSeries; }
     const QAbstractSeries *series() const { return _pSeries; }
-    const QList<QPointF> *values() const { return &_values; }
+    /// Samples charted so far, nullptr while the field is not charted
+    const MAVLinkChartBuffer *values() const { return _values.get(); }
     qreal rangeMin() const { return _rangeMin; }
     qreal rangeMax() const { return _rangeMax; }
     int chartIndex() const;
 
     void setSelectable(bool sel);
-    void updateValue(const QString &newValue, qreal v);
+    int index() const { return _index; }
+
+    /// The message changed, value() is formatted again on its next read
+    void invalidateValue();
+
+    /// Adds a sample to the chart, ignored unless the field is charted
+    void appendSample(qreal v);
 
     void addSeries(MAVLinkChartController *chart, QAbstractSeries *series);
     void delSeries();
     void updateSeries();
 
+    static constexpr qsizetype kChartBuckets = 1000;    ///< Charted window is decimated to the min and max of this many buckets
+
 signals:
     void seriesChanged();
     void selectableChanged();
@@ -66,13 +80,14 @@ class QGCMAVLinkMessageField : public QObject
     QString _type;
     QString _name;
     QGCMAVLinkMessage *_msg = nullptr;
+    int _index = 0;
 
-    QString _value;
+    mutable QString _value;
+    mutable bool _valueStale = true;
     bool _selectable = true;
-    int _dataIndex = 0;
     qreal _rangeMin = 0;
     qreal _rangeMax = 0;
-    QList<QPointF> _values;
+    std::unique_ptr<MAVLinkChartBuffer> _values;
 
     QAbstractSeries *_pSeries = nullptr;
     MAVLinkChartController *_chart = nullptr;
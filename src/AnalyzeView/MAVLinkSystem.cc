@@ -28,16 +28,7 @@ QGCMAVLinkSystem::~QGCMAVLinkSystem()
 
 QGCMAVLinkMessage *QGCMAVLinkSystem::findMessage(uint32_t id, uint8_t compId)
 {
-    for (int i = 0; i < _messages->count(); i++) {
-        QGCMAVLinkMessage *const msg = qobject_cast<QGCMAVLinkMessage*>(_messages->get(i));
-        if(msg) {
-            if((msg->id() == id) && (msg->compId() == compId)) {
-                return msg;
-            }
-        }
-    }
-
-    return nullptr;
+    return _messageMap.value(_messageKey(id, compId), nullptr);
 }
 
 int QGCMAVLinkSystem::findMessage(const QGCMAVLinkMessage *message)
@@ -113,6 +104,7 @@ void QGCMAVLinkSystem::append(QGCMAVLinkMessage *message)
         message->setSelected(true);
     }
     _messages->append(message);
+    _messageMap.insert(_messageKey(message->id(), message->compId()), message);
 
     if (_messages->count() > 0) {
         _messages->beginReset();
@@ -130,6 +122,12 @@ void QGCMAVLinkSystem::append(QGCMAVLinkMessage *message)
     }
 }
 
+void QGCMAVLinkSystem::clearMessages()
+{
+    _messageMap.clear();
+    _messages->clearAndDeleteContents();
+}
+
 void QGCMAVLinkSystem::_checkCompID(const QGCMAVLinkMessage *message)
 {
     if (_compIDsStr.isEmpty()) {
@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include <QtCore/QHash>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
 #include <QtCore/QStringList>
@@ -43,6 +44,7 @@ class QGCMAVLinkSystem : public QObject
     QGCMAVLinkMessage *findMessage(uint32_t id, uint8_t compId);
     int findMessage(const QGCMAVLinkMessage *message);
     void append(QGCMAVLinkMessage *message);
+    void clearMessages();
     QGCMAVLinkMessage *selectedMsg();
 
 signals:
@@ -53,9 +55,12 @@ class QGCMAVLinkSystem : public QObject
     void _checkCompID(const QGCMAVLinkMessage *message);
     void _resetSelection();
 
+    static quint32 _messageKey(uint32_t id, uint8_t compId) { return ((static_cast<quint32>(compId) << 24) | (id & 0xFFFFFF)); }
+
 private:
     quint8 _id = 0;
     QmlObjectListModel *_messages = nullptr; ///< List of QGCMAVLinkMessage
+    QHash<quint32, QGCMAVLinkMessage*> _messageMap;     ///< Keyed by _messageKey, every message is looked up on arrival
     QList<int> _compIDs;
     QStringList _compIDsStr;
     int _selected = 0;
@@ -2047,10 +2047,10 @@ VehicleCameraControl::_handleDefinitionFile(const QString &url)
             _modelName.toStdString().c_str(),
             ver,
             ext.toStdString().c_str());
+        const QString toDir = SettingsManager::instance()->appSettings()->parameterSavePath();
+        _ftpDownloadFile = FTPManager::downloadFilePath(url, toDir, fileName);
         connect(_vehicle->ftpManager(), &FTPManager::downloadComplete, this, &VehicleCameraControl::_ftpDownloadComplete);
-        _vehicle->ftpManager()->download(_compID, url,
-            SettingsManager::instance()->appSettings()->parameterSavePath().toStdString().c_str(),
-            fileName);
+        _vehicle->ftpManager()->download(_compID, url, toDir, fileName);
         return;
     }
 
@@ -2129,6 +2129,10 @@ void VehicleCameraControl::_ftpDownloadComplete(const QString& fileName, const Q
 {
     qCDebug(CameraControlLog) << "FTP Download completed: " << fileName << ", " << errorMsg;
 
+    if (fileName != _ftpDownloadFile) {
+        return;
+    }
+
     disconnect(_vehicle->ftpManager(), &FTPManager::downloadComplete, this, &VehicleCameraControl::_ftpDownloadComplete);
 
     QString outputFileName = fileName;
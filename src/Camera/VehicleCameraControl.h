@@ -272,6 +272,7 @@ protected slots:
     QString                             _modelName;
     QString                             _vendor;
     QString                             _cacheFile;
+    QString                             _ftpDownloadFile;   ///< Other downloads can complete while ours is queued behind them
     CameraMode                          _cameraMode         = CAM_MODE_UNDEFINED;
     StorageStatus                       _storageStatus      = STORAGE_NOT_SUPPORTED;
     PhotoCaptureMode                    _photoMode          = PHOTO_CAPTURE_SINGLE;
@@ -0,0 +1,99 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "HeadlessLogReplay.h"
+#include "LinkManager.h"
+#include "LogReplayLink.h"
+#include "MAVLinkProtocol.h"
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(HeadlessLogReplayLog, "qgc.comms.headlesslogreplay")
+
+HeadlessLogReplay::HeadlessLogReplay(const QString &logFilename, QObject *parent)
+    : QObject(parent)
+    , _logFilename(logFilename)
+{
+    // qCDebug(HeadlessLogReplayLog) << Q_FUNC_INFO << this;
+}
+
+HeadlessLogReplay::~HeadlessLogReplay()
+{
+    // qCDebug(HeadlessLogReplayLog) << Q_FUNC_INFO << this;
+}
+
+double HeadlessLogReplay::messagesPerSecond() const
+{
+    return ((_replayMSecs > 0) ? ((static_cast<double>(_messageCount) * 1000.) / _replayMSecs) : 0.);
+}
+
+void HeadlessLogReplay::start()
+{
+    qCInfo(HeadlessLogReplayLog) << "Replaying" << _logFilename;
+
+    (void) connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::messageReceived, this, &HeadlessLogReplay::_messageReceived);
+
+    _timer.start();
+    _link = LinkManager::instance()->startLogReplay(_logFilename, true /* unpaced */);
+    if (!_link) {
+        qCWarning(HeadlessLogReplayLog) << "Unable to start replay of" << _logFilename;
+        _finish(false);
+        return;
+    }
+
+    (void) connect(_link, &LogReplayLink::logFileStats, this, &HeadlessLogReplay::_logFileStats);
+    (void) connect(_link, &LogReplayLink::playbackAtEnd, this, &HeadlessLogReplay::_playbackAtEnd);
+    (void) connect(_link, &LinkInterface::communicationError, this, &HeadlessLogReplay::_communicationError);
+}
+
+void HeadlessLogReplay::_messageReceived(LinkInterface *link, const mavlink_message_t &message)
+{
+    Q_UNUSED(message);
+
+    if (link == _link) {
+        _messageCount++;
+    }
+}
+
+void HeadlessLogReplay::_logFileStats(uint32_t logDurationSecs)
+{
+    _logDurationSecs = logDurationSecs;
+    _openMSecs = _timer.restart();
+}
+
+void HeadlessLogReplay::_playbackAtEnd()
+{
+    // Chunks are queued ahead of this signal, so every message has been handled by now
+    _replayMSecs = _timer.elapsed();
+
+    qCInfo(HeadlessLogReplayLog).noquote() << QStringLiteral("Log opened in %1 ms, %2 s of flight replayed in %3 ms").arg(_openMSecs).arg(_logDurationSecs).arg(_replayMSecs);
+    qCInfo(HeadlessLogReplayLog).noquote() << QStringLiteral("%1 messages, %2 msgs/sec").arg(_messageCount).arg(messagesPerSecond(), 0, 'f', 0);
+
+    _finish(true);
+}
+
+void HeadlessLogReplay::_communicationError(const QString &title, const QString &error)
+{
+    qCWarning(HeadlessLogReplayLog) << title << error;
+    _finish(false);
+}
+
+void HeadlessLogReplay::_finish(bool success)
+{
+    if (_finished) {
+        return;
+    }
+    _finished = true;
+
+    (void) disconnect(MAVLinkProtocol::instance(), &MAVLinkProtocol::messageReceived, this, &HeadlessLogReplay::_messageReceived);
+    if (_link) {
+        _link->disconnect();
+    }
+
+    emit finished(success);
+}
@@ -0,0 +1,64 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+#include "MAVLinkLib.h"
+
+class LinkInterface;
+class LogReplayLink;
+
+Q_DECLARE_LOGGING_CATEGORY(HeadlessLogReplayLog)
+
+/// Pushes a tlog through the vehicle stack as fast as it can take it and reports the throughput.
+/// Used by the --replay-log:<file> command line option, which runs without the QML UI.
+class HeadlessLogReplay : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HeadlessLogReplay(const QString &logFilename, QObject *parent = nullptr);
+    ~HeadlessLogReplay();
+
+    quint64 messageCount() const { return _messageCount; }
+
+    /// @return Time from the start of playback to the last message being handled
+    qint64 replayMSecs() const { return _replayMSecs; }
+
+    double messagesPerSecond() const;
+
+public slots:
+    void start();
+
+signals:
+    void finished(bool success);
+
+private slots:
+    void _messageReceived(LinkInterface *link, const mavlink_message_t &message);
+    void _logFileStats(uint32_t logDurationSecs);
+    void _playbackAtEnd();
+    void _communicationError(const QString &title, const QString &error);
+
+private:
+    void _finish(bool success);
+
+    const QString _logFilename;
+    LogReplayLink *_link = nullptr;
+    QElapsedTimer _timer;
+    qint64 _openMSecs = 0;
+    qint64 _replayMSecs = 0;
+    quint64 _messageCount = 0;
+    uint32_t _logDurationSecs = 0;
+    bool _finished = false;
+};
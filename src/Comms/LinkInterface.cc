@@ -55,6 +55,7 @@ bool LinkInterface::initMavlinkSigning()
         auto mavlinkSettings = SettingsManager::instance()->mavlinkSettings();
         const QByteArray signingKeyBytes = mavlinkSettings->mavlink2SigningKey()->rawValue().toByteArray();
         if (MAVLinkSigning::initSigning(static_cast<mavlink_channel_t>(_mavlinkChannel), signingKeyBytes, MAVLinkSigning::insecureConnectionAccceptUnsignedCallback)) {
+            _signingEnabled = !signingKeyBytes.isEmpty();
             if (signingKeyBytes.isEmpty()) {
                 qCDebug(LinkInterfaceLog) << "Signing disabled on channel" << _mavlinkChannel;
             } else {
@@ -111,6 +112,11 @@ void LinkInterface::writeBytesThreadSafe(const char *bytes, int length)
     (void) QMetaObject::invokeMethod(this, "_writeBytes", Qt::AutoConnection, data);
 }
 
+void LinkInterface::writeBytesThreadSafe(const QByteArray &bytes)
+{
+    (void) QMetaObject::invokeMethod(this, "_writeBytes", Qt::AutoConnection, bytes);
+}
+
 void LinkInterface::removeVehicleReference()
 {
     if (_vehicleReferenceCount != 0) {
@@ -131,6 +137,44 @@ void LinkInterface::_connectionRemoved()
     }
 }
 
+bool LinkInterface::_parseOnWorkerThreadEnabled()
+{
+    return SettingsManager::instance()->mavlinkSettings()->parseMavlinkOnLinkThreads()->rawValue().toBool();
+}
+
+MAVLinkParserWorker *LinkInterface::_createWorkerParser(QThread *workerThread)
+{
+    MAVLinkParserWorker *const parser = new MAVLinkParserWorker(this);
+    parser->moveToThread(workerThread);
+    _workerParser = parser;
+
+    (void) connect(workerThread, &QThread::finished, parser, &QObject::deleteLater);
+    (void) connect(parser, &MAVLinkParserWorker::messagesReceived, this, &LinkInterface::_onParserMessagesReceived, Qt::QueuedConnection);
+    (void) connect(parser, &MAVLinkParserWorker::bytesReceived, this, &LinkInterface::_onParserBytesReceived, Qt::QueuedConnection);
+    (void) connect(parser, &MAVLinkParserWorker::mavlinkMessageStatus, this, &LinkInterface::mavlinkMessageStatus, Qt::QueuedConnection);
+
+    qCDebug(LinkInterfaceLog) << "Decoding MAVLink on worker thread" << workerThread->objectName();
+
+    return parser;
+}
+
+void LinkInterface::resetWorkerParser()
+{
+    if (_workerParser) {
+        (void) QMetaObject::invokeMethod(_workerParser, &MAVLinkParserWorker::resetMetadata, Qt::QueuedConnection);
+    }
+}
+
+void LinkInterface::_onParserMessagesReceived(const QList<mavlink_message_t> &messages, const QByteArray &frames)
+{
+    emit messagesReceived(this, messages, frames);
+}
+
+void LinkInterface::_onParserBytesReceived(const QByteArray &data)
+{
+    emit bytesReceived(this, data);
+}
+
 void LinkInterface::setSigningSignatureFailure(bool failure)
 {
     if (_signingSignatureFailure != failure) {
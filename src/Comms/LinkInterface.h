@@ -9,9 +9,16 @@
 
 #pragma once
 
+#include <QtCore/QList>
 #include <QtCore/QLoggingCategory>
+#include <QtCore/QPointer>
+#include <QtCore/QThread>
+
+#include <atomic>
 
 #include "LinkConfiguration.h"
+#include "MAVLinkLib.h"
+#include "MAVLinkParserWorker.h"
 
 class LinkManager;
 
@@ -40,13 +47,21 @@ class LinkInterface : public QObject
     bool decodedFirstMavlinkPacket() const { return _decodedFirstMavlinkPacket; }
     void setDecodedFirstMavlinkPacket(bool decodedFirstMavlinkPacket) { _decodedFirstMavlinkPacket = decodedFirstMavlinkPacket; }
     void writeBytesThreadSafe(const char *bytes, int length);
+    void writeBytesThreadSafe(const QByteArray &bytes);
     void addVehicleReference() { ++_vehicleReferenceCount; }
     void removeVehicleReference();
     bool initMavlinkSigning();
+    /// Thread safe, used by the worker thread parser
+    bool signingEnabled() const { return _signingEnabled; }
+    /// Resets the worker thread parser if there is one
+    void resetWorkerParser();
     void setSigningSignatureFailure(bool failure);
 
 signals:
     void bytesReceived(LinkInterface *link, const QByteArray &data);
+    /// @param frames Wire bytes of the messages, only filled in while forwarding is active
+    void messagesReceived(LinkInterface *link, const QList<mavlink_message_t> &messages, const QByteArray &frames);
+    void mavlinkMessageStatus(int sysid, uint64_t totalSent, uint64_t totalReceived, uint64_t totalLoss, float lossPercent);
     void bytesSent(LinkInterface *link, const QByteArray &data);
     void connected();
     void disconnected();
@@ -64,21 +79,48 @@ class LinkInterface : public QObject
 
     void _connectionRemoved();
 
+    /// Links which read on their own worker thread call this from their constructor, after the worker has been moved to its thread.
+    /// If enabled in the settings the data coming from the worker is then decoded on that thread.
+    ///     @return true: Parser set up, the worker data must not be forwarded through bytesReceived as well
+    template<typename Worker>
+    bool _setupWorkerParser(Worker *worker, void (Worker::*dataReceived)(const QByteArray&));
+
     SharedLinkConfigurationPtr _config;
 
 private slots:
     /// Not thread safe if called directly, only writeBytesThreadSafe is thread safe
     virtual void _writeBytes(const QByteArray &bytes) = 0;
 
+    void _onParserMessagesReceived(const QList<mavlink_message_t> &messages, const QByteArray &frames);
+    void _onParserBytesReceived(const QByteArray &data);
+
 private:
     /// connect is private since all links should be created through LinkManager::createConnectedLink calls
     virtual bool _connect() = 0;
 
+    MAVLinkParserWorker *_createWorkerParser(QThread *workerThread);
+    static bool _parseOnWorkerThreadEnabled();
+
     uint8_t _mavlinkChannel = std::numeric_limits<uint8_t>::max();
     bool _decodedFirstMavlinkPacket = false;
     int _vehicleReferenceCount = 0;
     bool _signingSignatureFailure = false;
+    std::atomic_bool _signingEnabled = false;
+    QPointer<MAVLinkParserWorker> _workerParser;
 };
 
+template<typename Worker>
+bool LinkInterface::_setupWorkerParser(Worker *worker, void (Worker::*dataReceived)(const QByteArray&))
+{
+    if (!_parseOnWorkerThreadEnabled()) {
+        return false;
+    }
+
+    MAVLinkParserWorker *const parser = _createWorkerParser(worker->thread());
+    (void) connect(worker, dataReceived, parser, &MAVLinkParserWorker::receiveBytes, Qt::DirectConnection);
+
+    return true;
+}
+
 typedef std::shared_ptr<LinkInterface> SharedLinkInterfacePtr;
 typedef std::weak_ptr<LinkInterface> WeakLinkInterfacePtr;
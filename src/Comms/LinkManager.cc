@@ -173,6 +173,8 @@ bool LinkManager::createConnectedLink(SharedLinkConfigurationPtr &config)
 
     (void) connect(link.get(), &LinkInterface::communicationError, qgcApp(), &QGCApplication::showAppMessage);
     (void) connect(link.get(), &LinkInterface::bytesReceived, MAVLinkProtocol::instance(), &MAVLinkProtocol::receiveBytes);
+    (void) connect(link.get(), &LinkInterface::messagesReceived, MAVLinkProtocol::instance(), &MAVLinkProtocol::receiveMessages);
+    (void) connect(link.get(), &LinkInterface::mavlinkMessageStatus, MAVLinkProtocol::instance(), &MAVLinkProtocol::mavlinkMessageStatus);
     (void) connect(link.get(), &LinkInterface::bytesSent, MAVLinkProtocol::instance(), &MAVLinkProtocol::logSentBytes);
     (void) connect(link.get(), &LinkInterface::disconnected, this, &LinkManager::_linkDisconnected);
 
@@ -231,6 +233,8 @@ void LinkManager::_linkDisconnected()
 
     (void) disconnect(link, &LinkInterface::communicationError, qgcApp(), &QGCApplication::showAppMessage);
     (void) disconnect(link, &LinkInterface::bytesReceived, MAVLinkProtocol::instance(), &MAVLinkProtocol::receiveBytes);
+    (void) disconnect(link, &LinkInterface::messagesReceived, MAVLinkProtocol::instance(), &MAVLinkProtocol::receiveMessages);
+    (void) disconnect(link, &LinkInterface::mavlinkMessageStatus, MAVLinkProtocol::instance(), &MAVLinkProtocol::mavlinkMessageStatus);
     (void) disconnect(link, &LinkInterface::bytesSent, MAVLinkProtocol::instance(), &MAVLinkProtocol::logSentBytes);
     (void) disconnect(link, &LinkInterface::disconnected, this, &LinkManager::_linkDisconnected);
 
@@ -239,7 +243,11 @@ void LinkManager::_linkDisconnected()
     for (auto it = _rgLinks.begin(); it != _rgLinks.end(); ++it) {
         if (it->get() == link) {
             qCDebug(LinkManagerLog) << Q_FUNC_INFO << it->get()->linkConfiguration()->name() << it->use_count();
+            const bool forwarding = it->get()->linkConfiguration()->isForwarding();
             (void) _rgLinks.erase(it);
+            if (forwarding) {
+                emit forwardingLinksChanged();
+            }
             return;
         }
     }
@@ -723,10 +731,11 @@ void LinkManager::freeMavlinkChannel(uint8_t channel)
     _mavlinkChannelsUsedBitMask &= ~(1 << channel);
 }
 
-LogReplayLink *LinkManager::startLogReplay(const QString &logFile)
+LogReplayLink *LinkManager::startLogReplay(const QString &logFile, bool unpaced)
 {
     LogReplayConfiguration* const linkConfig = new LogReplayConfiguration(tr("Log Replay"));
     linkConfig->setLogFilename(logFile);
+    linkConfig->setUnpaced(unpaced);
     linkConfig->setName(linkConfig->logFilenameShort());
 
     SharedLinkConfigurationPtr sharedConfig = addConfiguration(linkConfig);
@@ -747,6 +756,7 @@ void LinkManager::_createDynamicForwardLink(const char *linkName, const QString
 
     SharedLinkConfigurationPtr config = addConfiguration(udpConfig);
     createConnectedLink(config);
+    emit forwardingLinksChanged();
 
     qCDebug(LinkManagerLog) << "New dynamic MAVLink forwarding port added:" << linkName << " hostname:" << hostName;
 }
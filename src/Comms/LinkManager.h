@@ -67,7 +67,8 @@ class LinkManager : public QObject
     Q_INVOKABLE void createMavlinkForwardingSupportLink();
     /// Called to signal app shutdown. Disconnects all links while turning off auto-connect.
     Q_INVOKABLE void shutdown();
-    Q_INVOKABLE LogReplayLink *startLogReplay(const QString &logFile);
+    /// @param unpaced true: Replay as fast as possible instead of in log time
+    Q_INVOKABLE LogReplayLink *startLogReplay(const QString &logFile, bool unpaced = false);
 
     QList<SharedLinkInterfacePtr> links() { return _rgLinks; }
     QStringList linkTypeStrings() const;
@@ -120,6 +121,8 @@ class LinkManager : public QObject
 
 signals:
     void mavlinkSupportForwardingEnabledChanged();
+    /// A forwarding link was created or went away
+    void forwardingLinksChanged();
     void isBluetoothAvailableChanged();
 
 private slots:
@@ -14,7 +14,6 @@
 #include "QGCLoggingCategory.h"
 
 #include <QtCore/QFileInfo>
-#include <QtCore/QtEndian>
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
@@ -31,6 +30,7 @@ LogReplayConfiguration::LogReplayConfiguration(const QString &name, QObject *par
 LogReplayConfiguration::LogReplayConfiguration(const LogReplayConfiguration *copy, QObject *parent)
     : LinkConfiguration(copy, parent)
     , _logFilename(copy->logFilename())
+    , _unpaced(copy->isUnpaced())
 {
     // qCDebug(LogReplayLinkLog) << Q_FUNC_INFO << this;
 }
@@ -49,6 +49,7 @@ void LogReplayConfiguration::copyFrom(const LinkConfiguration *source)
     Q_ASSERT(logReplaySource);
 
     setLogFilename(logReplaySource->logFilename());
+    setUnpaced(logReplaySource->isUnpaced());
 }
 
 void LogReplayConfiguration::loadSettings(QSettings &settings, const QString &root)
@@ -140,6 +141,7 @@ void LogReplayWorker::disconnectFromLog()
     emit disconnected();
 
     _readTickTimer->stop();
+    _closeLogFile();
 }
 
 bool LogReplayWorker::isPlaying() const
@@ -152,7 +154,7 @@ void LogReplayWorker::play()
     LinkManager::instance()->setConnectionsSuspended(tr("Connect not allowed during Flight Data replay."));
     MAVLinkProtocol::instance()->suspendLogForReplay(true);
 
-    if (_logFile.atEnd()) {
+    if (_atEnd()) {
         _resetPlaybackToBeginning();
     }
 
@@ -190,42 +192,24 @@ void LogReplayWorker::movePlayhead(qreal percentComplete)
         }
     }
 
-    percentComplete = qBound(0., percentComplete, 100.);
-    const qreal percentCompleteMult = percentComplete / 100.0;
-    const qint64 newFilePos = static_cast<qint64>(percentCompleteMult * static_cast<qreal>(_logFile.size()));
-    if (!_logFile.seek(newFilePos)) {
-        emit errorOccurred(tr("Unable to seek to new position"));
+    if (_index.isEmpty()) {
         return;
     }
 
-    mavlink_message_t dummy{};
-    _logCurrentTimeUSecs = _seekToNextMavlinkMessage(dummy);
-
-    qreal newRelativeTimeUSecs = static_cast<qreal>(_logCurrentTimeUSecs - _logStartTimeUSecs);
-    const qreal baudRate = _logFile.size() / static_cast<qreal>(_logDurationUSecs) / 1e6;
-    const qreal desiredTimeUSecs = percentCompleteMult * _logDurationUSecs;
-    const qint64 offset = (newRelativeTimeUSecs - desiredTimeUSecs) * baudRate;
-    if (!_logFile.seek(_logFile.pos() + offset)) {
-        emit errorOccurred(tr("Unable to seek to new position"));
-        return;
-    }
+    percentComplete = qBound(0., percentComplete, 100.);
+    const quint64 desiredTimeUSecs = _logStartTimeUSecs + static_cast<quint64>((percentComplete / 100.0) * static_cast<qreal>(_logDurationUSecs));
 
-    _logCurrentTimeUSecs = _seekToNextMavlinkMessage(dummy);
+    _nextEntry = qMin(_index.seek(desiredTimeUSecs), _index.count() - 1);
+    _logCurrentTimeUSecs = _index.at(_nextEntry).timestampUSecs;
     _signalCurrentLogTimeSecs();
 
-    newRelativeTimeUSecs = static_cast<qreal>(_logCurrentTimeUSecs - _logStartTimeUSecs);
-    percentComplete = ((newRelativeTimeUSecs / _logDurationUSecs) * 100);
-    emit playbackPercentCompleteChanged(percentComplete);
+    const qreal newRelativeTimeUSecs = static_cast<qreal>(_logCurrentTimeUSecs - _logStartTimeUSecs);
+    emit playbackPercentCompleteChanged((newRelativeTimeUSecs / _logDurationUSecs) * 100);
 }
 
 void LogReplayWorker::_resetPlaybackToBeginning()
 {
-    if (_logFile.isOpen()) {
-        if (!_logFile.reset()) {
-            qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile.error() << _logFile.errorString();
-        }
-    }
-
+    _nextEntry = 0;
     _playbackStartTimeMSecs = 0;
     _playbackStartLogTimeUSecs = 0;
     _logCurrentTimeUSecs = _logStartTimeUSecs;
@@ -233,21 +217,28 @@ void LogReplayWorker::_resetPlaybackToBeginning()
 
 void LogReplayWorker::_readNextLogEntry()
 {
+    if (_logReplayConfig->isUnpaced()) {
+        _readNextChunkUnpaced();
+        return;
+    }
+
+    // Everything which is due goes out in a single chunk
+    QByteArray bytes;
     int timeToNextExecutionMSecs = 0;
     while (timeToNextExecutionMSecs < 3) {
-        QByteArray bytes;
-        bytes.reserve(_logFile.bytesAvailable());
-        const qint64 nextTimeUSecs = _readNextMavlinkMessage(bytes);
-        emit dataReceived(bytes);
-        emit playbackPercentCompleteChanged((static_cast<float>(_logCurrentTimeUSecs - _logStartTimeUSecs) / static_cast<float>(_logDurationUSecs)) * 100);
-
-        if (_logFile.atEnd()) {
-            pause();
-            emit playbackAtEnd();
-            return;
+        if (_atEnd()) {
+            break;
+        }
+
+        const QByteArrayView frame = TlogIndex::frame(_logData, _index.at(_nextEntry));
+        (void) bytes.append(frame.data(), frame.size());
+        _nextEntry++;
+
+        if (_atEnd()) {
+            break;
         }
 
-        _logCurrentTimeUSecs = nextTimeUSecs;
+        _logCurrentTimeUSecs = _index.at(_nextEntry).timestampUSecs;
 
         const quint64 currentTimeMSecs = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch());
         const quint64 desiredPlayheadMovementTimeMSecs = ((_logCurrentTimeUSecs - _playbackStartLogTimeUSecs) / 1000) / _playbackSpeed;
@@ -255,11 +246,69 @@ void LogReplayWorker::_readNextLogEntry()
         timeToNextExecutionMSecs = desiredCurrentTimeMSecs - currentTimeMSecs;
     }
 
+    if (!bytes.isEmpty()) {
+        _emitData(bytes);
+    }
+    emit playbackPercentCompleteChanged((static_cast<float>(_logCurrentTimeUSecs - _logStartTimeUSecs) / static_cast<float>(_logDurationUSecs)) * 100);
+
+    if (_atEnd()) {
+        pause();
+        emit playbackAtEnd();
+        return;
+    }
+
     _signalCurrentLogTimeSecs();
 
     _readTickTimer->start(timeToNextExecutionMSecs);
 }
 
+void LogReplayWorker::_readNextChunkUnpaced()
+{
+    // Getting further ahead of the vehicle stack would only grow the queue between the threads
+    if (_pendingChunks.load(std::memory_order_relaxed) >= kMaxPendingChunks) {
+        _readTickTimer->start(1);
+        return;
+    }
+
+    if (_atEnd()) {
+        pause();
+        emit playbackAtEnd();
+        return;
+    }
+
+    const qsizetype endEntry = qMin(_nextEntry + kUnpacedChunkMessages, _index.count());
+
+    // The records of the chunk follow each other in the file, so their extent bounds the size of the frames
+    const quint64 startOffset = _index.at(_nextEntry).offset();
+    const quint64 endOffset = (endEntry < _index.count()) ? _index.at(endEntry).offset() : static_cast<quint64>(_logData.size());
+    QByteArray bytes;
+    bytes.reserve(static_cast<qsizetype>(endOffset - startOffset));
+
+    for (; _nextEntry < endEntry; _nextEntry++) {
+        const QByteArrayView frame = TlogIndex::frame(_logData, _index.at(_nextEntry));
+        (void) bytes.append(frame.data(), frame.size());
+    }
+    _logCurrentTimeUSecs = _index.at(endEntry - 1).timestampUSecs;
+
+    _emitData(bytes);
+    emit playbackPercentCompleteChanged((static_cast<float>(_logCurrentTimeUSecs - _logStartTimeUSecs) / static_cast<float>(_logDurationUSecs)) * 100);
+    _signalCurrentLogTimeSecs();
+
+    if (_atEnd()) {
+        pause();
+        emit playbackAtEnd();
+        return;
+    }
+
+    _readTickTimer->start(0);
+}
+
+void LogReplayWorker::_emitData(const QByteArray &bytes)
+{
+    (void) _pendingChunks.fetch_add(1, std::memory_order_relaxed);
+    emit dataReceived(bytes);
+}
+
 void LogReplayWorker::_signalCurrentLogTimeSecs()
 {
     emit currentLogTimeSecs((_logCurrentTimeUSecs - _logStartTimeUSecs) / 1000000);
@@ -268,7 +317,7 @@ void LogReplayWorker::_signalCurrentLogTimeSecs()
 bool LogReplayWorker::_loadLogFile()
 {
     if (_logFile.isOpen()) {
-        _logFile.close();
+        _closeLogFile();
         emit errorOccurred(tr("Attempt to load new log while log being played"));
         return false;
     }
@@ -280,14 +329,21 @@ bool LogReplayWorker::_loadLogFile()
         return false;
     }
 
-    QFileInfo logFileInfo;
-    logFileInfo.setFile(logFilename);
-    _logFileSize = logFileInfo.size();
+    const qint64 logFileSize = _logFile.size();
+    const uchar *const mapped = (logFileSize > 0) ? _logFile.map(0, logFileSize) : nullptr;
+    if (!mapped) {
+        _closeLogFile();
+        emit errorOccurred(tr("The log file '%1' is corrupt or empty.").arg(logFilename));
+        return false;
+    }
+    _logData = QByteArrayView(mapped, logFileSize);
+
+    _index.open(logFilename, _logData);
 
-    const quint64 startTimeUSecs = _parseTimestamp(_logFile.read(kTimestamp));
-    const quint64 endTimeUSecs = _findLastTimestamp();
+    const quint64 startTimeUSecs = _index.startTimeUSecs();
+    const quint64 endTimeUSecs = _index.endTimeUSecs();
     if (endTimeUSecs <= startTimeUSecs) {
-        _logFile.close();
+        _closeLogFile();
         emit errorOccurred(tr("The log file '%1' is corrupt or empty.").arg(logFilename));
         return false;
     }
@@ -295,11 +351,7 @@ bool LogReplayWorker::_loadLogFile()
     _logEndTimeUSecs = endTimeUSecs;
     _logStartTimeUSecs = startTimeUSecs;
     _logDurationUSecs = endTimeUSecs - startTimeUSecs;
-    _logCurrentTimeUSecs = startTimeUSecs;
-
-    if (!_logFile.reset()) {
-        qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile.error() << _logFile.errorString();
-    }
+    _resetPlaybackToBeginning();
 
     const quint64 logDurationSecondsTotal = _logDurationUSecs / 1000000;
     emit logFileStats(logDurationSecondsTotal);
@@ -307,92 +359,16 @@ bool LogReplayWorker::_loadLogFile()
     return true;
 }
 
-quint64 LogReplayWorker::_parseTimestamp(const QByteArray &bytes)
-{
-    const quint64 currentTimestamp = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000;
-    quint64 timestamp = qFromBigEndian(*reinterpret_cast<const quint64*>(bytes.constData()));
-    if (timestamp > currentTimestamp) {
-        timestamp = qbswap(timestamp);
-    }
-
-    return timestamp;
-}
-
-quint64 LogReplayWorker::_readNextMavlinkMessage(QByteArray &bytes)
+void LogReplayWorker::_closeLogFile()
 {
-    bytes.clear();
-
-    char nextByte;
-    while (_logFile.getChar(&nextByte)) {
-        mavlink_message_t message{};
-        mavlink_status_t status{};
-        const bool messageFound = mavlink_parse_char(_mavlinkChannel, nextByte, &message, &status);
-
-        if (status.parse_state == MAVLINK_PARSE_STATE_GOT_STX) {
-            bytes.clear();
-        }
-        (void) bytes.append(nextByte);
-
-        if (messageFound) {
-            const QByteArray rawTime = _logFile.read(kTimestamp);
-            return _parseTimestamp(rawTime);
-        }
-    }
-
-    return 0;
-}
+    _index.clear();
+    _logData = QByteArrayView();
+    _nextEntry = 0;
 
-quint64 LogReplayWorker::_seekToNextMavlinkMessage(mavlink_message_t &nextMsg)
-{
-    mavlink_reset_channel_status(_mavlinkChannel);
-
-    qint64 messageStartPos = -1;
-    char nextByte;
-    while (_logFile.getChar(&nextByte)) {
-        mavlink_status_t status{};
-        const bool messageFound = mavlink_parse_char(_mavlinkChannel, nextByte, &nextMsg, &status);
-
-        if (status.parse_state == MAVLINK_PARSE_STATE_GOT_STX) {
-            messageStartPos = _logFile.pos() - 1;
-        }
-
-        if (messageFound && (messageStartPos != -1)) {
-            if (!_logFile.seek(messageStartPos - kTimestamp)) {
-                qCWarning(LogReplayLinkLog) << "Failed to seek next message:" << _logFile.error() << _logFile.errorString();
-                break;
-            }
-
-            const QByteArray rawTime = _logFile.read(kTimestamp);
-            return _parseTimestamp(rawTime);
-        }
-    }
-
-    return 0;
-}
-
-quint64 LogReplayWorker::_findLastTimestamp()
-{
-    if (!_logFile.reset()) {
-        qCWarning(LogReplayLinkLog) << "failed to reset log file:" << _logFile.error() << _logFile.errorString();
-    }
-
-    mavlink_reset_channel_status(_mavlinkChannel);
-
-    quint64 lastTimestamp = 0;
-
-    while (_logFile.bytesAvailable() > kTimestamp) {
-        lastTimestamp = _parseTimestamp(_logFile.read(kTimestamp));
-
-        bool endOfMessage = false;
-        char nextByte;
-        while (!endOfMessage && _logFile.getChar(&nextByte)) {
-            mavlink_message_t msg{};
-            mavlink_status_t status{};
-            endOfMessage = mavlink_parse_char(_mavlinkChannel, nextByte, &msg, &status);
-        }
+    // Closing the file also unmaps it
+    if (_logFile.isOpen()) {
+        _logFile.close();
     }
-
-    return lastTimestamp;
 }
 
 /*===========================================================================*/
@@ -420,6 +396,7 @@ LogReplayLink::LogReplayLink(SharedLinkConfigurationPtr &config, QObject *parent
     (void) connect(_worker, &LogReplayWorker::logFileStats, this, &LogReplayLink::logFileStats, Qt::QueuedConnection);
     (void) connect(_worker, &LogReplayWorker::playbackStarted, this, &LogReplayLink::playbackStarted, Qt::QueuedConnection);
     (void) connect(_worker, &LogReplayWorker::playbackPaused, this, &LogReplayLink::playbackPaused, Qt::QueuedConnection);
+    (void) connect(_worker, &LogReplayWorker::playbackAtEnd, this, &LogReplayLink::playbackAtEnd, Qt::QueuedConnection);
     (void) connect(_worker, &LogReplayWorker::playbackPercentCompleteChanged, this, &LogReplayLink::playbackPercentCompleteChanged, Qt::QueuedConnection);
     (void) connect(_worker, &LogReplayWorker::currentLogTimeSecs, this, &LogReplayLink::currentLogTimeSecs, Qt::QueuedConnection);
     (void) connect(_worker, &LogReplayWorker::disconnected, this, &LogReplayLink::disconnected, Qt::QueuedConnection);
@@ -457,7 +434,9 @@ void LogReplayLink::_onErrorOccurred(const QString &errorString)
 
 void LogReplayLink::_onDataReceived(const QByteArray &data)
 {
+    // The protocol handles the data synchronously, so once this returns the vehicle stack is done with it
     emit bytesReceived(this, data);
+    _worker->chunkConsumed();
 }
 
 void LogReplayLink::play()
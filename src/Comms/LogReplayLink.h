@@ -14,10 +14,11 @@
 
 #include "LinkConfiguration.h"
 #include "LinkInterface.h"
+#include "TlogIndex.h"
 
-class QTimer;
+#include <atomic>
 
-typedef struct __mavlink_message mavlink_message_t;
+class QTimer;
 
 Q_DECLARE_LOGGING_CATEGORY(LogReplayLinkLog)
 
@@ -45,11 +46,16 @@ class LogReplayConfiguration : public LinkConfiguration
     QString logFilename() const { return _logFilename; }
     void setLogFilename(const QString &logFilename);
 
+    /// true: Replay as fast as the vehicle stack can take the data, ignoring the log timestamps
+    bool isUnpaced() const { return _unpaced; }
+    void setUnpaced(bool unpaced) { _unpaced = unpaced; }
+
 signals:
     void filenameChanged();
 
 private:
     QString _logFilename;
+    bool _unpaced = false;
 };
 
 /*===========================================================================*/
@@ -65,6 +71,9 @@ class LogReplayWorker : public QObject
     bool isConnected() const { return _isConnected; }
     bool isPlaying() const;
 
+    /// Thread safe, called by the link once it has passed on a chunk of dataReceived
+    void chunkConsumed() { (void) _pendingChunks.fetch_sub(1, std::memory_order_relaxed); }
+
 signals:
     void connected();
     void disconnected();
@@ -90,11 +99,11 @@ private slots:
     void _readNextLogEntry();
 
 private:
-    quint64 _parseTimestamp(const QByteArray &bytes);
-    quint64 _seekToNextMavlinkMessage(mavlink_message_t &nextMsg);
-    quint64 _findLastTimestamp();
-    quint64 _readNextMavlinkMessage(QByteArray &bytes);
+    void _readNextChunkUnpaced();
+    void _emitData(const QByteArray &bytes);
     bool _loadLogFile();
+    void _closeLogFile();
+    bool _atEnd() const { return (_nextEntry >= _index.count()); }
     void _resetPlaybackToBeginning();
     void _signalCurrentLogTimeSecs();
 
@@ -102,7 +111,6 @@ private slots:
     QTimer *_readTickTimer = nullptr;
 
     bool _isConnected = false;
-    uint8_t _mavlinkChannel = 0;
 
     quint64 _logCurrentTimeUSecs = 0;
     quint64 _logStartTimeUSecs = 0;
@@ -114,9 +122,13 @@ private slots:
     quint64 _playbackStartLogTimeUSecs = 0;
 
     QFile _logFile;
-    quint64 _logFileSize = 0;
+    QByteArrayView _logData;    ///< Memory mapped contents of _logFile
+    TlogIndex _index;
+    qsizetype _nextEntry = 0;   ///< Index entry of the next message to send
 
-    static constexpr size_t kTimestamp = sizeof(quint64);
+    std::atomic_int _pendingChunks = 0;             ///< Chunks sent but not yet passed on by the link
+    static constexpr int kMaxPendingChunks = 4;
+    static constexpr qsizetype kUnpacedChunkMessages = 1024;
 };
 
 /*===========================================================================*/
@@ -0,0 +1,225 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkForwarder.h"
+#include "LinkManager.h"
+#include "MAVLinkFrameParser.h"
+#include "MavlinkSettings.h"
+#include "QGCLoggingCategory.h"
+#include "SettingsManager.h"
+
+#include <QtCore/QStringList>
+
+QGC_LOGGING_CATEGORY(MAVLinkForwarderLog, "qgc.comms.mavlinkforwarder")
+
+MAVLinkForwardFilter::MAVLinkForwardFilter(const QString &sysIds, const QString &msgIds, double maxRateHz)
+{
+    const QStringList sysIdList = sysIds.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString &entry : sysIdList) {
+        bool ok = false;
+        const uint sysId = entry.trimmed().toUInt(&ok);
+        if (!ok || (sysId >= _sysIds.size())) {
+            qCWarning(MAVLinkForwarderLog) << "Ignoring invalid system id" << entry;
+            continue;
+        }
+        _sysIds.set(sysId);
+        _allSysIds = false;
+    }
+
+    const QStringList msgIdList = msgIds.split(QLatin1Char(','), Qt::SkipEmptyParts);
+    for (const QString &entry : msgIdList) {
+        const QString trimmed = entry.trimmed();
+        const bool exclude = trimmed.startsWith(QLatin1Char('-'));
+        bool ok = false;
+        const uint msgId = (exclude ? trimmed.mid(1) : trimmed).toUInt(&ok);
+        if (!ok) {
+            qCWarning(MAVLinkForwarderLog) << "Ignoring invalid message id" << entry;
+            continue;
+        }
+        (void) (exclude ? _excludedMsgIds : _includedMsgIds).insert(msgId);
+    }
+
+    if (maxRateHz > 0) {
+        _minIntervalNsecs = static_cast<qint64>(1e9 / maxRateHz);
+    }
+}
+
+bool MAVLinkForwardFilter::accept(const mavlink_message_t &message, qint64 nowNsecs)
+{
+    if (!_allSysIds && !_sysIds.test(message.sysid)) {
+        return false;
+    }
+
+    if (_excludedMsgIds.contains(message.msgid)) {
+        return false;
+    }
+
+    if (!_includedMsgIds.isEmpty() && !_includedMsgIds.contains(message.msgid)) {
+        return false;
+    }
+
+    if ((_minIntervalNsecs == 0) || isReply(message.msgid)) {
+        return true;
+    }
+
+    const quint64 stream = (static_cast<quint64>(message.sysid) << 32) | (static_cast<quint64>(message.compid) << 24) | message.msgid;
+    const auto it = _nextForwardNsecs.find(stream);
+    if (it == _nextForwardNsecs.end()) {
+        (void) _nextForwardNsecs.insert(stream, nowNsecs + _minIntervalNsecs);
+        return true;
+    }
+
+    if (nowNsecs < it.value()) {
+        return false;
+    }
+
+    // Stepping from the previous slot instead of from now keeps arrival jitter from pulling the rate below the limit
+    it.value() = ((nowNsecs - it.value()) < _minIntervalNsecs) ? (it.value() + _minIntervalNsecs) : (nowNsecs + _minIntervalNsecs);
+    return true;
+}
+
+bool MAVLinkForwardFilter::isReply(uint32_t msgid)
+{
+    switch (msgid) {
+    case MAVLINK_MSG_ID_PARAM_VALUE:
+    case MAVLINK_MSG_ID_PARAM_EXT_VALUE:
+    case MAVLINK_MSG_ID_PARAM_EXT_ACK:
+    case MAVLINK_MSG_ID_MISSION_COUNT:
+    case MAVLINK_MSG_ID_MISSION_ITEM:
+    case MAVLINK_MSG_ID_MISSION_ITEM_INT:
+    case MAVLINK_MSG_ID_MISSION_REQUEST:
+    case MAVLINK_MSG_ID_MISSION_REQUEST_INT:
+    case MAVLINK_MSG_ID_MISSION_ACK:
+    case MAVLINK_MSG_ID_COMMAND_ACK:
+    case MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL:
+    case MAVLINK_MSG_ID_LOG_ENTRY:
+    case MAVLINK_MSG_ID_LOG_DATA:
+    case MAVLINK_MSG_ID_STATUSTEXT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/*===========================================================================*/
+
+MAVLinkForwarder::MAVLinkForwarder(QObject *parent)
+    : QObject(parent)
+{
+    // qCDebug(MAVLinkForwarderLog) << Q_FUNC_INFO << this;
+
+    _clock.start();
+}
+
+MAVLinkForwarder::~MAVLinkForwarder()
+{
+    // qCDebug(MAVLinkForwarderLog) << Q_FUNC_INFO << this;
+}
+
+void MAVLinkForwarder::init()
+{
+    MavlinkSettings *const mavlinkSettings = SettingsManager::instance()->mavlinkSettings();
+    (void) connect(mavlinkSettings->forwardMavlink(), &Fact::rawValueChanged, this, &MAVLinkForwarder::_updateTargets);
+    (void) connect(mavlinkSettings->forwardMavlinkSysIdFilter(), &Fact::rawValueChanged, this, &MAVLinkForwarder::_updateTargets);
+    (void) connect(mavlinkSettings->forwardMavlinkMsgIdFilter(), &Fact::rawValueChanged, this, &MAVLinkForwarder::_updateTargets);
+    (void) connect(mavlinkSettings->forwardMavlinkMaxRate(), &Fact::rawValueChanged, this, &MAVLinkForwarder::_updateTargets);
+    (void) connect(LinkManager::instance(), &LinkManager::mavlinkSupportForwardingEnabledChanged, this, &MAVLinkForwarder::_updateTargets);
+    (void) connect(LinkManager::instance(), &LinkManager::forwardingLinksChanged, this, &MAVLinkForwarder::_updateTargets);
+
+    _updateTargets();
+}
+
+void MAVLinkForwarder::_updateTargets()
+{
+    _targets.clear();
+
+    MavlinkSettings *const mavlinkSettings = SettingsManager::instance()->mavlinkSettings();
+    if (mavlinkSettings->forwardMavlink()->rawValue().toBool()) {
+        const SharedLinkInterfacePtr link = LinkManager::instance()->mavlinkForwardingLink();
+        if (link) {
+            const MAVLinkForwardFilter filter(mavlinkSettings->forwardMavlinkSysIdFilter()->rawValue().toString(),
+                                              mavlinkSettings->forwardMavlinkMsgIdFilter()->rawValue().toString(),
+                                              mavlinkSettings->forwardMavlinkMaxRate()->rawValue().toDouble());
+            (void) _targets.append(Target{link, filter, QByteArray()});
+        }
+    }
+
+    // The support server gets the unfiltered stream
+    if (LinkManager::instance()->mavlinkSupportForwardingEnabled()) {
+        const SharedLinkInterfacePtr link = LinkManager::instance()->mavlinkForwardingSupportLink();
+        if (link) {
+            (void) _targets.append(Target{link, MAVLinkForwardFilter(), QByteArray()});
+        }
+    }
+
+    _active = !_targets.isEmpty();
+
+    qCDebug(MAVLinkForwarderLog) << "Forwarding targets" << _targets.size();
+}
+
+void MAVLinkForwarder::forward(const QList<mavlink_message_t> &messages, QByteArrayView frames)
+{
+    if (_targets.isEmpty()) {
+        return;
+    }
+
+    const qint64 nowNsecs = _clock.nsecsElapsed();
+    bool targetGone = false;
+
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    qsizetype framePos = 0;
+    for (const mavlink_message_t &message : messages) {
+        QByteArrayView frame;
+        if (frames.isEmpty()) {
+            frame = QByteArrayView(buffer, mavlink_msg_to_send_buffer(buffer, &message));
+        } else {
+            const qsizetype frameLen = MAVLinkFrameParser::frameLength(message);
+            Q_ASSERT((framePos + frameLen) <= frames.size());
+            frame = frames.sliced(framePos, frameLen);
+            framePos += frameLen;
+        }
+
+        if (message.msgid == MAVLINK_MSG_ID_SETUP_SIGNING) {
+            continue;
+        }
+
+        for (Target &target : _targets) {
+            if (!target.filter.accept(message, nowNsecs)) {
+                continue;
+            }
+            if ((target.batch.size() + frame.size()) > kMaxBatchSize) {
+                targetGone |= !_flush(target);
+            }
+            (void) target.batch.append(frame);
+        }
+    }
+
+    for (Target &target : _targets) {
+        targetGone |= !_flush(target);
+    }
+
+    if (targetGone) {
+        _updateTargets();
+    }
+}
+
+bool MAVLinkForwarder::_flush(Target &target)
+{
+    if (target.batch.isEmpty()) {
+        return true;
+    }
+
+    const SharedLinkInterfacePtr link = target.link.lock();
+    if (link) {
+        link->writeBytesThreadSafe(target.batch);
+    }
+    target.batch.clear();
+
+    return static_cast<bool>(link);
+}
@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+
+#include <atomic>
+#include <bitset>
+
+#include "LinkInterface.h"
+#include "MAVLinkLib.h"
+
+Q_DECLARE_LOGGING_CATEGORY(MAVLinkForwarderLog)
+
+/// Decides which messages are forwarded to a single target
+class MAVLinkForwardFilter
+{
+public:
+    /// Forwards everything
+    MAVLinkForwardFilter() = default;
+
+    ///     @param sysIds Comma separated list of system ids to forward, empty for all
+    ///     @param msgIds Comma separated list of message ids to forward, empty for all. Ids prefixed with '-' are never forwarded.
+    ///     @param maxRateHz Highest rate at which each message stream (sysid, compid, msgid) is forwarded, 0 for no limit
+    MAVLinkForwardFilter(const QString &sysIds, const QString &msgIds, double maxRateHz);
+
+    /// @param nowNsecs Monotonic time at which the message arrived
+    /// @return true: Forward the message
+    bool accept(const mavlink_message_t &message, qint64 nowNsecs);
+
+    /// Messages which answer a request. Dropping them would break the protocol, so they are never rate limited.
+    static bool isReply(uint32_t msgid);
+
+private:
+    std::bitset<256> _sysIds;
+    bool _allSysIds = true;
+    QSet<uint32_t> _includedMsgIds;     ///< Empty: all messages which are not excluded
+    QSet<uint32_t> _excludedMsgIds;
+    qint64 _minIntervalNsecs = 0;
+    QHash<quint64, qint64> _nextForwardNsecs;   ///< Earliest time the next message of a stream may go out
+};
+
+/*===========================================================================*/
+
+/// Forwards received MAVLink to the forwarding links, the user configured one as well as the ArduPilot support one.
+/// Frames are sent with the bytes they arrived with whenever the parser could provide them. All frames of a received
+/// buffer which go to the same target are sent in as few writes as the datagram size allows.
+/// The target list is cached and only rebuilt when the forwarding settings or the forwarding links change.
+class MAVLinkForwarder : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MAVLinkForwarder(QObject *parent = nullptr);
+    ~MAVLinkForwarder();
+
+    /// Connects to the settings and LinkManager signals which invalidate the targets
+    void init();
+
+    /// @return true: There is at least one target. Thread safe.
+    bool isActive() const { return _active; }
+
+    /// Forwards the messages received in one buffer.
+    ///     @param frames Wire bytes of the messages as provided by MAVLinkFrameParser::parse, empty to re-serialize the messages
+    void forward(const QList<mavlink_message_t> &messages, QByteArrayView frames);
+
+    /// Largest write sent to a target, keeps UDP datagrams from being fragmented
+    static constexpr qsizetype kMaxBatchSize = 1400;
+
+private slots:
+    void _updateTargets();
+
+private:
+    struct Target {
+        WeakLinkInterfacePtr link;
+        MAVLinkForwardFilter filter;
+        QByteArray batch;
+    };
+
+    /// @return false: The target link is gone
+    bool _flush(Target &target);
+
+    QList<Target> _targets;
+    QElapsedTimer _clock;
+    std::atomic_bool _active = false;
+};
@@ -0,0 +1,69 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkParserWorker.h"
+#include "LinkInterface.h"
+#include "MAVLinkFrameParser.h"
+#include "MAVLinkProtocol.h"
+#include "QGCLoggingCategory.h"
+
+QGC_LOGGING_CATEGORY(MAVLinkParserWorkerLog, "qgc.comms.mavlinkparserworker")
+
+MAVLinkParserWorker::MAVLinkParserWorker(const LinkInterface *link, QObject *parent)
+    : QObject(parent)
+    , _link(link)
+{
+    // qCDebug(MAVLinkParserWorkerLog) << Q_FUNC_INFO << this;
+}
+
+MAVLinkParserWorker::~MAVLinkParserWorker()
+{
+    // qCDebug(MAVLinkParserWorkerLog) << Q_FUNC_INFO << this;
+}
+
+void MAVLinkParserWorker::receiveBytes(const QByteArray &data)
+{
+    if (!_link->mavlinkChannelIsSet()) {
+        return;
+    }
+
+    // Signature checks need the signing state of the channel, which belongs to the main thread
+    if (_link->signingEnabled()) {
+        emit bytesReceived(data);
+        return;
+    }
+
+    MAVLinkProtocol *const mavlinkProtocol = MAVLinkProtocol::instance();
+
+    // Forwarding sends the frames with their original bytes, keep them while it is active
+    QByteArray frames;
+    const bool keepFrames = mavlinkProtocol->forwardingActive() && !_link->linkConfiguration()->isForwarding();
+
+    QList<mavlink_message_t> messages;
+    if (MAVLinkFrameParser::parse(_parserState, data, messages, keepFrames ? &frames : nullptr) == 0) {
+        return;
+    }
+
+    for (const mavlink_message_t &message : std::as_const(messages)) {
+        if (_lossCounter.update(message)) {
+            emit mavlinkMessageStatus(message.sysid, _lossCounter.totalSent(), _lossCounter.totalReceived(), _lossCounter.totalLoss(), _lossCounter.runningLossPercent());
+        }
+        mavlinkProtocol->logReceivedMessage(message);
+    }
+
+    qCDebug(MAVLinkParserWorkerLog) << "Decoded" << messages.size() << "messages from" << data.size() << "bytes on channel" << _link->mavlinkChannel();
+
+    emit messagesReceived(messages, frames);
+}
+
+void MAVLinkParserWorker::resetMetadata()
+{
+    _lossCounter.reset();
+    _parserState = MAVLinkFrameParser::ParserState();
+}
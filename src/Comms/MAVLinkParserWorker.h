@@ -0,0 +1,56 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+
+#include "MAVLinkFrameParser.h"
+#include "MAVLinkLib.h"
+#include "MAVLinkLossCounter.h"
+
+class LinkInterface;
+
+Q_DECLARE_LOGGING_CATEGORY(MAVLinkParserWorkerLog)
+
+/// Decodes the MAVLink stream of a single link on that link's worker thread.
+/// Loss counting and telemetry logging happen here as well, only the decoded message batches go to the main thread.
+/// The parse state is private to the worker, the global channel status belongs to the main thread.
+class MAVLinkParserWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MAVLinkParserWorker(const LinkInterface *link, QObject *parent = nullptr);
+    ~MAVLinkParserWorker();
+
+public slots:
+    void receiveBytes(const QByteArray &data);
+
+    /// Restarts loss counting and parsing, the counterpart of MAVLinkProtocol::resetMetadataForLink
+    void resetMetadata();
+
+signals:
+    /// Decoded messages, in the order they arrived
+    ///     @param frames Wire bytes of the messages, only filled in while forwarding is active
+    void messagesReceived(const QList<mavlink_message_t> &messages, const QByteArray &frames);
+
+    /// Raw data which must be decoded on the main thread instead
+    void bytesReceived(const QByteArray &data);
+
+    void mavlinkMessageStatus(int sysid, uint64_t totalSent, uint64_t totalReceived, uint64_t totalLoss, float lossPercent);
+
+private:
+    const LinkInterface *_link = nullptr;
+    MAVLinkLossCounter _lossCounter;
+    MAVLinkFrameParser::ParserState _parserState;
+};
@@ -8,11 +8,14 @@
  ****************************************************************************/
 
 #include "MAVLinkProtocol.h"
+#include "MAVLinkForwarder.h"
+#include "MAVLinkFrameParser.h"
 #include "LinkManager.h"
 #include "MultiVehicleManager.h"
 #include "QGCApplication.h"
 #include "QGCLoggingCategory.h"
 #include "QGCTemporaryFile.h"
+#include "TelemetryLogWriter.h"
 #include "SettingsManager.h"
 #include "MavlinkSettings.h"
 #include "AppSettings.h"
@@ -31,9 +34,13 @@ Q_APPLICATION_STATIC(MAVLinkProtocol, _mavlinkProtocolInstance);
 
 MAVLinkProtocol::MAVLinkProtocol(QObject *parent)
     : QObject(parent)
-    , _tempLogFile(new QGCTemporaryFile(QStringLiteral("%2.%3").arg(_tempLogFileTemplate, _logFileExtension), this))
+    , _forwarder(new MAVLinkForwarder(this))
+    , _logWriter(new TelemetryLogWriter(this))
 {
     // qCDebug(MAVLinkProtocolLog) << Q_FUNC_INFO << this;
+
+    (void) connect(_logWriter, &TelemetryLogWriter::writeFailed, this, &MAVLinkProtocol::_logWriteFailed);
+    (void) connect(_logWriter, &TelemetryLogWriter::dataDropped, this, &MAVLinkProtocol::_logDataDropped);
 }
 
 MAVLinkProtocol::~MAVLinkProtocol()
@@ -54,10 +61,16 @@ void MAVLinkProtocol::init()
         return;
     }
 
-    (void) memset(_firstMessage, 1, sizeof(_firstMessage));
-
     (void) connect(MultiVehicleManager::instance(), &MultiVehicleManager::vehicleRemoved, this, &MAVLinkProtocol::_vehicleCountChanged);
 
+    Fact *const maxLatencyFact = SettingsManager::instance()->mavlinkSettings()->telemetryLogMaxLatency();
+    _logWriter->setMaxLatency(maxLatencyFact->rawValue().toInt());
+    (void) connect(maxLatencyFact, &Fact::rawValueChanged, this, [this](const QVariant &value) {
+        _logWriter->setMaxLatency(value.toInt());
+    });
+
+    _forwarder->init();
+
     _initialized = true;
 }
 
@@ -73,13 +86,8 @@ void MAVLinkProtocol::setVersion(unsigned version)
 
 void MAVLinkProtocol::resetMetadataForLink(LinkInterface *link)
 {
-    const uint8_t channel = link->mavlinkChannel();
-    _totalReceiveCounter[channel] = 0;
-    _totalLossCounter[channel] = 0;
-    _runningLossPercent[channel] = 0.f;
-    for (int i = 0; i < 256; i++) {
-        _firstMessage[channel][i] = 1;
-    }
+    _lossCounters[link->mavlinkChannel()].reset();
+    link->resetWorkerParser();
 
     link->setDecodedFirstMavlinkPacket(false);
 }
@@ -88,23 +96,11 @@ void MAVLinkProtocol::logSentBytes(const LinkInterface *link, const QByteArray &
 {
     Q_UNUSED(link);
 
-    if (_logSuspendError || _logSuspendReplay || !_tempLogFile->isOpen()) {
+    if (_logSuspendError || _logSuspendReplay) {
         return;
     }
 
-    const quint64 time = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() * 1000);
-    uint8_t bytes_time[sizeof(quint64)]{};
-    qToBigEndian(time, bytes_time);
-
-    QByteArray logData = data;
-    QByteArray timeData = QByteArray::fromRawData(reinterpret_cast<const char*>(bytes_time), sizeof(bytes_time));
-    (void) logData.prepend(timeData);
-    if (_tempLogFile->write(logData) != logData.length()) {
-        const QString message = QStringLiteral("MAVLink Logging failed. Could not write to file %1, logging disabled.").arg(_tempLogFile->fileName());
-        qgcApp()->showAppMessage(message, getName());
-        _stopLogging();
-        _logSuspendError = true;
-    }
+    _logWriter->logBytes(data);
 }
 
 void MAVLinkProtocol::receiveBytes(LinkInterface *link, const QByteArray &data)
@@ -115,39 +111,63 @@ void MAVLinkProtocol::receiveBytes(LinkInterface *link, const QByteArray &data)
         return;
     }
 
-    for (const uint8_t &byte: data) {
-        const uint8_t mavlinkChannel = link->mavlinkChannel();
-        mavlink_message_t message{};
-        mavlink_status_t status{};
+    const uint8_t mavlinkChannel = link->mavlinkChannel();
+    const bool forward = _forwarder->isActive() && !linkPtr->linkConfiguration()->isForwarding();
 
-        if (mavlink_parse_char(mavlinkChannel, byte, &message, &status) != MAVLINK_FRAMING_OK) {
-            continue;
-        }
+    QList<mavlink_message_t> messages;
+    QByteArray frames;
+    (void) MAVLinkFrameParser::parse(mavlinkChannel, data, messages, forward ? &frames : nullptr);
 
-        _updateVersion(link, mavlinkChannel);
+    if (forward) {
+        _forwarder->forward(messages, frames);
+    }
+
+    for (const mavlink_message_t &message : std::as_const(messages)) {
+        _updateVersion(link, mavlinkChannel, message);
         _updateCounters(mavlinkChannel, message);
-        if (!linkPtr->linkConfiguration()->isForwarding()) {
-            _forward(message);
-            _forwardSupport(message);
+        _logData(message);
+        _handleHeartbeat(link, message);
+
+        if (!_updateStatus(link, linkPtr, message)) {
+            break;
         }
-        _logData(link, message);
+    }
+}
+
+void MAVLinkProtocol::receiveMessages(LinkInterface *link, const QList<mavlink_message_t> &messages, const QByteArray &frames)
+{
+    const SharedLinkInterfacePtr linkPtr = LinkManager::instance()->sharedLinkInterfacePointerForLink(link);
+    if (!linkPtr) {
+        qCDebug(MAVLinkProtocolLog) << "receiveMessages: link gone!" << messages.size() << "messages arrived too late";
+        return;
+    }
+
+    if (!linkPtr->linkConfiguration()->isForwarding()) {
+        _forwarder->forward(messages, frames);
+    }
+
+    const uint8_t mavlinkChannel = link->mavlinkChannel();
+    for (const mavlink_message_t &message : messages) {
+        _updateVersion(link, mavlinkChannel, message);
+        _handleHeartbeat(link, message);
 
-        if (!_updateStatus(link, linkPtr, mavlinkChannel, message)) {
+        emit messageReceived(link, message);
+        if (linkPtr.use_count() == 1) {
             break;
         }
     }
 }
 
-void MAVLinkProtocol::_updateVersion(LinkInterface *link, uint8_t mavlinkChannel)
+void MAVLinkProtocol::_updateVersion(LinkInterface *link, uint8_t mavlinkChannel, const mavlink_message_t &message)
 {
     if (link->decodedFirstMavlinkPacket()) {
         return;
     }
 
     link->setDecodedFirstMavlinkPacket(true);
-    const mavlink_status_t *const mavlinkStatus = mavlink_get_channel_status(mavlinkChannel);
 
-    if (mavlinkStatus->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1) {
+    // The channel status only reflects the last frame of the batch, so check the frame itself
+    if (message.magic == MAVLINK_STX_MAVLINK1) {
         return;
     }
 
@@ -159,97 +179,65 @@ void MAVLinkProtocol::_updateVersion(LinkInterface *link, uint8_t mavlinkChannel
 
 void MAVLinkProtocol::_updateCounters(uint8_t mavlinkChannel, const mavlink_message_t &message)
 {
-    uint8_t lastSeq = _lastIndex[message.sysid][message.compid];
-    uint8_t expectedSeq = lastSeq + 1;
-    _totalReceiveCounter[mavlinkChannel]++;
-    if (_firstMessage[message.sysid][message.compid] != 0) {
-        _firstMessage[message.sysid][message.compid] = 0;
-        lastSeq = message.seq;
-        expectedSeq = message.seq;
-    }
-
-    if (message.seq != expectedSeq) {
-        uint64_t lostMessages = message.seq;
-        if (message.seq < expectedSeq) {
-            lostMessages += 255;
-        }
-        lostMessages -= expectedSeq;
-        _totalLossCounter[mavlinkChannel] += lostMessages;
+    MAVLinkLossCounter &lossCounter = _lossCounters[mavlinkChannel];
+    if (lossCounter.update(message)) {
+        emit mavlinkMessageStatus(message.sysid, lossCounter.totalSent(), lossCounter.totalReceived(), lossCounter.totalLoss(), lossCounter.runningLossPercent());
     }
+}
 
-    _lastIndex[message.sysid][message.compid] = message.seq;
+void MAVLinkProtocol::logReceivedMessage(const mavlink_message_t &message)
+{
+    _logData(message);
+}
 
-    const uint64_t totalSent = _totalReceiveCounter[mavlinkChannel] + _totalLossCounter[mavlinkChannel];
-    float receiveLossPercent = static_cast<float>(static_cast<double>(_totalLossCounter[mavlinkChannel]) / static_cast<double>(totalSent));
-    receiveLossPercent *= 100.0f;
-    receiveLossPercent *= 0.5f;
-    receiveLossPercent += (_runningLossPercent[mavlinkChannel] * 0.5f);
-    _runningLossPercent[mavlinkChannel] = receiveLossPercent;
+bool MAVLinkProtocol::forwardingActive() const
+{
+    return _forwarder->isActive();
 }
 
-void MAVLinkProtocol::_forward(const mavlink_message_t &message)
+void MAVLinkProtocol::_logData(const mavlink_message_t &message)
 {
-    if (message.msgid == MAVLINK_MSG_ID_SETUP_SIGNING) {
+    if (_logSuspendError || _logSuspendReplay) {
         return;
     }
 
-    if (!SettingsManager::instance()->mavlinkSettings()->forwardMavlink()->rawValue().toBool()) {
+    if (!_logWriter->isOpen()) {
         return;
     }
 
-    SharedLinkInterfacePtr forwardingLink = LinkManager::instance()->mavlinkForwardingLink();
-    if (!forwardingLink) {
-        return;
-    }
+    _logWriter->logMessage(message);
 
-    uint8_t buf[MAVLINK_MAX_PACKET_LEN]{};
-    const uint16_t len = mavlink_msg_to_send_buffer(buf, &message);
-    (void) forwardingLink->writeBytesThreadSafe(reinterpret_cast<const char*>(buf), len);
+    if ((message.msgid == MAVLINK_MSG_ID_HEARTBEAT) && !_vehicleWasArmed) {
+        if (mavlink_msg_heartbeat_get_base_mode(&message) & MAV_MODE_FLAG_DECODE_POSITION_SAFETY) {
+            _vehicleWasArmed = true;
+        }
+    }
 }
 
-void MAVLinkProtocol::_forwardSupport(const mavlink_message_t &message)
+void MAVLinkProtocol::_logWriteFailed()
 {
-    if (message.msgid == MAVLINK_MSG_ID_SETUP_SIGNING) {
+    if (_logSuspendError.exchange(true)) {
         return;
     }
 
-    if (!LinkManager::instance()->mavlinkSupportForwardingEnabled()) {
-        return;
-    }
-
-    SharedLinkInterfacePtr forwardingSupportLink = LinkManager::instance()->mavlinkForwardingSupportLink();
-    if (!forwardingSupportLink) {
-        return;
-    }
-
-    uint8_t buf[MAVLINK_MAX_PACKET_LEN]{};
-    const uint16_t len = mavlink_msg_to_send_buffer(buf, &message);
-    (void) forwardingSupportLink->writeBytesThreadSafe(reinterpret_cast<const char*>(buf), len);
+    const QString message = QStringLiteral("MAVLink Logging failed. Could not write to file %1, logging disabled.").arg(_logWriter->fileName());
+    qgcApp()->showAppMessage(message, getName());
+    _stopLogging();
+    _logSuspendError = true;
 }
 
-void MAVLinkProtocol::_logData(LinkInterface *link, const mavlink_message_t &message)
+void MAVLinkProtocol::_logDataDropped(quint64 droppedCount)
 {
-    if (!_logSuspendError && !_logSuspendReplay && _tempLogFile->isOpen()) {
-        const quint64 timestamp = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() * 1000);
-        uint8_t buf[MAVLINK_MAX_PACKET_LEN + sizeof(timestamp)]{};
-        qToBigEndian(timestamp, buf);
-
-        const qsizetype len = mavlink_msg_to_send_buffer(buf + sizeof(timestamp), &message) + sizeof(timestamp);
-        const QByteArray log_data(reinterpret_cast<const char*>(buf), len);
-        if (_tempLogFile->write(log_data) != len) {
-            const QString message = QStringLiteral("MAVLink Logging failed. Could not write to file %1, logging disabled.").arg(_tempLogFile->fileName());
-            qgcApp()->showAppMessage(message, getName());
-            _stopLogging();
-            _logSuspendError = true;
-        }
+    emit telemetryLogDataDropped(droppedCount);
 
-        if ((message.msgid == MAVLINK_MSG_ID_HEARTBEAT) && !_vehicleWasArmed) {
-            if (mavlink_msg_heartbeat_get_base_mode(&message) & MAV_MODE_FLAG_DECODE_POSITION_SAFETY) {
-                _vehicleWasArmed = true;
-            }
-        }
+    if (!_logDropReported) {
+        _logDropReported = true;
+        qgcApp()->showAppMessage(tr("Telemetry log storage is too slow, some telemetry was not written to the log."), getName());
     }
+}
 
+void MAVLinkProtocol::_handleHeartbeat(LinkInterface *link, const mavlink_message_t &message)
+{
     switch (message.msgid) {
     case MAVLINK_MSG_ID_HEARTBEAT: {
         _startLogging();
@@ -278,13 +266,8 @@ void MAVLinkProtocol::_logData(LinkInterface *link, const mavlink_message_t &mes
     }
 }
 
-bool MAVLinkProtocol::_updateStatus(LinkInterface *link, const SharedLinkInterfacePtr linkPtr, uint8_t mavlinkChannel, const mavlink_message_t &message)
+bool MAVLinkProtocol::_updateStatus(LinkInterface *link, const SharedLinkInterfacePtr linkPtr, const mavlink_message_t &message)
 {
-    if ((_totalReceiveCounter[mavlinkChannel] % 31) == 0) {
-        const uint64_t totalSent = _totalReceiveCounter[mavlinkChannel] + _totalLossCounter[mavlinkChannel];
-        emit mavlinkMessageStatus(message.sysid, totalSent, _totalReceiveCounter[mavlinkChannel], _totalLossCounter[mavlinkChannel], _runningLossPercent[mavlinkChannel]);
-    }
-
     emit messageReceived(link, message);
 
     if (linkPtr.use_count() == 1) {
@@ -296,17 +279,16 @@ bool MAVLinkProtocol::_updateStatus(LinkInterface *link, const SharedLinkInterfa
 
 bool MAVLinkProtocol::_closeLogFile()
 {
-    if (!_tempLogFile->isOpen()) {
+    const qint64 size = _logWriter->close();
+    if (size < 0) {
         return false;
     }
 
-    if (_tempLogFile->size() == 0) {
-        (void) _tempLogFile->remove();
+    if (size == 0) {
+        (void) QFile::remove(_logWriter->fileName());
         return false;
     }
 
-    (void) _tempLogFile->flush();
-    _tempLogFile->close();
     return true;
 }
 
@@ -327,23 +309,25 @@ void MAVLinkProtocol::_startLogging()
     }
 #endif
 
-    if (_tempLogFile->isOpen()) {
+    if (_logSuspendReplay) {
         return;
     }
 
-    if (_logSuspendReplay) {
+    if (_logWriter->isOpen()) {
         return;
     }
 
-    if (!_tempLogFile->open()) {
-        const QString message = QStringLiteral("Opening Flight Data file for writing failed. Unable to write to %1. Please choose a different file location.").arg(_tempLogFile->fileName());
+    const QString tempLogFileName = QGCTemporaryFile::newTempFileFullyQualifiedName(QStringLiteral("%1.%2").arg(_tempLogFileTemplate, _logFileExtension));
+    if (!_logWriter->open(tempLogFileName)) {
+        const QString message = QStringLiteral("Opening Flight Data file for writing failed. Unable to write to %1. Please choose a different file location.").arg(tempLogFileName);
         qgcApp()->showAppMessage(message, getName());
         _closeLogFile();
         _logSuspendError = true;
         return;
     }
+    _logDropReported = false;
 
-    qCDebug(MAVLinkProtocolLog) << "Temp log" << _tempLogFile->fileName();
+    qCDebug(MAVLinkProtocolLog) << "Temp log" << tempLogFileName;
     (void) _checkTelemetrySavePath();
 
     _logSuspendError = false;
@@ -351,15 +335,15 @@ void MAVLinkProtocol::_startLogging()
 
 void MAVLinkProtocol::_stopLogging()
 {
-    if (_tempLogFile->isOpen() && _closeLogFile()) {
+    if (_closeLogFile()) {
         auto appSettings = SettingsManager::instance()->appSettings();
         auto mavlinkSettings = SettingsManager::instance()->mavlinkSettings();
         if ((_vehicleWasArmed || mavlinkSettings->telemetrySaveNotArmed()->rawValue().toBool()) && 
                 mavlinkSettings->telemetrySave()->rawValue().toBool() && 
                 !appSettings->disableAllPersistence()->rawValue().toBool()) {
-            _saveTelemetryLog(_tempLogFile->fileName());
+            _saveTelemetryLog(_logWriter->fileName());
         } else {
-            (void) QFile::remove(_tempLogFile->fileName());
+            (void) QFile::remove(_logWriter->fileName());
         }
     }
 
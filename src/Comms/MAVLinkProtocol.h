@@ -10,14 +10,19 @@
 #pragma once
 
 #include <QtCore/QByteArray>
+#include <QtCore/QList>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
 #include <QtCore/QString>
 
+#include <atomic>
+
 #include "LinkInterface.h"
 #include "MAVLinkLib.h"
+#include "MAVLinkLossCounter.h"
 
-class QGCTemporaryFile;
+class MAVLinkForwarder;
+class TelemetryLogWriter;
 
 Q_DECLARE_LOGGING_CATEGORY(MAVLinkProtocolLog)
 
@@ -80,11 +85,27 @@ class MAVLinkProtocol : public QObject
 
     void mavlinkMessageStatus(int sysid, uint64_t totalSent, uint64_t totalReceived, uint64_t totalLoss, float lossPercent);
 
+    /// The telemetry log could not keep up with the incoming data
+    ///     @param droppedCount Total number of records dropped from the current log
+    void telemetryLogDataDropped(quint64 droppedCount);
+
+public:
+    /// Writes a received message to the telemetry log. Thread safe, used by links which decode on their own thread.
+    void logReceivedMessage(const mavlink_message_t &message);
+
+    /// @return true: Received messages are forwarded, parsers should keep the wire bytes. Thread safe.
+    bool forwardingActive() const;
+
 public slots:
     /// Receive bytes from a communication interface and constructs a MAVLink packet
     ///     @param link The interface to read from
     void receiveBytes(LinkInterface *link, const QByteArray &data);
 
+    /// Handles messages already decoded on the link worker thread. Loss counters and telemetry logging have been taken care of there.
+    ///     @param link The interface the messages arrived on
+    ///     @param frames Wire bytes of the messages, empty if they were decoded while forwarding was inactive
+    void receiveMessages(LinkInterface *link, const QList<mavlink_message_t> &messages, const QByteArray &frames);
+
     /// Log bytes sent from a communication interface and logs a MAVLink packet.
     /// It can handle multiple links in parallel, as each link has it's own buffer/parsing state machine.
     ///     @param link The interface to read from
@@ -95,34 +116,32 @@ public slots:
 
 private slots:
     void _vehicleCountChanged();
+    void _logWriteFailed();
+    void _logDataDropped(quint64 droppedCount);
 
 private:
-    void _logData(LinkInterface *link, const mavlink_message_t &message);
+    void _logData(const mavlink_message_t &message);
+    void _handleHeartbeat(LinkInterface *link, const mavlink_message_t &message);
     bool _closeLogFile();
     void _startLogging();
     void _stopLogging();
 
-    void _forward(const mavlink_message_t &message);
-    void _forwardSupport(const mavlink_message_t &message);
-
     void _updateCounters(uint8_t mavlinkChannel, const mavlink_message_t &message);
-    bool _updateStatus(LinkInterface *link, const SharedLinkInterfacePtr linkPtr, uint8_t mavlinkChannel, const mavlink_message_t &message);
-    void _updateVersion(LinkInterface *link, uint8_t mavlinkChannel);
+    bool _updateStatus(LinkInterface *link, const SharedLinkInterfacePtr linkPtr, const mavlink_message_t &message);
+    void _updateVersion(LinkInterface *link, uint8_t mavlinkChannel, const mavlink_message_t &message);
 
     void _saveTelemetryLog(const QString &tempLogfile);
     bool _checkTelemetrySavePath();
 
-    QGCTemporaryFile * const _tempLogFile = nullptr;
+    MAVLinkForwarder * const _forwarder = nullptr;
+    TelemetryLogWriter * const _logWriter = nullptr;
+    bool _logDropReported = false;              ///< true: User has been told about dropped data in the current log
 
-    bool _logSuspendError = false;  ///< true: Logging suspended due to error
-    bool _logSuspendReplay = false; ///< true: Logging suspended due to replay
-    bool _vehicleWasArmed = false;  ///< true: Vehicle was armed during log sequence
+    std::atomic_bool _logSuspendError = false;  ///< true: Logging suspended due to error
+    std::atomic_bool _logSuspendReplay = false; ///< true: Logging suspended due to replay
+    std::atomic_bool _vehicleWasArmed = false;  ///< true: Vehicle was armed during log sequence
 
-    uint8_t _lastIndex[256][256]{};                             ///< Store the last received sequence ID for each system/component pair
-    uint8_t _firstMessage[256][256]{};                          ///< First message flag
-    uint64_t _totalReceiveCounter[MAVLINK_COMM_NUM_BUFFERS]{};  ///< The total number of successfully received messages
-    uint64_t _totalLossCounter[MAVLINK_COMM_NUM_BUFFERS]{};     ///< Total messages lost during transmission.
-    float _runningLossPercent[MAVLINK_COMM_NUM_BUFFERS]{};      ///< Loss rate
+    MAVLinkLossCounter _lossCounters[MAVLINK_COMM_NUM_BUFFERS];
 
     unsigned _currentVersion = 100;
     bool _initialized = false;
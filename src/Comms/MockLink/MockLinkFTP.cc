@@ -9,6 +9,7 @@
 
 #include "MockLinkFTP.h"
 #include "MockLink.h"
+#include "QGC.h"
 #include "QGCLoggingCategory.h"
 #include "QGCTemporaryFile.h"
 
@@ -97,6 +98,29 @@ void MockLinkFTP::_listCommand(uint8_t senderSystemId, uint8_t senderComponentId
     _sendResponse(senderSystemId, senderComponentId, &ackResponse, outgoingSeqNumber);
 }
 
+QString MockLinkFTP::_filenameForPath(const QString &path) const
+{
+    QString filename;
+
+    const QString sizePrefix = sizeFilenamePrefix;
+    if (path.startsWith(sizePrefix)) {
+        const QString sizeString = path.right(path.length() - sizePrefix.length());
+        filename = _createTestTempFile(sizeString.toInt());
+    } else if (path == "/general.json") {
+        filename = QStringLiteral(":MockLink/General.MetaData.json");
+    } else if (path == "/general.json.xz") {
+        filename = QStringLiteral(":MockLink/General.MetaData.json.xz");
+    } else if (path == "/parameter.json") {
+        filename = QStringLiteral(":MockLink/Parameter.MetaData.json");
+    } else if (path == "/parameter.json.xz") {
+        filename = QStringLiteral(":MockLink/Parameter.MetaData.json.xz");
+    } else if (_BinParamFileEnabled && (path == "@PARAM/param.pck")) {
+        filename = ":MockLink/Arduplane.params.ftp.bin";
+    }
+
+    return filename;
+}
+
 void MockLinkFTP::_openCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber)
 {
     MavlinkFTP::Request response{};
@@ -111,23 +135,7 @@ void MockLinkFTP::_openCommand(uint8_t senderSystemId, uint8_t senderComponentId
 
     _currentFile.close();
 
-    QString tmpFilename;
-    const QString sizePrefix = sizeFilenamePrefix;
-    if (path.startsWith(sizePrefix)) {
-        const QString sizeString = path.right(path.length() - sizePrefix.length());
-        tmpFilename = _createTestTempFile(sizeString.toInt());
-    } else if (path == "/general.json") {
-        tmpFilename = QStringLiteral(":MockLink/General.MetaData.json");
-    } else if (path == "/general.json.xz") {
-        tmpFilename = QStringLiteral(":MockLink/General.MetaData.json.xz");
-    } else if (path == "/parameter.json") {
-        tmpFilename = QStringLiteral(":MockLink/Parameter.MetaData.json");
-    } else if (path == "/parameter.json.xz") {
-        tmpFilename = QStringLiteral(":MockLink/Parameter.MetaData.json.xz");
-    } else if (_BinParamFileEnabled && (path == "@PARAM/param.pck")) {
-        tmpFilename = ":MockLink/Arduplane.params.ftp.bin";
-    }
-
+    const QString tmpFilename = _filenameForPath(path);
     if (!tmpFilename.isEmpty()) {
         _currentFile.setFileName(tmpFilename);
         if (!_currentFile.open(QIODevice::ReadOnly)) {
@@ -152,6 +160,35 @@ void MockLinkFTP::_openCommand(uint8_t senderSystemId, uint8_t senderComponentId
     _sendResponse(senderSystemId, senderComponentId, &response, outgoingSeqNumber);
 }
 
+void MockLinkFTP::_calcFileCRC32Command(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber)
+{
+    MavlinkFTP::Request response{};
+    ensureNullTemination(request);
+    const QString path = reinterpret_cast<char*>(request->data);
+
+    const uint16_t outgoingSeqNumber = _nextSeqNumber(seqNumber);
+
+    QFile file(_filenameForPath(path));
+    if (file.fileName().isEmpty()) {
+        _sendNak(senderSystemId, senderComponentId, MavlinkFTP::kErrFailFileNotFound, outgoingSeqNumber, MavlinkFTP::kCmdCalcFileCRC32);
+        return;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        _sendNakErrno(senderSystemId, senderComponentId, file.error(), outgoingSeqNumber, MavlinkFTP::kCmdCalcFileCRC32);
+        return;
+    }
+
+    const QByteArray bytes = file.readAll();
+
+    response.hdr.opcode = MavlinkFTP::kRspAck;
+    response.hdr.req_opcode = MavlinkFTP::kCmdCalcFileCRC32;
+    response.hdr.session = 0;
+    response.hdr.size = sizeof(uint32_t);
+    response.fileCRC32 = QGC::crc32(reinterpret_cast<const uint8_t*>(bytes.constData()), static_cast<unsigned>(bytes.size()), 0);
+
+    _sendResponse(senderSystemId, senderComponentId, &response, outgoingSeqNumber);
+}
+
 void MockLinkFTP::_readCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber)
 {
     MavlinkFTP::Request	response{};
@@ -162,6 +199,10 @@ void MockLinkFTP::_readCommand(uint8_t senderSystemId, uint8_t senderComponentId
         return;
     }
 
+    if (_errMode == errModeNoReadResponse) {
+        return;
+    }
+
     const uint32_t readOffset = request->hdr.offset;  // offset into file for reading
     if (readOffset != 0) {
         // If we get here it means the client is requesting additional data past the first request
@@ -281,12 +322,13 @@ void MockLinkFTP::mavlinkMessageReceived(const mavlink_message_t &message)
 
     MavlinkFTP::Request *request = reinterpret_cast<MavlinkFTP::Request*>(&requestFTP.payload[0]);
 
-    // kCmdOpenFileRO and kCmdResetSessions don't support retry so we can't drop those
-    if (_randomDropsEnabled && (request->hdr.opcode != MavlinkFTP::kCmdOpenFileRO) && (request->hdr.opcode != MavlinkFTP::kCmdResetSessions)) {
-        if ((rand() % 5) == 0) {
-            qCDebug(MockLinkFTPLog) << "MockLinkFTP: Random drop of incoming packet";
-            return;
-        }
+    if (request->hdr.opcode == MavlinkFTP::kCmdReadFile) {
+        _readRequestOffsets.append(request->hdr.offset);
+    }
+
+    if (_randomDrop(request->hdr.opcode)) {
+        qCDebug(MockLinkFTPLog) << "MockLinkFTP: Random drop of incoming packet";
+        return;
     }
 
     if (_lastReplyValid && (request->hdr.seqNumber == (_lastReplySequence - 1))) {
@@ -340,6 +382,9 @@ void MockLinkFTP::mavlinkMessageReceived(const mavlink_message_t &message)
     case MavlinkFTP::kCmdResetSessions:
         _resetCommand(message.sysid, message.compid, incomingSeqNumber);
         break;
+    case MavlinkFTP::kCmdCalcFileCRC32:
+        _calcFileCRC32Command(message.sysid, message.compid, request, incomingSeqNumber);
+        break;
     default:
         // nack for all NYI opcodes
         _sendNak(message.sysid, message.compid, MavlinkFTP::kErrUnknownCommand, outgoingSeqNumber, static_cast<MavlinkFTP::OpCode_t>(request->hdr.opcode));
@@ -404,18 +449,31 @@ void MockLinkFTP::_sendResponse(uint8_t targetSystemId, uint8_t targetComponentI
         reinterpret_cast<uint8_t*>(request) // Payload
     );
 
-    // kCmdOpenFileRO and kCmdResetSessions don't support retry so we can't drop those
-    if (_randomDropsEnabled && (request->hdr.req_opcode != MavlinkFTP::kCmdOpenFileRO) && (request->hdr.req_opcode != MavlinkFTP::kCmdResetSessions)) {
-        if ((rand() % 5) == 0) {
-            qCDebug(MockLinkFTPLog) << "MockLinkFTP: Random drop of outgoing packet";
-            return;
-        }
+    if (_randomDrop(request->hdr.req_opcode)) {
+        qCDebug(MockLinkFTPLog) << "MockLinkFTP: Random drop of outgoing packet";
+        return;
     }
 
     _mockLink->respondWithMavlinkMessage(_lastReply);
 }
 
 
+void MockLinkFTP::setDropPercent(int dropPercent)
+{
+    _dropPercent = qBound(0, dropPercent, 100);
+    _dropGenerator.seed(1);
+}
+
+bool MockLinkFTP::_randomDrop(uint8_t opcode)
+{
+    // kCmdOpenFileRO and kCmdResetSessions don't support retry so we can't drop those
+    if ((_dropPercent == 0) || (opcode == MavlinkFTP::kCmdOpenFileRO) || (opcode == MavlinkFTP::kCmdResetSessions)) {
+        return false;
+    }
+
+    return (static_cast<int>(_dropGenerator.bounded(100)) < _dropPercent);
+}
+
 uint16_t MockLinkFTP::_nextSeqNumber(uint16_t seqNumber) const
 {
     uint16_t outgoingSeqNumber = seqNumber + 1;
@@ -10,8 +10,10 @@
 #pragma once
 
 #include <QtCore/QFile>
+#include <QtCore/QList>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
+#include <QtCore/QRandomGenerator>
 #include <QtCore/QStringList>
 
 #include "MAVLinkFTP.h"
@@ -36,7 +38,11 @@ class MockLinkFTP : public QObject
     /// Called to handle an FTP message
     void mavlinkMessageReceived(const mavlink_message_t &message);
 
-    void enableRandromDrops(bool enable) { _randomDropsEnabled = enable; }
+    void enableRandromDrops(bool enable) { setDropPercent(enable ? 20 : 0); }
+
+    /// Drops this percentage of the incoming and outgoing packets. The drops follow a fixed pseudo random sequence,
+    /// which restarts with each call, so runs with the same requests lose the same packets.
+    void setDropPercent(int dropPercent);
     void enableBinParamFile(bool enable) { _BinParamFileEnabled = enable; }
 
     /// By calling setErrorMode with one of these modes you can cause the server to simulate an error.
@@ -47,12 +53,16 @@ class MockLinkFTP : public QObject
         errModeNoSecondResponse,            ///< No response to subsequent request to initial command
         errModeNoSecondResponseAllowRetry,  ///< No response to subsequent request to initial command, error will be cleared after this so retry will succeed
         errModeNakSecondResponse,           ///< Nak subsequent request to initial command
-        errModeBadSequence                  ///< Return response with bad sequence number
+        errModeBadSequence,                 ///< Return response with bad sequence number
+        errModeNoReadResponse               ///< No response to Read requests, all other requests are answered
     };
 
     /// Sets the error mode for command responses. This allows you to simulate various server errors.
     void setErrorMode(ErrorMode_t errMode) { _errMode = errMode; };
 
+    /// @return Offsets of all Read requests sent to the server in the order they were sent, including dropped ones
+    const QList<uint32_t> &readRequestOffsets() const { return _readRequestOffsets; }
+
     /// Array of failure modes you can cycle through for testing. By looping through this array you can avoid
     /// hardcoding the specific error modes in your unit test. This way when new error modes are added your unit test
     /// code may not need to be modified.
@@ -87,6 +97,7 @@ class MockLinkFTP : public QObject
     /// File list returned is set using the setFileList method.
     void _listCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber);
     void _openCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber);
+    void _calcFileCRC32Command(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber);
     void _readCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber);
     void _burstReadCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber);
     void _terminateCommand(uint8_t senderSystemId, uint8_t senderComponentId, MavlinkFTP::Request *request, uint16_t seqNumber);
@@ -94,7 +105,10 @@ class MockLinkFTP : public QObject
     /// Generates the next sequence number given an incoming sequence number. Handles generating
     /// bad sequence numbers when errModeBadSequence is set.
     uint16_t _nextSeqNumber(uint16_t seqNumber) const;
+    bool _randomDrop(uint8_t opcode);
     static QString _createTestTempFile(int size);
+    /// @return Local file served for the path on the vehicle, empty if there is none
+    QString _filenameForPath(const QString &path) const;
 
     /// if request is a string, this ensures it's null-terminated
     static void ensureNullTemination(MavlinkFTP::Request *request);
@@ -105,11 +119,13 @@ class MockLinkFTP : public QObject
 
     bool _BinParamFileEnabled = false;
     bool _lastReplyValid = false;
-    bool _randomDropsEnabled = false;
+    int _dropPercent = 0;
+    QRandomGenerator _dropGenerator;
     ErrorMode_t _errMode = errModeNone;         ///< Currently set error mode, as specified by setErrorMode
     mavlink_message_t _lastReply{};
     QFile _currentFile;
     QStringList _fileList;                      ///< List of files returned by List command
+    QList<uint32_t> _readRequestOffsets;
     uint16_t _lastReplySequence = 0;
 
     static constexpr uint8_t _sessionId = 1;    ///< We only support a single fixed session
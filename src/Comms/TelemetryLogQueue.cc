@@ -0,0 +1,140 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TelemetryLogQueue.h"
+
+#include <QtCore/QtEndian>
+
+TelemetryLogQueue::TelemetryLogQueue(quint64 slotCount)
+    : _mask(slotCount - 1)
+    , _slots(std::make_unique<Slot[]>(slotCount))
+{
+    Q_ASSERT((slotCount != 0) && ((slotCount & _mask) == 0));
+
+    for (quint64 i = 0; i < slotCount; i++) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool TelemetryLogQueue::_reserve(quint64 slotCount, quint64 &pos)
+{
+    pos = _enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        bool free = true;
+        for (quint64 i = 0; i < slotCount; i++) {
+            if (_slots[(pos + i) & _mask].sequence.load(std::memory_order_acquire) != (pos + i)) {
+                free = false;
+                break;
+            }
+        }
+
+        if (free) {
+            if (_enqueuePos.compare_exchange_weak(pos, pos + slotCount, std::memory_order_relaxed)) {
+                return true;
+            }
+            continue;
+        }
+
+        // A slot which is not free at an unchanged position has not been consumed yet, otherwise another producer won the race
+        const quint64 current = _enqueuePos.load(std::memory_order_relaxed);
+        if (current == pos) {
+            return false;
+        }
+        pos = current;
+    }
+}
+
+bool TelemetryLogQueue::push(quint64 timestampUSecs, const mavlink_message_t &message)
+{
+    quint64 pos;
+    if (!_reserve(1, pos)) {
+        (void) _droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Slot &slot = _slots[pos & _mask];
+    slot.timestampUSecs = timestampUSecs;
+    slot.firstOfRecord = true;
+    slot.length = mavlink_msg_to_send_buffer(slot.data, &message);
+    _publish(slot, pos);
+
+    return true;
+}
+
+bool TelemetryLogQueue::push(quint64 timestampUSecs, QByteArrayView data)
+{
+    if (data.isEmpty()) {
+        return true;
+    }
+
+    // A single record may not take more than a quarter of the queue
+    const quint64 slotCount = (static_cast<quint64>(data.size()) + kSlotDataSize - 1) / kSlotDataSize;
+    quint64 pos;
+    if ((slotCount > (capacity() / 4)) || !_reserve(slotCount, pos)) {
+        (void) _droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(data.data());
+    qsizetype remaining = data.size();
+    for (quint64 i = 0; i < slotCount; i++) {
+        Slot &slot = _slots[(pos + i) & _mask];
+        const qsizetype length = qMin(remaining, kSlotDataSize);
+        slot.timestampUSecs = timestampUSecs;
+        slot.firstOfRecord = (i == 0);
+        slot.length = static_cast<quint16>(length);
+        (void) memcpy(slot.data, bytes, length);
+        bytes += length;
+        remaining -= length;
+        _publish(slot, pos + i);
+    }
+
+    return true;
+}
+
+quint64 TelemetryLogQueue::pop(QByteArray &block, qsizetype maxBytes)
+{
+    quint64 pos = _dequeuePos.load(std::memory_order_relaxed);
+    const quint64 startPos = pos;
+
+    while (block.size() < maxBytes) {
+        Slot &slot = _slots[pos & _mask];
+        if (slot.sequence.load(std::memory_order_acquire) != (pos + 1)) {
+            break;
+        }
+
+        if (slot.firstOfRecord) {
+            char timestamp[sizeof(quint64)];
+            qToBigEndian(slot.timestampUSecs, timestamp);
+            (void) block.append(timestamp, sizeof(timestamp));
+        }
+        (void) block.append(reinterpret_cast<const char*>(slot.data), slot.length);
+
+        // Hand the slot back to the producers for the next lap
+        slot.sequence.store(pos + capacity(), std::memory_order_release);
+        pos++;
+    }
+
+    _dequeuePos.store(pos, std::memory_order_relaxed);
+    return pos - startPos;
+}
+
+void TelemetryLogQueue::discard()
+{
+    quint64 pos = _dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot &slot = _slots[pos & _mask];
+        if (slot.sequence.load(std::memory_order_acquire) != (pos + 1)) {
+            break;
+        }
+        slot.sequence.store(pos + capacity(), std::memory_order_release);
+        pos++;
+    }
+    _dequeuePos.store(pos, std::memory_order_relaxed);
+}
@@ -0,0 +1,75 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+
+#include <atomic>
+#include <memory>
+
+#include "MAVLinkLib.h"
+
+/// Bounded lock-free queue of telemetry log records, each a timestamp plus the raw frame bytes.
+/// Any number of threads may push, a single thread pops. Records which do not fit are dropped and counted.
+class TelemetryLogQueue
+{
+public:
+    /// @param slotCount Number of fixed size slots, must be a power of two
+    explicit TelemetryLogQueue(quint64 slotCount = kDefaultSlotCount);
+
+    /// Serializes the message straight into the queue
+    ///     @return false: Queue full, record dropped
+    bool push(quint64 timestampUSecs, const mavlink_message_t &message);
+
+    /// Queues raw bytes, larger records span multiple consecutive slots
+    ///     @return false: Queue full or record larger than the queue allows, record dropped
+    bool push(quint64 timestampUSecs, QByteArrayView data);
+
+    /// Appends published records to block in tlog format (big endian timestamp followed by the bytes).
+    /// Consumer thread only.
+    ///     @param maxBytes Stop once block has grown to this size
+    ///     @return Number of slots consumed
+    quint64 pop(QByteArray &block, qsizetype maxBytes);
+
+    /// Throws away all published records. Consumer thread only.
+    void discard();
+
+    /// @return Approximate number of slots in use
+    quint64 size() const { return _enqueuePos.load(std::memory_order_relaxed) - _dequeuePos.load(std::memory_order_relaxed); }
+    quint64 capacity() const { return _mask + 1; }
+
+    /// @return Number of records dropped since construction
+    quint64 droppedCount() const { return _droppedCount.load(std::memory_order_relaxed); }
+
+    static constexpr quint64 kDefaultSlotCount = 8192;
+    static constexpr qsizetype kSlotDataSize = MAVLINK_MAX_PACKET_LEN;
+
+private:
+    struct Slot {
+        std::atomic<quint64> sequence;      ///< Position this slot is free for, position + 1 once published
+        quint64 timestampUSecs = 0;
+        quint16 length = 0;
+        bool firstOfRecord = false;         ///< false: Continuation of the record in the previous slot
+        uint8_t data[kSlotDataSize];
+    };
+
+    /// Claims slotCount consecutive slots
+    ///     @return false: Not enough free slots
+    bool _reserve(quint64 slotCount, quint64 &pos);
+    void _publish(Slot &slot, quint64 pos) { slot.sequence.store(pos + 1, std::memory_order_release); }
+
+    const quint64 _mask;
+    std::unique_ptr<Slot[]> _slots;
+
+    alignas(64) std::atomic<quint64> _enqueuePos = 0;
+    alignas(64) std::atomic<quint64> _dequeuePos = 0;   ///< Only written by the consumer
+    alignas(64) std::atomic<quint64> _droppedCount = 0;
+};
@@ -0,0 +1,241 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TelemetryLogWriter.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+QGC_LOGGING_CATEGORY(TelemetryLogWriterLog, "qgc.comms.telemetrylogwriter")
+
+TelemetryLogWorker::TelemetryLogWorker(TelemetryLogQueue *queue, QObject *parent)
+    : QObject(parent)
+    , _queue(queue)
+    , _file(new QFile(this))
+{
+    // qCDebug(TelemetryLogWriterLog) << Q_FUNC_INFO << this;
+}
+
+TelemetryLogWorker::~TelemetryLogWorker()
+{
+    // qCDebug(TelemetryLogWriterLog) << Q_FUNC_INFO << this;
+}
+
+void TelemetryLogWorker::setup()
+{
+    _drainTimer = new QTimer(this);
+    (void) connect(_drainTimer, &QTimer::timeout, this, &TelemetryLogWorker::drain);
+    setMaxLatency(_maxLatencyMSecs);
+}
+
+void TelemetryLogWorker::setMaxLatency(int maxLatencyMSecs)
+{
+    _maxLatencyMSecs = qMax(kMinMaxLatencyMSecs, maxLatencyMSecs);
+
+    // Data waits at most one interval in the queue and, see drain, half the latency plus one interval in the block
+    if (_drainTimer) {
+        _drainTimer->start(_maxLatencyMSecs / 4);
+    }
+}
+
+bool TelemetryLogWorker::open(const QString &fileName)
+{
+    (void) close();
+
+    // Records left over from the previous file have no business in this one
+    _queue->discard();
+    _block.truncate(0);
+    _block.reserve(kBlockSize + TelemetryLogQueue::kSlotDataSize + sizeof(quint64));
+    _droppedCountAtOpen = _queue->droppedCount();
+    _reportedDroppedCount = _droppedCountAtOpen;
+    _failed = false;
+
+    _file->setFileName(fileName);
+    if (!_file->open(QIODevice::WriteOnly)) {
+        qCWarning(TelemetryLogWriterLog) << "Unable to open" << fileName << _file->errorString();
+        return false;
+    }
+
+    return true;
+}
+
+qint64 TelemetryLogWorker::close()
+{
+    if (!_file->isOpen()) {
+        return -1;
+    }
+
+    if (!_failed) {
+        while ((_queue->pop(_block, kBlockSize) > 0) || !_block.isEmpty()) {
+            if (!_writeBlock()) {
+                break;
+            }
+        }
+    }
+    _checkDropped();
+    _queue->discard();
+
+    const qint64 size = _file->size();
+    _file->close();
+
+    return size;
+}
+
+void TelemetryLogWorker::drain()
+{
+    _checkDropped();
+
+    if (!_file->isOpen() || _failed) {
+        _queue->discard();
+        return;
+    }
+
+    for (;;) {
+        const bool wasEmpty = _block.isEmpty();
+        if ((_queue->pop(_block, kBlockSize) > 0) && wasEmpty) {
+            _blockAge.start();
+        }
+        if (_block.size() < kBlockSize) {
+            break;
+        }
+        if (!_writeBlock()) {
+            return;
+        }
+    }
+
+    if (!_block.isEmpty() && _blockAge.hasExpired(_maxLatencyMSecs / 2)) {
+        (void) _writeBlock();
+    }
+}
+
+bool TelemetryLogWorker::_writeBlock()
+{
+    const bool written = (_file->write(_block) == _block.size()) && _file->flush();
+    _block.truncate(0);
+
+    if (!written) {
+        qCWarning(TelemetryLogWriterLog) << "Write failed" << _file->fileName() << _file->errorString();
+        _failed = true;
+        emit writeFailed(_file->errorString());
+    }
+
+    return written;
+}
+
+void TelemetryLogWorker::_checkDropped()
+{
+    const quint64 droppedCount = _queue->droppedCount();
+    if (droppedCount != _reportedDroppedCount) {
+        qCWarning(TelemetryLogWriterLog) << "Telemetry log fell behind, dropped" << (droppedCount - _reportedDroppedCount) << "records";
+        _reportedDroppedCount = droppedCount;
+        emit dataDropped(droppedCount - _droppedCountAtOpen);
+    }
+}
+
+/*===========================================================================*/
+
+TelemetryLogWriter::TelemetryLogWriter(QObject *parent)
+    : QObject(parent)
+    , _worker(new TelemetryLogWorker(&_queue))
+    , _workerThread(new QThread(this))
+{
+    // qCDebug(TelemetryLogWriterLog) << Q_FUNC_INFO << this;
+
+    _workerThread->setObjectName(QStringLiteral("TelemetryLog"));
+
+    _worker->moveToThread(_workerThread);
+
+    (void) connect(_workerThread, &QThread::started, _worker, &TelemetryLogWorker::setup);
+    (void) connect(_workerThread, &QThread::finished, _worker, &QObject::deleteLater);
+
+    (void) connect(_worker, &TelemetryLogWorker::writeFailed, this, [this](const QString &errorString) {
+        _open = false;
+        emit writeFailed(errorString);
+    }, Qt::QueuedConnection);
+    (void) connect(_worker, &TelemetryLogWorker::dataDropped, this, &TelemetryLogWriter::dataDropped, Qt::QueuedConnection);
+
+    _workerThread->start();
+}
+
+TelemetryLogWriter::~TelemetryLogWriter()
+{
+    (void) close();
+
+    _workerThread->quit();
+    if (!_workerThread->wait()) {
+        qCWarning(TelemetryLogWriterLog) << "Failed to wait for telemetry log thread to close";
+    }
+
+    // qCDebug(TelemetryLogWriterLog) << Q_FUNC_INFO << this;
+}
+
+bool TelemetryLogWriter::open(const QString &fileName)
+{
+    bool result = false;
+    (void) QMetaObject::invokeMethod(_worker, [this, &result, fileName]() {
+        result = _worker->open(fileName);
+    }, Qt::BlockingQueuedConnection);
+
+    _fileName = fileName;
+    _open = result;
+
+    return result;
+}
+
+qint64 TelemetryLogWriter::close()
+{
+    _open = false;
+
+    qint64 size = -1;
+    (void) QMetaObject::invokeMethod(_worker, [this, &size]() {
+        size = _worker->close();
+    }, Qt::BlockingQueuedConnection);
+
+    return size;
+}
+
+void TelemetryLogWriter::setMaxLatency(int maxLatencyMSecs)
+{
+    (void) QMetaObject::invokeMethod(_worker, [this, maxLatencyMSecs]() {
+        _worker->setMaxLatency(maxLatencyMSecs);
+    }, Qt::QueuedConnection);
+}
+
+void TelemetryLogWriter::logMessage(const mavlink_message_t &message)
+{
+    if (_open && _queue.push(_timestamp(), message)) {
+        _queued();
+    }
+}
+
+void TelemetryLogWriter::logBytes(QByteArrayView data)
+{
+    if (_open && _queue.push(_timestamp(), data)) {
+        _queued();
+    }
+}
+
+void TelemetryLogWriter::_queued()
+{
+    // Don't wait for the next timer tick once the queue starts to fill up
+    if ((_queue.size() >= (_queue.capacity() / 2)) && !_drainRequested.exchange(true)) {
+        (void) QMetaObject::invokeMethod(_worker, [this]() {
+            _drainRequested = false;
+            _worker->drain();
+        }, Qt::QueuedConnection);
+    }
+}
+
+quint64 TelemetryLogWriter::_timestamp()
+{
+    return static_cast<quint64>(QDateTime::currentMSecsSinceEpoch() * 1000);
+}
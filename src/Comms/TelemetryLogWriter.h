@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+#include <atomic>
+
+#include "MAVLinkLib.h"
+#include "TelemetryLogQueue.h"
+
+class QFile;
+class QThread;
+class QTimer;
+
+Q_DECLARE_LOGGING_CATEGORY(TelemetryLogWriterLog)
+
+/// Lives on the telemetry log thread and moves queued records to disk in large blocks
+class TelemetryLogWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TelemetryLogWorker(TelemetryLogQueue *queue, QObject *parent = nullptr);
+    ~TelemetryLogWorker();
+
+    bool open(const QString &fileName);
+
+    /// Writes out everything still queued and closes the file
+    ///     @return Size of the closed file, -1 if no file was open
+    qint64 close();
+
+    void setMaxLatency(int maxLatencyMSecs);
+
+    static constexpr int kDefaultMaxLatencyMSecs = 1000;
+    static constexpr int kMinMaxLatencyMSecs = 40;
+    static constexpr qsizetype kBlockSize = 64 * 1024;  ///< Data is written in blocks of this size unless the latency runs out first
+
+public slots:
+    void setup();
+    void drain();
+
+signals:
+    void writeFailed(const QString &errorString);
+    /// @param droppedCount Total number of records dropped since the file was opened
+    void dataDropped(quint64 droppedCount);
+
+private:
+    bool _writeBlock();
+    void _checkDropped();
+
+    TelemetryLogQueue *const _queue = nullptr;
+    QFile *_file = nullptr;
+    QTimer *_drainTimer = nullptr;
+    QByteArray _block;
+    QElapsedTimer _blockAge;            ///< Time since the oldest unwritten data entered the block
+    int _maxLatencyMSecs = kDefaultMaxLatencyMSecs;
+    quint64 _droppedCountAtOpen = 0;
+    quint64 _reportedDroppedCount = 0;
+    bool _failed = false;
+};
+
+/*===========================================================================*/
+
+/// Writes the telemetry log (tlog) on a dedicated thread.
+/// Records are timestamped and copied into a lock-free queue by the caller, so logging never waits on the disk.
+/// Data is written in large blocks, but never sits in memory for longer than the maximum latency.
+/// If the disk cannot keep up the queue overflows, records are dropped and dataDropped is signalled.
+class TelemetryLogWriter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TelemetryLogWriter(QObject *parent = nullptr);
+    ~TelemetryLogWriter();
+
+    /// Opens a new log file, waits for the log thread
+    bool open(const QString &fileName);
+
+    /// Writes out everything logged so far and closes the file, waits for the log thread
+    ///     @return Size of the closed file, -1 if no file was open
+    qint64 close();
+
+    bool isOpen() const { return _open; }
+    QString fileName() const { return _fileName; }
+
+    /// Maximum time logged data may stay in memory before it is written to the file
+    void setMaxLatency(int maxLatencyMSecs);
+
+    /// Thread safe
+    void logMessage(const mavlink_message_t &message);
+
+    /// Thread safe
+    void logBytes(QByteArrayView data);
+
+signals:
+    void writeFailed(const QString &errorString);
+
+    /// The log thread fell behind and records had to be dropped
+    ///     @param droppedCount Total number of records dropped since the file was opened
+    void dataDropped(quint64 droppedCount);
+
+private:
+    void _queued();
+    static quint64 _timestamp();
+
+    TelemetryLogQueue _queue;
+    TelemetryLogWorker *_worker = nullptr;
+    QThread *_workerThread = nullptr;
+    QString _fileName;
+    std::atomic_bool _open = false;
+    std::atomic_bool _drainRequested = false;
+};
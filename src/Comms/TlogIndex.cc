@@ -0,0 +1,300 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TlogIndex.h"
+#include "MAVLinkLib.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDateTime>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtEndian>
+
+#include <algorithm>
+
+QGC_LOGGING_CATEGORY(TlogIndexLog, "qgc.comms.tlogindex")
+
+namespace
+{
+
+constexpr qsizetype kV1HeaderLen = MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1;    ///< Includes STX
+constexpr qsizetype kV2HeaderLen = MAVLINK_CORE_HEADER_LEN + 1;             ///< Includes STX
+
+/// Sidecar file layout: Header followed by the entries, both in native byte order
+struct Header {
+    quint32 magic = 0;
+    quint32 version = 0;
+    quint64 logSize = 0;
+    qint64 logModifiedMSecs = 0;
+    quint64 entryCount = 0;
+};
+static_assert((sizeof(Header) % alignof(TlogIndex::Entry)) == 0);
+static_assert(sizeof(TlogIndex::Entry) == 16);
+
+constexpr quint32 kMagic = 0x51544958; // "QTIX"
+constexpr quint32 kVersion = 1;
+
+bool _isStx(uint8_t byte)
+{
+    return (byte == MAVLINK_STX) || (byte == MAVLINK_STX_MAVLINK1);
+}
+
+/// @return Length of the frame starting with the start-of-frame marker at data
+qsizetype _frameLength(const uint8_t *data)
+{
+    if (data[0] == MAVLINK_STX_MAVLINK1) {
+        return (kV1HeaderLen + data[1] + MAVLINK_NUM_CHECKSUM_BYTES);
+    }
+
+    const qsizetype signatureLen = (data[2] & MAVLINK_IFLAG_SIGNED) ? MAVLINK_SIGNATURE_BLOCK_LEN : 0;
+    return (kV2HeaderLen + data[1] + MAVLINK_NUM_CHECKSUM_BYTES + signatureLen);
+}
+
+} // namespace
+
+TlogIndex::TlogIndex()
+{
+    // qCDebug(TlogIndexLog) << Q_FUNC_INFO << this;
+}
+
+TlogIndex::~TlogIndex()
+{
+    clear();
+
+    // qCDebug(TlogIndexLog) << Q_FUNC_INFO << this;
+}
+
+void TlogIndex::clear()
+{
+    _view = {};
+    _entries.clear();
+    _entries.shrink_to_fit();
+    if (_indexFile.isOpen()) {
+        _indexFile.close();
+    }
+}
+
+void TlogIndex::open(const QString &logFilename, QByteArrayView logData)
+{
+    const QFileInfo logInfo(logFilename);
+    const QString sidecar = indexFilename(logFilename);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (load(sidecar, logInfo)) {
+        qCDebug(TlogIndexLog) << "Loaded" << count() << "entries from" << sidecar << "in" << timer.elapsed() << "ms";
+        return;
+    }
+
+    build(logData);
+    qCDebug(TlogIndexLog) << "Indexed" << count() << "messages of" << logFilename << "in" << timer.elapsed() << "ms";
+
+    if (!isEmpty() && !save(sidecar, logInfo)) {
+        qCDebug(TlogIndexLog) << "Unable to save index" << sidecar;
+    }
+}
+
+void TlogIndex::build(QByteArrayView logData)
+{
+    clear();
+
+    const uint8_t *const data = reinterpret_cast<const uint8_t*>(logData.data());
+    const qsizetype size = logData.size();
+    const quint64 nowUSecs = static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()) * 1000;
+
+    // Typical records are a little over 40 bytes, reserving for that avoids most reallocations of large logs
+    _entries.reserve(static_cast<size_t>(size / 48));
+
+    quint64 lastTimestampUSecs = 0;
+    qsizetype pos = 0;
+    while ((pos + kTimestampLen) < size) {
+        uint32_t msgid = 0;
+        const qsizetype frameLen = _validFrameLength(data + pos + kTimestampLen, size - pos - kTimestampLen, msgid);
+        if (frameLen == 0) {
+            // Not a record boundary, resync one byte further on
+            pos++;
+            continue;
+        }
+
+        const quint64 timestampUSecs = parseTimestamp(logData.data() + pos, nowUSecs);
+        lastTimestampUSecs = qMax(lastTimestampUSecs, timestampUSecs);
+
+        Entry &entry = _entries.emplace_back();
+        entry.timestampUSecs = lastTimestampUSecs;
+        entry.packed = (static_cast<quint64>(pos) & kOffsetMask) | (static_cast<quint64>(msgid) << kOffsetBits);
+
+        pos += kTimestampLen + frameLen;
+    }
+
+    _view = std::span<const Entry>(_entries);
+}
+
+bool TlogIndex::load(const QString &indexFilename, const QFileInfo &logInfo)
+{
+    clear();
+
+    _indexFile.setFileName(indexFilename);
+    if (!_indexFile.exists() || !_indexFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 fileSize = _indexFile.size();
+    Header header;
+    if ((fileSize < static_cast<qint64>(sizeof(header))) || (_indexFile.read(reinterpret_cast<char*>(&header), sizeof(header)) != sizeof(header))) {
+        _indexFile.close();
+        return false;
+    }
+
+    const bool current = (header.magic == kMagic)
+        && (header.version == kVersion)
+        && (header.logSize == static_cast<quint64>(logInfo.size()))
+        && (header.logModifiedMSecs == logInfo.lastModified().toMSecsSinceEpoch())
+        && (static_cast<quint64>(fileSize) == (sizeof(header) + (header.entryCount * sizeof(Entry))));
+    if (!current) {
+        qCDebug(TlogIndexLog) << "Stale index" << indexFilename;
+        _indexFile.close();
+        return false;
+    }
+
+    if (header.entryCount == 0) {
+        _indexFile.close();
+        return false;
+    }
+
+    const uchar *const mapped = _indexFile.map(sizeof(header), fileSize - sizeof(header));
+    if (!mapped) {
+        qCWarning(TlogIndexLog) << "Unable to map index" << indexFilename << _indexFile.errorString();
+        _indexFile.close();
+        return false;
+    }
+
+    _view = std::span<const Entry>(reinterpret_cast<const Entry*>(mapped), static_cast<size_t>(header.entryCount));
+
+    // The sidecar may have been damaged or replaced independently of the log, every record must lie inside it in order
+    quint64 lastOffset = 0;
+    quint64 lastTimestampUSecs = 0;
+    for (const Entry &entry : _view) {
+        if ((entry.offset() < lastOffset) || (entry.timestampUSecs < lastTimestampUSecs) || ((entry.offset() + kTimestampLen + kV1HeaderLen) > header.logSize)) {
+            qCWarning(TlogIndexLog) << "Corrupt index" << indexFilename;
+            clear();
+            return false;
+        }
+        lastOffset = entry.offset() + kTimestampLen;
+        lastTimestampUSecs = entry.timestampUSecs;
+    }
+
+    return true;
+}
+
+bool TlogIndex::save(const QString &indexFilename, const QFileInfo &logInfo) const
+{
+    QSaveFile file(indexFilename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    Header header;
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.logSize = static_cast<quint64>(logInfo.size());
+    header.logModifiedMSecs = logInfo.lastModified().toMSecsSinceEpoch();
+    header.entryCount = _view.size();
+
+    const qint64 entriesSize = static_cast<qint64>(_view.size_bytes());
+    if ((file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != sizeof(header))
+            || (file.write(reinterpret_cast<const char*>(_view.data()), entriesSize) != entriesSize)) {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+qsizetype TlogIndex::seek(quint64 timestampUSecs) const
+{
+    const auto it = std::lower_bound(_view.begin(), _view.end(), timestampUSecs, [](const Entry &entry, quint64 value) {
+        return (entry.timestampUSecs < value);
+    });
+
+    return static_cast<qsizetype>(it - _view.begin());
+}
+
+QByteArrayView TlogIndex::frame(QByteArrayView logData, const Entry &entry)
+{
+    const qsizetype start = static_cast<qsizetype>(entry.offset()) + kTimestampLen;
+    if ((start + kV1HeaderLen) > logData.size()) {
+        return QByteArrayView();
+    }
+
+    const uint8_t *const data = reinterpret_cast<const uint8_t*>(logData.data()) + start;
+    if (!_isStx(data[0])) {
+        return QByteArrayView();
+    }
+
+    const qsizetype frameLen = _frameLength(data);
+    if ((start + frameLen) > logData.size()) {
+        return QByteArrayView();
+    }
+
+    return logData.sliced(start, frameLen);
+}
+
+quint64 TlogIndex::parseTimestamp(const char *data, quint64 nowUSecs)
+{
+    quint64 timestamp = qFromBigEndian<quint64>(data);
+    if (timestamp > nowUSecs) {
+        timestamp = qbswap(timestamp);
+    }
+
+    return timestamp;
+}
+
+qsizetype TlogIndex::_validFrameLength(const uint8_t *data, qsizetype size, uint32_t &msgid)
+{
+    if (!_isStx(data[0])) {
+        return 0;
+    }
+
+    const bool mavlink1 = (data[0] == MAVLINK_STX_MAVLINK1);
+
+    const qsizetype headerLen = mavlink1 ? kV1HeaderLen : kV2HeaderLen;
+    if (size < headerLen) {
+        return 0;
+    }
+
+    // Unknown incompatibility flags can't be parsed
+    if (!mavlink1 && ((data[2] & ~MAVLINK_IFLAG_SIGNED) != 0)) {
+        return 0;
+    }
+
+    const qsizetype frameLen = _frameLength(data);
+    if (size < frameLen) {
+        return 0;
+    }
+
+    msgid = mavlink1 ? data[5] : (data[7] | (data[8] << 8) | (static_cast<uint32_t>(data[9]) << 16));
+    const mavlink_msg_entry_t *const msgEntry = mavlink_get_msg_entry(msgid);
+    if (!msgEntry) {
+        // Messages of other dialects can't be CRC checked, they are kept if the next record starts right after them
+        const qsizetype nextFrame = frameLen + kTimestampLen;
+        return ((size == frameLen) || ((size > nextFrame) && _isStx(data[nextFrame]))) ? frameLen : 0;
+    }
+
+    const uint8_t payloadLen = data[1];
+    uint16_t checksum = crc_calculate(data + 1, static_cast<uint16_t>(headerLen - 1 + payloadLen));
+    crc_accumulate(msgEntry->crc_extra, &checksum);
+    const uint8_t *const ck = data + headerLen + payloadLen;
+    if ((ck[0] != (checksum & 0xFF)) || (ck[1] != (checksum >> 8))) {
+        return 0;
+    }
+
+    return frameLen;
+}
@@ -0,0 +1,93 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArrayView>
+#include <QtCore/QFile>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+
+#include <span>
+#include <vector>
+
+class QFileInfo;
+
+Q_DECLARE_LOGGING_CATEGORY(TlogIndexLog)
+
+/// Index of the records in a telemetry log (tlog), one entry per MAVLink message.
+///
+/// The log is indexed in a single pass over its (memory mapped) contents and the index is kept in a sidecar
+/// file next to the log, so opening the same log again only maps the sidecar. Seeking to a log time is a
+/// binary search. Timestamps are clamped to be non-decreasing, a clock which jumps backwards in the log simply
+/// replays those messages without delay.
+class TlogIndex
+{
+    Q_DISABLE_COPY(TlogIndex)
+
+public:
+    struct Entry {
+        quint64 timestampUSecs = 0;
+        quint64 packed = 0;         ///< File offset of the record in the low 40 bits, message id in the high 24
+
+        quint64 offset() const { return (packed & kOffsetMask); }
+        uint32_t msgid() const { return static_cast<uint32_t>(packed >> kOffsetBits); }
+    };
+
+    TlogIndex();
+    ~TlogIndex();
+
+    /// Loads the sidecar index of the log if it is still current, otherwise indexes logData and saves the sidecar.
+    /// Failing to save the sidecar (read only location) is not an error.
+    ///     @param logData Contents of logFilename
+    void open(const QString &logFilename, QByteArrayView logData);
+
+    /// Indexes logData without touching the disk. Messages of unknown dialects can't be CRC checked, they are
+    /// indexed when the next record follows right after them.
+    void build(QByteArrayView logData);
+
+    /// @return false: Sidecar missing, stale, unreadable or its entries don't fit the log
+    bool load(const QString &indexFilename, const QFileInfo &logInfo);
+    bool save(const QString &indexFilename, const QFileInfo &logInfo) const;
+
+    void clear();
+
+    /// @return true: The entries came from the sidecar file
+    bool isLoaded() const { return _indexFile.isOpen(); }
+    bool isEmpty() const { return _view.empty(); }
+    qsizetype count() const { return static_cast<qsizetype>(_view.size()); }
+    const Entry &at(qsizetype i) const { return _view[static_cast<size_t>(i)]; }
+
+    quint64 startTimeUSecs() const { return (isEmpty() ? 0 : _view.front().timestampUSecs); }
+    quint64 endTimeUSecs() const { return (isEmpty() ? 0 : _view.back().timestampUSecs); }
+
+    /// @return Index of the first entry at or after timestampUSecs, count() if there is none
+    qsizetype seek(quint64 timestampUSecs) const;
+
+    /// @return The MAVLink frame of the entry, without its timestamp. Empty if the entry doesn't fit logData.
+    static QByteArrayView frame(QByteArrayView logData, const Entry &entry);
+
+    /// Records are written big endian, but some older logs have them little endian
+    ///     @param nowUSecs Timestamps later than this are byte swapped
+    static quint64 parseTimestamp(const char *data, quint64 nowUSecs);
+
+    static QString indexFilename(const QString &logFilename) { return (logFilename + QStringLiteral(".idx")); }
+
+    static constexpr qsizetype kTimestampLen = sizeof(quint64);
+    static constexpr int kOffsetBits = 40;
+    static constexpr quint64 kOffsetMask = (Q_UINT64_C(1) << kOffsetBits) - 1;
+
+private:
+    /// @return Length of the valid MAVLink frame at data, 0 if there is none
+    static qsizetype _validFrameLength(const uint8_t *data, qsizetype size, uint32_t &msgid);
+
+    std::vector<Entry> _entries;
+    QFile _indexFile;
+    std::span<const Entry> _view;   ///< Either _entries or the mapped sidecar
+};
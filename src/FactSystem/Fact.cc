@@ -13,6 +13,9 @@
 #include "QGCCorePlugin.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QMetaMethod>
+#include <QtCore/QtNumeric>
+
 QGC_LOGGING_CATEGORY(FactLog, "qgc.factsystem.fact")
 
 Fact::Fact(QObject *parent)
@@ -78,12 +81,14 @@ const Fact &Fact::operator=(const Fact& other)
 {
     _name = other._name;
     _componentId = other._componentId;
-    _rawValue = other._rawValue;
+    _clearUnboxedRawValue();
+    _rawValue = other.rawValue();
     _type = other._type;
     _sendValueChangedSignals = other._sendValueChangedSignals;
     _deferredValueChangeSignal = other._deferredValueChangeSignal;
     _valueSliderModel = nullptr;
     if (_metaData && other._metaData) {
+        _detachSharedMetaData();
         *_metaData = *other._metaData;
     } else {
         _metaData = nullptr;
@@ -99,6 +104,7 @@ void Fact::forceSetRawValue(const QVariant &value)
         QString errorString;
 
         if (_metaData->convertAndValidateRaw(value, true /* convertOnly */, typedValue, errorString)) {
+            _clearUnboxedRawValue();
             _rawValue.setValue(typedValue);
             _sendValueChangedSignal(cookedValue());
             //-- Must be in this order
@@ -117,6 +123,7 @@ void Fact::setRawValue(const QVariant &value)
         QString errorString;
 
         if (_metaData->convertAndValidateRaw(value, true /* convertOnly */, typedValue, errorString)) {
+            _clearUnboxedRawValue();
             if (typedValue != _rawValue) {
                 _rawValue.setValue(typedValue);
                 _sendValueChangedSignal(cookedValue());
@@ -130,6 +137,118 @@ void Fact::setRawValue(const QVariant &value)
     }
 }
 
+bool Fact::_typeIsFloatingPoint() const
+{
+    return ((_type == FactMetaData::valueTypeFloat) || (_type == FactMetaData::valueTypeDouble) || (_type == FactMetaData::valueTypeElapsedTimeInSeconds));
+}
+
+void Fact::setRawDouble(double value)
+{
+    if (!_metaData || !_typeIsFloatingPoint()) {
+        setRawValue(value);
+        return;
+    }
+
+    if (_type == FactMetaData::valueTypeFloat) {
+        // Match the precision setRawValue would store
+        value = static_cast<float>(value);
+    }
+
+    const double currentValue = (_unboxedRawType == UnboxedRawDouble) ? _unboxedRawDouble : _rawValue.toDouble();
+    if ((currentValue == value) || (qIsNaN(currentValue) && qIsNaN(value))) {
+        return;
+    }
+
+    _unboxedRawDouble = value;
+    _unboxedRawType = UnboxedRawDouble;
+    _unboxedRawValueChanged();
+}
+
+void Fact::setRawInt(qint64 value)
+{
+    if (_metaData && _typeIsFloatingPoint()) {
+        setRawDouble(static_cast<double>(value));
+        return;
+    }
+
+    switch (_type) {
+    case FactMetaData::valueTypeInt8:
+    case FactMetaData::valueTypeInt16:
+    case FactMetaData::valueTypeInt32:
+    case FactMetaData::valueTypeInt64:
+    case FactMetaData::valueTypeUint8:
+    case FactMetaData::valueTypeUint16:
+    case FactMetaData::valueTypeUint32:
+        if (_metaData) {
+            break;
+        }
+        Q_FALLTHROUGH();
+    default:
+        setRawValue(value);
+        return;
+    }
+
+    const qint64 currentValue = (_unboxedRawType == UnboxedRawInt) ? _unboxedRawInt : _rawValue.toLongLong();
+    if (currentValue == value) {
+        return;
+    }
+
+    _unboxedRawInt = value;
+    _unboxedRawType = UnboxedRawInt;
+    _unboxedRawValueChanged();
+}
+
+void Fact::_unboxedRawValueChanged()
+{
+    static const QMetaMethod valueChangedSignal = QMetaMethod::fromSignal(&Fact::valueChanged);
+    static const QMetaMethod rawValueChangedSignal = QMetaMethod::fromSignal(&Fact::rawValueChanged);
+
+    _rawValueStale = true;
+
+    // Only box and cook the value if someone is listening right now
+    if (_sendValueChangedSignals) {
+        _deferredValueChangeSignal = false;
+        if (isSignalConnected(valueChangedSignal)) {
+            emit valueChanged(cookedValue());
+        }
+    } else {
+        _deferredValueChangeSignal = true;
+    }
+    if (isSignalConnected(rawValueChangedSignal)) {
+        emit rawValueChanged(rawValue());
+    }
+}
+
+void Fact::_boxUnboxedRawValue() const
+{
+    _rawValueStale = false;
+
+    switch (_type) {
+    case FactMetaData::valueTypeFloat:
+        _rawValue = QVariant(static_cast<float>(_unboxedRawDouble));
+        break;
+    case FactMetaData::valueTypeDouble:
+    case FactMetaData::valueTypeElapsedTimeInSeconds:
+        _rawValue = QVariant(_unboxedRawDouble);
+        break;
+    case FactMetaData::valueTypeInt8:
+    case FactMetaData::valueTypeInt16:
+    case FactMetaData::valueTypeInt32:
+        _rawValue = QVariant(static_cast<int>(_unboxedRawInt));
+        break;
+    case FactMetaData::valueTypeInt64:
+        _rawValue = QVariant(static_cast<qlonglong>(_unboxedRawInt));
+        break;
+    case FactMetaData::valueTypeUint8:
+    case FactMetaData::valueTypeUint16:
+    case FactMetaData::valueTypeUint32:
+        _rawValue = QVariant(static_cast<uint>(_unboxedRawInt));
+        break;
+    default:
+        break;
+    }
+}
+
 void Fact::setCookedValue(const QVariant& value)
 {
     if (_metaData) {
@@ -167,6 +286,7 @@ void Fact::setEnumIndex(int index)
 
 void Fact::containerSetRawValue(const QVariant &value)
 {
+    _clearUnboxedRawValue();
     if (_rawValue != value) {
         _rawValue = value;
         _sendValueChangedSignal(cookedValue());
@@ -180,10 +300,10 @@ void Fact::containerSetRawValue(const QVariant &value)
 QVariant Fact::cookedValue() const
 {
     if (_metaData) {
-        return _metaData->rawTranslator()(_rawValue);
+        return _metaData->rawTranslator()(rawValue());
     } else {
         qCWarning(FactLog) << kMissingMetadata << name();
-        return _rawValue;
+        return rawValue();
     }
 }
 
@@ -222,6 +342,7 @@ int Fact::enumIndex()
                 index++;
             }
             // Current value is not in list, add it manually
+            _detachSharedMetaData();
             _metaData->addEnumInfo(tr("Unknown: %1").arg(rawValue().toString()), rawValue());
             emit enumsChanged();
             return index;
@@ -255,6 +376,7 @@ QVariantList Fact::enumValues() const
 void Fact::setEnumInfo(const QStringList &strings, const QVariantList &values)
 {
     if (_metaData) {
+        _detachSharedMetaData();
         _metaData->setEnumInfo(strings, values);
         emit enumsChanged();
     } else {
@@ -553,6 +675,13 @@ void Fact::setMetaData(FactMetaData *metaData, bool setDefaultFromMetaData)
     emit valueChanged(cookedValue());
 }
 
+void Fact::_detachSharedMetaData()
+{
+    if (_metaData && _metaData->isShared()) {
+        _metaData = new FactMetaData(*_metaData, this);
+    }
+}
+
 bool Fact::valueEqualsDefault() const
 {
     if (_metaData) {
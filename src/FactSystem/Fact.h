@@ -82,7 +82,7 @@ class Fact : public QObject
     /// Convert and clamp value
     Q_INVOKABLE QVariant clamp(const QString &cookedValue);
     QVariant cookedValue() const; /// Value after translation
-    QVariant rawValue() const { return _rawValue; }  /// value prior to translation, careful
+    QVariant rawValue() const { _boxRawValue(); return _rawValue; }  /// value prior to translation, careful
     int componentId() const { return _componentId; }
     int decimalPlaces() const;
     QVariant rawDefaultValue() const;
@@ -135,6 +135,13 @@ class Fact : public QObject
 
     void setRawValue(const QVariant &value);
     void setCookedValue(const QVariant &value);
+
+    /// Typed fast path for trusted telemetry values. Meta data validation is skipped and the value is stored unboxed,
+    /// conversion to QVariant only happens once the value is read or the deferred valueChanged signal is sent.
+    /// containerRawValueChanged is not signalled since telemetry values are never sent back to the vehicle. Facts whose
+    /// type does not match fall back to setRawValue.
+    void setRawDouble(double value);
+    void setRawInt(qint64 value);
     void setEnumIndex(int index);
     void setEnumStringValue(const QString &value);
     int valueIndex(const QString &value) const;
@@ -186,9 +193,16 @@ class Fact : public QObject
     QString _variantToString(const QVariant &variant, int decimalPlaces) const;
     void _sendValueChangedSignal(const QVariant &value);
 
+    /// Shared meta data is immutable, switch to a private copy before changing it
+    void _detachSharedMetaData();
+
+    /// Makes _rawValue up to date with a value set through setRawDouble/setRawInt
+    void _boxRawValue() const { if (_rawValueStale) { _boxUnboxedRawValue(); } }
+    void _clearUnboxedRawValue() { _boxRawValue(); _unboxedRawType = UnboxedRawNone; }
+
     QString _name;
     int _componentId = -1;
-    QVariant _rawValue = 0;
+    mutable QVariant _rawValue = 0;
     FactMetaData::ValueType_t _type = FactMetaData::valueTypeInt32;
     FactMetaData *_metaData = nullptr;
     bool _sendValueChangedSignals = true;
@@ -202,4 +216,18 @@ private slots:
 
 private:
     void _init();
+    void _boxUnboxedRawValue() const;
+    void _unboxedRawValueChanged();
+    bool _typeIsFloatingPoint() const;
+
+    enum UnboxedRawType_t : quint8 {
+        UnboxedRawNone,     ///< _rawValue holds the current value
+        UnboxedRawDouble,   ///< _unboxedRawDouble holds the current value
+        UnboxedRawInt,      ///< _unboxedRawInt holds the current value
+    };
+
+    UnboxedRawType_t _unboxedRawType = UnboxedRawNone;
+    mutable bool _rawValueStale = false;    ///< true: _rawValue needs to be updated from the unboxed value
+    double _unboxedRawDouble = 0;
+    qint64 _unboxedRawInt = 0;
 };
@@ -19,7 +19,8 @@ FactGroup::FactGroup(int updateRateMsecs, const QString &metaDataFile, QObject *
 {
     // qCDebug(FactGroupLog) << Q_FUNC_INFO << this;
     _setupTimer();
-    _nameToFactMetaDataMap = FactMetaData::createMapFromJsonFile(metaDataFile, this);
+    // Meta data is shared by all instances of a FactGroup, see FactMetaData::sharedMapFromJsonFile
+    _nameToFactMetaDataMap = FactMetaData::sharedMapFromJsonFile(metaDataFile);
 }
 
 FactGroup::FactGroup(int updateRateMsecs, QObject *parent, bool ignoreCamelCase)
@@ -148,6 +149,12 @@ void FactGroup::_addFactGroup(FactGroup *factGroup, const QString &name)
     emit factGroupNamesChanged();
 }
 
+void FactGroup::_setHandledMessageIds(const QList<uint32_t> &msgids)
+{
+    _handledMessageIds = msgids;
+    _handlesAllMessages = false;
+}
+
 void FactGroup::_updateAllValues()
 {
     for (Fact *fact: _nameToFactMap) {
@@ -11,6 +11,7 @@
 
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QJsonArray>
+#include <QtCore/QList>
 #include <QtCore/QMap>
 #include <QtCore/QStringList>
 #include <QtCore/QTimer>
@@ -57,6 +58,11 @@ class FactGroup : public QObject
     /// Allows a FactGroup to parse incoming messages and fill in values
     virtual void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) {}
 
+    /// @return true: handleMessage wants to see messages with this id
+    bool handlesMessage(uint32_t msgid) const { return _handlesAllMessages || _handledMessageIds.contains(msgid); }
+    bool handlesAllMessages() const { return _handlesAllMessages; }
+    const QList<uint32_t> &handledMessageIds() const { return _handledMessageIds; }
+
 signals:
     void factNamesChanged();
     void factGroupNamesChanged();
@@ -73,6 +79,10 @@ protected slots:
     void _loadFromJsonArray(const QJsonArray &jsonArray);
     void _setTelemetryAvailable(bool telemetryAvailable);
 
+    /// Registers the message ids consumed by handleMessage so Vehicle only routes those to this group.
+    /// FactGroups which never call this are given every message.
+    void _setHandledMessageIds(const QList<uint32_t> &msgids);
+
     const int _updateRateMSecs = 0;   ///< Update rate for Fact::valueChanged signals, 0: immediate update
 
     QMap<QString, Fact*> _nameToFactMap;
@@ -87,4 +97,6 @@ protected slots:
     QTimer _updateTimer;
     const bool _ignoreCamelCase = false;
     bool _telemetryAvailable = false;
+    bool _handlesAllMessages = true;
+    QList<uint32_t> _handledMessageIds;
 };
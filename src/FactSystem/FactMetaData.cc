@@ -14,6 +14,9 @@
 #include "SettingsManager.h"
 #include "UnitsSettings.h"
 
+#include <QtCore/QDataStream>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
 #include <QtCore/QtMath>
 
 QGC_LOGGING_CATEGORY(FactMetaDataLog, "qgc.factsystem.factmetadata")
@@ -124,6 +127,36 @@ const FactMetaData &FactMetaData::operator=(const FactMetaData &other)
     return *this;
 }
 
+bool FactMetaData::operator==(const FactMetaData &other) const
+{
+    return ((_type == other._type) &&
+            (_decimalPlaces == other._decimalPlaces) &&
+            (_rawDefaultValue == other._rawDefaultValue) &&
+            (_defaultValueAvailable == other._defaultValueAvailable) &&
+            (_bitmaskStrings == other._bitmaskStrings) &&
+            (_bitmaskValues == other._bitmaskValues) &&
+            (_enumStrings == other._enumStrings) &&
+            (_enumValues == other._enumValues) &&
+            (_category == other._category) &&
+            (_group == other._group) &&
+            (_longDescription == other._longDescription) &&
+            (_rawMax == other._rawMax) &&
+            (_rawMin == other._rawMin) &&
+            (_name == other._name) &&
+            (_shortDescription == other._shortDescription) &&
+            (_rawUnits == other._rawUnits) &&
+            (_cookedUnits == other._cookedUnits) &&
+            (_rawTranslator == other._rawTranslator) &&
+            (_cookedTranslator == other._cookedTranslator) &&
+            (_vehicleRebootRequired == other._vehicleRebootRequired) &&
+            (_qgcRebootRequired == other._qgcRebootRequired) &&
+            ((_rawIncrement == other._rawIncrement) || (qIsNaN(_rawIncrement) && qIsNaN(other._rawIncrement))) &&
+            (_hasControl == other._hasControl) &&
+            (_readOnly == other._readOnly) &&
+            (_writeOnly == other._writeOnly) &&
+            (_volatile == other._volatile));
+}
+
 QVariant FactMetaData::rawDefaultValue() const
 {
     if (_defaultValueAvailable) {
@@ -1363,6 +1396,96 @@ QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonFile(const QString &
     return createMapFromJsonArray(factArray, defineMap, metaDataParent);
 }
 
+FactMetaData::NameToMetaDataMap_t FactMetaData::sharedMapFromJsonFile(const QString &jsonFilename)
+{
+    static QMutex registryMutex;
+    static QHash<QString, NameToMetaDataMap_t> registry;
+
+    const QMutexLocker locker(&registryMutex);
+
+    const auto it = registry.constFind(jsonFilename);
+    if (it != registry.constEnd()) {
+        return it.value();
+    }
+
+    // Shared meta data lives for the lifetime of the process, so it has no parent
+    const NameToMetaDataMap_t metaDataMap = createMapFromJsonFile(jsonFilename, nullptr /* metaDataParent */);
+    for (FactMetaData *const metaData: metaDataMap) {
+        metaData->_shared = true;
+    }
+    (void) registry.insert(jsonFilename, metaDataMap);
+    qCDebug(FactMetaDataLog) << "Loaded shared meta data" << jsonFilename << metaDataMap.count();
+
+    return metaDataMap;
+}
+
+QByteArray FactMetaData::toSnapshotRecord() const
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    // Loaders which set the units before adding enum values end up with a unit translator even though the
+    // value is an enum. Keep track of that so the translator can be rebuilt the same way.
+    const bool hasEnum = !_enumStrings.isEmpty() || !_bitmaskStrings.isEmpty();
+    const bool enumTranslated = hasEnum && ((_rawTranslator != &_defaultTranslator) || (_cookedUnits != _rawUnits));
+
+    stream << static_cast<qint32>(_type) << _name << _category << _group << _shortDescription << _longDescription << _rawUnits
+           << _rawMin << _rawMax << _defaultValueAvailable << _rawDefaultValue << static_cast<qint32>(_decimalPlaces) << _rawIncrement
+           << _enumStrings << _enumValues << _bitmaskStrings << _bitmaskValues
+           << _vehicleRebootRequired << _qgcRebootRequired << _hasControl << _readOnly << _writeOnly << _volatile
+           << enumTranslated;
+
+    return record;
+}
+
+FactMetaData *FactMetaData::createFromSnapshotRecord(const QByteArray &record, QObject *metaDataParent)
+{
+    QDataStream stream(record);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    qint32 type = 0;
+    qint32 decimalPlaces = kUnknownDecimalPlaces;
+    QString rawUnits;
+    bool enumTranslated = false;
+
+    stream >> type;
+    if ((type < valueTypeUint8) || (type > valueTypeCustom)) {
+        qCWarning(FactMetaDataLog) << "Snapshot record has invalid type" << type;
+        return nullptr;
+    }
+
+    FactMetaData *const metaData = new FactMetaData(static_cast<ValueType_t>(type), metaDataParent);
+
+    // Values were validated when the record was written, so they are restored without going through the setters
+    stream >> metaData->_name >> metaData->_category >> metaData->_group >> metaData->_shortDescription >> metaData->_longDescription >> rawUnits
+           >> metaData->_rawMin >> metaData->_rawMax >> metaData->_defaultValueAvailable >> metaData->_rawDefaultValue >> decimalPlaces >> metaData->_rawIncrement
+           >> metaData->_enumStrings >> metaData->_enumValues >> metaData->_bitmaskStrings >> metaData->_bitmaskValues
+           >> metaData->_vehicleRebootRequired >> metaData->_qgcRebootRequired >> metaData->_hasControl >> metaData->_readOnly >> metaData->_writeOnly >> metaData->_volatile
+           >> enumTranslated;
+
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(FactMetaDataLog) << "Snapshot record is truncated" << metaData->_name;
+        delete metaData;
+        return nullptr;
+    }
+
+    metaData->_decimalPlaces = decimalPlaces;
+
+    // Translators depend on the current unit settings so they are rebuilt rather than stored
+    if (enumTranslated) {
+        const QStringList enumStrings = std::exchange(metaData->_enumStrings, QStringList());
+        const QStringList bitmaskStrings = std::exchange(metaData->_bitmaskStrings, QStringList());
+        metaData->setRawUnits(rawUnits);
+        metaData->_enumStrings = enumStrings;
+        metaData->_bitmaskStrings = bitmaskStrings;
+    } else {
+        metaData->setRawUnits(rawUnits);
+    }
+
+    return metaData;
+}
+
 QMap<QString, FactMetaData*> FactMetaData::createMapFromJsonArray(const QJsonArray &jsonArray, const QMap<QString, QString> &defineMap, QObject *metaDataParent)
 {
     QMap<QString, FactMetaData*> metaDataMap;
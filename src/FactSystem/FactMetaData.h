@@ -65,7 +65,25 @@ class FactMetaData : public QObject
 
     static FactMetaData *createFromJsonObject(const QJsonObject &json, const QMap<QString, QString> &defineMap, QObject *metaDataParent);
 
+    /// Returns the process wide meta data for the specified json file. The file is only parsed the first time it is
+    /// requested, after that all callers share the same FactMetaData instances. Shared meta data must not be modified,
+    /// make a copy of it instead.
+    static NameToMetaDataMap_t sharedMapFromJsonFile(const QString &jsonFilename);
+
+    /// Serializes the meta data to a ParameterMetaDataSnapshot record. Translators are not stored, they are
+    /// rebuilt from the units when the record is read back.
+    QByteArray toSnapshotRecord() const;
+
+    /// Creates meta data from a record written by toSnapshotRecord
+    ///     @return nullptr if the record is corrupt
+    static FactMetaData *createFromSnapshotRecord(const QByteArray &record, QObject *metaDataParent);
+
     const FactMetaData &operator=(const FactMetaData &other);
+    bool operator==(const FactMetaData &other) const;
+    bool operator!=(const FactMetaData &other) const { return !(*this == other); }
+
+    /// @return true: Meta data is owned by the shared registry and is immutable
+    bool isShared() const { return _shared; }
 
     /// Converts from meters to the user specified horizontal distance unit
     static QVariant metersToAppSettingsHorizontalDistanceUnits(const QVariant &meters);
@@ -342,6 +360,7 @@ class FactMetaData : public QObject
     bool _writeOnly = false;
     bool _volatile = false;
     CustomCookedValidator _customCookedValidator = nullptr;
+    bool _shared = false;
 
     // Exact conversion constants
     static constexpr struct UnitConsts_s {
@@ -395,6 +395,10 @@ void ParameterManager::_ftpDownloadComplete(const QString &fileName, const QStri
     bool continueWithDefaultParameterdownload = true;
     bool immediateRetry = false;
 
+    if (fileName != _ftpDownloadFilePath) {
+        return;
+    }
+
     (void) disconnect(_vehicle->ftpManager(), &FTPManager::downloadComplete, this, &ParameterManager::_ftpDownloadComplete);
     (void) disconnect(_vehicle->ftpManager(), &FTPManager::commandProgress, this, &ParameterManager::_ftpDownloadProgress);
 
@@ -438,8 +442,13 @@ void ParameterManager::_ftpDownloadComplete(const QString &fileName, const QStri
     }
 }
 
-void ParameterManager::_ftpDownloadProgress(float progress)
+void ParameterManager::_ftpDownloadProgress(const QString &fileName, float progress)
 {
+    // The download may be queued behind others
+    if (fileName != _ftpDownloadFilePath) {
+        return;
+    }
+
     qCDebug(ParameterManagerVerbose1Log) << "ParameterManager::_ftpDownloadProgress:" << progress;
     _setLoadProgress(static_cast<double>(progress));
     if (progress > 0.001) {
@@ -470,17 +479,20 @@ void ParameterManager::refreshAllParameters(uint8_t componentId)
 
     if (_tryftp && ((componentId == MAV_COMP_ID_ALL) || (componentId == MAV_COMP_ID_AUTOPILOT1))) {
         FTPManager *const ftpManager = _vehicle->ftpManager();
+        const QString paramFileURI = QStringLiteral("@PARAM/param.pck");
+        const QString toDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+        _ftpDownloadFilePath = FTPManager::downloadFilePath(paramFileURI, toDir);
         (void) connect(ftpManager, &FTPManager::downloadComplete, this, &ParameterManager::_ftpDownloadComplete);
+        (void) connect(ftpManager, &FTPManager::commandProgress, this, &ParameterManager::_ftpDownloadProgress);
         _waitingParamTimeoutTimer.stop();
-        if (ftpManager->download(MAV_COMP_ID_AUTOPILOT1,
-                                 QStringLiteral("@PARAM/param.pck"),
-                                 QStandardPaths::writableLocation(QStandardPaths::TempLocation),
-                                 QStringLiteral(""),
-                                 false /* No filesize check */)) {
-            (void) connect(ftpManager, &FTPManager::commandProgress, this, &ParameterManager::_ftpDownloadProgress);
-        } else {
+        if (!ftpManager->download(MAV_COMP_ID_AUTOPILOT1,
+                                  paramFileURI,
+                                  toDir,
+                                  QStringLiteral(""),
+                                  false /* No filesize check */)) {
             qCWarning(ParameterManagerLog) << "ParameterManager::refreshallParameters FTPManager::download returned failure";
             (void) disconnect(ftpManager, &FTPManager::downloadComplete, this, &ParameterManager::_ftpDownloadComplete);
+            (void) disconnect(ftpManager, &FTPManager::commandProgress, this, &ParameterManager::_ftpDownloadProgress);
         }
     } else {
         // Reset index wait lists
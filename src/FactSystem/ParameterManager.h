@@ -55,6 +55,9 @@ class ParameterManager : public QObject
 
     void mavlinkMessageReceived(const mavlink_message_t &message);
 
+    /// Message ids consumed by mavlinkMessageReceived, Vehicle only routes these to us
+    static constexpr uint32_t handledMessageIds[] = { MAVLINK_MSG_ID_PARAM_VALUE };
+
     QList<int> componentIds() const;
 
     /// Re-request the full set of parameters from the autopilot
@@ -136,7 +139,7 @@ private slots:
     void _updateProgressBar();
     void _checkInitialLoadComplete();
     void _ftpDownloadComplete(const QString &fileName, const QString &errorMsg);
-    void _ftpDownloadProgress(float progress);
+    void _ftpDownloadProgress(const QString &fileName, float progress);
     /// Parse the binary parameter file and inject the parameters in the qgc fact system.
     /// See: https://github.com/ArduPilot/ardupilot/tree/master/libraries/AP_Filesystem
     bool _parseParamFile(const QString &filename);
@@ -197,4 +200,5 @@ private slots:
     Fact _defaultFact;   ///< Used to return default fact, when parameter not found
 
     bool _tryftp = false;
+    QString _ftpDownloadFilePath;               ///< Other downloads can complete while ours is queued behind them
 };
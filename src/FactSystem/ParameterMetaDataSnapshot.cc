@@ -0,0 +1,181 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ParameterMetaDataSnapshot.h"
+#include "ParameterManager.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+
+QGC_LOGGING_CATEGORY(ParameterMetaDataSnapshotLog, "qgc.factsystem.parametermetadatasnapshot")
+
+// Snapshot layout (QDataStream):
+//  quint32 magic, quint32 version, QString sourceKey, quint32 recordCount
+//  recordCount * (QString key, qint64 offset, qint64 length)
+//  record data, offsets are relative to the end of the index
+
+ParameterMetaDataSnapshot::~ParameterMetaDataSnapshot()
+{
+    close();
+}
+
+bool ParameterMetaDataSnapshot::open(const QString &sourceFile, const QString &kind)
+{
+    close();
+
+    _snapshotFile.setFileName(snapshotFilename(sourceFile, kind));
+    if (!_snapshotFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 fileSize = _snapshotFile.size();
+    const uchar *const mapped = _snapshotFile.map(0, fileSize);
+    if (mapped) {
+        _snapshotData = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), fileSize);
+    } else {
+        qCDebug(ParameterMetaDataSnapshotLog) << "Unable to map snapshot, reading instead" << _snapshotFile.fileName() << _snapshotFile.errorString();
+        _snapshotData = _snapshotFile.readAll();
+    }
+
+    QDataStream stream(_snapshotData);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString sourceKey;
+    quint32 recordCount = 0;
+    stream >> magic >> version;
+    if ((magic != kMagic) || (version != kVersion)) {
+        qCDebug(ParameterMetaDataSnapshotLog) << "Snapshot format mismatch" << _snapshotFile.fileName();
+        close();
+        return false;
+    }
+
+    stream >> sourceKey >> recordCount;
+    if ((stream.status() != QDataStream::Ok) || (sourceKey != _sourceKey(sourceFile, kind))) {
+        qCDebug(ParameterMetaDataSnapshotLog) << "Stale snapshot" << _snapshotFile.fileName();
+        close();
+        return false;
+    }
+
+    // The count is not trusted before it is known to fit in the file
+    if (recordCount > ((fileSize - stream.device()->pos()) / kMinIndexEntrySize)) {
+        qCWarning(ParameterMetaDataSnapshotLog) << "Corrupt snapshot record count" << recordCount << _snapshotFile.fileName();
+        close();
+        return false;
+    }
+
+    _recordIndex.reserve(recordCount);
+    for (quint32 i = 0; (i < recordCount) && (stream.status() == QDataStream::Ok); i++) {
+        QString key;
+        RecordLocation_t location;
+        stream >> key >> location.offset >> location.length;
+        (void) _recordIndex.insert(key, location);
+    }
+
+    const qint64 dataStart = stream.device()->pos();
+    bool corrupt = (stream.status() != QDataStream::Ok);
+    for (auto it = _recordIndex.begin(); !corrupt && (it != _recordIndex.end()); it++) {
+        it->offset += dataStart;
+        corrupt = (it->offset < dataStart) || (it->length < 0) || ((it->offset + it->length) > fileSize);
+    }
+    if (corrupt) {
+        qCWarning(ParameterMetaDataSnapshotLog) << "Corrupt snapshot" << _snapshotFile.fileName();
+        close();
+        return false;
+    }
+
+    qCDebug(ParameterMetaDataSnapshotLog) << "Opened snapshot" << sourceFile << kind << "records:" << recordCount;
+
+    return true;
+}
+
+void ParameterMetaDataSnapshot::close()
+{
+    _recordIndex.clear();
+    _snapshotData.clear();
+    _snapshotFile.close();
+}
+
+QByteArray ParameterMetaDataSnapshot::record(const QString &key) const
+{
+    const auto it = _recordIndex.constFind(key);
+    if (it == _recordIndex.constEnd()) {
+        return QByteArray();
+    }
+
+    return QByteArray::fromRawData(_snapshotData.constData() + it->offset, it->length);
+}
+
+bool ParameterMetaDataSnapshot::write(const QString &sourceFile, const QString &kind, const QHash<QString, QByteArray> &records)
+{
+    QDir dir = snapshotDir();
+    if (!dir.exists() && !dir.mkpath(dir.absolutePath())) {
+        qCWarning(ParameterMetaDataSnapshotLog) << "Unable to create snapshot directory" << dir.absolutePath();
+        return false;
+    }
+
+    QByteArray index;
+    QDataStream indexStream(&index, QIODevice::WriteOnly);
+    indexStream.setVersion(QDataStream::Qt_6_0);
+
+    indexStream << kMagic << kVersion << _sourceKey(sourceFile, kind) << static_cast<quint32>(records.count());
+    qint64 offset = 0;
+    for (auto it = records.constBegin(); it != records.constEnd(); it++) {
+        indexStream << it.key() << offset << static_cast<qint64>(it.value().size());
+        offset += it.value().size();
+    }
+
+    const QString filename = snapshotFilename(sourceFile, kind);
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(ParameterMetaDataSnapshotLog) << "Unable to write snapshot" << filename << file.errorString();
+        return false;
+    }
+
+    bool writeOk = (file.write(index) == index.size());
+    for (auto it = records.constBegin(); writeOk && (it != records.constEnd()); it++) {
+        writeOk = (file.write(it.value()) == it.value().size());
+    }
+    if (!writeOk) {
+        qCWarning(ParameterMetaDataSnapshotLog) << "Unable to write snapshot" << filename << file.errorString();
+        file.cancelWriting();
+        return false;
+    }
+
+    qCDebug(ParameterMetaDataSnapshotLog) << "Wrote snapshot" << sourceFile << kind << "records:" << records.count();
+
+    return file.commit();
+}
+
+QString ParameterMetaDataSnapshot::snapshotFilename(const QString &sourceFile, const QString &kind)
+{
+    const QByteArray sourceHash = QCryptographicHash::hash((kind + QFileInfo(sourceFile).absoluteFilePath()).toUtf8(), QCryptographicHash::Sha1);
+    return snapshotDir().filePath(QString::fromLatin1(sourceHash.toHex()) + QStringLiteral(".snapshot"));
+}
+
+QDir ParameterMetaDataSnapshot::snapshotDir()
+{
+    return QDir(ParameterManager::parameterCacheDir().filePath(QStringLiteral("MetaData")));
+}
+
+QString ParameterMetaDataSnapshot::_sourceKey(const QString &sourceFile, const QString &kind)
+{
+    // Sources compiled into the resources carry the build time, the application version covers the rest
+    const QFileInfo sourceInfo(sourceFile);
+    return QStringLiteral("%1|%2|%3|%4|%5").arg(kind, sourceInfo.absoluteFilePath())
+        .arg(sourceInfo.size())
+        .arg(sourceInfo.lastModified().toMSecsSinceEpoch())
+        .arg(QCoreApplication::applicationVersion());
+}
@@ -0,0 +1,71 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+Q_DECLARE_LOGGING_CATEGORY(ParameterMetaDataSnapshotLog)
+
+/// Binary snapshot of a parameter meta data source file (xml or json).
+///
+/// The source is parsed once and each parameter is stored as an opaque record keyed by name. The snapshot lives in
+/// the parameter cache directory and is memory mapped when opened, records are only decoded when they are asked
+/// for. A snapshot is stale once the source file, the snapshot format or the application version changes.
+class ParameterMetaDataSnapshot
+{
+    Q_DISABLE_COPY(ParameterMetaDataSnapshot)
+
+public:
+    ParameterMetaDataSnapshot() = default;
+    ~ParameterMetaDataSnapshot();
+
+    /// Maps the snapshot compiled from sourceFile
+    ///     @param kind Identifies the loader which wrote the records, the same source may be compiled by different loaders
+    ///     @return false: Snapshot missing, stale or corrupt
+    bool open(const QString &sourceFile, const QString &kind);
+    void close();
+
+    bool isOpen() const { return _snapshotFile.isOpen(); }
+    qsizetype count() const { return _recordIndex.count(); }
+    bool contains(const QString &key) const { return _recordIndex.contains(key); }
+    QStringList keys() const { return _recordIndex.keys(); }
+
+    /// @return The record for key without copying it out of the snapshot, empty if there is no such record. The
+    ///         returned data is only valid while the snapshot is open.
+    QByteArray record(const QString &key) const;
+
+    /// Writes a snapshot of records for sourceFile, replacing any previous snapshot
+    static bool write(const QString &sourceFile, const QString &kind, const QHash<QString, QByteArray> &records);
+
+    static QString snapshotFilename(const QString &sourceFile, const QString &kind);
+    static QDir snapshotDir();
+
+private:
+    struct RecordLocation_t {
+        qint64 offset = 0;
+        qint64 length = 0;
+    };
+
+    static QString _sourceKey(const QString &sourceFile, const QString &kind);
+
+    QFile _snapshotFile;
+    QByteArray _snapshotData;   ///< Raw view of the mapped file
+    QHash<QString, RecordLocation_t> _recordIndex;
+
+    static constexpr quint32 kMagic = 0x51504D53; // "QPMS"
+    static constexpr quint32 kVersion = 1;
+    static constexpr qint64 kMinIndexEntrySize = sizeof(quint32) + (2 * sizeof(qint64)); ///< Empty key length and record location
+};
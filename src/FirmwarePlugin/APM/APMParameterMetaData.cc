@@ -10,6 +10,7 @@
 #include "APMParameterMetaData.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QDataStream>
 #include <QtCore/QFile>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QRegularExpressionMatch>
@@ -137,6 +138,12 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString &metaData
     }
     _parameterMetaDataLoaded = true;
 
+    if (_snapshot.open(metaDataFile, QString::fromLatin1(kSnapshotKind))) {
+        // Raw meta data is decoded from the snapshot as parameters ask for it
+        qCDebug(APMParameterMetaDataLog) << "Using parameter meta data snapshot:" << metaDataFile << _snapshot.count();
+        return;
+    }
+
     qCDebug(APMParameterMetaDataLog) << "Loading parameter meta data:" << metaDataFile;
 
     QFile xmlFile(metaDataFile);
@@ -298,6 +305,59 @@ void APMParameterMetaData::loadParameterFactMetaDataFile(const QString &metaData
         }
         (void) xml.readNext();
     }
+
+    _writeSnapshot(metaDataFile);
+}
+
+void APMParameterMetaData::_writeSnapshot(const QString &metaDataFile) const
+{
+    QHash<QString, QByteArray> records;
+    for (auto categoryIt = _vehicleTypeToParametersMap.constBegin(); categoryIt != _vehicleTypeToParametersMap.constEnd(); categoryIt++) {
+        for (const APMFactMetaDataRaw *const rawMetaData : categoryIt.value()) {
+            QByteArray record;
+            QDataStream stream(&record, QIODevice::WriteOnly);
+            stream.setVersion(QDataStream::Qt_6_0);
+            stream << rawMetaData->name << rawMetaData->category << rawMetaData->group << rawMetaData->shortDescription << rawMetaData->longDescription
+                   << rawMetaData->min << rawMetaData->max << rawMetaData->incrementSize << rawMetaData->units
+                   << rawMetaData->rebootRequired << rawMetaData->readOnly << rawMetaData->values << rawMetaData->bitmask;
+            (void) records.insert(_snapshotKey(categoryIt.key(), rawMetaData->name), record);
+        }
+    }
+
+    if (!ParameterMetaDataSnapshot::write(metaDataFile, QString::fromLatin1(kSnapshotKind), records)) {
+        qCWarning(APMParameterMetaDataLog) << "Unable to write parameter meta data snapshot:" << metaDataFile;
+    }
+}
+
+APMFactMetaDataRaw *APMParameterMetaData::_rawMetaData(const QString &category, const QString &name)
+{
+    ParameterNametoFactMetaDataMap &parameterMap = _vehicleTypeToParametersMap[category];
+
+    const auto it = parameterMap.constFind(name);
+    if (it != parameterMap.constEnd()) {
+        return it.value();
+    }
+
+    const QByteArray record = _snapshot.record(_snapshotKey(category, name));
+    if (record.isEmpty()) {
+        return nullptr;
+    }
+
+    APMFactMetaDataRaw *const rawMetaData = new APMFactMetaDataRaw(this);
+    QDataStream stream(record);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream >> rawMetaData->name >> rawMetaData->category >> rawMetaData->group >> rawMetaData->shortDescription >> rawMetaData->longDescription
+           >> rawMetaData->min >> rawMetaData->max >> rawMetaData->incrementSize >> rawMetaData->units
+           >> rawMetaData->rebootRequired >> rawMetaData->readOnly >> rawMetaData->values >> rawMetaData->bitmask;
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(APMParameterMetaDataLog) << "Corrupt parameter meta data snapshot record:" << category << name;
+        delete rawMetaData;
+        return nullptr;
+    }
+
+    (void) parameterMap.insert(name, rawMetaData);
+
+    return rawMetaData;
 }
 
 void APMParameterMetaData::_correctGroupMemberships(ParameterNametoFactMetaDataMap &parameterToFactMetaDataMap, QMap<QString,QStringList> &groupMembers)
@@ -431,10 +491,9 @@ FactMetaData *APMParameterMetaData::getMetaDataForFact(const QString &name, MAV_
 
     // check if we have metadata for fact, use generic otherwise
     while (keepTrying) {
-        if (_vehicleTypeToParametersMap[mavTypeString].contains(name)) {
-            rawMetaData = _vehicleTypeToParametersMap[mavTypeString][name];
-        } else if (_vehicleTypeToParametersMap["libraries"].contains(name)) {
-            rawMetaData = _vehicleTypeToParametersMap["libraries"][name];
+        rawMetaData = _rawMetaData(mavTypeString, name);
+        if (!rawMetaData) {
+            rawMetaData = _rawMetaData(QStringLiteral("libraries"), name);
         }
         if (!rawMetaData && (mavTypeString == "Rover")) {
             // Hack city: Older versions of Rover have different name
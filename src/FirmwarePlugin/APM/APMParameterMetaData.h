@@ -17,6 +17,7 @@
 
 #include "MAVLinkLib.h"
 #include "FactMetaData.h"
+#include "ParameterMetaDataSnapshot.h"
 
 Q_DECLARE_LOGGING_CATEGORY(APMParameterMetaDataLog)
 Q_DECLARE_LOGGING_CATEGORY(APMParameterMetaDataVerboseLog)
@@ -40,7 +41,7 @@ class APMFactMetaDataRaw : public QObject
     QString incrementSize;
     QString units;
     bool rebootRequired = false;
-    bool readOnly;
+    bool readOnly = false;
     QList<QPair<QString, QString>> values;
     QList<QPair<QString, QString>> bitmask;
 };
@@ -87,10 +88,16 @@ class APMParameterMetaData : public QObject
     static void _correctGroupMemberships(ParameterNametoFactMetaDataMap &parameterToFactMetaDataMap, QMap<QString,QStringList> &groupMembers);
     static QString _mavTypeToString(MAV_TYPE vehicleTypeEnum);
     static QString _groupFromParameterName(const QString &name);
+    APMFactMetaDataRaw *_rawMetaData(const QString &category, const QString &name);
+    void _writeSnapshot(const QString &metaDataFile) const;
+    static QString _snapshotKey(const QString &category, const QString &name) { return (category + QLatin1Char('/') + name); }
 
     bool _parameterMetaDataLoaded = false; ///< true: parameter meta data already loaded
     // FIXME: metadata is vehicle type specific now
     QMap<QString, ParameterNametoFactMetaDataMap> _vehicleTypeToParametersMap; ///< Maps from a vehicle type to paramametertoFactMeta map>
+    ParameterMetaDataSnapshot _snapshot; ///< Raw meta data which has not been decoded into _vehicleTypeToParametersMap yet
+
+    static constexpr const char *kSnapshotKind = "APMFactMetaDataRaw";
 
     static constexpr const char *kInvalidConverstion = "Internal Error: No support for string parameters";
 };
@@ -18,6 +18,9 @@ APMSubmarineFactGroup::APMSubmarineFactGroup(QObject *parent)
 {
     // qCDebug(APMSubmarineFactGroupLog) << Q_FUNC_INFO << this;
 
+    // Values are filled in by ArduSubFirmwarePlugin::adjustIncomingMavlinkMessage
+    _setHandledMessageIds({});
+
     _addFact(&_camTiltFact);
     _addFact(&_tetherTurnsFact);
     _addFact(&_lightsLevel1Fact);
@@ -85,6 +85,12 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
     }
     _parameterMetaDataLoaded = true;
 
+    if (_snapshot.open(metaDataFile, QString::fromLatin1(kSnapshotKind))) {
+        // FactMetaData is decoded from the snapshot as parameters ask for it
+        qCDebug(PX4ParameterMetaDataLog) << "Using parameter meta data snapshot:" << metaDataFile << _snapshot.count();
+        return;
+    }
+
     qCDebug(PX4ParameterMetaDataLog) << "Loading parameter meta data:" << metaDataFile;
 
     QFile xmlFile(metaDataFile);
@@ -398,11 +404,25 @@ void PX4ParameterMetaData::loadParameterFactMetaDataFile(const QString& metaData
         xml.readNext();
     }
 
+    _writeSnapshot(metaDataFile);
+
 #ifdef GENERATE_PARAMETER_JSON
     _generateParameterJson();
 #endif
 }
 
+void PX4ParameterMetaData::_writeSnapshot(const QString& metaDataFile) const
+{
+    QHash<QString, QByteArray> records;
+    for (auto it = _mapParameterName2FactMetaData.constBegin(); it != _mapParameterName2FactMetaData.constEnd(); it++) {
+        (void) records.insert(it.key(), it.value()->toSnapshotRecord());
+    }
+
+    if (!ParameterMetaDataSnapshot::write(metaDataFile, QString::fromLatin1(kSnapshotKind), records)) {
+        qCWarning(PX4ParameterMetaDataLog) << "Unable to write parameter meta data snapshot:" << metaDataFile;
+    }
+}
+
 #ifdef GENERATE_PARAMETER_JSON
 void _jsonWriteLine(QFile& file, int indent, const QString& line)
 {
@@ -492,8 +512,16 @@ FactMetaData* PX4ParameterMetaData::getMetaDataForFact(const QString& name, MAV_
     Q_UNUSED(vehicleType)
 
     if (!_mapParameterName2FactMetaData.contains(name)) {
-        qCDebug(PX4ParameterMetaDataLog) << "No metaData for " << name << "using generic metadata";
-        FactMetaData* metaData = new FactMetaData(type, this);
+        FactMetaData* metaData = nullptr;
+
+        const QByteArray record = _snapshot.record(name);
+        if (!record.isEmpty()) {
+            metaData = FactMetaData::createFromSnapshotRecord(record, this);
+        }
+        if (!metaData) {
+            qCDebug(PX4ParameterMetaDataLog) << "No metaData for " << name << "using generic metadata";
+            metaData = new FactMetaData(type, this);
+        }
         _mapParameterName2FactMetaData[name] = metaData;
     }
 
@@ -12,6 +12,7 @@
 
 #include "MAVLinkLib.h"
 #include "FactMetaData.h"
+#include "ParameterMetaDataSnapshot.h"
 
 #include <QtCore/QObject>
 #include <QtCore/QLoggingCategory>
@@ -48,6 +49,7 @@ class PX4ParameterMetaData : public QObject
 
     QVariant _stringToTypedVariant(const QString& string, FactMetaData::ValueType_t type, bool* convertOk);
     static void _outputFileWarning(const QString& metaDataFile, const QString& error1, const QString& error2);
+    void _writeSnapshot(const QString& metaDataFile) const;
 
 #ifdef GENERATE_PARAMETER_JSON
     void _generateParameterJson();
@@ -55,6 +57,9 @@ class PX4ParameterMetaData : public QObject
 
     bool                                _parameterMetaDataLoaded        = false;    ///< true: parameter meta data already loaded
     FactMetaData::NameToMetaDataMap_t   _mapParameterName2FactMetaData;             ///< Maps from a parameter name to FactMetaData
+    ParameterMetaDataSnapshot           _snapshot;                                  ///< Meta data which has not been decoded into _mapParameterName2FactMetaData yet
+
+    static constexpr const char* kSnapshotKind = "PX4FactMetaData";
 
     static constexpr const char* kInvalidConverstion = "Internal Error: No support for string parameters";
 
@@ -17,6 +17,9 @@ GPSRTKFactGroup::GPSRTKFactGroup(QObject *parent)
 {
     // qCDebug(GPSRTKFactGroupLog) << Q_FUNC_INFO << this;
 
+    // Values come from the RTK base station, not the vehicle
+    _setHandledMessageIds({});
+
     _addFact(&_connectedFact);
     _addFact(&_currentDurationFact);
     _addFact(&_currentAccuracyFact);
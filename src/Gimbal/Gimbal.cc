@@ -60,6 +60,9 @@ const Gimbal &Gimbal::operator=(const Gimbal &other)
 
 void Gimbal::_initFacts()
 {
+    // Values are filled in by GimbalController
+    _setHandledMessageIds({});
+
     _addFact(&_absoluteRollFact);
     _addFact(&_absolutePitchFact);
     _addFact(&_bodyYawFact);
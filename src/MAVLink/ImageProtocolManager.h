@@ -30,6 +30,9 @@ class ImageProtocolManager : public QObject
 
     uint32_t flowImageIndex() const { return _flowImageIndex; }
 
+    /// Message ids consumed by mavlinkMessageReceived, Vehicle only routes these to us
+    static constexpr uint32_t handledMessageIds[] = { MAVLINK_MSG_ID_DATA_TRANSMISSION_HANDSHAKE, MAVLINK_MSG_ID_ENCAPSULATED_DATA };
+
     bool requestImage(uint8_t system_id, uint8_t component_id, uint8_t chan, mavlink_message_t &message);
     void cancelRequest(uint8_t system_id, uint8_t component_id, uint8_t chan, mavlink_message_t &message);
 
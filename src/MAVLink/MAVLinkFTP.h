@@ -48,6 +48,9 @@ class MavlinkFTP {
 
                     // Length of file chunk written by write command
                     uint32_t writeFileLength;
+
+                    // CRC32 returned by CalcFileCRC32 command
+                    uint32_t fileCRC32;
                 };
             }) Request;
 
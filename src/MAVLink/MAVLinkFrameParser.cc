@@ -0,0 +1,245 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkFrameParser.h"
+
+namespace
+{
+
+constexpr qsizetype kV1HeaderLen = MAVLINK_CORE_HEADER_MAVLINK1_LEN + 1;    ///< Includes STX
+constexpr qsizetype kV2HeaderLen = MAVLINK_CORE_HEADER_LEN + 1;             ///< Includes STX
+
+bool _isStx(uint8_t byte)
+{
+    // MAVLINK_STX (0xFD) and MAVLINK_STX_MAVLINK1 (0xFE) are adjacent
+    static_assert(MAVLINK_STX_MAVLINK1 == MAVLINK_STX + 1);
+    return static_cast<uint8_t>(byte - MAVLINK_STX) <= 1;
+}
+
+bool _isIdle(const mavlink_status_t *status)
+{
+    return (status->parse_state == MAVLINK_PARSE_STATE_UNINIT) || (status->parse_state == MAVLINK_PARSE_STATE_IDLE);
+}
+
+/// Decodes a complete frame starting at data[0], which must be a start-of-frame marker, without going through
+/// the per-byte state machine. The channel status is updated the same way mavlink_parse_char would.
+///     @return Frame length, 0 if the frame must be handled by mavlink_parse_char
+qsizetype _decodeFrame(mavlink_status_t *status, const uint8_t *data, qsizetype size, mavlink_message_t &message)
+{
+    // Unsigned messages may or may not be accepted on a signing channel, leave that to the signing callback
+    if (status->signing) {
+        return 0;
+    }
+
+    const bool mavlink1 = (data[0] == MAVLINK_STX_MAVLINK1);
+    const qsizetype headerLen = mavlink1 ? kV1HeaderLen : kV2HeaderLen;
+    if (size < headerLen) {
+        return 0;
+    }
+
+    const uint8_t payloadLen = data[1];
+    const qsizetype frameLen = headerLen + payloadLen + MAVLINK_NUM_CHECKSUM_BYTES;
+    if (size < frameLen) {
+        return 0;
+    }
+
+    // Signed frames and unknown incompatibility flags
+    if (!mavlink1 && (data[2] != 0)) {
+        return 0;
+    }
+
+    const uint32_t msgid = mavlink1 ? data[5] : (data[7] | (data[8] << 8) | (static_cast<uint32_t>(data[9]) << 16));
+    const mavlink_msg_entry_t *const entry = mavlink_get_msg_entry(msgid);
+    if (!entry) {
+        return 0;
+    }
+
+    uint16_t checksum = crc_calculate(data + 1, static_cast<uint16_t>(headerLen - 1 + payloadLen));
+    crc_accumulate(entry->crc_extra, &checksum);
+    const uint8_t *const ck = data + headerLen + payloadLen;
+    if ((ck[0] != (checksum & 0xFF)) || (ck[1] != (checksum >> 8))) {
+        return 0;
+    }
+
+    message.magic = data[0];
+    message.len = payloadLen;
+    if (mavlink1) {
+        message.incompat_flags = 0;
+        message.compat_flags = 0;
+        message.seq = data[2];
+        message.sysid = data[3];
+        message.compid = data[4];
+    } else {
+        message.incompat_flags = data[2];
+        message.compat_flags = data[3];
+        message.seq = data[4];
+        message.sysid = data[5];
+        message.compid = data[6];
+    }
+    message.msgid = msgid;
+    message.checksum = checksum;
+    message.ck[0] = ck[0];
+    message.ck[1] = ck[1];
+    (void) memcpy(_MAV_PAYLOAD_NON_CONST(&message), data + headerLen, payloadLen);
+
+    if (mavlink1) {
+        status->flags |= MAVLINK_STATUS_FLAG_IN_MAVLINK1;
+    } else {
+        status->flags &= ~MAVLINK_STATUS_FLAG_IN_MAVLINK1;
+    }
+    status->msg_received = MAVLINK_FRAMING_OK;
+    status->parse_state = MAVLINK_PARSE_STATE_IDLE;
+    status->packet_idx = payloadLen;
+    status->current_rx_seq = message.seq;
+    if (status->packet_rx_success_count == 0) {
+        status->packet_rx_drop_count = 0;
+    }
+    status->packet_rx_success_count++;
+    status->parse_error = 0;
+
+    return frameLen;
+}
+
+/// Appends the wire bytes of a frame which mavlink_parse_char completed at data[lastPos]
+void _appendFrame(QByteArrayView data, qsizetype lastPos, const mavlink_message_t &message, QByteArray &frames)
+{
+    const qsizetype frameLen = MAVLinkFrameParser::frameLength(message);
+    const qsizetype start = lastPos + 1 - frameLen;
+    if (start >= 0) {
+        (void) frames.append(data.sliced(start, frameLen));
+        return;
+    }
+
+    // Part of the frame arrived in an earlier buffer
+    uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+    (void) frames.append(reinterpret_cast<const char*>(buffer), len);
+}
+
+/// mavlink_parse_char on a private parse state
+uint8_t _parseChar(MAVLinkFrameParser::ParserState &state, uint8_t byte, mavlink_message_t *message, mavlink_status_t *messageStatus)
+{
+    const uint8_t result = mavlink_frame_char_buffer(&state.buffer, &state.status, byte, message, messageStatus);
+    if ((result != MAVLINK_FRAMING_BAD_CRC) && (result != MAVLINK_FRAMING_BAD_SIGNATURE)) {
+        return result;
+    }
+
+    // Same recovery as mavlink_parse_char
+    _mav_parse_error(&state.status);
+    state.status.msg_received = MAVLINK_FRAMING_INCOMPLETE;
+    state.status.parse_state = MAVLINK_PARSE_STATE_IDLE;
+    if (byte == MAVLINK_STX) {
+        state.status.parse_state = MAVLINK_PARSE_STATE_GOT_STX;
+        state.buffer.len = 0;
+        mavlink_start_checksum(&state.buffer);
+    }
+
+    return MAVLINK_FRAMING_INCOMPLETE;
+}
+
+/// Scans data for frames, parseChar is the per-byte state machine working on status
+template<typename ParseChar>
+qsizetype _parse(mavlink_status_t *status, QByteArrayView data, QList<mavlink_message_t> &messages, QByteArray *frames, ParseChar parseChar)
+{
+    const uint8_t *const bytes = reinterpret_cast<const uint8_t*>(data.data());
+    const qsizetype size = data.size();
+    const qsizetype startCount = messages.size();
+
+    qsizetype pos = 0;
+    while (pos < size) {
+        if (_isIdle(status)) {
+            // Between frames the state machine ignores everything up to the next start-of-frame marker
+            const qsizetype start = pos;
+            while ((pos < size) && !_isStx(bytes[pos])) {
+                pos++;
+            }
+            if (pos != start) {
+                status->msg_received = MAVLINK_FRAMING_INCOMPLETE;
+                status->parse_error = 0;
+            }
+            if (pos == size) {
+                break;
+            }
+
+            mavlink_message_t &message = messages.emplaceBack();
+            const qsizetype frameLen = _decodeFrame(status, bytes + pos, size - pos, message);
+            if (frameLen > 0) {
+                if (frames) {
+                    (void) frames->append(data.sliced(pos, frameLen));
+                }
+                pos += frameLen;
+                continue;
+            }
+            messages.removeLast();
+        }
+
+        mavlink_message_t message;
+        mavlink_status_t messageStatus;
+        if (parseChar(bytes[pos], &message, &messageStatus) == MAVLINK_FRAMING_OK) {
+            (void) messages.append(message);
+            if (frames) {
+                _appendFrame(data, pos, message, *frames);
+            }
+        }
+        pos++;
+    }
+
+    return messages.size() - startCount;
+}
+
+} // namespace
+
+namespace MAVLinkFrameParser
+{
+
+qsizetype frameLength(const mavlink_message_t &message)
+{
+    if (message.magic == MAVLINK_STX_MAVLINK1) {
+        return kV1HeaderLen + message.len + MAVLINK_NUM_CHECKSUM_BYTES;
+    }
+
+    const qsizetype signatureLen = (message.incompat_flags & MAVLINK_IFLAG_SIGNED) ? MAVLINK_SIGNATURE_BLOCK_LEN : 0;
+    return kV2HeaderLen + message.len + MAVLINK_NUM_CHECKSUM_BYTES + signatureLen;
+}
+
+qsizetype parse(uint8_t channel, QByteArrayView data, QList<mavlink_message_t> &messages, QByteArray *frames)
+{
+    mavlink_status_t *const status = mavlink_get_channel_status(channel);
+    if (!status) {
+        return 0;
+    }
+
+    return _parse(status, data, messages, frames, [channel](uint8_t byte, mavlink_message_t *message, mavlink_status_t *messageStatus) {
+        return mavlink_parse_char(channel, byte, message, messageStatus);
+    });
+}
+
+qsizetype parse(ParserState &state, QByteArrayView data, QList<mavlink_message_t> &messages, QByteArray *frames)
+{
+    return _parse(&state.status, data, messages, frames, [&state](uint8_t byte, mavlink_message_t *message, mavlink_status_t *messageStatus) {
+        return _parseChar(state, byte, message, messageStatus);
+    });
+}
+
+qsizetype parseBytewise(uint8_t channel, QByteArrayView data, QList<mavlink_message_t> &messages)
+{
+    const qsizetype startCount = messages.size();
+
+    for (const char byte : data) {
+        mavlink_message_t message;
+        mavlink_status_t messageStatus;
+        if (mavlink_parse_char(channel, static_cast<uint8_t>(byte), &message, &messageStatus) == MAVLINK_FRAMING_OK) {
+            (void) messages.append(message);
+        }
+    }
+
+    return messages.size() - startCount;
+}
+
+} // namespace MAVLinkFrameParser
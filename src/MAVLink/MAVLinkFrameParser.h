@@ -0,0 +1,50 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QList>
+
+#include "MAVLinkLib.h"
+
+/// Buffer-at-a-time MAVLink frame scanner.
+///
+/// Complete, unsigned frames which lie entirely within the buffer are located by their start-of-frame
+/// marker, length checked and CRC validated in one pass and copied straight into a mavlink_message_t.
+/// Anything else (frames split across buffers, signed frames, channels with signing enabled, bad CRCs,
+/// unknown message ids) goes through mavlink_parse_char so the decoded messages and the channel status
+/// are identical to feeding every byte through mavlink_parse_char.
+namespace MAVLinkFrameParser
+{
+    /// Parse state owned by the caller instead of the global channel status, for parsing off the main thread.
+    /// Signing is never enabled on it, signed channels must be parsed through their channel.
+    struct ParserState
+    {
+        mavlink_status_t status{};
+        mavlink_message_t buffer{};
+    };
+
+    /// Parses all frames in data on the specified channel and appends them to messages.
+    ///     @param frames If set, the wire bytes of each decoded frame are appended here in the same order.
+    ///                   Frames which started in an earlier buffer are re-serialized from the message.
+    ///     @return Number of messages appended
+    qsizetype parse(uint8_t channel, QByteArrayView data, QList<mavlink_message_t> &messages, QByteArray *frames = nullptr);
+
+    /// Same as above but on a private parse state, the global channel status is not touched
+    qsizetype parse(ParserState &state, QByteArrayView data, QList<mavlink_message_t> &messages, QByteArray *frames = nullptr);
+
+    /// @return Length of the message on the wire, including the signature if it is signed
+    qsizetype frameLength(const mavlink_message_t &message);
+
+    /// Reference implementation which passes every byte through mavlink_parse_char.
+    ///     @return Number of messages appended
+    qsizetype parseBytewise(uint8_t channel, QByteArrayView data, QList<mavlink_message_t> &messages);
+}; // namespace MAVLinkFrameParser
@@ -0,0 +1,51 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkLossCounter.h"
+
+#include <algorithm>
+
+void MAVLinkLossCounter::reset()
+{
+    _lastSequence.reset();
+    _totalReceived = 0;
+    _totalLoss = 0;
+    _runningLossPercent = 0.f;
+}
+
+bool MAVLinkLossCounter::update(const mavlink_message_t &message)
+{
+    if (!_lastSequence) {
+        _lastSequence = std::make_unique<uint16_t[]>(256 * 256);
+        std::fill_n(_lastSequence.get(), 256 * 256, _noSequence);
+    }
+
+    uint16_t &lastSeq = _lastSequence[(message.sysid << 8) | message.compid];
+    uint8_t expectedSeq = (lastSeq == _noSequence) ? message.seq : static_cast<uint8_t>(lastSeq + 1);
+    _totalReceived++;
+
+    if (message.seq != expectedSeq) {
+        uint64_t lostMessages = message.seq;
+        if (message.seq < expectedSeq) {
+            lostMessages += 255;
+        }
+        lostMessages -= expectedSeq;
+        _totalLoss += lostMessages;
+    }
+
+    lastSeq = message.seq;
+
+    float receiveLossPercent = static_cast<float>(static_cast<double>(_totalLoss) / static_cast<double>(totalSent()));
+    receiveLossPercent *= 100.0f;
+    receiveLossPercent *= 0.5f;
+    receiveLossPercent += (_runningLossPercent * 0.5f);
+    _runningLossPercent = receiveLossPercent;
+
+    return ((_totalReceived % 31) == 0);
+}
@@ -0,0 +1,39 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <memory>
+
+#include "MAVLinkLib.h"
+
+/// Tracks received and lost messages on a single MAVLink channel from the per system/component sequence numbers.
+/// Not thread safe, each channel is only ever updated from the thread which decodes it.
+class MAVLinkLossCounter
+{
+public:
+    void reset();
+
+    /// Accounts for a received message
+    ///     @return true: it is time to report the status (every 31 messages)
+    bool update(const mavlink_message_t &message);
+
+    uint64_t totalReceived() const { return _totalReceived; }
+    uint64_t totalLoss() const { return _totalLoss; }
+    uint64_t totalSent() const { return (_totalReceived + _totalLoss); }
+    float runningLossPercent() const { return _runningLossPercent; }
+
+private:
+    static constexpr uint16_t _noSequence = 0x100;
+
+    std::unique_ptr<uint16_t[]> _lastSequence;  ///< Indexed by (sysid << 8) | compid, _noSequence until the first message arrives. Allocated on first use.
+    uint64_t _totalReceived = 0;                ///< The total number of successfully received messages
+    uint64_t _totalLoss = 0;                    ///< Total messages lost during transmission
+    float _runningLossPercent = 0.f;            ///< Loss rate
+};
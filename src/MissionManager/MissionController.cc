@@ -59,6 +59,7 @@ MissionController::MissionController(PlanMasterController* masterController, QOb
     connect(_masterController,                                  &PlanMasterController::managerVehicleChanged,           this, &MissionController::multipleLandPatternsAllowedChanged);
     connect(this,                                               &MissionController::multipleLandPatternsAllowedChanged, this, &MissionController::_forceRecalcOfAllowedBits);
     connect(this,                                               &MissionController::missionPlannedDistanceChanged,      this, &MissionController::recalcTerrainProfile);
+    connect(_planViewSettings->showGimbalOnlyWhenSet(),         &Fact::rawValueChanged,                                 this, [this]() { _queueMissionFlightStatusRecalc(nullptr); });
 
     // The follow is used to compress multiple recalc calls in a row to into a single call.
     connect(this, &MissionController::_recalcMissionFlightStatusSignal, this, &MissionController::_recalcMissionFlightStatus,   Qt::QueuedConnection);
@@ -74,6 +75,21 @@ MissionController::~MissionController()
 }
 
 void MissionController::_resetMissionFlightStatus(void)
+{
+    _resetMissionFlightStatusValues();
+
+    emit missionPlannedDistanceChanged(_missionFlightStatus.plannedDistance);
+    emit missionTimeChanged();
+    emit missionHoverDistanceChanged(_missionFlightStatus.hoverDistance);
+    emit missionCruiseDistanceChanged(_missionFlightStatus.cruiseDistance);
+    emit missionHoverTimeChanged();
+    emit missionCruiseTimeChanged();
+    emit missionMaxTelemetryChanged(_missionFlightStatus.maxTelemetryDistance);
+    emit batteryChangePointChanged(_missionFlightStatus.batteryChangePoint);
+    emit batteriesRequiredChanged(_missionFlightStatus.batteriesRequired);
+}
+
+void MissionController::_resetMissionFlightStatusValues(void)
 {
     _missionFlightStatus.totalDistance =        0.0;
     _missionFlightStatus.plannedDistance =      0.0;
@@ -104,17 +120,6 @@ void MissionController::_resetMissionFlightStatus(void)
         double batteryPercentRemainingAnnounce = SettingsManager::instance()->appSettings()->batteryPercentRemainingAnnounce()->rawValue().toDouble();
         _missionFlightStatus.ampMinutesAvailable = static_cast<double>(_missionFlightStatus.mAhBattery) / 1000.0 * 60.0 * ((100.0 - batteryPercentRemainingAnnounce) / 100.0);
     }
-
-    emit missionPlannedDistanceChanged(_missionFlightStatus.plannedDistance);
-    emit missionTimeChanged();
-    emit missionHoverDistanceChanged(_missionFlightStatus.hoverDistance);
-    emit missionCruiseDistanceChanged(_missionFlightStatus.cruiseDistance);
-    emit missionHoverTimeChanged();
-    emit missionCruiseTimeChanged();
-    emit missionMaxTelemetryChanged(_missionFlightStatus.maxTelemetryDistance);
-    emit batteryChangePointChanged(_missionFlightStatus.batteryChangePoint);
-    emit batteriesRequiredChanged(_missionFlightStatus.batteriesRequired);
-
 }
 
 void MissionController::start(bool flyView)
@@ -1192,11 +1197,15 @@ FlightPathSegment* MissionController::_createFlightPathSegmentWorker(VisualItemP
     connect(pair.second, &VisualMissionItem::coordinateChanged,     segment,    &FlightPathSegment::setCoordinate2);
     connect(pair.second, &VisualMissionItem::amslEntryAltChanged,   segment,    &FlightPathSegment::setCoord2AMSLAlt);
 
-    connect(pair.second, &VisualMissionItem::coordinateChanged,         this,       &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
+    // Only the items from the changed end of the segment onwards need their flight status recalculated
+    VisualMissionItem* firstItem = pair.first;
+    VisualMissionItem* secondItem = pair.second;
+    connect(pair.first,  &VisualMissionItem::exitCoordinateChanged,     segment,    [this, firstItem]() { _queueMissionFlightStatusRecalc(firstItem); });
+    connect(pair.second, &VisualMissionItem::coordinateChanged,         segment,    [this, secondItem]() { _queueMissionFlightStatusRecalc(secondItem); });
 
     connect(segment,    &FlightPathSegment::totalDistanceChanged,       this,       &MissionController::recalcTerrainProfile,             Qt::QueuedConnection);
-    connect(segment,    &FlightPathSegment::coord1AMSLAltChanged,       this,       &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(segment,    &FlightPathSegment::coord2AMSLAltChanged,       this,       &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
+    connect(segment,    &FlightPathSegment::coord1AMSLAltChanged,       this,       [this, firstItem]() { _queueMissionFlightStatusRecalc(firstItem); });
+    connect(segment,    &FlightPathSegment::coord2AMSLAltChanged,       this,       [this, secondItem]() { _queueMissionFlightStatusRecalc(secondItem); });
     connect(segment,    &FlightPathSegment::amslTerrainHeightsChanged,  this,       &MissionController::recalcTerrainProfile,             Qt::QueuedConnection);
     connect(segment,    &FlightPathSegment::terrainCollisionChanged,    this,       &MissionController::recalcTerrainProfile,             Qt::QueuedConnection);
 
@@ -1439,7 +1448,7 @@ void MissionController::_recalcFlightPathSegments(void)
     // Anything left in the old table is an obsolete line object that can go
     qDeleteAll(oldSegmentTable);
 
-    emit _recalcMissionFlightStatusSignal();
+    _queueMissionFlightStatusRecalc(nullptr);
 
     emit recalcTerrainProfile();
     if (signalSplitSegmentChanged) {
@@ -1507,51 +1516,177 @@ void MissionController::_addTimeDistance(bool vtolInHover, double hoverTime, dou
     }
 }
 
+/// Records a change which affects the flight status of the specified item and everything after it
+///     @param changedItem nullptr to recalculate the whole mission
+void MissionController::_queueMissionFlightStatusRecalc(VisualMissionItem* changedItem)
+{
+    if (changedItem) {
+        _flightStatusDirtyItems.insert(changedItem);
+    } else {
+        _flightStatusDirtyAll = true;
+    }
+    emit _recalcMissionFlightStatusSignal();
+}
+
+/// @return Visual item index the flight status recalc must start at, -1 if nothing changed
+int MissionController::_missionFlightStatusRecalcStart(void)
+{
+    if (_flightStatusDirtyAll || _flightStatusCheckpoints.count() != _visualItems->count()) {
+        return 0;
+    }
+    if (_flightStatusDirtyItems.isEmpty()) {
+        return -1;
+    }
+
+    for (int i=0; i<_visualItems->count(); i++) {
+        VisualMissionItem* item = _visualItems->value<VisualMissionItem*>(i);
+        if (_flightStatusCheckpoints[i].item != item) {
+            // The mission changed underneath the checkpoints
+            return 0;
+        }
+        if (_flightStatusDirtyItems.contains(item)) {
+            return i;
+        }
+    }
+
+    // Changed items are no longer part of the mission
+    return -1;
+}
+
+bool MissionController::_flightStatusValueChanged(double oldValue, double newValue)
+{
+    if (qIsNaN(oldValue) || qIsNaN(newValue)) {
+        return qIsNaN(oldValue) != qIsNaN(newValue);
+    }
+    return oldValue != newValue;
+}
+
+/// Signals only the mission totals which actually changed from the previous recalc
+void MissionController::_emitMissionFlightStatusChanges(const MissionFlightStatus_t& previousStatus, double previousMinAMSLAltitude, double previousMaxAMSLAltitude)
+{
+    if (_flightStatusValueChanged(previousStatus.maxTelemetryDistance, _missionFlightStatus.maxTelemetryDistance)) {
+        emit missionMaxTelemetryChanged(_missionFlightStatus.maxTelemetryDistance);
+    }
+    if (_flightStatusValueChanged(previousStatus.totalDistance, _missionFlightStatus.totalDistance)) {
+        emit missionTotalDistanceChanged(_missionFlightStatus.totalDistance);
+    }
+    if (_flightStatusValueChanged(previousStatus.plannedDistance, _missionFlightStatus.plannedDistance)) {
+        emit missionPlannedDistanceChanged(_missionFlightStatus.plannedDistance);
+    }
+    if (_flightStatusValueChanged(previousStatus.hoverDistance, _missionFlightStatus.hoverDistance)) {
+        emit missionHoverDistanceChanged(_missionFlightStatus.hoverDistance);
+    }
+    if (_flightStatusValueChanged(previousStatus.cruiseDistance, _missionFlightStatus.cruiseDistance)) {
+        emit missionCruiseDistanceChanged(_missionFlightStatus.cruiseDistance);
+    }
+    if (_flightStatusValueChanged(previousStatus.totalTime, _missionFlightStatus.totalTime)) {
+        emit missionTimeChanged();
+    }
+    if (_flightStatusValueChanged(previousStatus.hoverTime, _missionFlightStatus.hoverTime)) {
+        emit missionHoverTimeChanged();
+    }
+    if (_flightStatusValueChanged(previousStatus.cruiseTime, _missionFlightStatus.cruiseTime)) {
+        emit missionCruiseTimeChanged();
+    }
+    if (previousStatus.batteryChangePoint != _missionFlightStatus.batteryChangePoint) {
+        emit batteryChangePointChanged(_missionFlightStatus.batteryChangePoint);
+    }
+    if (previousStatus.batteriesRequired != _missionFlightStatus.batteriesRequired) {
+        emit batteriesRequiredChanged(_missionFlightStatus.batteriesRequired);
+    }
+    if (_flightStatusValueChanged(previousMinAMSLAltitude, _minAMSLAltitude)) {
+        emit minAMSLAltitudeChanged(_minAMSLAltitude);
+    }
+    if (_flightStatusValueChanged(previousMaxAMSLAltitude, _maxAMSLAltitude)) {
+        emit maxAMSLAltitudeChanged(_maxAMSLAltitude);
+    }
+}
+
 void MissionController::_recalcMissionFlightStatus()
 {
     if (!_visualItems->count()) {
         return;
     }
 
+    const int startIndex = _missionFlightStatusRecalcStart();
+    _flightStatusDirtyItems.clear();
+    _flightStatusDirtyAll = false;
+    if (startIndex < 0) {
+        return;
+    }
+
+    const MissionFlightStatus_t previousStatus = _missionFlightStatus;
+    const double previousMinAMSLAltitude = _minAMSLAltitude;
+    const double previousMaxAMSLAltitude = _maxAMSLAltitude;
+
     bool                firstCoordinateItem =           true;
     VisualMissionItem*  lastFlyThroughVI =   qobject_cast<VisualMissionItem*>(_visualItems->get(0));
 
     bool homePositionValid = _settingsItem->coordinate().isValid();
 
-    qCDebug(MissionControllerLog) << "_recalcMissionFlightStatus";
+    qCDebug(MissionControllerLog) << "_recalcMissionFlightStatus startIndex:count" << startIndex << _visualItems->count();
 
     // If home position is valid we can calculate distances between all waypoints.
     // If home position is not valid we can only calculate distances between waypoints which are
     // both relative altitude.
 
-    // No values for first item
-    lastFlyThroughVI->setAltDifference(0);
-    lastFlyThroughVI->setAzimuth(0);
-    lastFlyThroughVI->setDistance(0);
-    lastFlyThroughVI->setDistanceFromStart(0);
-
-    _minAMSLAltitude = _maxAMSLAltitude = qQNaN();
-
-    _resetMissionFlightStatus();
-
     bool   linkStartToHome =            false;
     bool   foundRTL =                   false;
     bool   pastLandCommand =            false;
     double totalHorizontalDistance =    0;
 
-    for (int i=0; i<_visualItems->count(); i++) {
+    if (startIndex == 0) {
+        // No values for first item
+        lastFlyThroughVI->setAltDifference(0);
+        lastFlyThroughVI->setAzimuth(0);
+        lastFlyThroughVI->setDistance(0);
+        lastFlyThroughVI->setDistanceFromStart(0);
+
+        _minAMSLAltitude = _maxAMSLAltitude = qQNaN();
+
+        _resetMissionFlightStatusValues();
+
+        _flightStatusCheckpoints.resize(_visualItems->count());
+    } else {
+        // Items before the first change are unaffected, pick up the walk where they left it
+        const FlightStatusCheckpoint_t& checkpoint = _flightStatusCheckpoints[startIndex];
+        lastFlyThroughVI =          checkpoint.lastFlyThroughVI;
+        _missionFlightStatus =      checkpoint.missionFlightStatus;
+        totalHorizontalDistance =   checkpoint.totalHorizontalDistance;
+        _minAMSLAltitude =          checkpoint.minAMSLAltitude;
+        _maxAMSLAltitude =          checkpoint.maxAMSLAltitude;
+        firstCoordinateItem =       checkpoint.firstCoordinateItem;
+        linkStartToHome =           checkpoint.linkStartToHome;
+        foundRTL =                  checkpoint.foundRTL;
+        pastLandCommand =           checkpoint.pastLandCommand;
+    }
+
+    for (int i=startIndex; i<_visualItems->count(); i++) {
         VisualMissionItem*  item =          qobject_cast<VisualMissionItem*>(_visualItems->get(i));
         SimpleMissionItem*  simpleItem =    qobject_cast<SimpleMissionItem*>(item);
         ComplexMissionItem* complexItem =   qobject_cast<ComplexMissionItem*>(item);
 
+        _flightStatusCheckpoints[i] = {
+            item,
+            lastFlyThroughVI,
+            _missionFlightStatus,
+            totalHorizontalDistance,
+            _minAMSLAltitude,
+            _maxAMSLAltitude,
+            firstCoordinateItem,
+            linkStartToHome,
+            foundRTL,
+            pastLandCommand,
+        };
+
         if (simpleItem && simpleItem->mavCommand() == MAV_CMD_NAV_RETURN_TO_LAUNCH) {
             foundRTL = true;
         }
 
-        // Assume the worst
-        item->setAzimuth(0);
-        item->setDistance(0);
-        item->setDistanceFromStart(0);
+        // Assume the worst. These are only applied to the item once the final values are known to prevent signalling twice.
+        double itemAzimuth =            0;
+        double itemDistance =           0;
+        double itemDistanceFromStart =  0;
 
         // Gimbal states reflect the state AFTER executing the item
 
@@ -1646,7 +1781,7 @@ void MissionController::_recalcMissionFlightStatus()
                         // If the last waypoint was a land command, there's a discontinuity at this point
                         if (!lastFlyThroughVI->isLandCommand()) {
                             totalHorizontalDistance += distance;
-                            item->setDistance(distance);
+                            itemDistance = distance;
 
                             if (!pastLandCommand) {
                                 // Calculate time/distance
@@ -1657,8 +1792,8 @@ void MissionController::_recalcMissionFlightStatus()
                         }
 
                         item->setAltDifference(altDifference);
-                        item->setAzimuth(azimuth);
-                        item->setDistanceFromStart(totalHorizontalDistance);
+                        itemAzimuth = azimuth;
+                        itemDistanceFromStart = totalHorizontalDistance;
 
                         _missionFlightStatus.maxTelemetryDistance = qMax(_missionFlightStatus.maxTelemetryDistance, _calcDistanceToHome(item, _settingsItem));
                     }
@@ -1683,6 +1818,10 @@ void MissionController::_recalcMissionFlightStatus()
             }
         }
 
+        item->setAzimuth(itemAzimuth);
+        item->setDistance(itemDistance);
+        item->setDistanceFromStart(itemDistanceFromStart);
+
         // Speed, VTOL states changes are processed last since they take affect on the next item
 
         double newSpeed = item->specifiedFlightSpeed();
@@ -1759,22 +1898,12 @@ void MissionController::_recalcMissionFlightStatus()
         _maxAMSLAltitude = std::fmax(_maxAMSLAltitude, _settingsItem->plannedHomePositionAltitude()->rawValue().toDouble());
     }
 
-    emit missionMaxTelemetryChanged     (_missionFlightStatus.maxTelemetryDistance);
-    emit missionTotalDistanceChanged    (_missionFlightStatus.totalDistance);
-    emit missionPlannedDistanceChanged  (_missionFlightStatus.plannedDistance);
-    emit missionHoverDistanceChanged    (_missionFlightStatus.hoverDistance);
-    emit missionCruiseDistanceChanged   (_missionFlightStatus.cruiseDistance);
-    emit missionTimeChanged             ();
-    emit missionHoverTimeChanged        ();
-    emit missionCruiseTimeChanged       ();
-    emit batteryChangePointChanged      (_missionFlightStatus.batteryChangePoint);
-    emit batteriesRequiredChanged       (_missionFlightStatus.batteriesRequired);
-    emit minAMSLAltitudeChanged         (_minAMSLAltitude);
-    emit maxAMSLAltitudeChanged         (_maxAMSLAltitude);
-
-    // Walk the list again calculating altitude percentages
+    _emitMissionFlightStatusChanges(previousStatus, previousMinAMSLAltitude, previousMaxAMSLAltitude);
+
+    // Walk the list again calculating altitude percentages. If the altitude range is unchanged the items before the first change keep theirs.
+    const bool altRangeChanged = _flightStatusValueChanged(previousMinAMSLAltitude, _minAMSLAltitude) || _flightStatusValueChanged(previousMaxAMSLAltitude, _maxAMSLAltitude);
     double altRange = _maxAMSLAltitude - _minAMSLAltitude;
-    for (int i=0; i<_visualItems->count(); i++) {
+    for (int i=(altRangeChanged ? 0 : startIndex); i<_visualItems->count(); i++) {
         VisualMissionItem* item = qobject_cast<VisualMissionItem*>(_visualItems->get(i));
 
         if (item->specifiesCoordinate()) {
@@ -1803,7 +1932,8 @@ void MissionController::_recalcMissionFlightStatus()
 }
 
 // This will update the sequence numbers to be sequential starting from 0
-void MissionController::_recalcSequence(void)
+///     @param startIndex Visual item index to start at, items before it keep their sequence numbers
+void MissionController::_recalcSequence(int startIndex)
 {
     if (_inRecalcSequence) {
         // Don't let this call recurse due to signalling
@@ -1813,8 +1943,11 @@ void MissionController::_recalcSequence(void)
     // Setup ascending sequence numbers for all visual items
 
     _inRecalcSequence = true;
-    int sequenceNumber = 0;
-    for (int i=0; i<_visualItems->count(); i++) {
+    if (startIndex < 0 || startIndex >= _visualItems->count()) {
+        startIndex = 0;
+    }
+    int sequenceNumber = startIndex == 0 ? 0 : _visualItems->value<VisualMissionItem*>(startIndex)->sequenceNumber();
+    for (int i=startIndex; i<_visualItems->count(); i++) {
         VisualMissionItem* item = qobject_cast<VisualMissionItem*>(_visualItems->get(i));
         item->setSequenceNumber(sequenceNumber);
         sequenceNumber = item->lastSequenceNumber() + 1;
@@ -1883,6 +2016,9 @@ void MissionController::_setPlannedHomePositionFromFirstCoordinate(const QGeoCoo
 
 void MissionController::_recalcAllWithCoordinate(const QGeoCoordinate& coordinate)
 {
+    // Items may have moved, so the flight status checkpoints no longer line up with the visual items
+    _flightStatusDirtyAll = true;
+
     if (!_flyView) {
         _setPlannedHomePositionFromFirstCoordinate(coordinate);
     }
@@ -1958,14 +2094,16 @@ void MissionController::_initVisualItem(VisualMissionItem* visualItem)
     setDirty(false);
 
     connect(visualItem, &VisualMissionItem::specifiesCoordinateChanged,                 this, &MissionController::_recalcFlightPathSegmentsSignal,  Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::specifiedFlightSpeedChanged,                this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::specifiedGimbalYawChanged,                  this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::specifiedGimbalPitchChanged,                this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::specifiedVehicleYawChanged,                 this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::terrainAltitudeChanged,                     this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::additionalTimeDelayChanged,                 this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::currentVTOLModeChanged,                     this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(visualItem, &VisualMissionItem::lastSequenceNumberChanged,                  this, &MissionController::_recalcSequence);
+
+    auto recalcFlightStatus = [this, visualItem]() { _queueMissionFlightStatusRecalc(visualItem); };
+    connect(visualItem, &VisualMissionItem::specifiedFlightSpeedChanged,                this, recalcFlightStatus);
+    connect(visualItem, &VisualMissionItem::specifiedGimbalYawChanged,                  this, recalcFlightStatus);
+    connect(visualItem, &VisualMissionItem::specifiedGimbalPitchChanged,                this, recalcFlightStatus);
+    connect(visualItem, &VisualMissionItem::specifiedVehicleYawChanged,                 this, recalcFlightStatus);
+    connect(visualItem, &VisualMissionItem::terrainAltitudeChanged,                     this, recalcFlightStatus);
+    connect(visualItem, &VisualMissionItem::additionalTimeDelayChanged,                 this, recalcFlightStatus);
+    connect(visualItem, &VisualMissionItem::currentVTOLModeChanged,                     this, recalcFlightStatus);
+    connect(visualItem, &VisualMissionItem::lastSequenceNumberChanged,                  this, [this, visualItem]() { _recalcSequence(_visualItems->indexOf(visualItem)); });
 
     if (visualItem->isSimpleItem()) {
         // We need to track commandChanged on simple item since recalc has special handling for takeoff command
@@ -1978,10 +2116,10 @@ void MissionController::_initVisualItem(VisualMissionItem* visualItem)
     } else {
         ComplexMissionItem* complexItem = qobject_cast<ComplexMissionItem*>(visualItem);
         if (complexItem) {
-            connect(complexItem, &ComplexMissionItem::complexDistanceChanged,       this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-            connect(complexItem, &ComplexMissionItem::greatestDistanceToChanged,    this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-            connect(complexItem, &ComplexMissionItem::minAMSLAltitudeChanged,       this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-            connect(complexItem, &ComplexMissionItem::maxAMSLAltitudeChanged,       this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
+            connect(complexItem, &ComplexMissionItem::complexDistanceChanged,       this, recalcFlightStatus);
+            connect(complexItem, &ComplexMissionItem::greatestDistanceToChanged,    this, recalcFlightStatus);
+            connect(complexItem, &ComplexMissionItem::minAMSLAltitudeChanged,       this, recalcFlightStatus);
+            connect(complexItem, &ComplexMissionItem::maxAMSLAltitudeChanged,       this, recalcFlightStatus);
             connect(complexItem, &ComplexMissionItem::isIncompleteChanged,          this, &MissionController::_recalcFlightPathSegmentsSignal,  Qt::QueuedConnection);
         } else {
             qWarning() << "ComplexMissionItem not found";
@@ -2026,8 +2164,8 @@ void MissionController::_managerVehicleChanged(Vehicle* managerVehicle)
     connect(_missionManager, &MissionManager::lastCurrentIndexChanged,  this, &MissionController::resumeMissionIndexChanged);
     connect(_missionManager, &MissionManager::resumeMissionReady,       this, &MissionController::resumeMissionReady);
     connect(_missionManager, &MissionManager::resumeMissionUploadFail,  this, &MissionController::resumeMissionUploadFail);
-    connect(_managerVehicle, &Vehicle::defaultCruiseSpeedChanged,       this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
-    connect(_managerVehicle, &Vehicle::defaultHoverSpeedChanged,        this, &MissionController::_recalcMissionFlightStatusSignal, Qt::QueuedConnection);
+    connect(_managerVehicle, &Vehicle::defaultCruiseSpeedChanged,       this, [this]() { _queueMissionFlightStatusRecalc(nullptr); });
+    connect(_managerVehicle, &Vehicle::defaultHoverSpeedChanged,        this, [this]() { _queueMissionFlightStatusRecalc(nullptr); });
     connect(_managerVehicle, &Vehicle::vehicleTypeChanged,              this, &MissionController::complexMissionItemNamesChanged);
 
     emit complexMissionItemNamesChanged();
@@ -11,6 +11,7 @@
 
 #include <QtCore/QHash>
 #include <QtCore/QFile>
+#include <QtCore/QSet>
 #include <QtCore/QLoggingCategory>
 
 #include "PlanElementController.h"
@@ -331,7 +332,7 @@ private slots:
 
 private:
     void                    _init                               (void);
-    void                    _recalcSequence                     (void);
+    void                    _recalcSequence                     (int startIndex = 0);
     void                    _recalcChildItems                   (void);
     void                    _recalcAllWithCoordinate            (const QGeoCoordinate& coordinate);
     void                    _recalcROISpecialVisuals            (void);
@@ -352,6 +353,10 @@ private slots:
     void                    _scanForAdditionalSettings          (QmlObjectListModel* visualItems, PlanMasterController* masterController);
     void                    _setPlannedHomePositionFromFirstCoordinate(const QGeoCoordinate& clickCoordinate);
     void                    _resetMissionFlightStatus           (void);
+    void                    _resetMissionFlightStatusValues     (void);
+    void                    _queueMissionFlightStatusRecalc     (VisualMissionItem* changedItem);
+    int                     _missionFlightStatusRecalcStart     (void);
+    void                    _emitMissionFlightStatusChanges     (const MissionFlightStatus_t& previousStatus, double previousMinAMSLAltitude, double previousMaxAMSLAltitude);
     void                    _addHoverTime                       (double hoverTime, double hoverDistance, int waypointIndex);
     void                    _addCruiseTime                      (double cruiseTime, double cruiseDistance, int wayPointIndex);
     void                    _updateBatteryInfo                  (int waypointIndex);
@@ -368,11 +373,27 @@ private slots:
     void                    _firstItemAdded                     (void);
 
     static double           _calcDistanceToHome                 (VisualMissionItem* currentItem, VisualMissionItem* homeItem);
+    static bool             _flightStatusValueChanged           (double oldValue, double newValue);
     static double           _normalizeLat                       (double lat);
     static double           _normalizeLon                       (double lon);
     static bool             _convertToMissionItems              (QmlObjectListModel* visualMissionItems, QList<MissionItem*>& rgMissionItems, QObject* missionItemParent);
 
 private:
+    /// State of the flight status walk just before an item. Lets a recalc resume at the first changed item
+    /// instead of walking the whole mission again.
+    typedef struct {
+        VisualMissionItem*      item;
+        VisualMissionItem*      lastFlyThroughVI;
+        MissionFlightStatus_t   missionFlightStatus;
+        double                  totalHorizontalDistance;
+        double                  minAMSLAltitude;
+        double                  maxAMSLAltitude;
+        bool                    firstCoordinateItem;
+        bool                    linkStartToHome;
+        bool                    foundRTL;
+        bool                    pastLandCommand;
+    } FlightStatusCheckpoint_t;
+
     Vehicle*                    _controllerVehicle =            nullptr;
     Vehicle*                    _managerVehicle =               nullptr;
     MissionManager*             _missionManager =               nullptr;
@@ -411,6 +432,10 @@ private slots:
     double                      _maxAMSLAltitude =              0;
     bool                        _missionContainsVTOLTakeoff =   false;
 
+    QList<FlightStatusCheckpoint_t> _flightStatusCheckpoints;                   ///< One per visual item, from the last flight status recalc
+    QSet<VisualMissionItem*>        _flightStatusDirtyItems;                    ///< Items changed since the last flight status recalc
+    bool                            _flightStatusDirtyAll =         true;       ///< Next flight status recalc must walk the whole mission
+
     QGroundControlQmlGlobal::AltMode _globalAltMode = QGroundControlQmlGlobal::AltitudeModeRelative;
 
     static constexpr const char* _settingsGroup =                 "MissionController";
@@ -11,9 +11,13 @@
 
 #include "TransectStyleComplexItem.h"
 #include "SettingsFact.h"
+#include "SurveyTransectGenerator.h"
 
 #include <QtCore/QLoggingCategory>
 
+#include <atomic>
+#include <memory>
+
 Q_DECLARE_LOGGING_CATEGORY(SurveyComplexItemLog)
 
 class PlanMasterController;
@@ -27,6 +31,7 @@ class SurveyComplexItem : public TransectStyleComplexItem
     /// @param flyView true: Created for use in the Fly View, false: Created for use in the Plan View
     /// @param kmlOrShpFile Polygon comes from this file, empty for default polygon
     SurveyComplexItem(PlanMasterController* masterController, bool flyView, const QString& kmlOrShpFile);
+    ~SurveyComplexItem();
 
     Q_PROPERTY(Fact*            gridAngle              READ gridAngle              CONSTANT)
     Q_PROPERTY(Fact*            flyAlternateTransects  READ flyAlternateTransects  CONSTANT)
@@ -62,6 +67,9 @@ class SurveyComplexItem : public TransectStyleComplexItem
     ReadyForSaveState   readyForSaveState    (void) const final;
     double              additionalTimeDelay (void) const final;
 
+    /// true: A background rebuild of the transects is in progress, the current transects are from before the last change
+    bool transectsPending(void) const { return _transectsRebuildPending; }
+
     // Must match json spec for GridEntryLocation
     enum EntryLocation {
         EntryLocationFirst,
@@ -74,6 +82,9 @@ class SurveyComplexItem : public TransectStyleComplexItem
 
     static const QString name;
 
+    /// Transect rebuilds estimated at or above this cost run in the background, see SurveyTransectGenerator::estimateCost
+    static constexpr qint64 backgroundTransectsCost = 20000;
+
     static constexpr const char* jsonComplexItemTypeValue =   "survey";
     static constexpr const char* jsonV3ComplexItemTypeValue = "survey";
 
@@ -94,6 +105,10 @@ private slots:
     void _recalcCameraShots             (void) final;
 
 private:
+    // Overrides from TransectStyleComplexItem
+    bool _startRebuildTransectsPhase1   (void) final;
+    void _waitForTransects              (void) final;
+
     enum CameraTriggerCode {
         CameraTriggerNone,
         CameraTriggerOn,
@@ -101,21 +116,15 @@ private slots:
         CameraTriggerHoverAndCapture
     };
 
-    QPointF _rotatePoint(const QPointF& point, const QPointF& origin, double angle);
-    void _intersectLinesWithRect(const QList<QLineF>& lineList, const QRectF& boundRect, QList<QLineF>& resultLines);
-    void _intersectLinesWithPolygon(const QList<QLineF>& lineList, const QPolygonF& polygon, QList<QLineF>& resultLines);
-    void _adjustLineDirection(const QList<QLineF>& lineList, QList<QLineF>& resultLines);
+    SurveyTransectGenerator::Params _transectParams(void) const;
+    void _clearLoadedMissionItems(void);
+    void _cancelPendingTransects(void);
     bool _nextTransectCoord(const QList<QGeoCoordinate>& transectPoints, int pointIndex, QGeoCoordinate& coord);
     bool _appendMissionItemsWorker(QList<MissionItem*>& items, QObject* missionItemParent, int& seqNum, bool hasRefly, bool buildRefly);
-    void _optimizeTransectsForShortestDistance(const QGeoCoordinate& distanceCoord, QList<QList<QGeoCoordinate>>& transects);
     qreal _ccw(QPointF pt1, QPointF pt2, QPointF pt3);
     qreal _dp(QPointF pt1, QPointF pt2);
     void _swapPoints(QList<QPointF>& points, int index1, int index2);
-    void _reverseTransectOrder(QList<QList<QGeoCoordinate>>& transects);
-    void _reverseInternalTransectPoints(QList<QList<QGeoCoordinate>>& transects);
-    void _adjustTransectsToEntryPointLocation(QList<QList<QGeoCoordinate>>& transects);
     bool _gridAngleIsNorthSouthTransects();
-    double _clampGridAngle90(double gridAngle);
     bool _imagesEverywhere(void) const;
     bool _triggerCamera(void) const;
     bool _hasTurnaround(void) const;
@@ -124,16 +133,14 @@ private slots:
     bool _loadV3(const QJsonObject& complexObject, int sequenceNumber, QString& errorString);
     bool _loadV4V5(const QJsonObject& complexObject, int sequenceNumber, QString& errorString, int version, bool forPresets);
     void _saveCommon(QJsonObject& complexObject);
-    void _rebuildTransectsPhase1Worker(bool refly);
-    void _rebuildTransectsPhase1WorkerSinglePolygon(bool refly);
-    /// Adds to the _transects array from one polygon
-    void _rebuildTransectsFromPolygon(bool refly, const QPolygonF& polygon, const QGeoCoordinate& tangentOrigin, const QPointF* const transitionPoint);
 
 #if 0
     // Splitting polygons is not supported since this code would get stuck in a infinite loop
     // Code is left here in case someone wants to try to resurrect it
 
     void _rebuildTransectsPhase1WorkerSplitPolygons(bool refly);
+    /// Adds to the _transects array from one polygon
+    void _rebuildTransectsFromPolygon(bool refly, const QPolygonF& polygon, const QGeoCoordinate& tangentOrigin, const QPointF* const transitionPoint);
 
     // Decompose polygon into list of convex sub polygons
     void _PolygonDecomposeConvex(const QPolygonF& polygon, QList<QPolygonF>& decomposedPolygons);
@@ -149,6 +156,10 @@ private slots:
     SettingsFact    _splitConcavePolygonsFact;
     int             _entryPoint;
 
+    std::shared_ptr<std::atomic_bool>   _transectsCancel;                   ///< Cancel flag of the background rebuild in progress
+    quint64                             _transectsGeneration =      0;      ///< Results from an older generation are discarded
+    bool                                _transectsRebuildPending =  false;
+
     static constexpr const char* _jsonGridAngleKey =          "angle";
     static constexpr const char* _jsonEntryPointKey =         "entryLocation";
 
@@ -0,0 +1,465 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "SurveyTransectGenerator.h"
+#include "QGCGeo.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QtMath>
+
+#include <vector>
+
+QGC_LOGGING_CATEGORY(SurveyTransectGeneratorLog, "SurveyTransectGeneratorLog")
+
+namespace {
+    /// Transects are generated to be as long as the largest width/height of the bounding rect plus this fudge factor.
+    /// This way they will always be guaranteed to intersect with a polygon edge no matter what angle they are rotated to.
+    constexpr double kTransectFudge = 2000.0;
+
+    /// We can't let gridSpacing get too small otherwise we will end up with too many transects.
+    constexpr double kMinGridSpacing = 0.5;
+
+    /// Spacing used below kMinGridSpacing, which will cause a single transect to be added
+    constexpr double kSingleTransectGridSpacing = 100000;
+
+    double _gridSpacing(const SurveyTransectGenerator::Params& params)
+    {
+        return (params.gridSpacing < kMinGridSpacing) ? kSingleTransectGridSpacing : params.gridSpacing;
+    }
+
+    /// Converts the polygon to NED around its first vertex and closes it
+    QPolygonF _nedPolygon(const QList<QGeoCoordinate>& vertices)
+    {
+        const QGeoCoordinate& tangentOrigin = vertices.first();
+
+        QPolygonF polygon;
+        polygon.reserve(vertices.count() + 1);
+        for (int i=0; i<vertices.count(); i++) {
+            double y, x, down;
+            if (i == 0) {
+                // This avoids a nan calculation that comes out of convertGeoToNed
+                x = y = 0;
+            } else {
+                QGCGeo::convertGeoToNed(vertices[i], tangentOrigin, y, x, down);
+            }
+            polygon << QPointF(x, y);
+        }
+        polygon << polygon.first();
+
+        return polygon;
+    }
+}
+
+SurveyTransectGenerator::Transects SurveyTransectGenerator::generate(const Params& params, const std::atomic_bool* cancel)
+{
+    Transects transects;
+
+    if (params.polygon.count() < 3) {
+        return transects;
+    }
+
+    _appendPass(params, false /* refly */, transects, cancel);
+    if (params.refly90Degrees) {
+        _appendPass(params, true /* refly */, transects, cancel);
+    }
+
+    qCDebug(SurveyTransectGeneratorLog) << "generate transects" << transects.count() << "cancelled" << _cancelled(cancel);
+
+    return transects;
+}
+
+qint64 SurveyTransectGenerator::estimateCost(const Params& params)
+{
+    if (params.polygon.count() < 3) {
+        return 0;
+    }
+
+    // Every generated line costs a little, but only the ones crossing the polygon turn into transects and hover points
+    const QRectF boundingRect = _nedPolygon(params.polygon).boundingRect();
+    const double gridSpacing = _gridSpacing(params);
+    const double diagonal = qSqrt((boundingRect.width() * boundingRect.width()) + (boundingRect.height() * boundingRect.height()));
+    const qint64 lineCount = qCeil((qMax(boundingRect.width(), boundingRect.height()) + kTransectFudge) / gridSpacing);
+    const qint64 transectCount = qCeil(diagonal / gridSpacing) + 1;
+
+    qint64 cost = params.polygon.count() + lineCount + transectCount;
+    if (params.hoverAndCapture && (params.triggerDistance > 0)) {
+        cost += transectCount * qCeil(diagonal / params.triggerDistance);
+    }
+
+    return (params.refly90Degrees ? (cost * 2) : cost);
+}
+
+double SurveyTransectGenerator::clampGridAngle90(double gridAngle)
+{
+    // Clamp grid angle to -90<->90. This prevents transects from being rotated to a reversed order.
+    if (gridAngle > 90.0) {
+        gridAngle -= 180.0;
+    } else if (gridAngle < -90.0) {
+        gridAngle += 180;
+    }
+    return gridAngle;
+}
+
+void SurveyTransectGenerator::_appendPass(const Params& params, bool refly, Transects& result, const std::atomic_bool* cancel)
+{
+    if (_cancelled(cancel)) {
+        return;
+    }
+
+    const QGeoCoordinate tangentOrigin = params.polygon.first();
+    const QPolygonF polygon = _nedPolygon(params.polygon);
+
+    // Generate transects
+
+    const double gridSpacing = _gridSpacing(params);
+    double gridAngle = clampGridAngle90(params.gridAngle);
+    gridAngle += refly ? 90 : 0;
+    qCDebug(SurveyTransectGeneratorLog) << "_appendPass gridSpacing:gridAngle:refly" << gridSpacing << gridAngle << refly;
+
+    const QRectF boundingRect = polygon.boundingRect();
+    const QPointF boundingCenter = boundingRect.center();
+
+    // Create set of rotated parallel lines within the expanded bounding rect. Make the lines larger than the
+    // bounding box to guarantee intersection.
+    // They are initially generated with the transects flowing from west to east and then points within the transect north to south.
+
+    QList<QLineF> lineList;
+    const double maxWidth = qMax(boundingRect.width(), boundingRect.height()) + kTransectFudge;
+    const double halfWidth = maxWidth / 2.0;
+    const double firstTransectX = boundingCenter.x() - halfWidth;
+    double transectX = firstTransectX;
+    const double transectXMax = transectX + maxWidth;
+    lineList.reserve(qCeil(maxWidth / gridSpacing));
+    while (transectX < transectXMax) {
+        const double transectYTop = boundingCenter.y() - halfWidth;
+        const double transectYBottom = boundingCenter.y() + halfWidth;
+
+        lineList += QLineF(_rotatePoint(QPointF(transectX, transectYTop), boundingCenter, gridAngle), _rotatePoint(QPointF(transectX, transectYBottom), boundingCenter, gridAngle));
+        transectX += gridSpacing;
+    }
+
+    // Now intersect the lines with the polygon
+    QList<QLineF> intersectLines;
+    _intersectTransectsWithPolygon(lineList, firstTransectX, gridSpacing, boundingCenter, gridAngle, polygon, intersectLines, cancel);
+    if (_cancelled(cancel)) {
+        return;
+    }
+
+    // Less than two transects intersected with the polygon:
+    //      Create a single transect which goes through the center of the polygon
+    //      Intersect it with the polygon
+    if (intersectLines.count() < 2) {
+        QLineF firstLine = lineList.first();
+        const QPointF lineCenter = firstLine.pointAt(0.5);
+        const QPointF centerOffset = boundingCenter - lineCenter;
+        firstLine.translate(centerOffset);
+        lineList.clear();
+        lineList.append(firstLine);
+        intersectLines = lineList;
+        _intersectLinesWithPolygon(lineList, polygon, intersectLines);
+    }
+
+    // Make sure all lines are going the same direction. Polygon intersection leads to lines which
+    // can be in varied directions depending on the order of the intesecting sides.
+    QList<QLineF> resultLines;
+    _adjustLineDirection(intersectLines, resultLines);
+
+    // Convert from NED to Geo
+    QList<QList<QGeoCoordinate>> transects;
+    transects.reserve(resultLines.count());
+    for (const QLineF& line : resultLines) {
+        QGeoCoordinate          coord;
+        QList<QGeoCoordinate>   transect;
+
+        QGCGeo::convertNedToGeo(line.p1().y(), line.p1().x(), 0, tangentOrigin, coord);
+        transect.append(coord);
+        QGCGeo::convertNedToGeo(line.p2().y(), line.p2().x(), 0, tangentOrigin, coord);
+        transect.append(coord);
+
+        transects.append(transect);
+    }
+
+    if (transects.isEmpty()) {
+        return;
+    }
+
+    // Adjust to entry point location
+    if (params.reverseTransectPoints) {
+        _reverseInternalTransectPoints(transects);
+    }
+    if (params.reverseTransectOrder) {
+        _reverseTransectOrder(transects);
+    }
+
+    if (refly && !result.isEmpty()) {
+        _optimizeTransectsForShortestDistance(result.last().last().coord, transects);
+    }
+
+    if (params.flyAlternateTransects) {
+        QList<QList<QGeoCoordinate>> alternatingTransects;
+        for (int i=0; i<transects.count(); i++) {
+            if (!(i & 1)) {
+                alternatingTransects.append(transects[i]);
+            }
+        }
+        for (int i=transects.count()-1; i>0; i--) {
+            if (i & 1) {
+                alternatingTransects.append(transects[i]);
+            }
+        }
+        transects = alternatingTransects;
+    }
+
+    // Adjust to lawnmower pattern
+    // We must reverse the vertices for every other transect in order to make a lawnmower pattern
+    for (int i=1; i<transects.count(); i+=2) {
+        std::reverse(transects[i].begin(), transects[i].end());
+    }
+
+    // Convert to CoordInfo transects and append to result
+    result.reserve(result.count() + transects.count());
+    for (const QList<QGeoCoordinate>& transect : transects) {
+        QList<TransectStyleComplexItem::CoordInfo_t> coordInfoTransect;
+
+        coordInfoTransect.append({ transect[0], TransectStyleComplexItem::CoordTypeSurveyEntry });
+        coordInfoTransect.append({ transect[1], TransectStyleComplexItem::CoordTypeSurveyExit });
+
+        // For hover and capture we need points for each camera location within the transect
+        if (params.hoverAndCapture) {
+            const double transectLength = transect[0].distanceTo(transect[1]);
+            const double transectAzimuth = transect[0].azimuthTo(transect[1]);
+            if (params.triggerDistance < transectLength) {
+                const int cInnerHoverPoints = static_cast<int>(floor(transectLength / params.triggerDistance));
+                for (int i=0; i<cInnerHoverPoints; i++) {
+                    const QGeoCoordinate hoverCoord = transect[0].atDistanceAndAzimuth(params.triggerDistance * (i + 1), transectAzimuth);
+                    coordInfoTransect.insert(1 + i, { hoverCoord, TransectStyleComplexItem::CoordTypeInteriorHoverTrigger });
+                }
+            }
+        }
+
+        // Extend the transect ends for turnaround
+        if (params.turnaroundDistance > 0) {
+            QGeoCoordinate turnaroundCoord;
+
+            double azimuth = transect[0].azimuthTo(transect[1]);
+            turnaroundCoord = transect[0].atDistanceAndAzimuth(-params.turnaroundDistance, azimuth);
+            turnaroundCoord.setAltitude(qQNaN());
+            coordInfoTransect.prepend({ turnaroundCoord, TransectStyleComplexItem::CoordTypeTurnaround });
+
+            azimuth = transect.last().azimuthTo(transect[transect.count() - 2]);
+            turnaroundCoord = transect.last().atDistanceAndAzimuth(-params.turnaroundDistance, azimuth);
+            turnaroundCoord.setAltitude(qQNaN());
+            coordInfoTransect.append({ turnaroundCoord, TransectStyleComplexItem::CoordTypeTurnaround });
+        }
+
+        result.append(coordInfoTransect);
+    }
+}
+
+QPointF SurveyTransectGenerator::_rotatePoint(const QPointF& point, const QPointF& origin, double angle)
+{
+    QPointF rotated;
+    double radians = (M_PI / 180.0) * -angle;
+
+    rotated.setX(((point.x() - origin.x()) * cos(radians)) - ((point.y() - origin.y()) * sin(radians)) + origin.x());
+    rotated.setY(((point.x() - origin.x()) * sin(radians)) + ((point.y() - origin.y()) * cos(radians)) + origin.y());
+
+    return rotated;
+}
+
+void SurveyTransectGenerator::_intersectLinesWithPolygon(const QList<QLineF>& lineList, const QPolygonF& polygon, QList<QLineF>& resultLines)
+{
+    resultLines.clear();
+
+    for (const QLineF& line : lineList) {
+        QList<QPointF> intersections;
+
+        // Intersect the line with all the polygon edges
+        for (int j=0; j<polygon.count()-1; j++) {
+            QPointF intersectPoint;
+            const QLineF polygonLine(polygon[j], polygon[j+1]);
+            if (line.intersects(polygonLine, &intersectPoint) == QLineF::BoundedIntersection) {
+                if (!intersections.contains(intersectPoint)) {
+                    intersections.append(intersectPoint);
+                }
+            }
+        }
+
+        QLineF resultLine;
+        if (_furthestIntersections(line, intersections, resultLine)) {
+            resultLines += resultLine;
+        }
+    }
+}
+
+/// Same result as _intersectLinesWithPolygon for the parallel transect lines, but each line is only tested
+/// against the edges which span it instead of all of them. Rotated back by the grid angle, transect i lies on
+/// x = firstTransectX + i * gridSpacing, so the x range of an edge tells which transects it can cross.
+void SurveyTransectGenerator::_intersectTransectsWithPolygon(const QList<QLineF>& lineList, double firstTransectX, double gridSpacing, const QPointF& center, double gridAngle, const QPolygonF& polygon, QList<QLineF>& resultLines, const std::atomic_bool* cancel)
+{
+    resultLines.clear();
+
+    const int lineCount = lineList.count();
+    const int edgeCount = polygon.count() - 1;
+    if ((lineCount == 0) || (edgeCount <= 0)) {
+        return;
+    }
+
+    // Range of transects each edge may cross, padded by one to stay clear of rounding
+    std::vector<std::pair<int, int>> edgeLines(edgeCount);
+    std::vector<int> lineEdgeOffsets(lineCount + 1, 0);
+    QPointF previous = _rotatePoint(polygon[0], center, -gridAngle);
+    for (int j=0; j<edgeCount; j++) {
+        const QPointF next = _rotatePoint(polygon[j+1], center, -gridAngle);
+        const double minX = qMin(previous.x(), next.x());
+        const double maxX = qMax(previous.x(), next.x());
+        const int first = qBound(0, static_cast<int>(qFloor((minX - firstTransectX) / gridSpacing)) - 1, lineCount);
+        const int last = qBound(-1, static_cast<int>(qCeil((maxX - firstTransectX) / gridSpacing)) + 1, lineCount - 1);
+        edgeLines[j] = { first, last };
+        for (int i=first; i<=last; i++) {
+            lineEdgeOffsets[i + 1]++;
+        }
+        previous = next;
+    }
+
+    // Edges of each line, in polygon order since that decides which intersections are kept
+    for (int i=0; i<lineCount; i++) {
+        lineEdgeOffsets[i + 1] += lineEdgeOffsets[i];
+    }
+    std::vector<int> lineEdges(lineEdgeOffsets[lineCount]);
+    std::vector<int> fill(lineEdgeOffsets.begin(), lineEdgeOffsets.end() - 1);
+    for (int j=0; j<edgeCount; j++) {
+        for (int i=edgeLines[j].first; i<=edgeLines[j].second; i++) {
+            lineEdges[fill[i]++] = j;
+        }
+    }
+
+    QList<QPointF> intersections;
+    for (int i=0; i<lineCount; i++) {
+        if (((i & 0xFF) == 0) && _cancelled(cancel)) {
+            return;
+        }
+
+        const QLineF& line = lineList[i];
+        intersections.clear();
+        for (int k=lineEdgeOffsets[i]; k<lineEdgeOffsets[i + 1]; k++) {
+            const int j = lineEdges[k];
+            QPointF intersectPoint;
+            const QLineF polygonLine(polygon[j], polygon[j+1]);
+            if (line.intersects(polygonLine, &intersectPoint) == QLineF::BoundedIntersection) {
+                if (!intersections.contains(intersectPoint)) {
+                    intersections.append(intersectPoint);
+                }
+            }
+        }
+
+        QLineF resultLine;
+        if (_furthestIntersections(line, intersections, resultLine)) {
+            resultLines += resultLine;
+        }
+    }
+}
+
+/// We have one or more intersection points all along the same line. Find the two
+/// which are furthest away from each other to form the transect.
+bool SurveyTransectGenerator::_furthestIntersections(const QLineF& line, const QList<QPointF>& intersections, QLineF& resultLine)
+{
+    if (intersections.count() < 2) {
+        return false;
+    }
+
+    // The points are on the line, so the furthest pair are the two extremes along it. The one found first comes first.
+    const QPointF direction = line.p2() - line.p1();
+    int minIndex = 0;
+    int maxIndex = 0;
+    double minProjection = QPointF::dotProduct(intersections[0] - line.p1(), direction);
+    double maxProjection = minProjection;
+    for (int i=1; i<intersections.count(); i++) {
+        const double projection = QPointF::dotProduct(intersections[i] - line.p1(), direction);
+        if (projection < minProjection) {
+            minProjection = projection;
+            minIndex = i;
+        } else if (projection > maxProjection) {
+            maxProjection = projection;
+            maxIndex = i;
+        }
+    }
+
+    if (minIndex == maxIndex) {
+        return false;
+    }
+
+    resultLine = QLineF(intersections[qMin(minIndex, maxIndex)], intersections[qMax(minIndex, maxIndex)]);
+    return true;
+}
+
+/// Adjust the line segments such that they are all going the same direction with respect to going from P1->P2
+void SurveyTransectGenerator::_adjustLineDirection(const QList<QLineF>& lineList, QList<QLineF>& resultLines)
+{
+    qreal firstAngle = 0;
+    resultLines.reserve(lineList.count());
+    for (int i=0; i<lineList.count(); i++) {
+        const QLineF& line = lineList[i];
+
+        if (i == 0) {
+            firstAngle = line.angle();
+        }
+
+        if (qAbs(line.angle() - firstAngle) > 1.0) {
+            resultLines += QLineF(line.p2(), line.p1());
+        } else {
+            resultLines += line;
+        }
+    }
+}
+
+/// Reverse the order of the transects. First transect becomes last and so forth.
+void SurveyTransectGenerator::_reverseTransectOrder(QList<QList<QGeoCoordinate>>& transects)
+{
+    std::reverse(transects.begin(), transects.end());
+}
+
+/// Reverse the order of all points withing each transect, First point becomes last and so forth.
+void SurveyTransectGenerator::_reverseInternalTransectPoints(QList<QList<QGeoCoordinate>>& transects)
+{
+    for (QList<QGeoCoordinate>& transect : transects) {
+        std::reverse(transect.begin(), transect.end());
+    }
+}
+
+/// Reorders the transects such that the first transect is the shortest distance to the specified coordinate
+/// and the first point within that transect is the shortest distance to the specified coordinate.
+///     @param distanceCoord Coordinate to measure distance against
+///     @param transects Transects to test and reorder
+void SurveyTransectGenerator::_optimizeTransectsForShortestDistance(const QGeoCoordinate& distanceCoord, QList<QList<QGeoCoordinate>>& transects)
+{
+    double rgTransectDistance[4];
+    rgTransectDistance[0] = transects.first().first().distanceTo(distanceCoord);
+    rgTransectDistance[1] = transects.first().last().distanceTo(distanceCoord);
+    rgTransectDistance[2] = transects.last().first().distanceTo(distanceCoord);
+    rgTransectDistance[3] = transects.last().last().distanceTo(distanceCoord);
+
+    int shortestIndex = 0;
+    double shortestDistance = rgTransectDistance[0];
+    for (int i=1; i<3; i++) {
+        if (rgTransectDistance[i] < shortestDistance) {
+            shortestIndex = i;
+            shortestDistance = rgTransectDistance[i];
+        }
+    }
+
+    if (shortestIndex > 1) {
+        // We need to reverse the order of segments
+        _reverseTransectOrder(transects);
+    }
+    if (shortestIndex & 1) {
+        // We need to reverse the points within each segment
+        _reverseInternalTransectPoints(transects);
+    }
+}
@@ -0,0 +1,63 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QLineF>
+#include <QtCore/QLoggingCategory>
+#include <QtGui/QPolygonF>
+#include <QtPositioning/QGeoCoordinate>
+
+#include <atomic>
+
+#include "TransectStyleComplexItem.h"
+
+Q_DECLARE_LOGGING_CATEGORY(SurveyTransectGeneratorLog)
+
+/// Generates the transects of a survey from plain geometry, so it can run on any thread.
+/// All inputs are copied into Params up front, nothing refers back to the survey item.
+class SurveyTransectGenerator
+{
+public:
+    using Transects = QList<QList<TransectStyleComplexItem::CoordInfo_t>>;
+
+    struct Params {
+        QList<QGeoCoordinate>   polygon;
+        double                  gridAngle =             0;
+        double                  gridSpacing =           0;
+        bool                    reverseTransectPoints = false;  ///< Entry location is at the bottom
+        bool                    reverseTransectOrder =  false;  ///< Entry location is on the right
+        bool                    refly90Degrees =        false;
+        bool                    flyAlternateTransects = false;
+        bool                    hoverAndCapture =       false;  ///< Adds a hover point at each camera location
+        double                  triggerDistance =       0;
+        double                  turnaroundDistance =    0;
+    };
+
+    /// @param cancel Generation stops early once this is set, the result is then incomplete
+    static Transects generate(const Params& params, const std::atomic_bool* cancel = nullptr);
+
+    /// Rough amount of work generate will do for these params, used to decide whether to run it in the background
+    static qint64 estimateCost(const Params& params);
+
+    static double clampGridAngle90(double gridAngle);
+
+private:
+    static void     _appendPass                         (const Params& params, bool refly, Transects& result, const std::atomic_bool* cancel);
+    static QPointF  _rotatePoint                        (const QPointF& point, const QPointF& origin, double angle);
+    static void     _intersectLinesWithPolygon          (const QList<QLineF>& lineList, const QPolygonF& polygon, QList<QLineF>& resultLines);
+    static void     _intersectTransectsWithPolygon      (const QList<QLineF>& lineList, double firstTransectX, double gridSpacing, const QPointF& center, double gridAngle, const QPolygonF& polygon, QList<QLineF>& resultLines, const std::atomic_bool* cancel);
+    static bool     _furthestIntersections              (const QLineF& line, const QList<QPointF>& intersections, QLineF& resultLine);
+    static void     _adjustLineDirection                (const QList<QLineF>& lineList, QList<QLineF>& resultLines);
+    static void     _reverseTransectOrder               (QList<QList<QGeoCoordinate>>& transects);
+    static void     _reverseInternalTransectPoints      (QList<QList<QGeoCoordinate>>& transects);
+    static void     _optimizeTransectsForShortestDistance(const QGeoCoordinate& distanceCoord, QList<QList<QGeoCoordinate>>& transects);
+    static bool     _cancelled                          (const std::atomic_bool* cancel) { return cancel && cancel->load(std::memory_order_relaxed); }
+};
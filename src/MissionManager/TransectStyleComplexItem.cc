@@ -388,12 +388,31 @@ void TransectStyleComplexItem::_rebuildTransects(void)
         return;
     }
 
+    if (_startRebuildTransectsPhase1()) {
+        // Phase 2 runs once the background rebuild hands back the new transects
+        return;
+    }
+
     _transects.clear();
     _rgPathHeightInfo.clear();
     _rgFlightPathCoordInfo.clear();
 
     _rebuildTransectsPhase1();
+    _rebuildTransectsPhase2();
+}
 
+void TransectStyleComplexItem::_setRebuiltTransects(const QList<QList<CoordInfo_t>>& transects)
+{
+    _transects = transects;
+    _rgPathHeightInfo.clear();
+    _rgFlightPathCoordInfo.clear();
+
+    _rebuildTransectsPhase2();
+}
+
+/// Builds the flight path, visuals and stats from the new _transects
+void TransectStyleComplexItem::_rebuildTransectsPhase2(void)
+{
     _minAMSLAltitude = _maxAMSLAltitude = qQNaN();
 
     switch (_cameraCalc.distanceMode()) {
@@ -1108,6 +1127,8 @@ void TransectStyleComplexItem::_handleHoverAndCaptureEnabled(QVariant enabled)
 
 void TransectStyleComplexItem::appendMissionItems(QList<MissionItem*>& items, QObject* missionItemParent)
 {
+    _waitForTransects();
+
     if (_loadedMissionItems.count()) {
         // We have mission items from the loaded plan, use those
         _appendLoadedMissionItems(items, missionItemParent);
@@ -1310,6 +1331,8 @@ void TransectStyleComplexItem::_appendLoadedMissionItems(QList<MissionItem*>& it
 
 void TransectStyleComplexItem::addKMLVisuals(KMLPlanDomDocument& domDocument)
 {
+    _waitForTransects();
+
     // We add the survey area polygon as a Placemark
 
     QDomElement placemarkElement = domDocument.addPlacemark(QStringLiteral("Survey Area"), true);
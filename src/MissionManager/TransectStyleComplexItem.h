@@ -46,6 +46,20 @@ class TransectStyleComplexItem : public ComplexMissionItem
     Q_PROPERTY(Fact*            terrainAdjustMaxDescentRate READ terrainAdjustMaxDescentRate                        CONSTANT)
     Q_PROPERTY(Fact*            terrainAdjustMaxClimbRate   READ terrainAdjustMaxClimbRate                          CONSTANT)
 
+    enum CoordType {
+        CoordTypeInterior,              ///< Interior waypoint for flight path only (example: interior corridor point)
+        CoordTypeInteriorHoverTrigger,  ///< Interior waypoint for hover and capture trigger
+        CoordTypeInteriorTerrainAdded,  ///< Interior waypoint added for terrain
+        CoordTypeSurveyEntry,           ///< Waypoint at entry edge of survey polygon
+        CoordTypeSurveyExit,            ///< Waypoint at exit edge of survey polygon
+        CoordTypeTurnaround,            ///< Turnaround extension waypoint
+    };
+
+    typedef struct {
+        QGeoCoordinate  coord;
+        CoordType       coordType;
+    } CoordInfo_t;
+
     QGCMapPolygon*  surveyAreaPolygon   (void) { return &_surveyAreaPolygon; }
     CameraCalc*     cameraCalc          (void) { return &_cameraCalc; }
     QVariantList    visualTransectPoints(void) { return _visualTransectPoints; }
@@ -138,6 +152,17 @@ protected slots:
     virtual void _rebuildTransectsPhase1    (void) = 0; ///< Rebuilds the _transects array
     virtual void _recalcCameraShots         (void) = 0;
 
+    /// Gives derived classes the chance to rebuild _transects in the background instead of through _rebuildTransectsPhase1.
+    /// The derived class then hands over the result through _setRebuiltTransects.
+    ///     @return true: rebuild was started in the background
+    virtual bool _startRebuildTransectsPhase1(void) { return false; }
+
+    /// Blocks until any background rebuild started by _startRebuildTransectsPhase1 has been applied
+    virtual void _waitForTransects          (void) { }
+
+    void    _setRebuiltTransects            (const QList<QList<CoordInfo_t>>& transects);
+    void    _rebuildTransectsPhase2         (void);
+
     void    _save                           (QJsonObject& saveObject);
     bool    _load                           (const QJsonObject& complexObject, bool forPresets, QString& errorString);
     void    _setExitCoordinate              (const QGeoCoordinate& coordinate);
@@ -159,20 +184,6 @@ protected slots:
     QGeoCoordinate      _exitCoordinate;
     QGCMapPolygon       _surveyAreaPolygon;
 
-    enum CoordType {
-        CoordTypeInterior,              ///< Interior waypoint for flight path only (example: interior corridor point)
-        CoordTypeInteriorHoverTrigger,  ///< Interior waypoint for hover and capture trigger
-        CoordTypeInteriorTerrainAdded,  ///< Interior waypoint added for terrain
-        CoordTypeSurveyEntry,           ///< Waypoint at entry edge of survey polygon
-        CoordTypeSurveyExit,            ///< Waypoint at exit edge of survey polygon
-        CoordTypeTurnaround,            ///< Turnaround extension waypoint
-    };
-
-    typedef struct {
-        QGeoCoordinate  coord;
-        CoordType       coordType;
-    } CoordInfo_t;
-
     QVariantList                                _visualTransectPoints;                          ///< Used to draw the flight path visuals on the screen
     QList<QList<CoordInfo_t>>                   _transects;
     QList<TerrainPathQuery::PathHeightInfo_t>   _rgPathHeightInfo;                              ///< Path height for each segment includes turn segments
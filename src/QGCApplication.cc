@@ -44,6 +44,7 @@
 #include "GeoTagController.h"
 #include "GimbalController.h"
 #include "GPSRtk.h"
+#include "HeadlessLogReplay.h"
 #include "JoystickConfigController.h"
 #include "JoystickManager.h"
 #include "JsonHelper.h"
@@ -118,6 +119,7 @@ QGCApplication::QGCApplication(int &argc, char *argv[], bool unitTesting, bool s
     bool fClearCache = false;           // Clear parameter/airframe caches
     bool logging = false;               // Turn on logging
     QString loggingOptions;
+    bool replayLog = false;             // Replay a log without the UI
 
     CmdLineOpt_t rgCmdLineOptions[] = {
         { "--clear-settings",   &fClearSettingsOptions, nullptr },
@@ -125,6 +127,7 @@ QGCApplication::QGCApplication(int &argc, char *argv[], bool unitTesting, bool s
         { "--logging",          &logging,               &loggingOptions },
         { "--fake-mobile",      &_fakeMobile,           nullptr },
         { "--log-output",       &_logOutput,            nullptr },
+        { "--replay-log",       &replayLog,             &_replayLogFilename },
         // Add additional command line option flags here
     };
 
@@ -332,7 +335,11 @@ void QGCApplication::init()
         // to make sure it works and verfies plugin availability.
         _initVideo();
     } else if (!_runningUnitTests) {
-        _initForNormalAppBoot();
+        if (_replayLogFilename.isEmpty()) {
+            _initForNormalAppBoot();
+        } else {
+            _initForHeadlessLogReplay();
+        }
     }
 }
 
@@ -417,6 +424,23 @@ void QGCApplication::_initForNormalAppBoot()
     LinkManager::instance()->startAutoConnectedLinks();
 }
 
+void QGCApplication::_initForHeadlessLogReplay()
+{
+    // Only what it takes to turn the log into vehicles, no links are auto-connected
+    QGCCorePlugin::instance()->init();
+    MAVLinkProtocol::instance()->init();
+    MultiVehicleManager::instance()->init();
+    QGCPositionManager::instance()->init();
+
+    HeadlessLogReplay *const replay = new HeadlessLogReplay(_replayLogFilename, this);
+    (void) connect(replay, &HeadlessLogReplay::finished, this, [](bool success) {
+        QCoreApplication::exit(success ? 0 : 1);
+    }, Qt::QueuedConnection);
+
+    // Exiting only works once the event loop runs
+    (void) QMetaObject::invokeMethod(replay, &HeadlessLogReplay::start, Qt::QueuedConnection);
+}
+
 void QGCApplication::deleteAllSettingsNextBoot()
 {
     QSettings settings;
@@ -658,7 +682,7 @@ void QGCApplication::CompressedSignalList::add(const QMetaMethod &method)
     const int signalIndex = _signalIndex(method);
 
     if (signalIndex != -1 && !contains(metaObject, signalIndex)) {
-        _signalMap[method.enclosingMetaObject()].insert(signalIndex);
+        _signalMap[method.enclosingMetaObject()].insert(signalIndex, 0);
     }
 }
 
@@ -677,19 +701,47 @@ void QGCApplication::CompressedSignalList::remove(const QMetaMethod &method)
 
 bool QGCApplication::CompressedSignalList::contains(const QMetaObject *metaObject, int signalIndex)
 {
-    return _signalMap.contains(metaObject) && _signalMap[metaObject].contains(signalIndex);
+    const auto it = _signalMap.constFind(metaObject);
+    return (it != _signalMap.constEnd()) && it->contains(signalIndex);
+}
+
+quint64 QGCApplication::CompressedSignalList::compressedCount(const QMetaMethod &method) const
+{
+    return _signalMap.value(method.enclosingMetaObject()).value(_signalIndex(method), 0);
 }
 
 void QGCApplication::addCompressedSignal(const QMetaMethod &method)
 {
+    const QMutexLocker locker(&_compressedSignalsMutex);
     _compressedSignals.add(method);
 }
 
 void QGCApplication::removeCompressedSignal(const QMetaMethod &method)
 {
+    const QMutexLocker locker(&_compressedSignalsMutex);
     _compressedSignals.remove(method);
 }
 
+quint64 QGCApplication::compressedSignalCount(const QMetaMethod &method)
+{
+    const QMutexLocker locker(&_compressedSignalsMutex);
+    return _compressedSignals.compressedCount(method);
+}
+
+qsizetype QGCApplication::_findPendingCompressedEvent(const QPostEventList *postedEvents, const PendingCompressedEvent_t &pendingEvent)
+{
+    // Events are only ever removed in front of a pending event when Qt compacts the list after sending posted events,
+    // so if it is no longer at the recorded index it can only have moved towards the front. Only list entries are
+    // dereferenced, the recorded event pointer may be stale.
+    for (qsizetype i = qMin(pendingEvent.index, postedEvents->size() - 1); i >= 0; i--) {
+        if (postedEvents->at(i).event == pendingEvent.event) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
 bool QGCApplication::compressEvent(QEvent *event, QObject *receiver, QPostEventList *postedEvents)
 {
     if (event->type() != QEvent::MetaCall) {
@@ -697,41 +749,92 @@ bool QGCApplication::compressEvent(QEvent *event, QObject *receiver, QPostEventL
     }
 
     const QMetaCallEvent *mce = static_cast<QMetaCallEvent*>(event);
-    if (!mce->sender() || !_compressedSignals.contains(mce->sender()->metaObject(), mce->signalId())) {
+    if (!mce->sender()) {
         return QApplication::compressEvent(event, receiver, postedEvents);
     }
 
-    for (QPostEventList::iterator it = postedEvents->begin(); it != postedEvents->end(); ++it) {
-        QPostEvent &cur = *it;
-        if (cur.receiver != receiver || cur.event == 0 || cur.event->type() != event->type()) {
-            continue;
-        }
-        const QMetaCallEvent *cur_mce = static_cast<QMetaCallEvent*>(cur.event);
-        if (cur_mce->sender() != mce->sender() || cur_mce->signalId() != mce->signalId() || cur_mce->id() != mce->id()) {
-            continue;
-        }
-        /* Keep The Newest Call */
-        // We can't merely qSwap the existing posted event with the new one, since QEvent
-        // keeps track of whether it has been posted. Deletion of a formerly posted event
-        // takes the posted event list mutex and does a useless search of the posted event
-        // list upon deletion. We thus clear the QEvent::posted flag before deletion.
-        struct EventHelper : private QEvent {
-            static void clearPostedFlag(QEvent * ev) {
-                (&static_cast<EventHelper*>(ev)->t)[1] &= ~0x8001; // Hack to clear QEvent::posted
+    const QMutexLocker locker(&_compressedSignalsMutex);
+
+    const QMetaObject *const senderMetaObject = mce->sender()->metaObject();
+    if (!_compressedSignals.contains(senderMetaObject, mce->signalId())) {
+        return QApplication::compressEvent(event, receiver, postedEvents);
+    }
+
+    // Rather than searching the whole posted event list for an older duplicate we remember where the last call for
+    // each (receiver, sender, signal, slot) was posted.
+    const CompressedEventKey_t key = { receiver, mce->sender(), mce->signalId(), mce->id() };
+    const auto pendingIt = _pendingCompressedEvents.find(key);
+    if (pendingIt != _pendingCompressedEvents.end()) {
+        const qsizetype index = _findPendingCompressedEvent(postedEvents, pendingIt.value());
+        if (index >= 0) {
+            QPostEvent &cur = (*postedEvents)[index];
+            const QMetaCallEvent *cur_mce = static_cast<QMetaCallEvent*>(cur.event);
+            if ((cur.receiver == receiver) && (cur.event->type() == event->type()) &&
+                (cur_mce->sender() == mce->sender()) && (cur_mce->signalId() == mce->signalId()) && (cur_mce->id() == mce->id())) {
+                /* Keep The Newest Call */
+                // We can't merely qSwap the existing posted event with the new one, since QEvent
+                // keeps track of whether it has been posted. Deletion of a formerly posted event
+                // takes the posted event list mutex and does a useless search of the posted event
+                // list upon deletion. We thus clear the QEvent::posted flag before deletion.
+                struct EventHelper : private QEvent {
+                    static void clearPostedFlag(QEvent * ev) {
+                        (&static_cast<EventHelper*>(ev)->t)[1] &= ~0x8001; // Hack to clear QEvent::posted
+                    }
+                };
+                EventHelper::clearPostedFlag(cur.event);
+                delete cur.event;
+                cur.event = event;
+                pendingIt->event = event;
+                pendingIt->index = index;
+                _compressedSignals.addCompressed(senderMetaObject, mce->signalId());
+                return true;
             }
-        };
-        EventHelper::clearPostedFlag(cur.event);
-        delete cur.event;
-        cur.event = event;
-        return true;
+        }
+    }
+
+    // Delivered calls are removed in notify. Calls dropped without delivery, for example because their receiver was
+    // deleted, are not. Start over once too many accumulate, worst case one duplicate call gets through.
+    if (_pendingCompressedEvents.size() >= _maxPendingCompressedEvents) {
+        _pendingCompressedEvents.clear();
     }
 
+    // Qt appends normal priority events to the end of the list once we return false
+    _pendingCompressedEvents.insert(key, { event, postedEvents->size() });
+    _pendingCompressedEventCount.store(_pendingCompressedEvents.size(), std::memory_order_relaxed);
+
     return false;
 }
 
+void QGCApplication::_removePendingCompressedEvent(const QObject *receiver, const QEvent *event)
+{
+    const QMetaCallEvent *mce = static_cast<const QMetaCallEvent*>(event);
+    if (!mce->sender()) {
+        return;
+    }
+
+    const QMutexLocker locker(&_compressedSignalsMutex);
+
+    // Only the newest call for a key has an entry, an older one may have been sent directly
+    const CompressedEventKey_t key = { receiver, mce->sender(), mce->signalId(), mce->id() };
+    const auto pendingIt = _pendingCompressedEvents.constFind(key);
+    if ((pendingIt != _pendingCompressedEvents.cend()) && (pendingIt->event == event)) {
+        (void) _pendingCompressedEvents.erase(pendingIt);
+        _pendingCompressedEventCount.store(_pendingCompressedEvents.size(), std::memory_order_relaxed);
+    }
+}
+
+bool QGCApplication::notify(QObject *receiver, QEvent *event)
+{
+    if ((event->type() == QEvent::MetaCall) && (_pendingCompressedEventCount.load(std::memory_order_relaxed) > 0)) {
+        _removePendingCompressedEvent(receiver, event);
+    }
+
+    return QApplication::notify(receiver, event);
+}
+
 bool QGCApplication::event(QEvent *e)
 {
-    if (e->type() == QEvent::Quit) {
+    if ((e->type() == QEvent::Quit) && _mainRootWindow) {
         // On OSX if the user selects Quit from the menu (or Command-Q) the ApplicationWindow does not signal closing. Instead you get a Quit event here only.
         // This in turn causes the standard QGC shutdown sequence to not run. So in this case we close the window ourselves such that the
         // signal is sent and the normal shutdown sequence runs.
@@ -10,13 +10,17 @@
 #pragma once
 
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtCore/QMutex>
 #include <QtCore/QSet>
 #include <QtCore/QTimer>
 #include <QtCore/QTranslator>
 
 #include <QtWidgets/QApplication>
 
+#include <atomic>
+
 class QQmlApplicationEngine;
 class QQuickWindow;
 class QGCImageProvider;
@@ -47,6 +51,7 @@ class QGCApplication : public QApplication
 
     /// Unit Test have access to creating and destroying singletons
     friend class UnitTest;
+    friend class CompressedSignalTest;
 public:
     QGCApplication(int &argc, char *argv[], bool unitTesting, bool simpleBootTest);
     ~QGCApplication();
@@ -60,6 +65,9 @@ class QGCApplication : public QApplication
     bool runningUnitTests() const { return _runningUnitTests; }
     bool simpleBootTest() const { return _simpleBootTest; }
 
+    /// @return true: Replaying a log from the command line without UI
+    bool headlessLogReplay() const { return !_replayLogFilename.isEmpty(); }
+
     /// Returns true if Qt debug output should be logged to a file
     bool logOutput() const { return _logOutput; }
 
@@ -82,8 +90,14 @@ class QGCApplication : public QApplication
 
     void removeCompressedSignal(const QMetaMethod &method);
 
+    /// @return Number of queued calls of the compressed signal which were dropped in favor of a newer duplicate
+    quint64 compressedSignalCount(const QMetaMethod &method);
+
     bool event(QEvent *e) final;
 
+    /// Drops the pending event table entry of a compressed call once it is delivered
+    bool notify(QObject *receiver, QEvent *event) final;
+
     static QString cachedParameterMetaDataFile();
     static QString cachedAirframeMetaDataFile();
 
@@ -133,6 +147,9 @@ private slots:
     /// Initialize the application for normal application boot. Or in other words we are not going to run unit tests.
     void _initForNormalAppBoot();
 
+    /// Initialize the application for replaying the --replay-log file without UI
+    void _initForHeadlessLogReplay();
+
     QObject *_rootQmlObject();
     void _checkForNewVersion();
 
@@ -145,6 +162,7 @@ private slots:
     QQmlApplicationEngine *_qmlAppEngine = nullptr;
     bool _logOutput = false;    ///< true: Log Qt debug output to file
     bool _fakeMobile = false;    ///< true: Fake ui into displaying mobile interface
+    QString _replayLogFilename;  ///< Log to replay as fast as possible without UI, then quit
     bool _settingsUpgraded = false;    ///< true: Settings format has been upgrade to new version
     int _majorVersion = 0;
     int _minorVersion = 0;
@@ -168,16 +186,48 @@ private slots:
         void remove(const QMetaMethod &method);
         bool contains(const QMetaObject *metaObject, int signalIndex);
 
+        /// Counts a queued call which was replaced by a newer duplicate
+        void addCompressed(const QMetaObject *metaObject, int signalIndex) { _signalMap[metaObject][signalIndex]++; }
+        quint64 compressedCount(const QMetaMethod &method) const;
+
     private:
         /// Returns a signal index that is can be compared to QMetaCallEvent.signalId
         static int _signalIndex(const QMetaMethod &method);
 
-        QMap<const QMetaObject*, QSet<int>> _signalMap;
+        QMap<const QMetaObject*, QMap<int /* signal index */, quint64 /* compressed count */>> _signalMap;
 
         Q_DISABLE_COPY(CompressedSignalList)
     };
 
+    /// Identifies queued calls which are duplicates of each other
+    struct CompressedEventKey_t {
+        const QObject *receiver;
+        const QObject *sender;
+        int signalId;
+        int slotId;
+
+        bool operator==(const CompressedEventKey_t &other) const {
+            return ((receiver == other.receiver) && (sender == other.sender) && (signalId == other.signalId) && (slotId == other.slotId));
+        }
+        friend size_t qHash(const CompressedEventKey_t &key, size_t seed = 0) {
+            return qHashMulti(seed, key.receiver, key.sender, key.signalId, key.slotId);
+        }
+    };
+
+    /// Last known location of a pending compressed call in its thread's posted event list
+    struct PendingCompressedEvent_t {
+        const QEvent *event;
+        qsizetype index;
+    };
+
+    static qsizetype _findPendingCompressedEvent(const QPostEventList *postedEvents, const PendingCompressedEvent_t &pendingEvent);
+    void _removePendingCompressedEvent(const QObject *receiver, const QEvent *event);
+
     CompressedSignalList _compressedSignals;
+    QHash<CompressedEventKey_t, PendingCompressedEvent_t> _pendingCompressedEvents;
+    QMutex _compressedSignalsMutex;                             ///< compressEvent is called from the posting thread
+    std::atomic<qsizetype> _pendingCompressedEventCount = 0;   ///< Lets notify skip the mutex while nothing is pending
+    static constexpr qsizetype _maxPendingCompressedEvents = 4096;   ///< Entries of calls dropped undelivered are cleared past this size
 
     const QString _settingsVersionKey = QStringLiteral("SettingsVersion"); ///< Settings key which hold settings version
     const QString _deleteAllSettingsKey = QStringLiteral("DeleteAllSettingsNextBoot"); ///< If this settings key is set on boot, all settings will be deleted
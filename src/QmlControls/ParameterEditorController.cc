@@ -23,6 +23,7 @@ ParameterEditorController::ParameterEditorController(QObject *parent)
     // qCDebug(ParameterEditorControllerLog) << Q_FUNC_INFO << this;
 
     _buildLists();
+    _buildSearchIndex();
 
     _searchTimer.setSingleShot(true);
     _searchTimer.setInterval(300);
@@ -123,8 +124,20 @@ void ParameterEditorController::_buildLists(void)
     }
 }
 
+void ParameterEditorController::_buildSearchIndex(void)
+{
+    _searchIndex.clear();
+    for (const QString& paramName: _parameterMgr->parameterNames(_vehicle->defaultComponentId())) {
+        _searchIndex.addFact(_parameterMgr->getParameter(_vehicle->defaultComponentId(), paramName));
+    }
+}
+
 void ParameterEditorController::_factAdded(int compId, Fact* fact)
 {
+    if (compId == _vehicle->defaultComponentId()) {
+        _searchIndex.addFact(fact);
+    }
+
     bool                        inserted = false;
     ParameterEditorCategory*    category = nullptr;
 
@@ -393,29 +406,9 @@ void ParameterEditorController::_performSearch(void)
         _searchParameters.beginReset();
         _searchParameters.clear();
 
-        for (const QString &paraName: _parameterMgr->parameterNames(_vehicle->defaultComponentId())) {
-            Fact* fact = _parameterMgr->getParameter(_vehicle->defaultComponentId(), paraName);
-            bool matched = _shouldShow(fact);
-            // All of the search items must match in order for the parameter to be added to the list
-            if (matched) {
-                for (const auto& searchItem : rgSearchStrings) {
-                    QRegularExpression re = QRegularExpression(searchItem, QRegularExpression::CaseInsensitiveOption);
-                    if (re.isValid()) {
-                        if (!fact->name().contains(re) &&
-                                !fact->shortDescription().contains(re) &&
-                                !fact->longDescription().contains(re)) {
-                            matched = false;
-                        }
-                    } else {
-                        if (!fact->name().contains(searchItem, Qt::CaseInsensitive) &&
-                                !fact->shortDescription().contains(searchItem, Qt::CaseInsensitive) &&
-                                !fact->longDescription().contains(searchItem, Qt::CaseInsensitive)) {
-                            matched = false;
-                        }
-                    }
-                }
-            }
-            if (matched) {
+        // All of the search items must match in order for the parameter to be added to the list
+        for (Fact* fact: _searchIndex.search(rgSearchStrings)) {
+            if (_shouldShow(fact)) {
                 _searchParameters.append(fact);
             }
         }
@@ -12,6 +12,7 @@
 #include "FactPanelController.h"
 #include "QmlObjectListModel.h"
 #include "FactMetaData.h"
+#include "ParameterSearchIndex.h"
 
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
@@ -140,6 +141,7 @@ private slots:
 
 private:
     bool _shouldShow(Fact *fact) const;
+    void _buildSearchIndex(void);
 
     void _performSearch();
 
@@ -156,6 +158,7 @@ private slots:
     QmlObjectListModel          _categories;
     QmlObjectListModel          _diffList;
     QmlObjectListModel          _searchParameters;
+    ParameterSearchIndex        _searchIndex;
     QmlObjectListModel*         _parameters             = nullptr;
     QMap<QString, ParameterEditorCategory*> _mapCategoryName2Category;
 };
@@ -0,0 +1,251 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ParameterSearchIndex.h"
+#include "Fact.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QRegularExpression>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+QGC_LOGGING_CATEGORY(ParameterSearchIndexLog, "qgc.qmlcontrols.parametersearchindex")
+
+void ParameterSearchIndex::clear()
+{
+    _facts.clear();
+    _foldedTexts.clear();
+    _tokens.clear();
+    _tokenIds.clear();
+    _tokenFactIds.clear();
+    _trigramTokenIds.clear();
+    _sortedByName = true;
+
+    _lastTerms.clear();
+    _lastMatches.clear();
+    _lastMatchesValid = false;
+}
+
+void ParameterSearchIndex::addFact(Fact *fact)
+{
+    const int factId = _facts.count();
+    if (!_facts.isEmpty() && (fact->name() < _facts.last()->name())) {
+        _sortedByName = false;
+    }
+    _facts.append(fact);
+
+    // Fields are separated by whitespace so a term can never match across two of them
+    const QString foldedText = (fact->name() + QLatin1Char('\n') + fact->shortDescription() + QLatin1Char('\n') + fact->longDescription()).toCaseFolded();
+    _foldedTexts.append(foldedText);
+
+    qsizetype tokenStart = -1;
+    for (qsizetype i = 0; i <= foldedText.size(); i++) {
+        if ((i == foldedText.size()) || foldedText.at(i).isSpace()) {
+            if (tokenStart >= 0) {
+                _addToken(QStringView(foldedText).sliced(tokenStart, i - tokenStart), factId);
+                tokenStart = -1;
+            }
+        } else if (tokenStart < 0) {
+            tokenStart = i;
+        }
+    }
+
+    _lastMatchesValid = false;
+}
+
+void ParameterSearchIndex::_addToken(QStringView token, int factId)
+{
+    int tokenId = 0;
+
+    const QString tokenString = token.toString();
+    const auto it = _tokenIds.constFind(tokenString);
+    if (it != _tokenIds.constEnd()) {
+        tokenId = it.value();
+    } else {
+        tokenId = _tokens.count();
+        _tokens.append(tokenString);
+        (void) _tokenIds.insert(tokenString, tokenId);
+        _tokenFactIds.append(IdList_t());
+
+        for (qsizetype i = 0; (i + 3) <= token.size(); i++) {
+            QList<int> &tokenIds = _trigramTokenIds[_trigram(token.data() + i)];
+            if (tokenIds.isEmpty() || (tokenIds.last() != tokenId)) {
+                tokenIds.append(tokenId);
+            }
+        }
+    }
+
+    // Fact ids only ever increase so the list stays sorted
+    IdList_t &factIds = _tokenFactIds[tokenId];
+    if (factIds.isEmpty() || (factIds.last() != factId)) {
+        factIds.append(factId);
+    }
+}
+
+QList<Fact*> ParameterSearchIndex::search(const QStringList &terms)
+{
+    // A narrower query only has to look at the previous matches. Each previous term must be contained in the
+    // matching new term for that to hold, which is the case when typing more characters or adding terms.
+    bool narrowed = _lastMatchesValid && (terms.count() >= _lastTerms.count());
+    for (qsizetype i = 0; narrowed && (i < _lastTerms.count()); i++) {
+        narrowed = _isLiteral(terms[i]) && terms[i].contains(_lastTerms[i], Qt::CaseInsensitive);
+    }
+
+    IdList_t matches;
+    bool haveMatches = false;
+    if (narrowed) {
+        matches = _lastMatches;
+        haveMatches = true;
+    }
+
+    bool allLiteral = true;
+    for (const QString &term : terms) {
+        const IdList_t *const candidates = haveMatches ? &matches : nullptr;
+        if (_isLiteral(term)) {
+            matches = _literalMatches(term.toCaseFolded(), candidates);
+        } else {
+            allLiteral = false;
+            matches = _regexMatches(term, candidates);
+        }
+        haveMatches = true;
+    }
+
+    if (!haveMatches) {
+        matches.resize(_facts.count());
+        std::iota(matches.begin(), matches.end(), 0);
+    }
+
+    qCDebug(ParameterSearchIndexLog) << "search" << terms << "narrowed:" << narrowed << "matches:" << matches.count();
+
+    _lastTerms = terms;
+    _lastMatches = matches;
+    _lastMatchesValid = allLiteral;
+
+    return _factsForIds(matches);
+}
+
+ParameterSearchIndex::IdList_t ParameterSearchIndex::_literalMatches(const QString &foldedTerm, const IdList_t *candidates) const
+{
+    IdList_t matches;
+
+    // Few candidates are cheaper to check directly. Terms containing whitespace can't be found through the tokens.
+    const bool hasSpace = std::any_of(foldedTerm.cbegin(), foldedTerm.cend(), [](QChar ch) { return ch.isSpace(); });
+    if (hasSpace || (candidates && (candidates->count() <= kVerifyCandidatesMax))) {
+        const auto check = [&](int factId) {
+            if (_foldedTexts[factId].contains(foldedTerm)) {
+                matches.append(factId);
+            }
+        };
+        if (candidates) {
+            std::for_each(candidates->cbegin(), candidates->cend(), check);
+        } else {
+            for (int factId = 0; factId < _facts.count(); factId++) {
+                check(factId);
+            }
+        }
+        return matches;
+    }
+
+    // Every token containing the term contains all of its trigrams, the rarest one gives the fewest tokens to check
+    const QList<int> *tokenIds = nullptr;
+    for (qsizetype i = 0; (i + 3) <= foldedTerm.size(); i++) {
+        const auto it = _trigramTokenIds.constFind(_trigram(foldedTerm.constData() + i));
+        if (it == _trigramTokenIds.constEnd()) {
+            return matches;
+        }
+        if (!tokenIds || (it->count() < tokenIds->count())) {
+            tokenIds = &it.value();
+        }
+    }
+
+    QList<bool> matched(_facts.count(), false);
+    const auto checkToken = [&](int tokenId) {
+        if (_tokens[tokenId].contains(foldedTerm)) {
+            for (const int factId : _tokenFactIds[tokenId]) {
+                matched[factId] = true;
+            }
+        }
+    };
+    if (tokenIds) {
+        std::for_each(tokenIds->cbegin(), tokenIds->cend(), checkToken);
+    } else {
+        // Terms shorter than a trigram are checked against every unique token
+        for (int tokenId = 0; tokenId < _tokens.count(); tokenId++) {
+            checkToken(tokenId);
+        }
+    }
+
+    if (candidates) {
+        std::copy_if(candidates->cbegin(), candidates->cend(), std::back_inserter(matches), [&](int factId) { return matched[factId]; });
+    } else {
+        for (int factId = 0; factId < _facts.count(); factId++) {
+            if (matched[factId]) {
+                matches.append(factId);
+            }
+        }
+    }
+
+    return matches;
+}
+
+ParameterSearchIndex::IdList_t ParameterSearchIndex::_regexMatches(const QString &term, const IdList_t *candidates) const
+{
+    IdList_t matches;
+
+    // Fields are matched separately, the same as a plain search of the fact
+    const QRegularExpression re(term, QRegularExpression::CaseInsensitiveOption);
+    const auto check = [&](int factId) {
+        const Fact *const fact = _facts[factId];
+        if (fact->name().contains(re) || fact->shortDescription().contains(re) || fact->longDescription().contains(re)) {
+            matches.append(factId);
+        }
+    };
+
+    if (candidates) {
+        std::for_each(candidates->cbegin(), candidates->cend(), check);
+    } else {
+        for (int factId = 0; factId < _facts.count(); factId++) {
+            check(factId);
+        }
+    }
+
+    return matches;
+}
+
+QList<Fact*> ParameterSearchIndex::_factsForIds(const IdList_t &ids) const
+{
+    QList<Fact*> facts;
+    facts.reserve(ids.count());
+    for (const int factId : ids) {
+        facts.append(_facts[factId]);
+    }
+
+    if (!_sortedByName) {
+        std::sort(facts.begin(), facts.end(), [](const Fact *fact1, const Fact *fact2) { return (fact1->name() < fact2->name()); });
+    }
+
+    return facts;
+}
+
+bool ParameterSearchIndex::_isLiteral(const QString &term)
+{
+    if (QRegularExpression::escape(term) == term) {
+        return true;
+    }
+
+    // Invalid expressions are matched as plain text
+    return !QRegularExpression(term).isValid();
+}
+
+quint64 ParameterSearchIndex::_trigram(const QChar *chars)
+{
+    return ((static_cast<quint64>(chars[0].unicode()) << 32) | (static_cast<quint64>(chars[1].unicode()) << 16) | chars[2].unicode());
+}
@@ -0,0 +1,68 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+class Fact;
+
+Q_DECLARE_LOGGING_CATEGORY(ParameterSearchIndexLog)
+
+/// Search index over the names and descriptions of a set of parameters.
+///
+/// The text of each parameter is split into whitespace separated tokens. Since search terms never contain
+/// whitespace a term matches a parameter exactly when it is a substring of one of the parameter's tokens, so only
+/// the much smaller set of unique tokens has to be searched. The tokens are found through a trigram index and each
+/// token maps to the parameters containing it. When a query narrows the previous one only the previous matches are
+/// searched again.
+class ParameterSearchIndex
+{
+public:
+    void clear();
+    void addFact(Fact *fact);
+
+    qsizetype count() const { return _facts.count(); }
+
+    /// Every term must match the name, short description or long description of a fact. A term is a case insensitive
+    /// substring, unless it is a valid regular expression containing special characters in which case it is matched
+    /// as such.
+    ///     @return Matching facts sorted by name, all facts if there are no terms
+    QList<Fact*> search(const QStringList &terms);
+
+private:
+    typedef QList<int> IdList_t; ///< Sorted fact ids
+
+    /// @return true: Term is matched as a plain substring
+    static bool _isLiteral(const QString &term);
+    static quint64 _trigram(const QChar *chars);
+
+    IdList_t _literalMatches(const QString &foldedTerm, const IdList_t *candidates) const;
+    IdList_t _regexMatches(const QString &term, const IdList_t *candidates) const;
+    void _addToken(QStringView token, int factId);
+    QList<Fact*> _factsForIds(const IdList_t &ids) const;
+
+    QList<Fact*> _facts;
+    QStringList _foldedTexts;                       ///< Case folded name and descriptions, by fact id
+    QStringList _tokens;                            ///< Unique case folded tokens of all texts
+    QHash<QString, int> _tokenIds;
+    QList<IdList_t> _tokenFactIds;                  ///< Facts containing each token
+    QHash<quint64, QList<int>> _trigramTokenIds;    ///< Tokens containing each trigram
+    bool _sortedByName = true;                      ///< Fact ids are in name order
+
+    QStringList _lastTerms;
+    IdList_t _lastMatches;
+    bool _lastMatchesValid = false;
+
+    static constexpr qsizetype kVerifyCandidatesMax = 64; ///< Smaller candidate sets are checked directly instead of going through the index
+};
@@ -19,6 +19,7 @@
 #include "QGCMapEngine.h"
 #include "QGCCachedTileSet.h"
 #include "QGCTileCacheWorker.h"
+#include "QGCTileFetchPool.h"
 #include "QGeoFileTileCacheQGC.h"
 #include "QGCMapTasks.h"
 #include "QGCTileSet.h"
@@ -42,6 +43,7 @@ QGCMapEngine *getQGCMapEngine()
 QGCMapEngine::QGCMapEngine(QObject *parent)
     : QObject(parent)
     , m_worker(new QGCCacheWorker(this))
+    , m_fetchPool(new QGCTileFetchPool(this))
 {
     // qCDebug(QGCMapEngineLog) << Q_FUNC_INFO << this;
 
@@ -52,11 +54,14 @@ QGCMapEngine::QGCMapEngine(QObject *parent)
     (void) qRegisterMetaType<QGCCacheTile>("QGCCacheTile");
 
     (void) connect(m_worker, &QGCCacheWorker::updateTotals, this, &QGCMapEngine::_updateTotals);
+    (void) connect(m_worker, &QGCCacheWorker::databaseAboutToBeReplaced, m_fetchPool, &QGCTileFetchPool::suspend, Qt::DirectConnection);
+    (void) connect(m_worker, &QGCCacheWorker::databaseReplaced, m_fetchPool, &QGCTileFetchPool::reopenDatabase, Qt::DirectConnection);
 }
 
 QGCMapEngine::~QGCMapEngine()
 {
     (void) disconnect(m_worker);
+    m_fetchPool->stop();
     m_worker->stop();
     m_worker->wait();
 
@@ -71,6 +76,7 @@ QGCMapEngine *QGCMapEngine::instance()
 void QGCMapEngine::init(const QString &databasePath)
 {
     m_worker->setDatabaseFile(databasePath);
+    m_fetchPool->setDatabaseFile(databasePath);
 
     QGCMapTask* const task = new QGCMapTask(QGCMapTask::taskInit);
     (void) addTask(task);
@@ -78,6 +84,12 @@ void QGCMapEngine::init(const QString &databasePath)
 
 bool QGCMapEngine::addTask(QGCMapTask *task)
 {
+    // Fetches are what the map is waiting for, they must not queue up behind saves and maintenance tasks
+    if ((task->type() == QGCMapTask::taskFetchTile) && m_worker->isValid()) {
+        m_fetchPool->enqueueTask(static_cast<QGCFetchTileTask*>(task));
+        return true;
+    }
+
     return m_worker->enqueueTask(task);
 }
 
@@ -26,6 +26,7 @@ Q_DECLARE_LOGGING_CATEGORY(QGCMapEngineLog)
 
 class QGCMapTask;
 class QGCCacheWorker;
+class QGCTileFetchPool;
 
 class QGCMapEngine : public QObject
 {
@@ -49,6 +50,7 @@ private slots:
 
 private:
     QGCCacheWorker *m_worker = nullptr;
+    QGCTileFetchPool *m_fetchPool = nullptr;
     bool m_prunning = false;
 };
 
@@ -22,6 +22,8 @@
 #include <QtCore/QQueue>
 #include <QtCore/QString>
 
+#include <atomic>
+
 #include "QGCTile.h"
 #include "QGCCacheTile.h"
 #include "QGCCachedTileSet.h"
@@ -131,9 +133,10 @@ class QGCFetchTileTask : public QGCMapTask
     Q_OBJECT
 
 public:
-    explicit QGCFetchTileTask(const QString &hash, QObject *parent = nullptr)
+    explicit QGCFetchTileTask(const QString &hash, int zoom = -1, QObject *parent = nullptr)
         : QGCMapTask(QGCMapTask::taskFetchTile, parent)
         , m_hash(hash)
+        , m_zoom(zoom)
     {}
     ~QGCFetchTileTask() = default;
 
@@ -143,12 +146,19 @@ class QGCFetchTileTask : public QGCMapTask
     }
 
     QString hash() const { return m_hash; }
+    int zoom() const { return m_zoom; }
+
+    /// Nobody waits for the tile anymore, it is skipped if still queued. Thread safe.
+    void cancel() { m_canceled = true; }
+    bool isCanceled() const { return m_canceled; }
 
 signals:
     void tileFetched(QGCCacheTile *tile);
 
 private:
     const QString m_hash;
+    const int m_zoom = -1;
+    std::atomic_bool m_canceled = false;
 };
 
 //-----------------------------------------------------------------------------
@@ -61,7 +61,8 @@ bool QGCCacheWorker::enqueueTask(QGCMapTask *task)
     if (isRunning()) {
         _waitc.wakeAll();
     } else {
-        start(QThread::HighPriority);
+        // Interactive fetches are served by QGCTileFetchPool, what is left here can wait
+        start(QThread::LowPriority);
     }
 
     return true;
@@ -78,6 +79,7 @@ void QGCCacheWorker::run()
 
     if (_valid) {
         if (_connectDB()) {
+            _prepareQueries();
             _deleteBingNoTileTiles();
         }
     }
@@ -85,11 +87,24 @@ void QGCCacheWorker::run()
     QMutexLocker lock(&_taskQueueMutex);
     while (true) {
         if (!_taskQueue.isEmpty()) {
-            QGCMapTask* const task = _taskQueue.dequeue();
+            QList<QGCMapTask*> tasks = { _taskQueue.dequeue() };
+            // Saves arrive in bursts while the map pans or a tile set downloads, commit them together.
+            // Only consecutive saves are merged so tasks still run in the order they were queued.
+            if (tasks.first()->type() == QGCMapTask::taskCacheTile) {
+                while (!_taskQueue.isEmpty() && (_taskQueue.head()->type() == QGCMapTask::taskCacheTile) && (tasks.size() < kMaxSaveBatch)) {
+                    tasks.append(_taskQueue.dequeue());
+                }
+            }
             lock.unlock();
-            _runTask(task);
+            if (tasks.first()->type() == QGCMapTask::taskCacheTile) {
+                _saveTiles(tasks);
+            } else {
+                _runTask(tasks.first());
+            }
             lock.relock();
-            task->deleteLater();
+            for (QGCMapTask *task : tasks) {
+                task->deleteLater();
+            }
 
             const qsizetype count = _taskQueue.count();
             if (count > 100) {
@@ -123,7 +138,7 @@ void QGCCacheWorker::_runTask(QGCMapTask *task)
     case QGCMapTask::taskInit:
         break;
     case QGCMapTask::taskCacheTile:
-        _saveTile(task);
+        _saveTiles({ task });
         break;
     case QGCMapTask::taskFetchTile:
         _getTile(task);
@@ -237,37 +252,46 @@ quint64 QGCCacheWorker::_getDefaultTileSet()
     return 1L;
 }
 
-void QGCCacheWorker::_saveTile(QGCMapTask *mtask)
+void QGCCacheWorker::_saveTiles(const QList<QGCMapTask*> &tasks)
 {
-    if (!_valid) {
+    if (!_valid || !_saveTileQuery) {
         qCWarning(QGCTileCacheWorkerLog) << "Map Cache SQL error (saveTile() open db):" << _db->lastError();
         return;
     }
 
-    QGCSaveTileTask *task = static_cast<QGCSaveTileTask*>(mtask);
-    QSqlQuery query(*_db);
-    (void) query.prepare("INSERT INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)");
-    query.addBindValue(task->tile()->hash());
-    query.addBindValue(task->tile()->format());
-    query.addBindValue(task->tile()->img());
-    query.addBindValue(task->tile()->img().size());
-    query.addBindValue(task->tile()->type());
-    query.addBindValue(QDateTime::currentSecsSinceEpoch());
-    if (!query.exec()) {
-        // Tile was already there.
-        // QtLocation some times requests the same tile twice in a row. The first is saved, the second is already there.
-        return;
-    }
+    // One transaction per batch, SQLite syncs on every commit
+    const bool transaction = _db->transaction();
+    const qint64 date = QDateTime::currentSecsSinceEpoch();
+
+    for (QGCMapTask *mtask : tasks) {
+        const QGCCacheTile *tile = static_cast<QGCSaveTileTask*>(mtask)->tile();
+        _saveTileQuery->bindValue(0, tile->hash());
+        _saveTileQuery->bindValue(1, tile->format());
+        _saveTileQuery->bindValue(2, tile->img());
+        _saveTileQuery->bindValue(3, tile->img().size());
+        _saveTileQuery->bindValue(4, tile->type());
+        _saveTileQuery->bindValue(5, date);
+        if (!_saveTileQuery->exec()) {
+            // Tile was already there.
+            // QtLocation some times requests the same tile twice in a row. The first is saved, the second is already there.
+            continue;
+        }
 
-    const quint64 tileID = query.lastInsertId().toULongLong();
-    const quint64 setID = task->tile()->tileSet() == UINT64_MAX ? _getDefaultTileSet() : task->tile()->tileSet();
-    const QString s = QStringLiteral("INSERT INTO SetTiles(tileID, setID) VALUES(%1, %2)").arg(tileID).arg(setID);
-    (void) query.prepare(s);
-    if (!query.exec()) {
-        qCWarning(QGCTileCacheWorkerLog) << "Map Cache SQL error (add tile into SetTiles):" << query.lastError().text();
+        const quint64 tileID = _saveTileQuery->lastInsertId().toULongLong();
+        const quint64 setID = tile->tileSet() == UINT64_MAX ? _getDefaultTileSet() : tile->tileSet();
+        _saveSetTileQuery->bindValue(0, tileID);
+        _saveSetTileQuery->bindValue(1, setID);
+        if (!_saveSetTileQuery->exec()) {
+            qCWarning(QGCTileCacheWorkerLog) << "Map Cache SQL error (add tile into SetTiles):" << _saveSetTileQuery->lastError().text();
+        }
+
+        qCDebug(QGCTileCacheWorkerLog) << "HASH:" << tile->hash();
     }
 
-    qCDebug(QGCTileCacheWorkerLog) << "HASH:" << task->tile()->hash();
+    if (transaction && !_db->commit()) {
+        qCWarning(QGCTileCacheWorkerLog) << "Map Cache SQL error (commit tiles):" << _db->lastError();
+        (void) _db->rollback();
+    }
 }
 
 void QGCCacheWorker::_getTile(QGCMapTask* mtask)
@@ -276,18 +300,25 @@ void QGCCacheWorker::_getTile(QGCMapTask* mtask)
         return;
     }
 
+    if (!_getTileQuery) {
+        mtask->setError("No Cache Database");
+        return;
+    }
+
     QGCFetchTileTask *task = static_cast<QGCFetchTileTask*>(mtask);
-    QSqlQuery query(*_db);
-    const QString s = QStringLiteral("SELECT tile, format, type FROM Tiles WHERE hash = \"%1\"").arg(task->hash());
-    if (query.exec(s) && query.next()) {
-        const QByteArray &arrray = query.value(0).toByteArray();
-        const QString &format = query.value(1).toString();
-        const QString &type = query.value(2).toString();
+    QSqlQuery &query = *_getTileQuery;
+    query.bindValue(0, task->hash());
+    if (query.exec() && query.next()) {
+        const QByteArray arrray = query.value(0).toByteArray();
+        const QString format = query.value(1).toString();
+        const QString type = query.value(2).toString();
+        query.finish();
         qCDebug(QGCTileCacheWorkerLog) << "(Found in DB) HASH:" << task->hash();
         QGCCacheTile *tile = new QGCCacheTile(task->hash(), arrray, format, type);
         task->setTileFetched(tile);
         return;
     }
+    query.finish();
 
     qCDebug(QGCTileCacheWorkerLog) << "(NOT in DB) HASH:" << task->hash();
     task->setError("Tile not in cache database");
@@ -414,11 +445,15 @@ quint64 QGCCacheWorker::_findTile(const QString &hash)
 {
     quint64 tileID = 0;
 
-    QSqlQuery query(*_db);
-    const QString s = QStringLiteral("SELECT tileID FROM Tiles WHERE hash = \"%1\"").arg(hash);
-    if (query.exec(s) && query.next()) {
-        tileID = query.value(0).toULongLong();
+    if (!_findTileQuery) {
+        return tileID;
+    }
+
+    _findTileQuery->bindValue(0, hash);
+    if (_findTileQuery->exec() && _findTileQuery->next()) {
+        tileID = _findTileQuery->value(0).toULongLong();
     }
+    _findTileQuery->finish();
 
     return tileID;
 }
@@ -634,6 +669,7 @@ void QGCCacheWorker::_resetCacheDatabase(QGCMapTask *mtask)
     }
 
     QGCResetTask *task = static_cast<QGCResetTask*>(mtask);
+    _clearQueries();
     QSqlQuery query(*_db);
     QString s = QStringLiteral("DROP TABLE Tiles");
     (void) query.exec(s);
@@ -644,6 +680,10 @@ void QGCCacheWorker::_resetCacheDatabase(QGCMapTask *mtask)
     s = QStringLiteral("DROP TABLE TilesDownload");
     (void) query.exec(s);
     _valid = _createDB(*_db);
+    if (_valid) {
+        _prepareQueries();
+    }
+    emit databaseReplaced();
     task->setResetCompleted();
 }
 
@@ -656,17 +696,33 @@ void QGCCacheWorker::_importSets(QGCMapTask *mtask)
     QGCImportTileTask *task = static_cast<QGCImportTileTask*>(mtask);
     // If replacing, simply copy over it
     if (task->replace()) {
-        // Close and delete old database
+        // Close and delete old database, the fetch pool readers must let go of it first
         _disconnectDB();
-        (void) QFile::remove(_databasePath);
+        emit databaseAboutToBeReplaced();
+        // A leftover write ahead log would be replayed into the imported database
+        bool removed = true;
+        for (const QString &suffix : {QString(), QStringLiteral("-wal"), QStringLiteral("-shm")}) {
+            const QString fileName = _databasePath + suffix;
+            if (QFile::exists(fileName) && !QFile::remove(fileName)) {
+                qCWarning(QGCTileCacheWorkerLog) << "Unable to remove" << fileName;
+                removed = false;
+            }
+        }
         // Copy given database
-        (void) QFile::copy(task->path(), _databasePath);
+        if (!removed) {
+            task->setError("Error removing old map cache");
+        } else if (!QFile::copy(task->path(), _databasePath)) {
+            task->setError("Error copying imported map cache");
+        }
         task->setProgress(25);
         _init();
         if (_valid) {
             task->setProgress(50);
-            _connectDB();
+            if (_connectDB()) {
+                _prepareQueries();
+            }
         }
+        emit databaseReplaced();
         task->setProgress(100);
     } else {
         // Open imported set
@@ -977,7 +1033,47 @@ bool QGCCacheWorker::_connectDB()
     _db->setDatabaseName(_databasePath);
     _db->setConnectOptions("QSQLITE_ENABLE_SHARED_CACHE");
     _valid = _db->open();
-    return _valid;
+    if (!_valid) {
+        return false;
+    }
+
+    // The write ahead log turns every commit into an append and lets readers run alongside the writer.
+    // NORMAL sync is safe with WAL, a power loss may only drop the most recent commits of what is a cache anyway.
+    QSqlQuery query(*_db);
+    if (!query.exec("PRAGMA journal_mode = WAL")) {
+        qCWarning(QGCTileCacheWorkerLog) << "Map Cache SQL error (journal mode):" << query.lastError().text();
+    }
+    (void) query.exec("PRAGMA synchronous = NORMAL");
+    (void) query.exec("PRAGMA temp_store = MEMORY");
+    (void) query.exec("PRAGMA cache_size = -8192");
+
+    return true;
+}
+
+void QGCCacheWorker::_prepareQueries()
+{
+    _clearQueries();
+
+    _saveTileQuery = std::make_unique<QSqlQuery>(*_db);
+    _saveSetTileQuery = std::make_unique<QSqlQuery>(*_db);
+    _getTileQuery = std::make_unique<QSqlQuery>(*_db);
+    _findTileQuery = std::make_unique<QSqlQuery>(*_db);
+
+    if (!_saveTileQuery->prepare("INSERT INTO Tiles(hash, format, tile, size, type, date) VALUES(?, ?, ?, ?, ?, ?)") ||
+        !_saveSetTileQuery->prepare("INSERT INTO SetTiles(tileID, setID) VALUES(?, ?)") ||
+        !_getTileQuery->prepare("SELECT tile, format, type FROM Tiles WHERE hash = ?") ||
+        !_findTileQuery->prepare("SELECT tileID FROM Tiles WHERE hash = ?")) {
+        qCWarning(QGCTileCacheWorkerLog) << "Map Cache SQL error (prepare queries):" << _db->lastError();
+        _clearQueries();
+    }
+}
+
+void QGCCacheWorker::_clearQueries()
+{
+    _saveTileQuery.reset();
+    _saveSetTileQuery.reset();
+    _getTileQuery.reset();
+    _findTileQuery.reset();
 }
 
 bool QGCCacheWorker::_createDB(QSqlDatabase &db, bool createDefault)
@@ -1063,6 +1159,8 @@ bool QGCCacheWorker::_createDB(QSqlDatabase &db, bool createDefault)
 
 void QGCCacheWorker::_disconnectDB()
 {
+    _clearQueries();
+
     if (_db) {
         _db.reset();
         QSqlDatabase::removeDatabase(kSession);
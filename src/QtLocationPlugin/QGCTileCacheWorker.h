@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QMutex>
 #include <QtCore/QQueue>
@@ -25,11 +27,14 @@
 #include <QtCore/QThread>
 #include <QtCore/QWaitCondition>
 
+#include <memory>
+
 Q_DECLARE_LOGGING_CATEGORY(QGCTileCacheWorkerLog)
 
 class QGCMapTask;
 class QGCCachedTileSet;
 class QSqlDatabase;
+class QSqlQuery;
 
 class QGCCacheWorker : public QThread
 {
@@ -40,6 +45,7 @@ class QGCCacheWorker : public QThread
     ~QGCCacheWorker();
 
     void setDatabaseFile(const QString &path) { _databasePath = path; }
+    bool isValid() const { return _valid; }
 
 public slots:
     bool enqueueTask(QGCMapTask *task);
@@ -47,6 +53,10 @@ public slots:
 
 signals:
     void updateTotals(quint32 totaltiles, quint64 totalsize, quint32 defaulttiles, quint64 defaultsize);
+    /// The database file is about to be removed, other connections to it must be closed by the time this returns
+    void databaseAboutToBeReplaced();
+    /// The database file was replaced or its tables recreated, other connections to it must be reopened
+    void databaseReplaced();
 
 protected:
     void run() final;
@@ -54,7 +64,8 @@ public slots:
 private:
     void _runTask(QGCMapTask *task);
 
-    void _saveTile(QGCMapTask *task);
+    /// Saves a run of consecutive save tasks in a single transaction
+    void _saveTiles(const QList<QGCMapTask*> &tasks);
     void _getTile(QGCMapTask *task);
     void _getTileSets(QGCMapTask *task);
     void _createTileSet(QGCMapTask *task);
@@ -70,6 +81,9 @@ public slots:
 
     bool _connectDB();
     void _disconnectDB();
+    /// Prepares the statements used for every tile, they live as long as the connection
+    void _prepareQueries();
+    void _clearQueries();
     bool _createDB(QSqlDatabase &db, bool createDefault = true);
     bool _findTileSetID(const QString &name, quint64 &setID);
     bool _init();
@@ -81,6 +95,10 @@ public slots:
     void _updateTotals();
 
     std::shared_ptr<QSqlDatabase> _db = nullptr;
+    std::unique_ptr<QSqlQuery> _saveTileQuery;
+    std::unique_ptr<QSqlQuery> _saveSetTileQuery;
+    std::unique_ptr<QSqlQuery> _getTileQuery;
+    std::unique_ptr<QSqlQuery> _findTileQuery;
     QMutex _taskQueueMutex;
     QQueue<QGCMapTask*> _taskQueue;
     QWaitCondition _waitc;
@@ -99,4 +117,5 @@ public slots:
     static constexpr const char *kExportSession = "QGeoTileExportSession";
     static constexpr int kShortTimeout = 2;
     static constexpr int kLongTimeout = 5;
+    static constexpr qsizetype kMaxSaveBatch = 256;    ///< Most tiles committed in one transaction
 };
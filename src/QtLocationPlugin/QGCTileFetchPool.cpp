@@ -0,0 +1,219 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCTileFetchPool.h"
+#include "QGCMapTasks.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QThread>
+#include <QtSql/QSqlDatabase>
+#include <QtSql/QSqlError>
+#include <QtSql/QSqlQuery>
+
+#include <memory>
+
+QGC_LOGGING_CATEGORY(QGCTileFetchPoolLog, "qgc.qtlocationplugin.qgctilefetchpool")
+
+QGCTileFetchPool::QGCTileFetchPool(QObject *parent)
+    : QObject(parent)
+{
+    // qCDebug(QGCTileFetchPoolLog) << Q_FUNC_INFO << this;
+}
+
+QGCTileFetchPool::~QGCTileFetchPool()
+{
+    stop();
+
+    // qCDebug(QGCTileFetchPoolLog) << Q_FUNC_INFO << this;
+}
+
+void QGCTileFetchPool::enqueueTask(QGCFetchTileTask *task)
+{
+    QMutexLocker lock(&_mutex);
+    if (_stopping) {
+        lock.unlock();
+        task->deleteLater();
+        return;
+    }
+
+    if (_threads.isEmpty()) {
+        _start();
+    }
+
+    _pending.append(Pending{task, _sequence++});
+    if (task->zoom() >= 0) {
+        _latestZoom = task->zoom();
+    }
+    lock.unlock();
+
+    _waitc.wakeOne();
+}
+
+void QGCTileFetchPool::stop()
+{
+    QMutexLocker lock(&_mutex);
+    _stopping = true;
+    for (const Pending &pending : _pending) {
+        delete pending.task;
+    }
+    _pending.clear();
+    const QList<QThread*> threads = _threads;
+    _threads.clear();
+    lock.unlock();
+
+    _waitc.wakeAll();
+    for (QThread *thread : threads) {
+        (void) thread->wait();
+        delete thread;
+    }
+}
+
+void QGCTileFetchPool::suspend()
+{
+    QMutexLocker lock(&_mutex);
+    _suspended = true;
+    _waitc.wakeAll();
+    while ((_connectedReaders > 0) && !_stopping) {
+        (void) _suspendc.wait(lock.mutex());
+    }
+}
+
+void QGCTileFetchPool::reopenDatabase()
+{
+    QMutexLocker lock(&_mutex);
+    (void) _generation.fetch_add(1);
+    if (_suspended) {
+        _suspended = false;
+        lock.unlock();
+        _waitc.wakeAll();
+    }
+}
+
+void QGCTileFetchPool::_start()
+{
+    const int threadCount = qBound(1, QThread::idealThreadCount() / 2, kMaxThreadCount);
+    qCDebug(QGCTileFetchPoolLog) << "Starting" << threadCount << "reader threads";
+
+    for (int i = 0; i < threadCount; i++) {
+        QThread* const thread = QThread::create([this, i]() { _run(i); });
+        thread->setObjectName(QStringLiteral("TileFetch%1").arg(i));
+        thread->start(QThread::HighPriority);
+        _threads.append(thread);
+    }
+}
+
+QGCFetchTileTask *QGCTileFetchPool::_takeNext()
+{
+    qsizetype best = -1;
+    int bestDistance = 0;
+    for (qsizetype i = 0; i < _pending.size(); i++) {
+        const int zoom = _pending[i].task->zoom();
+        const int distance = ((zoom < 0) || (_latestZoom < 0)) ? 0 : qAbs(zoom - _latestZoom);
+        if ((best < 0) || (distance < bestDistance) || ((distance == bestDistance) && (_pending[i].sequence > _pending[best].sequence))) {
+            best = i;
+            bestDistance = distance;
+        }
+    }
+
+    return _pending.takeAt(best).task;
+}
+
+void QGCTileFetchPool::_run(int index)
+{
+    const QString connectionName = QStringLiteral("%1%2").arg(kSession).arg(index);
+
+    {
+        std::unique_ptr<QSqlDatabase> db;
+        std::unique_ptr<QSqlQuery> query;
+        int generation = -1;
+        bool connected = false;
+
+        const auto closeDatabase = [&]() {
+            query.reset();
+            db.reset();
+            QSqlDatabase::removeDatabase(connectionName);
+        };
+
+        QMutexLocker lock(&_mutex);
+        while (!_stopping) {
+            if (_suspended) {
+                // The database file is about to be removed, let go of it
+                if (connected) {
+                    closeDatabase();
+                    connected = false;
+                    _connectedReaders--;
+                    _suspendc.wakeAll();
+                }
+                (void) _waitc.wait(lock.mutex());
+                continue;
+            }
+
+            if (_pending.isEmpty()) {
+                (void) _waitc.wait(lock.mutex());
+                continue;
+            }
+
+            QGCFetchTileTask* const task = _takeNext();
+            if (!connected) {
+                // Counted before unlocking so a suspend waits for the connection about to be opened as well
+                connected = true;
+                _connectedReaders++;
+            }
+            lock.unlock();
+
+            if (!task->isCanceled()) {
+                if (!db || (generation != _generation)) {
+                    closeDatabase();
+
+                    generation = _generation;
+                    db = std::make_unique<QSqlDatabase>(QSqlDatabase::addDatabase("QSQLITE", connectionName));
+                    db->setDatabaseName(_databasePath);
+                    if (db->open()) {
+                        // Not opened read only, WAL readers need to be able to create the shared memory index
+                        query = std::make_unique<QSqlQuery>(*db);
+                        (void) query->exec("PRAGMA query_only = ON");
+                        if (!query->prepare("SELECT tile, format, type FROM Tiles WHERE hash = ?")) {
+                            qCWarning(QGCTileFetchPoolLog) << "Map Cache SQL error (prepare fetch):" << query->lastError().text();
+                            query.reset();
+                        }
+                    } else {
+                        qCWarning(QGCTileFetchPoolLog) << "Map Cache SQL error (open db):" << db->lastError();
+                    }
+                }
+
+                if (!query) {
+                    task->setError("No Cache Database");
+                } else {
+                    query->bindValue(0, task->hash());
+                    if (query->exec() && query->next()) {
+                        QGCCacheTile* const tile = new QGCCacheTile(task->hash(), query->value(0).toByteArray(), query->value(1).toString(), query->value(2).toString());
+                        query->finish();
+                        qCDebug(QGCTileFetchPoolLog) << "(Found in DB) HASH:" << task->hash();
+                        task->setTileFetched(tile);
+                    } else {
+                        query->finish();
+                        qCDebug(QGCTileFetchPoolLog) << "(NOT in DB) HASH:" << task->hash();
+                        task->setError("Tile not in cache database");
+                    }
+                }
+            }
+
+            task->deleteLater();
+            lock.relock();
+        }
+
+        if (connected) {
+            closeDatabase();
+            _connectedReaders--;
+            _suspendc.wakeAll();
+        }
+    }
+
+    QSqlDatabase::removeDatabase(connectionName);
+}
@@ -0,0 +1,85 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QWaitCondition>
+
+#include <atomic>
+
+Q_DECLARE_LOGGING_CATEGORY(QGCTileFetchPoolLog)
+
+class QGCFetchTileTask;
+class QThread;
+
+/// Serves tile fetches from the map cache database on a few reader threads, each with its own connection.
+/// Runs alongside QGCCacheWorker, which keeps all writes and long maintenance tasks, so a large export, import
+/// or prune no longer holds up the tiles the map is waiting for. The database is in WAL mode, readers and the
+/// writer don't block each other.
+/// Pending fetches at the zoom level of the most recent request go first, newest first, as they make up the
+/// current viewport. Fetches canceled by their requester are dropped unanswered.
+class QGCTileFetchPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QGCTileFetchPool(QObject *parent = nullptr);
+    ~QGCTileFetchPool();
+
+    void setDatabaseFile(const QString &path) { _databasePath = path; }
+
+    /// Queues the fetch and takes ownership of the task. Thread safe.
+    void enqueueTask(QGCFetchTileTask *task);
+
+    /// Drops all queued fetches and waits for the reader threads to finish, fetches queued afterwards are dropped as well
+    void stop();
+
+    /// Closes the connection of every reader and holds fetches until reopenDatabase is called. Needed before the
+    /// database file is removed, returns once no reader has it open. Thread safe.
+    void suspend();
+
+    /// Makes every reader reopen its connection before the next fetch, needed once the database file was replaced
+    /// or its tables recreated. Ends a suspend. Thread safe.
+    void reopenDatabase();
+
+    static constexpr int kMaxThreadCount = 4;
+
+private:
+    struct Pending {
+        QGCFetchTileTask *task;
+        quint64 sequence;
+    };
+
+    void _start();
+    void _run(int index);
+    /// Takes the most urgent pending fetch, _mutex must be held
+    QGCFetchTileTask *_takeNext();
+
+    QString _databasePath;
+    QList<QThread*> _threads;
+
+    QMutex _mutex;
+    QWaitCondition _waitc;
+    QWaitCondition _suspendc;
+    QList<Pending> _pending;
+    quint64 _sequence = 0;
+    int _latestZoom = -1;
+    bool _stopping = false;
+    bool _suspended = false;
+    int _connectedReaders = 0;      ///< Readers with a connection, or about to open one
+
+    std::atomic_int _generation = 0;
+
+    static constexpr const char *kSession = "QGeoTileFetchSession";
+};
@@ -116,7 +116,7 @@ void QGeoFileTileCacheQGC::cacheTile(const QString &type, const QString &hash, c
 QGCFetchTileTask* QGeoFileTileCacheQGC::createFetchTileTask(const QString &type, int x, int y, int z)
 {
     const QString hash = UrlFactory::getTileHash(type, x, y, z);
-    QGCFetchTileTask* const task = new QGCFetchTileTask(hash);
+    QGCFetchTileTask* const task = new QGCFetchTileTask(hash, z);
     return task;
 }
 
@@ -48,6 +48,9 @@ QGeoTiledMapReplyQGC::QGeoTiledMapReplyQGC(QNetworkAccessManager *networkManager
     QGCFetchTileTask* const task = QGeoFileTileCacheQGC::createFetchTileTask(UrlFactory::getProviderTypeFromQtMapId(spec.mapId()), spec.x(), spec.y(), spec.zoom());
     (void) connect(task, &QGCFetchTileTask::tileFetched, this, &QGeoTiledMapReplyQGC::_cacheReply);
     (void) connect(task, &QGCMapTask::error, this, &QGeoTiledMapReplyQGC::_cacheError);
+    // Tiles scrolled out of view are aborted by the map, don't spend a database lookup on them
+    (void) connect(this, &QGeoTiledMapReplyQGC::aborted, task, &QGCFetchTileTask::cancel);
+    (void) connect(this, &QObject::destroyed, task, &QGCFetchTileTask::cancel);
     getQGCMapEngine()->addTask(task);
 }
 
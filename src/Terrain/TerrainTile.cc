@@ -10,13 +10,16 @@
 #include "TerrainTile.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QtMath>
 #include <QtCore/QtNumeric>
 #include <QtPositioning/QGeoCoordinate>
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(TerrainTileLog, "qgc.terrain.terraintile");
 
 TerrainTile::TerrainTile(const QByteArray &byteArray)
-    : _tileInfo(*reinterpret_cast<const TileInfo_t*>(byteArray.constData()))
+    : _tileData(byteArray)
 {
     // qCDebug(TerrainTileLog) << Q_FUNC_INFO << this;
 
@@ -28,6 +31,13 @@ TerrainTile::TerrainTile(const QByteArray &byteArray)
         return;
     }
 
+    (void) memcpy(&_tileInfo, byteArray.constData(), cTileHeaderBytes);
+
+    if ((_tileInfo.gridSizeLat <= 0) || (_tileInfo.gridSizeLon <= 0)) {
+        qCWarning(TerrainTileLog) << "Terrain tile has no elevation grid";
+        return;
+    }
+
     const int cTileDataBytes = static_cast<int>(sizeof(int16_t)) * _tileInfo.gridSizeLat * _tileInfo.gridSizeLon;
     if (cTileBytesAvailable < cTileHeaderBytes + cTileDataBytes) {
         qCWarning(TerrainTileLog) << "Terrain tile binary data too small for tile data";
@@ -45,22 +55,15 @@ TerrainTile::TerrainTile(const QByteArray &byteArray)
 
     qCDebug(TerrainTileLog) << this << "TileInfo: south west:" << _tileInfo.swLat << _tileInfo.swLon;
     qCDebug(TerrainTileLog) << this << "TileInfo: north east:" << _tileInfo.neLat << _tileInfo.neLon;
-    qCDebug(TerrainTileLog) << this << "TileInfo: dimensions:" << _tileInfo.gridSizeLat << "by" << _tileInfo.gridSizeLat;
+    qCDebug(TerrainTileLog) << this << "TileInfo: dimensions:" << _tileInfo.gridSizeLat << "by" << _tileInfo.gridSizeLon;
     qCDebug(TerrainTileLog) << this << "TileInfo: min, max, avg:" << _tileInfo.minElevation << _tileInfo.maxElevation << _tileInfo.avgElevation;
     qCDebug(TerrainTileLog) << this << "TileInfo: cell size:" << _cellSizeLat << _cellSizeLon;
 
-    _elevationData.resize(_tileInfo.gridSizeLat);
-    for (int k = 0; k < _tileInfo.gridSizeLat; k++) {
-        _elevationData[k].resize(_tileInfo.gridSizeLon);
-    }
-
-    int valueIndex = 0;
-    const int16_t* const pTileData = reinterpret_cast<const int16_t*>(&reinterpret_cast<const uint8_t*>(byteArray.constData())[cTileHeaderBytes]);
-    for (int i = 0; i < _tileInfo.gridSizeLat; i++) {
-        for (int j = 0; j < _tileInfo.gridSizeLon; j++) {
-            _elevationData[i][j] = pTileData[valueIndex++];
-        }
+    // The grid is used in place. Only a buffer which does not keep it aligned gets copied, the copy starts on an aligned boundary.
+    if ((reinterpret_cast<quintptr>(_tileData.constData() + cTileHeaderBytes) % alignof(int16_t)) != 0) {
+        _tileData = QByteArray(byteArray.constData(), cTileHeaderBytes + cTileDataBytes);
     }
+    _elevationData = reinterpret_cast<const int16_t*>(_tileData.constData() + cTileHeaderBytes);
 
     _isValid = true;
 }
@@ -80,8 +83,8 @@ double TerrainTile::elevation(const QGeoCoordinate &coordinate) const
     const double latDeltaSw = coordinate.latitude() - _tileInfo.swLat;
     const double lonDeltaSw = coordinate.longitude() - _tileInfo.swLon;
 
-    const int16_t latIndex = qFloor(latDeltaSw / _cellSizeLat);
-    const int16_t lonIndex = qFloor(lonDeltaSw / _cellSizeLon);
+    const int latIndex = qFloor(latDeltaSw / _cellSizeLat);
+    const int lonIndex = qFloor(lonDeltaSw / _cellSizeLon);
 
     const bool latIndexInvalid = (latIndex < 0) || (latIndex > (_tileInfo.gridSizeLat - 1));
     const bool lonIndexInvalid = (lonIndex < 0) || (lonIndex > (_tileInfo.gridSizeLon - 1));
@@ -91,21 +94,71 @@ double TerrainTile::elevation(const QGeoCoordinate &coordinate) const
         return qQNaN();
     }
 
-    if ((latIndex >= _elevationData.size()) || (lonIndex >= _elevationData[latIndex].size())) {
-        qCWarning(TerrainTileLog).noquote() << this << "Internal error: _elevationData size inconsistent _tileInfo << coordinate" << coordinate
-            << "\n\t_tillIndo.gridSizeLat:" << _tileInfo.gridSizeLat << "_tileInfo.gridSizeLon:" << _tileInfo.gridSizeLon
-            << "\n\t_data.size():" << _elevationData.size() << "_elevationData[latIndex].size():" << _elevationData[latIndex].size();
-        return qQNaN();
-    }
-
-    const int16_t elevation = _elevationData[latIndex][lonIndex];
+    const int16_t elevation = _elevationData[(latIndex * _tileInfo.gridSizeLon) + lonIndex];
     if (elevation < _tileInfo.minElevation) {
         qCWarning(TerrainTileLog) << this << "Warning: elevation read is below min elevation in tile:" << elevation << "<" << _tileInfo.minElevation;
     } else if (elevation > _tileInfo.maxElevation) {
         qCWarning(TerrainTileLog) << this << "Warning: elevation read is above max elevation in tile:" << elevation << ">" << _tileInfo.maxElevation;
     }
 
-    qCDebug(TerrainTileLog) << this << "latIndex, lonIndex:" << latIndex << lonIndex << "elevation:" << elevation;
-
     return static_cast<double>(elevation);
 }
+
+void TerrainTile::elevations(std::span<const QGeoCoordinate> coordinates, std::span<double> elevations) const
+{
+    Q_ASSERT(coordinates.size() == elevations.size());
+    const size_t count = qMin(coordinates.size(), elevations.size());
+
+    if (!_isValid) {
+        qCWarning(TerrainTileLog) << this << "Request for elevations, but tile is invalid.";
+        std::fill_n(elevations.begin(), count, qQNaN());
+        return;
+    }
+
+    const int rows = _tileInfo.gridSizeLat;
+    const int cols = _tileInfo.gridSizeLon;
+    const double latScale = 1.0 / _cellSizeLat;
+    const double lonScale = 1.0 / _cellSizeLon;
+    const double maxRow = rows - 1;
+    const double maxCol = cols - 1;
+
+    double rowPos[kBatchSize];
+    double colPos[kBatchSize];
+    bool inside[kBatchSize];
+
+    for (size_t batchStart = 0; batchStart < count; batchStart += kBatchSize) {
+        const size_t batchCount = qMin(kBatchSize, count - batchStart);
+
+        for (size_t i = 0; i < batchCount; i++) {
+            rowPos[i] = coordinates[batchStart + i].latitude();
+            colPos[i] = coordinates[batchStart + i].longitude();
+        }
+
+        // Grid position relative to the cell centers, clamped so the edge cells extend to the tile border.
+        // Branch free so the compiler can vectorize it, NaN coordinates fail the inside test.
+        for (size_t i = 0; i < batchCount; i++) {
+            const double row = (rowPos[i] - _tileInfo.swLat) * latScale;
+            const double col = (colPos[i] - _tileInfo.swLon) * lonScale;
+            inside[i] = (row >= 0.0) & (row <= rows) & (col >= 0.0) & (col <= cols);
+            rowPos[i] = inside[i] ? std::clamp(row - 0.5, 0.0, maxRow) : 0.0;
+            colPos[i] = inside[i] ? std::clamp(col - 0.5, 0.0, maxCol) : 0.0;
+        }
+
+        for (size_t i = 0; i < batchCount; i++) {
+            const int row0 = static_cast<int>(rowPos[i]);
+            const int col0 = static_cast<int>(colPos[i]);
+            const int row1 = qMin(row0 + 1, rows - 1);
+            const int col1 = qMin(col0 + 1, cols - 1);
+            const double rowFraction = rowPos[i] - row0;
+            const double colFraction = colPos[i] - col0;
+
+            const int16_t *const south = _elevationData + (row0 * cols);
+            const int16_t *const north = _elevationData + (row1 * cols);
+            const double southElevation = south[col0] + ((south[col1] - south[col0]) * colFraction);
+            const double northElevation = north[col0] + ((north[col1] - north[col0]) * colFraction);
+            const double elevation = southElevation + ((northElevation - southElevation) * rowFraction);
+
+            elevations[batchStart + i] = inside[i] ? elevation : qQNaN();
+        }
+    }
+}
@@ -9,9 +9,11 @@
 
 #pragma once
 
-#include <QtCore/QList>
+#include <QtCore/QByteArray>
 #include <QtCore/QLoggingCategory>
 
+#include <span>
+
 class QGeoCoordinate;
 class TerrainTileTest;
 
@@ -33,9 +35,15 @@ class TerrainTile
 
     /// Evaluates the elevation at the given coordinate
     ///    @param coordinate
-    ///    @return elevation
+    ///    @return elevation of the grid cell containing the coordinate
     double elevation(const QGeoCoordinate &coordinate) const;
 
+    /// Evaluates the elevations at many coordinates at once, interpolating bilinearly between the cell centers.
+    /// Much cheaper per coordinate than elevation(), use it for paths and surveys.
+    ///    @param coordinates
+    ///    @param[out] elevations Same size as coordinates, NaN for coordinates outside the tile
+    void elevations(std::span<const QGeoCoordinate> coordinates, std::span<double> elevations) const;
+
     /// Accessor for the minimum elevation of the tile
     ///    @return minimum elevation
     double minElevation() const { return (_isValid ? static_cast<double>(_tileInfo.minElevation) : qQNaN()); }
@@ -48,6 +56,9 @@ class TerrainTile
     ///    @return average elevation
     double avgElevation() const { return (_isValid ? _tileInfo.avgElevation : qQNaN()); }
 
+    /// Approximate memory held by the tile, used for cache accounting
+    qint64 byteCount() const { return static_cast<qint64>(sizeof(TerrainTile)) + _tileData.size(); }
+
 protected:
     struct TileInfo_t {
         double  swLat, swLon, neLat, neLon;
@@ -57,8 +68,12 @@ class TerrainTile
     } Q_PACKED;
 
 private:
+    /// Coordinates are converted to grid positions this many at a time, so the arithmetic runs in tight loops
+    static constexpr size_t kBatchSize = 64;
+
     TileInfo_t _tileInfo{};
-    QList<QList<int16_t>> _elevationData;   ///< 2D elevation data array
+    QByteArray _tileData;                   ///< Serialized tile, shared with whoever handed it to us
+    const int16_t *_elevationData = nullptr;///< Row major elevation grid inside _tileData, gridSizeLat rows of gridSizeLon values
     double _cellSizeLat = 0.0;              ///< data grid size in latitude direction
     double _cellSizeLon = 0.0;              ///< data grid size in longitude direction
     bool _isValid = false;                  ///< data loaded is valid
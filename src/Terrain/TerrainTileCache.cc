@@ -0,0 +1,313 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TerrainTileCache.h"
+#include "TerrainTile.h"
+#include "QGCLoggingCategory.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStringList>
+#include <QtCore/QUrl>
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <iterator>
+#include <limits>
+
+QGC_LOGGING_CATEGORY(TerrainTileCacheLog, "qgc.terrain.terraintilecache")
+
+namespace {
+
+struct ProviderRegistry {
+    QMutex mutex;
+    QStringList names;  ///< Indexed by provider id
+};
+
+}
+
+Q_GLOBAL_STATIC(ProviderRegistry, _providerRegistry)
+
+TerrainTileCache::TerrainTileCache(qint64 memoryBudget, const QString &diskPath, qint64 diskBudget)
+    : _stripeBudget(qMax<qint64>(1, memoryBudget / kStripeCount))
+    , _diskPath(diskPath)
+    , _diskBudget(diskBudget)
+{
+    // qCDebug(TerrainTileCacheLog) << Q_FUNC_INFO << this;
+
+    _diskPool.setMaxThreadCount(1);
+    _diskPool.setObjectName(QStringLiteral("TerrainTileCacheDisk"));
+
+    if (!_diskPath.isEmpty() && !QDir().mkpath(_diskPath)) {
+        qCWarning(TerrainTileCacheLog) << "Unable to create terrain tile directory, caching in memory only" << _diskPath;
+        _diskPath.clear();
+    }
+
+    if (!_diskPath.isEmpty()) {
+        (void) QtConcurrent::run(&_diskPool, [this]() { _scanDisk(); });
+    }
+}
+
+TerrainTileCache::~TerrainTileCache()
+{
+    // qCDebug(TerrainTileCacheLog) << Q_FUNC_INFO << this;
+
+    // Queued writes still reference the cache
+    waitForDisk();
+}
+
+quint16 TerrainTileCache::providerId(QStringView mapName)
+{
+    QMutexLocker locker(&_providerRegistry->mutex);
+
+    QStringList &names = _providerRegistry->names;
+    qsizetype id = names.indexOf(mapName);
+    if (id < 0) {
+        Q_ASSERT(names.size() <= std::numeric_limits<quint16>::max());
+        id = names.size();
+        names.append(mapName.toString());
+    }
+
+    return static_cast<quint16>(id);
+}
+
+QString TerrainTileCache::providerName(quint16 providerId)
+{
+    QMutexLocker locker(&_providerRegistry->mutex);
+
+    return _providerRegistry->names.value(providerId);
+}
+
+quint64 TerrainTileCache::tileKey(quint16 providerId, int x, int y, int zoom)
+{
+    // 16 bits provider, 6 bits zoom, 21 bits each for x and y
+    return (static_cast<quint64>(providerId) << 48) |
+           (static_cast<quint64>(zoom & 0x3F) << 42) |
+           (static_cast<quint64>(x & 0x1FFFFF) << 21) |
+           static_cast<quint64>(y & 0x1FFFFF);
+}
+
+std::shared_ptr<const TerrainTile> TerrainTileCache::tile(quint64 key)
+{
+    {
+        Stripe &stripe = _stripe(key);
+        QMutexLocker locker(&stripe.mutex);
+        const auto it = stripe.entries.constFind(key);
+        if (it != stripe.entries.cend()) {
+            stripe.lru.splice(stripe.lru.begin(), stripe.lru, it.value());
+            (void) _hits.fetch_add(1, std::memory_order_relaxed);
+            return it.value()->tile;
+        }
+    }
+
+    // With a disk store the miss is counted once load() has not found the tile either
+    if (_diskPath.isEmpty()) {
+        (void) _misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return nullptr;
+}
+
+QFuture<std::shared_ptr<const TerrainTile>> TerrainTileCache::load(quint64 key)
+{
+    if (_diskPath.isEmpty()) {
+        return QtFuture::makeReadyValueFuture(std::shared_ptr<const TerrainTile>());
+    }
+
+    return QtConcurrent::run(&_diskPool, [this, key]() { return _readDisk(key); });
+}
+
+std::shared_ptr<const TerrainTile> TerrainTileCache::insert(quint64 key, const QByteArray &data)
+{
+    std::shared_ptr<const TerrainTile> tile = std::make_shared<const TerrainTile>(data);
+    if (!tile->isValid()) {
+        return nullptr;
+    }
+
+    if (!_diskPath.isEmpty()) {
+        (void) QtConcurrent::run(&_diskPool, [this, key, data]() { _writeDisk(key, data); });
+    }
+
+    return _insertMemory(key, std::move(tile));
+}
+
+void TerrainTileCache::waitForDisk()
+{
+    (void) _diskPool.waitForDone();
+}
+
+std::shared_ptr<const TerrainTile> TerrainTileCache::_insertMemory(quint64 key, std::shared_ptr<const TerrainTile> tile)
+{
+    const qint64 bytes = tile->byteCount();
+
+    Stripe &stripe = _stripe(key);
+    QMutexLocker locker(&stripe.mutex);
+
+    const auto existing = stripe.entries.find(key);
+    if (existing != stripe.entries.end()) {
+        stripe.bytes -= existing.value()->bytes;
+        (void) stripe.lru.erase(existing.value());
+        (void) stripe.entries.erase(existing);
+    }
+
+    stripe.lru.push_front(Entry{key, tile, bytes});
+    (void) stripe.entries.insert(key, stripe.lru.begin());
+    stripe.bytes += bytes;
+
+    // Tiles handed out earlier stay alive through their shared pointers
+    while ((stripe.bytes > _stripeBudget) && (stripe.lru.size() > 1)) {
+        const Entry &oldest = stripe.lru.back();
+        stripe.bytes -= oldest.bytes;
+        (void) stripe.entries.remove(oldest.key);
+        stripe.lru.pop_back();
+        (void) _evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return tile;
+}
+
+void TerrainTileCache::clearMemory()
+{
+    for (Stripe &stripe : _stripes) {
+        QMutexLocker locker(&stripe.mutex);
+        stripe.entries.clear();
+        stripe.lru.clear();
+        stripe.bytes = 0;
+    }
+}
+
+TerrainTileCache::Stats TerrainTileCache::stats() const
+{
+    Stats stats;
+    stats.hits = _hits.load(std::memory_order_relaxed);
+    stats.diskHits = _diskHits.load(std::memory_order_relaxed);
+    stats.misses = _misses.load(std::memory_order_relaxed);
+    stats.evictions = _evictions.load(std::memory_order_relaxed);
+    stats.diskBytes = _diskBytes.load(std::memory_order_relaxed);
+
+    for (const Stripe &stripe : _stripes) {
+        QMutexLocker locker(&stripe.mutex);
+        stats.memoryBytes += stripe.bytes;
+        stats.tileCount += static_cast<int>(stripe.entries.size());
+    }
+
+    return stats;
+}
+
+QString TerrainTileCache::_diskFileName(quint64 key)
+{
+    // Provider ids differ between runs, the name stays the same. Escaped, since it may hold any character.
+    const QString provider = QString::fromLatin1(QUrl::toPercentEncoding(providerName(static_cast<quint16>(key >> 48))));
+    const QString tile = QString::number(key & Q_UINT64_C(0xFFFFFFFFFFFF), 16).rightJustified(12, QLatin1Char('0'));
+    return provider + QLatin1Char('_') + tile + QLatin1String(kDiskFileSuffix);
+}
+
+void TerrainTileCache::_scanDisk()
+{
+    const QDir dir(_diskPath);
+    const QFileInfoList files = dir.entryInfoList(QStringList(QStringLiteral("*%1").arg(QLatin1String(kDiskFileSuffix))), QDir::Files, QDir::Time | QDir::Reversed);
+
+    qint64 total = 0;
+    for (const QFileInfo &file : files) {
+        _diskOrder.push_back(file.fileName());
+        (void) _diskFiles.insert(file.fileName(), DiskFile{std::prev(_diskOrder.end()), file.size()});
+        total += file.size();
+    }
+    _diskBytes.store(total, std::memory_order_relaxed);
+
+    qCDebug(TerrainTileCacheLog) << "Disk store holds" << files.size() << "tiles" << total << "bytes";
+
+    if (total > _diskBudget) {
+        _pruneDisk();
+    }
+}
+
+std::shared_ptr<const TerrainTile> TerrainTileCache::_readDisk(quint64 key)
+{
+    const QString fileName = _diskFileName(key);
+    if (!_diskFiles.contains(fileName)) {
+        (void) _misses.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    QFile file(_diskPath + QLatin1Char('/') + fileName);
+    if (file.open(QIODevice::ReadOnly)) {
+        std::shared_ptr<const TerrainTile> tile = std::make_shared<const TerrainTile>(file.readAll());
+        if (tile->isValid()) {
+            (void) _diskHits.fetch_add(1, std::memory_order_relaxed);
+            return _insertMemory(key, std::move(tile));
+        }
+        qCWarning(TerrainTileCacheLog) << "Removing invalid tile from disk" << file.fileName();
+    }
+
+    _removeDisk(fileName);
+    (void) _misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void TerrainTileCache::_writeDisk(quint64 key, const QByteArray &data)
+{
+    const QString fileName = _diskFileName(key);
+
+    // Written under a temporary name and renamed, so a crash never leaves a partial tile behind
+    QSaveFile file(_diskPath + QLatin1Char('/') + fileName);
+    if (!file.open(QIODevice::WriteOnly) || (file.write(data) != data.size()) || !file.commit()) {
+        qCWarning(TerrainTileCacheLog) << "Unable to write terrain tile" << file.fileName() << file.errorString();
+        return;
+    }
+
+    qint64 total = _diskBytes.load(std::memory_order_relaxed);
+    const auto existing = _diskFiles.find(fileName);
+    if (existing != _diskFiles.end()) {
+        total -= existing->bytes;
+        existing->bytes = data.size();
+        _diskOrder.splice(_diskOrder.end(), _diskOrder, existing->order);
+    } else {
+        _diskOrder.push_back(fileName);
+        (void) _diskFiles.insert(fileName, DiskFile{std::prev(_diskOrder.end()), data.size()});
+    }
+    total += data.size();
+    _diskBytes.store(total, std::memory_order_relaxed);
+
+    if (total > _diskBudget) {
+        _pruneDisk();
+    }
+}
+
+void TerrainTileCache::_removeDisk(const QString &fileName)
+{
+    const auto it = _diskFiles.find(fileName);
+    if (it == _diskFiles.end()) {
+        return;
+    }
+
+    // Dropped from the index either way, a file that could not be removed is picked up again by the next scan
+    if (!QFile::remove(_diskPath + QLatin1Char('/') + fileName)) {
+        qCWarning(TerrainTileCacheLog) << "Unable to remove terrain tile" << fileName;
+    }
+
+    (void) _diskBytes.fetch_sub(it->bytes, std::memory_order_relaxed);
+    (void) _diskOrder.erase(it->order);
+    (void) _diskFiles.erase(it);
+}
+
+void TerrainTileCache::_pruneDisk()
+{
+    // Oldest first, leave some headroom so this does not run again on the next write
+    const qint64 target = (_diskBudget / 10) * 9;
+    int removedCount = 0;
+    while (!_diskOrder.empty() && (_diskBytes.load(std::memory_order_relaxed) > target)) {
+        const QString fileName = _diskOrder.front();
+        _removeDisk(fileName);
+        removedCount++;
+    }
+
+    qCDebug(TerrainTileCacheLog) << "Pruned" << removedCount << "tiles from disk store";
+}
@@ -0,0 +1,150 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFuture>
+#include <QtCore/QHash>
+#include <QtCore/QLoggingCategory>
+#include <QtCore/QMutex>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringView>
+#include <QtCore/QThreadPool>
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+
+class TerrainTile;
+
+Q_DECLARE_LOGGING_CATEGORY(TerrainTileCacheLog)
+
+/// Thread safe two tier cache of decoded terrain tiles.
+/// Memory is a byte budgeted LRU, split into independently locked stripes so concurrent lookups rarely contend.
+/// Every inserted tile is also written to a directory on disk, which can be loaded from on a memory miss and outlives
+/// the process. The disk store has its own budget, the least recently written files are removed once it is exceeded.
+/// All disk access runs on a single worker thread, which keeps an index of the stored files so pruning never rescans.
+class TerrainTileCache
+{
+public:
+    struct Stats {
+        Q_GADGET
+        Q_PROPERTY(quint64  hits        MEMBER hits         CONSTANT)
+        Q_PROPERTY(quint64  diskHits    MEMBER diskHits     CONSTANT)
+        Q_PROPERTY(quint64  misses      MEMBER misses       CONSTANT)
+        Q_PROPERTY(quint64  evictions   MEMBER evictions    CONSTANT)
+        Q_PROPERTY(qint64   memoryBytes MEMBER memoryBytes  CONSTANT)
+        Q_PROPERTY(qint64   diskBytes   MEMBER diskBytes    CONSTANT)
+        Q_PROPERTY(int      tileCount   MEMBER tileCount    CONSTANT)
+
+    public:
+        quint64 hits = 0;           ///< Found in memory
+        quint64 diskHits = 0;       ///< Found on disk
+        quint64 misses = 0;         ///< Found nowhere, the tile has to be fetched
+        quint64 evictions = 0;      ///< Dropped from memory to stay within budget
+        qint64 memoryBytes = 0;
+        qint64 diskBytes = 0;       ///< -1 if the disk store has not been scanned yet
+        int tileCount = 0;          ///< Tiles in memory
+    };
+
+    ///     @param memoryBudget Bytes of tiles kept in memory
+    ///     @param diskPath Directory for the disk store, empty for memory only
+    ///     @param diskBudget Bytes of tiles kept on disk
+    explicit TerrainTileCache(qint64 memoryBudget = kDefaultMemoryBudget, const QString &diskPath = QString(), qint64 diskBudget = kDefaultDiskBudget);
+    ~TerrainTileCache();
+
+    /// Id of an elevation provider, part of the tile key. Ids are handed out in order of first use, so unlike a hash
+    /// of the name two providers never share one. They are only valid within the process, the disk store names its
+    /// files after the provider instead.
+    static quint16 providerId(QStringView mapName);
+
+    /// @return Name of the provider the id was handed out for, empty if there is none
+    static QString providerName(quint16 providerId);
+
+    /// @return Key of the tile, unique across providers
+    static quint64 tileKey(quint16 providerId, int x, int y, int zoom);
+
+    /// Looks in memory only, never waits on the disk store
+    ///     @return nullptr: Tile not in memory, use load() to look on disk
+    std::shared_ptr<const TerrainTile> tile(quint64 key);
+
+    /// Looks for the tile in the disk store on the disk thread, a tile found there is added to memory
+    ///     @return Resolves to nullptr if the tile is not stored
+    QFuture<std::shared_ptr<const TerrainTile>> load(quint64 key);
+
+    /// Adds a tile, replacing any previous one with the same key, and queues writing it to the disk store
+    ///     @param data Serialized tile
+    ///     @return The cached tile, nullptr if data does not hold a valid tile
+    std::shared_ptr<const TerrainTile> insert(quint64 key, const QByteArray &data);
+
+    /// Blocks until all queued disk reads and writes are done
+    void waitForDisk();
+
+    /// Drops all tiles from memory, the disk store is left alone
+    void clearMemory();
+
+    Stats stats() const;
+
+    static constexpr qint64 kDefaultMemoryBudget = 32 * 1024 * 1024;
+    static constexpr qint64 kDefaultDiskBudget = 256 * 1024 * 1024;
+    static constexpr int kStripeCount = 16;
+
+private:
+    struct Entry {
+        quint64 key;
+        std::shared_ptr<const TerrainTile> tile;
+        qint64 bytes;
+    };
+
+    struct Stripe {
+        mutable QMutex mutex;
+        std::list<Entry> lru;                                   ///< Most recently used first
+        QHash<quint64, std::list<Entry>::iterator> entries;
+        qint64 bytes = 0;
+    };
+
+    Stripe &_stripe(quint64 key) { return _stripes[qHash(key) % kStripeCount]; }
+    std::shared_ptr<const TerrainTile> _insertMemory(quint64 key, std::shared_ptr<const TerrainTile> tile);
+
+    /// Disk store index entry, owned by the disk thread
+    struct DiskFile {
+        std::list<QString>::iterator order;
+        qint64 bytes;
+    };
+
+    static QString _diskFileName(quint64 key);
+
+    // Only called on the disk thread
+    void _scanDisk();
+    std::shared_ptr<const TerrainTile> _readDisk(quint64 key);
+    void _writeDisk(quint64 key, const QByteArray &data);
+    void _removeDisk(const QString &fileName);
+    void _pruneDisk();
+
+    const qint64 _stripeBudget;
+    QString _diskPath;
+    const qint64 _diskBudget;
+
+    std::array<Stripe, kStripeCount> _stripes;
+
+    std::atomic<quint64> _hits = 0;
+    std::atomic<quint64> _diskHits = 0;
+    std::atomic<quint64> _misses = 0;
+    std::atomic<quint64> _evictions = 0;
+
+    QThreadPool _diskPool;                  ///< Single thread, so disk tasks run in the order they are queued
+    std::list<QString> _diskOrder;          ///< File names, least recently written first
+    QHash<QString, DiskFile> _diskFiles;
+    std::atomic<qint64> _diskBytes = -1;    ///< -1 until the disk store has been scanned
+
+    static constexpr const char *kDiskFileSuffix = ".terrain";
+};
@@ -16,13 +16,17 @@
 #include "ElevationMapProvider.h"
 #include "SettingsManager.h"
 #include "FlightMapSettings.h"
+#include "AppSettings.h"
 #include "QGCLoggingCategory.h"
 
+#include <QtCore/QStandardPaths>
 #include <QtLocation/private/qgeotilespec_p.h>
 #include <QtNetwork/QNetworkAccessManager>
 #include <QtNetwork/QNetworkProxy>
 #include <QtNetwork/QNetworkRequest>
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(TerrainTileManagerLog, "qgc.terrain.terraintilemanager")
 
 Q_GLOBAL_STATIC(TerrainTileManager, _terrainTileManager)
@@ -32,8 +36,22 @@ TerrainTileManager *TerrainTileManager::instance()
     return _terrainTileManager();
 }
 
+namespace {
+
+QString _tileCacheDir()
+{
+    if (SettingsManager::instance()->appSettings()->disableAllPersistence()->rawValue().toBool()) {
+        return QString();
+    }
+
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/QGCTerrainTileCache");
+}
+
+}
+
 TerrainTileManager::TerrainTileManager(QObject *parent)
     : QObject(parent)
+    , _tileCache(TerrainTileCache::kDefaultMemoryBudget, _tileCacheDir())
     , _networkManager(new QNetworkAccessManager(this))
 {
     // qCDebug(TerrainTileManagerLog) << Q_FUNC_INFO << this;
@@ -47,8 +65,6 @@ TerrainTileManager::TerrainTileManager(QObject *parent)
 
 TerrainTileManager::~TerrainTileManager()
 {
-    qDeleteAll(_tiles);
-
     // qCDebug(TerrainTileManagerLog) << Q_FUNC_INFO << this;
 }
 
@@ -58,40 +74,44 @@ bool TerrainTileManager::getAltitudesForCoordinates(const QList<QGeoCoordinate>
 
     const QString elevationProviderName = SettingsManager::instance()->flightMapSettings()->elevationMapProvider()->rawValue().toString();
     const SharedMapProvider provider = UrlFactory::getMapProviderFromProviderType(elevationProviderName);
-    for (const QGeoCoordinate &coordinate: coordinates) {
-        const QString tileHash = UrlFactory::getTileHash(
-            provider->getMapName(),
-            provider->long2tileX(coordinate.longitude(), 1),
-            provider->lat2tileY(coordinate.latitude(), 1),
-            1
-        );
-        qCDebug(TerrainTileManagerLog) << Q_FUNC_INFO << "hash:coordinate" << tileHash << coordinate;
-
-        TerrainTile* const tile = _getCachedTile(tileHash);
+    const quint16 providerId = TerrainTileCache::providerId(provider->getMapName());
+
+    altitudes.reserve(altitudes.size() + coordinates.size());
+
+    // Consecutive coordinates usually fall into the same tile, look those up as one batch
+    qsizetype runStart = 0;
+    while (runStart < coordinates.size()) {
+        const int tileX = provider->long2tileX(coordinates[runStart].longitude(), 1);
+        const int tileY = provider->lat2tileY(coordinates[runStart].latitude(), 1);
+
+        qsizetype runEnd = runStart + 1;
+        while ((runEnd < coordinates.size()) &&
+               (provider->long2tileX(coordinates[runEnd].longitude(), 1) == tileX) &&
+               (provider->lat2tileY(coordinates[runEnd].latitude(), 1) == tileY)) {
+            runEnd++;
+        }
+
+        const quint64 tileKey = TerrainTileCache::tileKey(providerId, tileX, tileY, 1);
+        qCDebug(TerrainTileManagerLog) << Q_FUNC_INFO << "key:coordinate:count" << Qt::hex << tileKey << Qt::dec << coordinates[runStart] << (runEnd - runStart);
+
+        const std::shared_ptr<const TerrainTile> tile = _getCachedTile(tileKey);
         if (tile) {
-            const double elevation = tile->elevation(coordinate);
-            if (qIsNaN(elevation)) {
+            const qsizetype offset = altitudes.size();
+            altitudes.resize(offset + (runEnd - runStart));
+            tile->elevations(std::span<const QGeoCoordinate>(coordinates.constData() + runStart, runEnd - runStart),
+                             std::span<double>(altitudes.data() + offset, runEnd - runStart));
+            if (std::any_of(altitudes.cbegin() + offset, altitudes.cend(), [](double elevation) { return qIsNaN(elevation); })) {
                 error = true;
                 qCWarning(TerrainTileManagerLog) << Q_FUNC_INFO << "Internal Error: missing elevation in tile cache";
-            } else {
-                qCDebug(TerrainTileManagerLog) << Q_FUNC_INFO << "returning elevation from tile cache" << elevation;
             }
-            altitudes.push_back(elevation);
         } else if (_state != TerrainQuery::State::Downloading) {
-            QGeoTileSpec spec;
-            spec.setX(provider->long2tileX(coordinate.longitude(), 1));
-            spec.setY(provider->lat2tileY(coordinate.latitude(), 1));
-            spec.setZoom(1);
-            spec.setMapId(provider->getMapId());
-            const QNetworkRequest request = QGeoTileFetcherQGC::getNetworkRequest(spec.mapId(), spec.x(), spec.y(), spec.zoom());
-            QGeoTiledMapReplyQGC* const reply = new QGeoTiledMapReplyQGC(_networkManager, request, spec, this);
-            (void) connect(reply, &QGeoTiledMapReplyQGC::finished, this, &TerrainTileManager::_terrainDone);
-            _state = TerrainQuery::State::Downloading;
-            // TODO: Batch Downloading?
+            _fetchTile(tileKey, provider->getMapId(), tileX, tileY);
             return false;
         } else {
             return false;
         }
+
+        runStart = runEnd;
     }
 
     return true;
@@ -242,9 +262,38 @@ void TerrainTileManager::_terrainDone()
 
     qCDebug(TerrainTileManagerLog) << "Received some bytes of terrain data:" << responseBytes.size();
 
-    const QString hash = UrlFactory::getTileHash(UrlFactory::getProviderTypeFromQtMapId(spec.mapId()), spec.x(), spec.y(), spec.zoom());
-    _cacheTile(responseBytes, hash);
+    const quint64 tileKey = TerrainTileCache::tileKey(TerrainTileCache::providerId(UrlFactory::getProviderTypeFromQtMapId(spec.mapId())), spec.x(), spec.y(), spec.zoom());
+    _cacheTile(responseBytes, tileKey);
+    _processQueuedRequests();
+}
 
+void TerrainTileManager::_fetchTile(quint64 key, int mapId, int x, int y)
+{
+    // Covers loading from the disk store as well as downloading, one tile is fetched at a time
+    _state = TerrainQuery::State::Downloading;
+
+    (void) _tileCache.load(key).then(this, [this, mapId, x, y](const std::shared_ptr<const TerrainTile> &tile) {
+        if (tile) {
+            _state = TerrainQuery::State::Idle;
+            // Queued, this may run before the caller has queued the request which started the load
+            (void) QMetaObject::invokeMethod(this, &TerrainTileManager::_processQueuedRequests, Qt::QueuedConnection);
+            return;
+        }
+
+        QGeoTileSpec spec;
+        spec.setX(x);
+        spec.setY(y);
+        spec.setZoom(1);
+        spec.setMapId(mapId);
+        const QNetworkRequest request = QGeoTileFetcherQGC::getNetworkRequest(spec.mapId(), spec.x(), spec.y(), spec.zoom());
+        QGeoTiledMapReplyQGC* const reply = new QGeoTiledMapReplyQGC(_networkManager, request, spec, this);
+        (void) connect(reply, &QGeoTiledMapReplyQGC::finished, this, &TerrainTileManager::_terrainDone);
+        // TODO: Batch Downloading?
+    });
+}
+
+void TerrainTileManager::_processQueuedRequests()
+{
     for (qsizetype i = _requestQueue.count() - 1; i >= 0; i--) {
         bool error;
         QList<double> altitudes;
@@ -283,39 +332,21 @@ void TerrainTileManager::_terrainDone()
     }
 }
 
-void TerrainTileManager::_cacheTile(const QByteArray &data, const QString &hash)
+void TerrainTileManager::_cacheTile(const QByteArray &data, quint64 key)
 {
-    TerrainTile* const terrainTile = new TerrainTile(data);
-    if (terrainTile->isValid()) {
-        _tilesMutex.lock();
-        if (!_tiles.contains(hash)) {
-            (void) _tiles.insert(hash, terrainTile);
-        } else {
-            delete terrainTile;
-        }
-        _tilesMutex.unlock();
-    } else {
-        delete terrainTile;
+    if (!_tileCache.insert(key, data)) {
         qCWarning(TerrainTileManagerLog) << "Received invalid tile";
+        return;
     }
-}
 
-TerrainTile *TerrainTileManager::_getCachedTile(const QString &hash)
-{
-    _tilesMutex.lock();
-    if (!_tiles.contains(hash)) {
-        _tilesMutex.unlock();
-        return nullptr;
+    if (TerrainTileManagerLog().isDebugEnabled()) {
+        const TerrainTileCache::Stats stats = _tileCache.stats();
+        qCDebug(TerrainTileManagerLog) << "Tile cache hits:diskHits:misses:evictions:memoryBytes:diskBytes"
+                                       << stats.hits << stats.diskHits << stats.misses << stats.evictions << stats.memoryBytes << stats.diskBytes;
     }
+}
 
-    TerrainTile* const tile = _tiles[hash];
-
-    if (!tile->isValid()) {
-        _tilesMutex.unlock();
-        return nullptr;
-    }
-
-    _tilesMutex.unlock();
-
-    return tile;
+std::shared_ptr<const TerrainTile> TerrainTileManager::_getCachedTile(quint64 key)
+{
+    return _tileCache.tile(key);
 }
@@ -10,13 +10,15 @@
 #pragma once
 
 #include "TerrainQueryInterface.h"
+#include "TerrainTileCache.h"
 
 #include <QtCore/QLoggingCategory>
-#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QQueue>
 #include <QtPositioning/QGeoCoordinate>
 
+#include <memory>
+
 class TerrainTile;
 class QNetworkAccessManager;
 class UnitTestTerrainQuery;
@@ -42,6 +44,9 @@ class TerrainTileManager : public QObject
     void addCoordinateQuery(TerrainQueryInterface *terrainQueryInterface, const QList<QGeoCoordinate> &coordinates);
     void addPathQuery(TerrainQueryInterface *terrainQueryInterface, const QGeoCoordinate &startPoint, const QGeoCoordinate &endPoint);
 
+    /// Hit, miss and eviction counts of the tile cache, for tuning the cache budgets
+    Q_INVOKABLE TerrainTileCache::Stats cacheStats() const { return _tileCache.stats(); }
+
 private slots:
     void _terrainDone();
 
@@ -49,8 +54,12 @@ private slots:
     /// Returns a list of individual coordinates along the requested path spaced according to the terrain tile value spacing
     static QList<QGeoCoordinate> _pathQueryToCoords(const QGeoCoordinate &fromCoord, const QGeoCoordinate &toCoord, double &distanceBetween, double &finalDistanceBetween);
     void _tileFailed();
-    void _cacheTile(const QByteArray &data, const QString &hash);
-    TerrainTile *_getCachedTile(const QString &hash);
+    /// Looks for the tile in the disk store and downloads it if it is not there
+    void _fetchTile(quint64 key, int mapId, int x, int y);
+    /// Answers the queued requests whose tiles are all cached now
+    void _processQueuedRequests();
+    void _cacheTile(const QByteArray &data, quint64 key);
+    std::shared_ptr<const TerrainTile> _getCachedTile(quint64 key);
 
     struct QueuedRequestInfo_t {
         TerrainQueryInterface *terrainQueryInterface;
@@ -63,8 +72,7 @@ private slots:
     QQueue<QueuedRequestInfo_t> _requestQueue;
     TerrainQuery::State _state = TerrainQuery::State::Idle;
 
-    QMutex _tilesMutex;
-    QHash<QString, TerrainTile*> _tiles;
+    TerrainTileCache _tileCache;
 
     QNetworkAccessManager *_networkManager = nullptr;
 };
@@ -34,12 +34,12 @@ QGCTemporaryFile::~QGCTemporaryFile()
 
 bool QGCTemporaryFile::open(QFile::OpenMode openMode)
 {
-    setFileName(_newTempFileFullyQualifiedName(_template));
+    setFileName(newTempFileFullyQualifiedName(_template));
 
     return QFile::open(openMode);
 }
 
-QString QGCTemporaryFile::_newTempFileFullyQualifiedName(const QString &fileTemplate)
+QString QGCTemporaryFile::newTempFileFullyQualifiedName(const QString &fileTemplate)
 {
     QString nameTemplate = fileTemplate;
     const QDir tempDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation));
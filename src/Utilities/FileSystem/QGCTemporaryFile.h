@@ -29,9 +29,10 @@ class QGCTemporaryFile : public QFile
 
     void setAutoRemove(bool autoRemove) { _autoRemove = autoRemove; }
 
-private:
-    static QString _newTempFileFullyQualifiedName(const QString &fileTemplate);
+    /// @return Unused file name in the QStandardPaths::TempLocation directory following the template
+    static QString newTempFileFullyQualifiedName(const QString &fileTemplate);
 
+private:
     const QString _template;
     bool _autoRemove = false;
 };
@@ -58,6 +58,9 @@ void SignalHandler::_onSigInt()
         (void) qgcApp()->mainRootWindow()->close();
         QEvent ev(QEvent::Quit);
         (void) qgcApp()->event(&ev);
+    } else if (qgcApp() && qgcApp()->headlessLogReplay()) {
+        // Running without UI, there is no window whose closing starts the shutdown
+        QCoreApplication::quit();
     }
 
     _notifierInt->setEnabled(true);
@@ -74,6 +77,9 @@ void SignalHandler::_onSigTerm()
         (void) qgcApp()->mainRootWindow()->close();
         QEvent ev(QEvent::Quit);
         (void) qgcApp()->event(&ev);
+    } else if (qgcApp() && qgcApp()->headlessLogReplay()) {
+        // Running without UI, there is no window whose closing starts the shutdown
+        QCoreApplication::quit();
     }
 
     _notifierTerm->setEnabled(true);
@@ -37,7 +37,9 @@ class CompInfo : public QObject
 
     void setUriMetaData(const QString& uri, uint32_t crc);
 
-    virtual void setJson(const QString& metaDataJsonFileName) = 0;
+    /// @param cached true: The file is a CRC validated entry of the file cache, its contents never change. false: A
+    ///                 temporary file, for example a download without CRC or a translation.
+    virtual void setJson(const QString& metaDataJsonFileName, bool cached) = 0;
 
     bool available() const { return !_uris.uriMetaData.isEmpty(); }
 
@@ -16,8 +16,10 @@ CompInfoActuators::CompInfoActuators(uint8_t compId, Vehicle* vehicle, QObject*
 
 }
 
-void CompInfoActuators::setJson(const QString& metadataJsonFileName)
+void CompInfoActuators::setJson(const QString& metadataJsonFileName, bool cached)
 {
+    Q_UNUSED(cached);
+
     if (!metadataJsonFileName.isEmpty()) {
         vehicle->setActuatorsMetadata(compId, metadataJsonFileName);
     }
@@ -25,7 +25,7 @@ class CompInfoActuators : public CompInfo
     CompInfoActuators(uint8_t compId, Vehicle* vehicle, QObject* parent = nullptr);
 
     // Overrides from CompInfo
-    void setJson(const QString& metadataJsonFileName) override;
+    void setJson(const QString& metadataJsonFileName, bool cached) override;
 
 private:
 };
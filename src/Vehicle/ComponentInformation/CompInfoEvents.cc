@@ -16,8 +16,10 @@ CompInfoEvents::CompInfoEvents(uint8_t compId, Vehicle* vehicle, QObject* parent
 
 }
 
-void CompInfoEvents::setJson(const QString& metadataJsonFileName)
+void CompInfoEvents::setJson(const QString& metadataJsonFileName, bool cached)
 {
+    Q_UNUSED(cached);
+
     vehicle->setEventsMetadata(compId, metadataJsonFileName);
 }
 
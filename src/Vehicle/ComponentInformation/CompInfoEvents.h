@@ -25,7 +25,7 @@ class CompInfoEvents : public CompInfo
     CompInfoEvents(uint8_t compId, Vehicle* vehicle, QObject* parent = nullptr);
 
     // Overrides from CompInfo
-    void setJson(const QString& metadataJsonFileName) override;
+    void setJson(const QString& metadataJsonFileName, bool cached) override;
 
 private:
 };
@@ -32,8 +32,10 @@ void CompInfoGeneral::setUris(CompInfo &compInfo) const
     }
 }
 
-void CompInfoGeneral::setJson(const QString& metadataJsonFileName)
+void CompInfoGeneral::setJson(const QString& metadataJsonFileName, bool cached)
 {
+    Q_UNUSED(cached);
+
     if (metadataJsonFileName.isEmpty()) {
         return;
     }
@@ -33,7 +33,7 @@ class CompInfoGeneral : public CompInfo
     void setUris(CompInfo& compInfo) const;
 
     // Overrides from CompInfo
-    void setJson(const QString& metadataJsonFileName) override;
+    void setJson(const QString& metadataJsonFileName, bool cached) override;
 
 private:
     QMap<COMP_METADATA_TYPE, Uris>   _supportedTypes;
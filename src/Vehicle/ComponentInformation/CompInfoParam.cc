@@ -30,9 +30,9 @@ CompInfoParam::CompInfoParam(uint8_t compId, Vehicle* vehicle, QObject* parent)
 
 }
 
-void CompInfoParam::setJson(const QString& metadataJsonFileName)
+void CompInfoParam::setJson(const QString& metadataJsonFileName, bool cached)
 {
-    qCDebug(CompInfoParamLog) << "setJson: metadataJsonFileName" << metadataJsonFileName;
+    qCDebug(CompInfoParamLog) << "setJson: metadataJsonFileName:cached" << metadataJsonFileName << cached;
 
     if (metadataJsonFileName.isEmpty()) {
         // This will fall back to using the old FirmwarePlugin mechanism for parameter meta data.
@@ -45,6 +45,21 @@ void CompInfoParam::setJson(const QString& metadataJsonFileName)
 
     _noJsonMetadata = false;
 
+    // Snapshots are keyed on the source path, only a cached source keeps its path and contents across downloads
+    if (cached && _snapshot.open(metadataJsonFileName, QString::fromLatin1(_snapshotKind))) {
+        // Indexed names are matched against every parameter so those are decoded up front, everything else on demand
+        qCDebug(CompInfoParamLog) << "Using metadata snapshot: compid:" << compId << _snapshot.count();
+        for (const QString& name: _snapshot.keys()) {
+            if (name.contains(_indexedNameTag)) {
+                FactMetaData* newMetaData = FactMetaData::createFromSnapshotRecord(_snapshot.record(name), this);
+                if (newMetaData) {
+                    _indexedNameMetaDataList.append(RegexFactMetaDataPair_t(name, newMetaData));
+                }
+            }
+        }
+        return;
+    }
+
     if (!JsonHelper::isJsonFile(metadataJsonFileName, jsonDoc, errorString)) {
         qCWarning(CompInfoParamLog) << "Metadata json file open failed: compid:" << compId << errorString;
         return;
@@ -83,6 +98,25 @@ void CompInfoParam::setJson(const QString& metadataJsonFileName)
             _nameToMetaDataMap[newMetaData->name()] = newMetaData;
         }
     }
+
+    if (cached) {
+        _writeSnapshot(metadataJsonFileName);
+    }
+}
+
+void CompInfoParam::_writeSnapshot(const QString& metadataJsonFileName) const
+{
+    QHash<QString, QByteArray> records;
+    for (const FactMetaData* metaData: _nameToMetaDataMap) {
+        (void) records.insert(metaData->name(), metaData->toSnapshotRecord());
+    }
+    for (const RegexFactMetaDataPair_t& pair: _indexedNameMetaDataList) {
+        (void) records.insert(pair.first, pair.second->toSnapshotRecord());
+    }
+
+    if (!ParameterMetaDataSnapshot::write(metadataJsonFileName, QString::fromLatin1(_snapshotKind), records)) {
+        qCWarning(CompInfoParamLog) << "Unable to write metadata snapshot: compid:" << compId;
+    }
 }
 
 FactMetaData* CompInfoParam::factMetaDataForName(const QString& name, FactMetaData::ValueType_t type)
@@ -100,8 +134,13 @@ FactMetaData* CompInfoParam::factMetaDataForName(const QString& name, FactMetaDa
         if (_nameToMetaDataMap.contains(name)) {
             factMetaData = _nameToMetaDataMap[name];
         } else {
+            const QByteArray record = _snapshot.record(name);
+            if (!record.isEmpty()) {
+                factMetaData = FactMetaData::createFromSnapshotRecord(record, this);
+            }
+
             // We didn't get any direct matches. Try an indexed name.
-            for (int i=0; i<_indexedNameMetaDataList.count(); i++) {
+            for (int i=0; !factMetaData && (i<_indexedNameMetaDataList.count()); i++) {
                 const RegexFactMetaDataPair_t& pair = _indexedNameMetaDataList[i];
 
                 QString indexedName = pair.first;
@@ -12,6 +12,7 @@
 #include "CompInfo.h"
 #include "MAVLinkLib.h"
 #include "FactMetaData.h"
+#include "ParameterMetaDataSnapshot.h"
 
 #include <QtCore/QLoggingCategory>
 #include <QtCore/QObject>
@@ -31,7 +32,7 @@ class CompInfoParam : public CompInfo
     FactMetaData* factMetaDataForName(const QString& name, FactMetaData::ValueType_t type);
 
     // Overrides from CompInfo
-    void setJson(const QString& metadataJsonFileName) override;
+    void setJson(const QString& metadataJsonFileName, bool cached) override;
 
     static void _cachePX4MetaDataFile(const QString& metaDataFile);
 
@@ -40,6 +41,7 @@ class CompInfoParam : public CompInfo
 
     static FirmwarePlugin*  _anyVehicleTypeFirmwarePlugin   (MAV_AUTOPILOT firmwareType);
     static QString          _parameterMetaDataFile          (Vehicle* vehicle, MAV_AUTOPILOT firmwareType, int& majorVersion, int& minorVersion);
+    void                    _writeSnapshot                  (const QString& metadataJsonFileName) const;
 
     typedef QPair<QString /* indexed name */, FactMetaData*> RegexFactMetaDataPair_t;
 
@@ -47,8 +49,10 @@ class CompInfoParam : public CompInfo
     FactMetaData::NameToMetaDataMap_t   _nameToMetaDataMap;
     QList<RegexFactMetaDataPair_t>      _indexedNameMetaDataList;
     QObject*                            _opaqueParameterMetaData    = nullptr;
+    ParameterMetaDataSnapshot           _snapshot;                              ///< Meta data which has not been decoded into _nameToMetaDataMap yet
 
     static constexpr const char* _jsonParametersKey           = "parameters";
     static constexpr const char* _cachedMetaDataFilePrefix    = "ParameterFactMetaData";
     static constexpr const char* _indexedNameTag              = "{n}";
+    static constexpr const char* _snapshotKind                = "CompInfoParam";
 };
@@ -354,6 +354,10 @@ void RequestMetaDataTypeStateMachine::_ftpDownloadComplete(const QString& fileNa
 {
     qCDebug(ComponentInformationManagerLog) << "RequestMetaDataTypeStateMachine::_ftpDownloadComplete fileName:errorMsg" << fileName << errorMsg;
 
+    if (fileName != _currentFtpFilePath) {
+        return;
+    }
+
     disconnect(_compInfo->vehicle->ftpManager(), &FTPManager::downloadComplete, this, &RequestMetaDataTypeStateMachine::_ftpDownloadComplete);
     disconnect(_compInfo->vehicle->ftpManager(), &FTPManager::commandProgress, this, &RequestMetaDataTypeStateMachine::_ftpDownloadProgress);
     if (errorMsg.isEmpty()) {
@@ -368,8 +372,15 @@ void RequestMetaDataTypeStateMachine::_ftpDownloadComplete(const QString& fileNa
     advance();
 }
 
-void RequestMetaDataTypeStateMachine::_ftpDownloadProgress(float progress)
+void RequestMetaDataTypeStateMachine::_ftpDownloadProgress(const QString& fileName, float progress)
 {
+    if (fileName != _currentFtpFilePath) {
+        return;
+    }
+    if (!_downloadStartTime.isValid()) {
+        _downloadStartTime.start();
+    }
+
     int elapsedSec = _downloadStartTime.elapsed() / 1000;
     float totalDownloadTime = elapsedSec / progress;
     // abort download if it's too slow (e.g. over telemetry link) and use the fallback.
@@ -412,13 +423,17 @@ void RequestMetaDataTypeStateMachine::_requestFile(const QString& cacheFileTag,
         if (cachedFile.isEmpty()) {
             qCDebug(ComponentInformationManagerLog) << "Downloading json" << uri;
             if (_uriIsMAVLinkFTP(uri)) {
+                const QString toDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+                _currentFtpFilePath = FTPManager::downloadFilePath(uri, toDir);
                 connect(ftpManager, &FTPManager::downloadComplete, this, &RequestMetaDataTypeStateMachine::_ftpDownloadComplete);
-                if (ftpManager->download(MAV_COMP_ID_AUTOPILOT1, uri, QStandardPaths::writableLocation(QStandardPaths::TempLocation))) {
-                    _downloadStartTime.start();
-                    connect(ftpManager, &FTPManager::commandProgress, this, &RequestMetaDataTypeStateMachine::_ftpDownloadProgress);
+                connect(ftpManager, &FTPManager::commandProgress, this, &RequestMetaDataTypeStateMachine::_ftpDownloadProgress);
+                if (ftpManager->download(MAV_COMP_ID_AUTOPILOT1, uri, toDir)) {
+                    // Started by the first progress, the download may still be queued behind others
+                    _downloadStartTime.invalidate();
                 } else {
                     qCWarning(ComponentInformationManagerLog) << "RequestMetaDataTypeStateMachine::_requestFile FTPManager::download returned failure";
                     disconnect(ftpManager, &FTPManager::downloadComplete, this, &RequestMetaDataTypeStateMachine::_ftpDownloadComplete);
+                    disconnect(ftpManager, &FTPManager::commandProgress, this, &RequestMetaDataTypeStateMachine::_ftpDownloadProgress);
                     advance();
                 }
             } else {
@@ -518,9 +533,9 @@ void RequestMetaDataTypeStateMachine::_stateRequestComplete(StateMachine* stateM
     CompInfo*                           compInfo        = requestMachine->compInfo();
 
     if (requestMachine->_jsonMetadataTranslatedFileName.isEmpty()) {
-        compInfo->setJson(requestMachine->_jsonMetadataFileName);
+        compInfo->setJson(requestMachine->_jsonMetadataFileName, requestMachine->_jsonMetadataCrcValid);
     } else {
-        compInfo->setJson(requestMachine->_jsonMetadataTranslatedFileName);
+        compInfo->setJson(requestMachine->_jsonMetadataTranslatedFileName, false);
         QFile(requestMachine->_jsonMetadataTranslatedFileName).remove();
     }
 
@@ -46,7 +46,7 @@ class RequestMetaDataTypeStateMachine : public StateMachine
 
 private slots:
     void    _ftpDownloadComplete                (const QString& file, const QString& errorMsg);
-    void    _ftpDownloadProgress                (float progress);
+    void    _ftpDownloadProgress                (const QString& fileName, float progress);
     void    _httpDownloadComplete               (QString remoteFile, QString localFile, QString errorMsg);
     QString _downloadCompleteJsonWorker         (const QString& jsonFileName);
     void _downloadAndTranslationComplete(QString translatedJsonTempFile, QString errorMsg);
@@ -73,6 +73,7 @@ private slots:
 
     QString*                        _currentFileName            = nullptr;
     QString                         _currentCacheFileTag;
+    QString                         _currentFtpFilePath;        ///< Other downloads can complete while ours is queued behind them
     bool                            _currentFileValidCrc        = false;
 
     QElapsedTimer                   _downloadStartTime;
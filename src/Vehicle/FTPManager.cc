@@ -15,6 +15,11 @@
 
 #include <QtCore/QFile>
 #include <QtCore/QDir>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSaveFile>
+#include <QtCore/QtMath>
 
 QGC_LOGGING_CATEGORY(FTPManagerLog, "FTPManagerLog")
 
@@ -23,8 +28,12 @@ FTPManager::FTPManager(Vehicle* vehicle)
     , _vehicle  (vehicle)
 {
     _ackOrNakTimeoutTimer.setSingleShot(true);
+    _ackOrNakTimeoutTimer.setTimerType(Qt::PreciseTimer);
     // Mock link responds immediately if at all, speed up unit tests with faster timoue
-    _ackOrNakTimeoutTimer.setInterval(qgcApp()->runningUnitTests() ? 10 : _ackOrNakTimeoutMsecs);
+    if (qgcApp()->runningUnitTests()) {
+        _rtoMsecs = _minRtoMsecs = _burstTimeoutMsecs = 10;
+    }
+    _ackOrNakTimeoutTimer.setInterval(_rtoMsecs);
     connect(&_ackOrNakTimeoutTimer, &QTimer::timeout, this, &FTPManager::_ackOrNakTimeout);
     
     // Make sure we don't have bad structure packing
@@ -35,22 +44,45 @@ bool FTPManager::download(uint8_t fromCompId, const QString& fromURI, const QStr
 {
     qCDebug(FTPManagerLog) << "download fromURI:" << fromURI << "to:" << toDir << "fromCompId:" << fromCompId;
 
-    if (!_rgStateMachine.isEmpty()) {
-        qCDebug(FTPManagerLog) << "Cannot download. Already in another operation";
+    if (_rgStateMachine.isEmpty() && _pendingOperations.isEmpty()) {
+        return _startDownload(fromCompId, fromURI, toDir, fileName, checksize);
+    }
+
+    QString parsedURI;
+    uint8_t compId;
+    if (!_parseURI(fromCompId, fromURI, parsedURI, compId)) {
+        qCWarning(FTPManagerLog) << "_parseURI failed";
         return false;
     }
 
-    static const StateFunctions_t rgDownloadStateMachine[] = {
-        { &FTPManager::_openFileROBegin,            &FTPManager::_openFileROAckOrNak,           &FTPManager::_openFileROTimeout },
-        { &FTPManager::_burstReadFileBegin,         &FTPManager::_burstReadFileAckOrNak,        &FTPManager::_burstReadFileTimeout },
-        { &FTPManager::_fillMissingBlocksBegin,     &FTPManager::_fillMissingBlocksAckOrNak,    &FTPManager::_fillMissingBlocksTimeout },
-        { &FTPManager::_resetSessionsBegin,         &FTPManager::_resetSessionsAckOrNak,        &FTPManager::_resetSessionsTimeout },
-        { &FTPManager::_downloadCompleteNoError,    nullptr,                                    nullptr },
-    };
-    for (size_t i=0; i<sizeof(rgDownloadStateMachine)/sizeof(rgDownloadStateMachine[0]); i++) {
-        _rgStateMachine.append(rgDownloadStateMachine[i]);
+    qCDebug(FTPManagerLog) << "Download queued behind" << _pendingOperations.count() + 1 << "operations";
+    _pendingOperations.append({ false, fromCompId, fromURI, toDir, fileName, checksize });
+
+    return true;
+}
+
+QString FTPManager::downloadFilePath(const QString& fromURI, const QString& toDir, const QString& fileName)
+{
+    if (!fileName.isEmpty()) {
+        return QDir(toDir).absoluteFilePath(fileName);
     }
 
+    QString fullPathOnVehicle;
+    uint8_t compId;
+    (void) _parseURI(MAV_COMP_ID_AUTOPILOT1, fromURI, fullPathOnVehicle, compId);
+
+    return QDir(toDir).absoluteFilePath(_fileNameFromPath(fullPathOnVehicle));
+}
+
+QString FTPManager::_fileNameFromPath(const QString& fullPathOnVehicle)
+{
+    // We need to strip off the file name from the fully qualified path. We can't use the usual QDir
+    // routines because this path does not exist locally.
+    return fullPathOnVehicle.mid(fullPathOnVehicle.lastIndexOf('/') + 1);
+}
+
+bool FTPManager::_startDownload(uint8_t fromCompId, const QString& fromURI, const QString& toDir, const QString& fileName, bool checksize)
+{
     _downloadState.reset();
     _downloadState.toDir.setPath(toDir);
     _downloadState.checksize = checksize;
@@ -60,24 +92,28 @@ bool FTPManager::download(uint8_t fromCompId, const QString& fromURI, const QStr
         return false;
     }
 
-    // We need to strip off the file name from the fully qualified path. We can't use the usual QDir
-    // routines because this path does not exist locally.
-    int lastDirSlashIndex;
-    for (lastDirSlashIndex=_downloadState.fullPathOnVehicle.size()-1; lastDirSlashIndex>=0; lastDirSlashIndex--) {
-        if (_downloadState.fullPathOnVehicle[lastDirSlashIndex] == '/') {
-            break;
-        }
-    }
-    lastDirSlashIndex++; // move past slash
-
     if (fileName.isEmpty()) {
-        _downloadState.fileName = _downloadState.fullPathOnVehicle.right(_downloadState.fullPathOnVehicle.size() - lastDirSlashIndex);
+        _downloadState.fileName = _fileNameFromPath(_downloadState.fullPathOnVehicle);
     } else {
         _downloadState.fileName = fileName;
     }
 
     qCDebug(FTPManagerLog) << "_downloadState.fullPathOnVehicle:_downloadState.fileName" << _downloadState.fullPathOnVehicle << _downloadState.fileName;
 
+    _loadResumeState();
+
+    static const StateFunctions_t rgDownloadStateMachine[] = {
+        { &FTPManager::_openFileROBegin,            &FTPManager::_openFileROAckOrNak,           &FTPManager::_openFileROTimeout },
+        { &FTPManager::_calcFileCRCBegin,           &FTPManager::_calcFileCRCAckOrNak,          &FTPManager::_calcFileCRCTimeout },
+        { &FTPManager::_burstReadFileBegin,         &FTPManager::_burstReadFileAckOrNak,        &FTPManager::_burstReadFileTimeout },
+        { &FTPManager::_fillMissingBlocksBegin,     &FTPManager::_fillMissingBlocksAckOrNak,    &FTPManager::_fillMissingBlocksTimeout },
+        { &FTPManager::_resetSessionsBegin,         &FTPManager::_resetSessionsAckOrNak,        &FTPManager::_resetSessionsTimeout },
+        { &FTPManager::_downloadCompleteNoError,    nullptr,                                    nullptr },
+    };
+    for (size_t i=0; i<sizeof(rgDownloadStateMachine)/sizeof(rgDownloadStateMachine[0]); i++) {
+        _rgStateMachine.append(rgDownloadStateMachine[i]);
+    }
+
     _startStateMachine();
 
     return true;
@@ -87,19 +123,25 @@ bool FTPManager::listDirectory(uint8_t fromCompId, const QString& fromURI)
 {
     qCDebug(FTPManagerLog) << "list directory fromURI:" << fromURI << "fromCompId:" << fromCompId;
 
-    if (!_rgStateMachine.isEmpty()) {
-        qCDebug(FTPManagerLog) << "Cannot list directory. Already in another operation";
-        return false;
+    if (_rgStateMachine.isEmpty() && _pendingOperations.isEmpty()) {
+        return _startListDirectory(fromCompId, fromURI);
     }
 
-    static const StateFunctions_t rgStateMachine[] = {
-        { &FTPManager::_listDirectoryBegin,             &FTPManager::_listDirectoryAckOrNak,        &FTPManager::_listDirectoryTimeout },
-        { &FTPManager::_listDirectoryCompleteNoError,   nullptr,                                    nullptr },
-    };
-    for (size_t i=0; i<sizeof(rgStateMachine)/sizeof(rgStateMachine[0]); i++) {
-        _rgStateMachine.append(rgStateMachine[i]);
+    QString parsedURI;
+    uint8_t compId;
+    if (!_parseURI(fromCompId, fromURI, parsedURI, compId)) {
+        qCWarning(FTPManagerLog) << "_parseURI failed";
+        return false;
     }
 
+    qCDebug(FTPManagerLog) << "List directory queued behind" << _pendingOperations.count() + 1 << "operations";
+    _pendingOperations.append({ true, fromCompId, fromURI, QString(), QString(), false });
+
+    return true;
+}
+
+bool FTPManager::_startListDirectory(uint8_t fromCompId, const QString& fromURI)
+{
     _listDirectoryState.reset();
 
     if (!_parseURI(fromCompId, fromURI, _listDirectoryState.fullPathOnVehicle, _ftpCompId)) {
@@ -109,11 +151,36 @@ bool FTPManager::listDirectory(uint8_t fromCompId, const QString& fromURI)
 
     qCDebug(FTPManagerLog) << "_listDirectoryState.fullPathOnVehicle" << _listDirectoryState.fullPathOnVehicle;
 
+    static const StateFunctions_t rgStateMachine[] = {
+        { &FTPManager::_listDirectoryBegin,             &FTPManager::_listDirectoryAckOrNak,        &FTPManager::_listDirectoryTimeout },
+        { &FTPManager::_listDirectoryCompleteNoError,   nullptr,                                    nullptr },
+    };
+    for (size_t i=0; i<sizeof(rgStateMachine)/sizeof(rgStateMachine[0]); i++) {
+        _rgStateMachine.append(rgStateMachine[i]);
+    }
+
     _startStateMachine();
 
     return true;
 }
 
+/// Starts the oldest queued operation once the one in progress is finished
+void FTPManager::_startNextPendingOperation(void)
+{
+    while (_rgStateMachine.isEmpty() && !_pendingOperations.isEmpty()) {
+        const PendingOperation_t operation = _pendingOperations.takeFirst();
+
+        if (operation.listDirectory) {
+            if (!_startListDirectory(operation.fromCompId, operation.fromURI)) {
+                // The caller was told the operation started, so it is waiting for the completion
+                emit listDirectoryComplete(QStringList(), tr("List directory failed"));
+            }
+        } else if (!_startDownload(operation.fromCompId, operation.fromURI, operation.toDir, operation.fileName, operation.checksize)) {
+            emit downloadComplete(downloadFilePath(operation.fromURI, operation.toDir, operation.fileName), tr("Download failed"));
+        }
+    }
+}
+
 void FTPManager::cancelDownload()
 {
     if (!_downloadState.inProgress()) {
@@ -122,6 +189,7 @@ void FTPManager::cancelDownload()
 
     _ackOrNakTimeoutTimer.stop();
     _rgStateMachine.clear();
+    _downloadState.cancelled = true;
     static const StateFunctions_t rgTerminateStateMachine[] = {
         { &FTPManager::_terminateSessionBegin,  &FTPManager::_terminateSessionAckOrNak,     &FTPManager::_terminateSessionTimeout },
         { &FTPManager::_terminateComplete,      nullptr,                                    nullptr },
@@ -189,12 +257,29 @@ void FTPManager::_downloadComplete(const QString& errorMsg)
     _currentStateMachineIndex = -1;
     if (_downloadState.file.isOpen()) {
         _downloadState.file.close();
-        if (!errorMsg.isEmpty()) {
-            _downloadState.file.remove();
+        if (error.isEmpty()) {
+            // Only a complete file shows up under the real name
+            (void) QFile::remove(downloadFilePath);
+            if (_downloadState.file.rename(downloadFilePath)) {
+                _removeResumeState();
+            } else {
+                qCWarning(FTPManagerLog) << "_downloadComplete: rename failed" << _downloadState.file.errorString();
+                error = tr("Download failed: Error saving file");
+            }
+        }
+        if (!error.isEmpty()) {
+            if (!_downloadState.cancelled && _downloadState.checksize && _downloadState.fileCRCValid && (_downloadState.bytesWritten > 0)) {
+                _saveResumeState();
+            } else {
+                _removeResumeState();
+            }
         }
     }
+    _downloadState.rgReadsInFlight.clear();
 
-    emit downloadComplete(downloadFilePath, errorMsg);
+    emit downloadComplete(downloadFilePath, error);
+
+    _startNextPendingOperation();
 }
 
 /// Closes out a list directory sequence
@@ -213,6 +298,8 @@ void FTPManager::_listDirectoryComplete(const QString& errorMsg)
     }
 
     emit listDirectoryComplete(rgDirectoryList, errorMsg);
+
+    _startNextPendingOperation();
 }
 
 void FTPManager::_mavlinkMessageReceived(const mavlink_message_t& message)
@@ -237,15 +324,23 @@ void FTPManager::_mavlinkMessageReceived(const mavlink_message_t& message)
     
     MavlinkFTP::Request* request = (MavlinkFTP::Request*)&data.payload[0];
 
+    // With several reads in flight responses to all of them are current, those are matched up in _fillMissingBlocksAckOrNak
+    const bool pipelined = (_rgStateMachine[_currentStateMachineIndex].ackNakFn == &FTPManager::_fillMissingBlocksAckOrNak);
+
     // Ignore old/reordered packets (handle wrap-around properly)
     uint16_t actualIncomingSeqNumber = request->hdr.seqNumber;
-    if ((uint16_t)((_expectedIncomingSeqNumber - 1) - actualIncomingSeqNumber) < (std::numeric_limits<uint16_t>::max()/2)) {
+    if (!pipelined && ((uint16_t)((_expectedIncomingSeqNumber - 1) - actualIncomingSeqNumber) < (std::numeric_limits<uint16_t>::max()/2))) {
         qCDebug(FTPManagerLog) << "_mavlinkMessageReceived: Received old packet seqNum expected:actual" << _expectedIncomingSeqNumber << actualIncomingSeqNumber
                                << "hdr.opcode:hdr.req_opcode" << MavlinkFTP::opCodeToString(static_cast<MavlinkFTP::OpCode_t>(request->hdr.opcode)) <<  MavlinkFTP::opCodeToString(static_cast<MavlinkFTP::OpCode_t>(request->hdr.req_opcode));
 
         return;
     }
 
+    if (!pipelined && _rttSamplePending && (actualIncomingSeqNumber == _rttSampleSeqNumber)) {
+        _rttSamplePending = false;
+        _rttSample(_rttTimer.nsecsElapsed() / 1.0e6);
+    }
+
     qCDebug(FTPManagerLog) << "_mavlinkMessageReceived: hdr.opcode:hdr.req_opcode:seqNumber"
                            << MavlinkFTP::opCodeToString(static_cast<MavlinkFTP::OpCode_t>(request->hdr.opcode)) <<  MavlinkFTP::opCodeToString(static_cast<MavlinkFTP::OpCode_t>(request->hdr.req_opcode))
                            << request->hdr.seqNumber;
@@ -267,9 +362,26 @@ void FTPManager::_advanceStateMachine(void)
 
 void FTPManager::_ackOrNakTimeout(void)
 {
+    // Back off until a response is timed again, the link may just have become slower
+    _rtoMsecs = qMin(_rtoMsecs * 2, _maxAckOrNakTimeoutMsecs);
+
     (this->*_rgStateMachine[_currentStateMachineIndex].timeoutFn)();
 }
 
+/// Updates the round trip time estimate and the ack/nak timeout derived from it as in RFC 6298
+void FTPManager::_rttSample(double rttMsecs)
+{
+    if (_srttMsecs < 0) {
+        _srttMsecs = rttMsecs;
+        _rttVarMsecs = rttMsecs / 2;
+    } else {
+        _rttVarMsecs = (0.75 * _rttVarMsecs) + (0.25 * qAbs(_srttMsecs - rttMsecs));
+        _srttMsecs = (0.875 * _srttMsecs) + (0.125 * rttMsecs);
+    }
+
+    _rtoMsecs = qBound(_minRtoMsecs, qCeil(_srttMsecs + (4 * _rttVarMsecs)), _maxAckOrNakTimeoutMsecs);
+}
+
 void FTPManager::_fillRequestDataWithString(MavlinkFTP::Request* request, const QString& str)
 {
     strncpy((char *)&request->data[0], str.toStdString().c_str(), sizeof(request->data));
@@ -337,19 +449,108 @@ void FTPManager::_openFileROAckOrNak(const MavlinkFTP::Request* ackOrNak)
         _downloadState.fileSize         = ackOrNak->openFileLength;
         _downloadState.expectedOffset   = 0;
 
-        _downloadState.file.setFileName(_downloadState.toDir.filePath(_downloadState.fileName));
-        if (_downloadState.file.open(QFile::WriteOnly | QFile::Truncate)) {
-            _advanceStateMachine();
-        } else {
-            qCDebug(FTPManagerLog) << "_openFileROAckOrNak: Ack _downloadState.file open failed" << _downloadState.file.errorString();
-            _downloadComplete(tr("Download failed"));
-        }
+        _advanceStateMachine();
     } else if (ackOrNak->hdr.opcode == MavlinkFTP::kRspNak) {
         qCDebug(FTPManagerLog) << "_handlOpenFileROAck: Nak -" << _errorMsgFromNak(ackOrNak);
         _downloadComplete(tr("Download failed") + ": " + _errorMsgFromNak(ackOrNak));
     }
 }
 
+void FTPManager::_calcFileCRCBegin(void)
+{
+    if (!_downloadState.checksize) {
+        // Partial downloads of files without a known size are never kept, so there is nothing to check
+        _openPartFile();
+        return;
+    }
+
+    _downloadState.retryCount = 0;
+    _calcFileCRCWorker();
+}
+
+void FTPManager::_calcFileCRCWorker(void)
+{
+    MavlinkFTP::Request request{};
+    request.hdr.session = 0;
+    request.hdr.opcode  = MavlinkFTP::kCmdCalcFileCRC32;
+    request.hdr.offset  = 0;
+    request.hdr.size    = 0;
+    _fillRequestDataWithString(&request, _downloadState.fullPathOnVehicle);
+    _sendRequestExpectAck(&request);
+}
+
+void FTPManager::_calcFileCRCAckOrNak(const MavlinkFTP::Request* ackOrNak)
+{
+    MavlinkFTP::OpCode_t requestOpCode = static_cast<MavlinkFTP::OpCode_t>(ackOrNak->hdr.req_opcode);
+    if (requestOpCode != MavlinkFTP::kCmdCalcFileCRC32) {
+        qCDebug(FTPManagerLog) << "_calcFileCRCAckOrNak: Disregarding due to incorrect requestOpCode" << MavlinkFTP::opCodeToString(requestOpCode);
+        return;
+    }
+    if (ackOrNak->hdr.seqNumber != _expectedIncomingSeqNumber) {
+        qCDebug(FTPManagerLog) << "_calcFileCRCAckOrNak: Disregarding due to incorrect sequence actual:expected" << ackOrNak->hdr.seqNumber << _expectedIncomingSeqNumber;
+        return;
+    }
+
+    _ackOrNakTimeoutTimer.stop();
+
+    if ((ackOrNak->hdr.opcode == MavlinkFTP::kRspAck) && (ackOrNak->hdr.size == sizeof(uint32_t))) {
+        _downloadState.fileCRC      = ackOrNak->fileCRC32;
+        _downloadState.fileCRCValid = true;
+        qCDebug(FTPManagerLog) << "_calcFileCRCAckOrNak: Ack crc" << Qt::hex << _downloadState.fileCRC;
+    } else if (ackOrNak->hdr.opcode == MavlinkFTP::kRspNak) {
+        // Not all vehicles support this, the download just can't be resumed then
+        qCDebug(FTPManagerLog) << "_calcFileCRCAckOrNak: Nak -" << _errorMsgFromNak(ackOrNak);
+    } else {
+        qCDebug(FTPManagerLog) << "_calcFileCRCAckOrNak: Ack ack->hdr.size != sizeof(uint32_t)" << ackOrNak->hdr.size << sizeof(uint32_t);
+    }
+
+    _openPartFile();
+}
+
+void FTPManager::_calcFileCRCTimeout(void)
+{
+    if (++_downloadState.retryCount > _maxRetry) {
+        qCDebug(FTPManagerLog) << QString("_calcFileCRCTimeout retries exceeded, download can't be resumed");
+        _openPartFile();
+    } else {
+        qCDebug(FTPManagerLog) << QString("_calcFileCRCTimeout: retrying - retryCount(%1)").arg(_downloadState.retryCount);
+        _calcFileCRCWorker();
+    }
+}
+
+/// Opens the partial file the download is written to. A previous attempt is picked up where it left off, as long as
+/// the file on the vehicle still has the same size and CRC.
+void FTPManager::_openPartFile(void)
+{
+    _downloadState.resumed = _downloadState.checksize && _downloadState.fileCRCValid
+            && (_downloadState.resumeFileSize == _downloadState.fileSize) && (_downloadState.resumeFileCRC == _downloadState.fileCRC)
+            && QFile::exists(_partFilePath());
+    if (_downloadState.resumeFileSize && !_downloadState.resumed) {
+        qCDebug(FTPManagerLog) << "_openPartFile: discarding stale partial download" << _partFilePath();
+        _removeResumeState();
+    }
+
+    QIODevice::OpenMode openMode = QFile::WriteOnly | QFile::Truncate;
+    if (_downloadState.resumed) {
+        openMode = QFile::ReadWrite;
+        _downloadState.rgMissingData    = _downloadState.rgResumeMissingData;
+        _downloadState.expectedOffset   = _downloadState.fileSize;
+        _downloadState.bytesWritten     = _downloadState.fileSize;
+        for (const MissingData_t& missingData: _downloadState.rgMissingData) {
+            _downloadState.bytesWritten -= missingData.cBytesMissing;
+        }
+        qCDebug(FTPManagerLog) << "_openPartFile: resuming download - bytesWritten:fileSize" << _downloadState.bytesWritten << _downloadState.fileSize;
+    }
+
+    _downloadState.file.setFileName(_partFilePath());
+    if (_downloadState.file.open(openMode)) {
+        _advanceStateMachine();
+    } else {
+        qCDebug(FTPManagerLog) << "_openPartFile: _downloadState.file open failed" << _downloadState.file.errorString();
+        _downloadComplete(tr("Download failed"));
+    }
+}
+
 void FTPManager::_burstReadFileWorker(bool firstRequest)
 {
     qCDebug(FTPManagerLog) << "_burstReadFileWorker: starting burst at offset:firstRequest:retryCount" << _downloadState.expectedOffset << firstRequest << _downloadState.retryCount;
@@ -372,6 +573,12 @@ void FTPManager::_burstReadFileWorker(bool firstRequest)
 
 void FTPManager::_burstReadFileBegin(void)
 {
+    if (_downloadState.resumed) {
+        // Everything the burst would read was received by the previous attempt, only the gaps are left
+        _advanceStateMachine();
+        return;
+    }
+
     _burstReadFileWorker(true /* firstRequestr */);
 }
 
@@ -408,7 +615,7 @@ void FTPManager::_burstReadFileAckOrNak(const MavlinkFTP::Request* ackOrNak)
                 qCDebug(FTPManagerLog) << "_handleBurstReadFileAck: adding missing data offset:cBytesMissing" << missingData.offset << missingData.cBytesMissing;
             } else {
                 // Offset is past what we have already seen, disregard and wait for something usefule
-                _ackOrNakTimeoutTimer.start();
+                _ackOrNakTimeoutTimer.start(qMax(_rtoMsecs, _burstTimeoutMsecs));
                 qCDebug(FTPManagerLog) << "_handleBurstReadFileAck: received offset less than expected offset received:expected" << ackOrNak->hdr.offset << _downloadState.expectedOffset;
                 return;
             }
@@ -428,14 +635,15 @@ void FTPManager::_burstReadFileAckOrNak(const MavlinkFTP::Request* ackOrNak)
             _expectedIncomingSeqNumber = ackOrNak->hdr.seqNumber;
             _burstReadFileWorker(true /* firstRequest */);
         } else {
-            // Still within a burst, next ack should come automatically
+            // Still within a burst, next ack should come automatically. The vehicle paces the burst, so this
+            // is not a round trip and the round trip time says little about how long the wait may be.
             _expectedIncomingSeqNumber = ackOrNak->hdr.seqNumber + 1;
-            _ackOrNakTimeoutTimer.start();
+            _ackOrNakTimeoutTimer.start(qMax(_rtoMsecs, _burstTimeoutMsecs));
         }
 
         // Emit progress last, as cancel could be called in there
         if (_downloadState.fileSize != 0) {
-            emit commandProgress((float)(_downloadState.bytesWritten) / (float)_downloadState.fileSize);
+            emit commandProgress(_downloadState.toDir.absoluteFilePath(_downloadState.fileName), (float)(_downloadState.bytesWritten) / (float)_downloadState.fileSize);
         }
     } else if (ackOrNak->hdr.opcode == MavlinkFTP::kRspNak) {
         MavlinkFTP::ErrorCode_t errorCode = static_cast<MavlinkFTP::ErrorCode_t>(ackOrNak->data[0]);
@@ -536,7 +744,7 @@ void FTPManager::_listDirectoryAckOrNak(const MavlinkFTP::Request* ackOrNak)
             // All entries returned
             if (ackOrNak->hdr.seqNumber != _expectedIncomingSeqNumber) {
                 qCDebug(FTPManagerLog) << "_listDirectoryAckOrNak: Disregarding Nak due to incorrect sequence actual:expected" << ackOrNak->hdr.seqNumber << _expectedIncomingSeqNumber;
-                _ackOrNakTimeoutTimer.start();
+                _ackOrNakTimeoutTimer.start(_rtoMsecs);
                 return;
             } else {
                 qCDebug(FTPManagerLog) << "_listDirectoryAckOrNak EOF";
@@ -561,44 +769,76 @@ void FTPManager::_listDirectoryTimeout(void)
     }
 }
 
-void FTPManager::_fillMissingBlocksWorker(bool firstRequest)
+/// Keeps up to _maxReadsInFlight reads for missing data outstanding, each for a different block
+void FTPManager::_fillMissingBlocksWorker(void)
 {
-    if (_downloadState.rgMissingData.count()) {
-        MavlinkFTP::Request request{};
-        MissingData_t&      missingData = _downloadState.rgMissingData.first();
+    while ((_downloadState.rgReadsInFlight.count() < _maxReadsInFlight) && !_downloadState.rgMissingData.isEmpty()) {
+        MissingData_t& missingData = _downloadState.rgMissingData.first();
 
-        uint32_t cBytesToRead = qMin((uint32_t)sizeof(request.data), missingData.cBytesMissing);
+        ReadInFlight_t read{};
+        read.offset = missingData.offset;
+        read.cBytes = qMin(static_cast<uint32_t>(sizeof(MavlinkFTP::Request::data)), missingData.cBytesMissing);
 
-        qCDebug(FTPManagerLog) << "_fillMissingBlocksBegin: offset:cBytesToRead" << missingData.offset << cBytesToRead;
+        missingData.offset          += read.cBytes;
+        missingData.cBytesMissing   -= read.cBytes;
+        if (missingData.cBytesMissing == 0) {
+            _downloadState.rgMissingData.removeFirst();
+        }
 
-        request.hdr.session                 = _downloadState.sessionId;
-        request.hdr.opcode                  = MavlinkFTP::kCmdReadFile;
-        request.hdr.offset                  = missingData.offset;
-        request.hdr.size                    = cBytesToRead;
+        _downloadState.rgReadsInFlight.append(read);
+        _sendReadRequest(_downloadState.rgReadsInFlight.last());
+    }
 
-        if (firstRequest) {
-            _downloadState.retryCount = 0;
-        } else {
-            // Must used same sequence number as previous request
-            _expectedIncomingSeqNumber -= 2;
-        }
-        _downloadState.expectedOffset = request.hdr.offset;
+    if (!_downloadState.rgReadsInFlight.isEmpty()) {
+        _startReadsInFlightTimer();
+        return;
+    }
 
-        _sendRequestExpectAck(&request);
+    // We should have the full file now
+    if (_downloadState.checksize == false || _downloadState.bytesWritten == _downloadState.fileSize) {
+        _advanceStateMachine();
     } else {
-        // We should have the full file now
-        if (_downloadState.checksize == false || _downloadState.bytesWritten == _downloadState.fileSize) {
-            _advanceStateMachine();
-        } else {
-            qCDebug(FTPManagerLog) << "_fillMissingBlocksWorker: no missing blocks but file still incomplete - bytesWritten:fileSize" << _downloadState.bytesWritten << _downloadState.fileSize;
-            _downloadComplete(tr("Download failed"));
-        }
+        qCDebug(FTPManagerLog) << "_fillMissingBlocksWorker: no missing blocks but file still incomplete - bytesWritten:fileSize" << _downloadState.bytesWritten << _downloadState.fileSize;
+        _downloadComplete(tr("Download failed"));
+    }
+}
+
+void FTPManager::_sendReadRequest(ReadInFlight_t& read)
+{
+    qCDebug(FTPManagerLog) << "_sendReadRequest: offset:cBytes:retryCount" << read.offset << read.cBytes << read.retryCount;
+
+    MavlinkFTP::Request request{};
+    request.hdr.session = _downloadState.sessionId;
+    request.hdr.opcode  = MavlinkFTP::kCmdReadFile;
+    request.hdr.offset  = read.offset;
+    request.hdr.size    = static_cast<uint8_t>(read.cBytes);
+
+    // Resent reads get a new sequence number, the vehicle only remembers the response to the latest request
+    _sendRequestExpectAck(&request);
+
+    read.lastSeqNumber = request.hdr.seqNumber + 1;
+    if (read.retryCount == 0) {
+        read.firstSeqNumber = read.lastSeqNumber;
     }
+    read.timeoutMsecs = _rtoMsecs;
+    read.sent.start();
+}
+
+/// Times out the read which has been waiting the longest
+void FTPManager::_startReadsInFlightTimer(void)
+{
+    qint64 msecsToTimeout = std::numeric_limits<int>::max();
+    for (const ReadInFlight_t& read: _downloadState.rgReadsInFlight) {
+        msecsToTimeout = qMin(msecsToTimeout, read.timeoutMsecs - read.sent.elapsed());
+    }
+
+    _ackOrNakTimeoutTimer.start(static_cast<int>(qMax<qint64>(0, msecsToTimeout)));
 }
 
 void FTPManager::_fillMissingBlocksBegin(void)
 {
-    _fillMissingBlocksWorker(true /* firstRequest */);
+    _downloadState.rgReadsInFlight.clear();
+    _fillMissingBlocksWorker();
 }
 
 void FTPManager::_fillMissingBlocksAckOrNak(const MavlinkFTP::Request* ackOrNak)
@@ -609,66 +849,72 @@ void FTPManager::_fillMissingBlocksAckOrNak(const MavlinkFTP::Request* ackOrNak)
         qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Disregarding due to incorrect requestOpCode" << MavlinkFTP::opCodeToString(requestOpCode);
         return;
     }
-    if (ackOrNak->hdr.seqNumber != _expectedIncomingSeqNumber) {
-        qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Disregarding due to incorrect sequence actual:expected" << ackOrNak->hdr.seqNumber << _expectedIncomingSeqNumber;
-        return;
-    }
     if (ackOrNak->hdr.session != _downloadState.sessionId) {
         qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Disregarding due to incorrect session id actual:expected" << ackOrNak->hdr.session << _downloadState.sessionId;
         return;
     }
 
-    _ackOrNakTimeoutTimer.stop();
+    // Match the response to its read, responses to any of the requests sent for the read will do
+    qsizetype readIndex = -1;
+    for (qsizetype i=0; i<_downloadState.rgReadsInFlight.count(); i++) {
+        const ReadInFlight_t& read = _downloadState.rgReadsInFlight[i];
+        const uint16_t seqNumberSpan = read.lastSeqNumber - read.firstSeqNumber;
+        if ((ackOrNak->hdr.offset == read.offset) && (static_cast<uint16_t>(ackOrNak->hdr.seqNumber - read.firstSeqNumber) <= seqNumberSpan)) {
+            readIndex = i;
+            break;
+        }
+    }
+    if (readIndex == -1) {
+        qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Disregarding response to read not in flight offset:seqNumber" << ackOrNak->hdr.offset << ackOrNak->hdr.seqNumber;
+        return;
+    }
+
+    const ReadInFlight_t read = _downloadState.rgReadsInFlight.takeAt(readIndex);
+    if (read.retryCount == 0) {
+        // Karn's algorithm: a response to a resent request can't be timed
+        _rttSample(read.sent.nsecsElapsed() / 1.0e6);
+    }
 
     if (ackOrNak->hdr.opcode == MavlinkFTP::kRspAck) {
         qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Ack offset:size" << ackOrNak->hdr.offset << ackOrNak->hdr.size;
 
-        if (ackOrNak->hdr.offset != _downloadState.expectedOffset) {
-            if (++_downloadState.retryCount > _maxRetry) {
-                qCDebug(FTPManagerLog) << QString("_fillMissingBlocksAckOrNak: offset mismatch, retries exceeded");
-                _downloadComplete(tr("Download failed"));
-                return;
-            }
-
-            // Ask for current offset again
-            qCDebug(FTPManagerLog) << QString("_fillMissingBlocksAckOrNak: Ack offset mismatch retry, retryCount(%1) offset(%2)").arg(_downloadState.retryCount).arg(_downloadState.expectedOffset);
-            _fillMissingBlocksWorker(false /* firstReqeust */);
+        if (ackOrNak->hdr.size == 0) {
+            qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Ack with no data";
+            _downloadComplete(tr("Download failed"));
             return;
         }
 
+        // Servers may return more than was asked for, that belongs to other reads
+        const uint32_t cBytes = qMin(static_cast<uint32_t>(ackOrNak->hdr.size), read.cBytes);
+
         _downloadState.file.seek(ackOrNak->hdr.offset);
-        int bytesWritten = _downloadState.file.write((const char*)ackOrNak->data, ackOrNak->hdr.size);
-        if (bytesWritten != ackOrNak->hdr.size) {
+        int bytesWritten = _downloadState.file.write((const char*)ackOrNak->data, cBytes);
+        if (bytesWritten != static_cast<int>(cBytes)) {
             _downloadComplete(tr("Download failed: Error saving file"));
             return;
         }
-        _downloadState.bytesWritten += ackOrNak->hdr.size;
+        _downloadState.bytesWritten += cBytes;
 
-        MissingData_t& missingData = _downloadState.rgMissingData.first();
-        missingData.offset += ackOrNak->hdr.size;
-        missingData.cBytesMissing -= ackOrNak->hdr.size;
-        if (missingData.cBytesMissing == 0) {
-            // This block is finished, remove it
-            _downloadState.rgMissingData.takeFirst();
+        if (cBytes < read.cBytes) {
+            // Short read, ask for the rest next
+            _downloadState.rgMissingData.prepend({ read.offset + cBytes, read.cBytes - cBytes });
         }
 
         // Move on to fill in possible next hole
-        _fillMissingBlocksWorker(true /* firstReqeust */);
+        _fillMissingBlocksWorker();
 
         // Emit progress last, as cancel could be called in there
         if (_downloadState.fileSize != 0) {
-            emit commandProgress((float)(_downloadState.bytesWritten) / (float)_downloadState.fileSize);
+            emit commandProgress(_downloadState.toDir.absoluteFilePath(_downloadState.fileName), (float)(_downloadState.bytesWritten) / (float)_downloadState.fileSize);
         }
     } else if (ackOrNak->hdr.opcode == MavlinkFTP::kRspNak) {
         MavlinkFTP::ErrorCode_t errorCode = static_cast<MavlinkFTP::ErrorCode_t>(ackOrNak->data[0]);
 
-        if (errorCode == MavlinkFTP::kErrEOF) {
-            qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak EOF";
-            if (_downloadState.checksize == false || _downloadState.bytesWritten == _downloadState.fileSize) {
-                // We've successfully complete filling in all missing blocks
-                _advanceStateMachine();
-                return;
-            }
+        if ((errorCode == MavlinkFTP::kErrEOF) && !_downloadState.checksize) {
+            // The file size is only a guess, there is simply nothing at this offset
+            qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak EOF offset" << read.offset;
+            _fillMissingBlocksWorker();
+            return;
         }
 
         qCDebug(FTPManagerLog) << "_fillMissingBlocksAckOrNak: Nak -" << _errorMsgFromNak(ackOrNak);
@@ -678,14 +924,23 @@ void FTPManager::_fillMissingBlocksAckOrNak(const MavlinkFTP::Request* ackOrNak)
 
 void FTPManager::_fillMissingBlocksTimeout(void)
 {
-    if (++_downloadState.retryCount > _maxRetry) {
-        qCDebug(FTPManagerLog) << QString("_fillMissingBlocksTimeout retries exceeded");
-        _downloadComplete(tr("Download failed"));
-    } else {
-        // Ask for current offset again
-        qCDebug(FTPManagerLog) << QString("_fillMissingBlocksTimeout: retrying - retryCount(%1) offset(%2)").arg(_downloadState.retryCount).arg(_downloadState.expectedOffset);
-        _fillMissingBlocksWorker(false /* firstReqeust */);
+    for (ReadInFlight_t& read: _downloadState.rgReadsInFlight) {
+        if (read.sent.elapsed() < read.timeoutMsecs) {
+            continue;
+        }
+
+        if (++read.retryCount > _maxRetry) {
+            qCDebug(FTPManagerLog) << QString("_fillMissingBlocksTimeout retries exceeded offset(%1)").arg(read.offset);
+            _downloadComplete(tr("Download failed"));
+            return;
+        }
+
+        // Ask for this block again, the other reads keep going
+        qCDebug(FTPManagerLog) << QString("_fillMissingBlocksTimeout: retrying - retryCount(%1) offset(%2)").arg(read.retryCount).arg(read.offset);
+        _sendReadRequest(read);
     }
+
+    _startReadsInFlightTimer();
 }
 
 void FTPManager::_resetSessionsBegin(void)
@@ -728,13 +983,18 @@ void FTPManager::_resetSessionsTimeout(void)
 
 void FTPManager::_sendRequestExpectAck(MavlinkFTP::Request* request)
 {
-    _ackOrNakTimeoutTimer.start();
+    _ackOrNakTimeoutTimer.start(_rtoMsecs);
     
     SharedLinkInterfacePtr sharedLink = _vehicle->vehicleLinkManager()->primaryLink().lock();
     if (sharedLink) {
         request->hdr.seqNumber = _expectedIncomingSeqNumber + 1;    // Outgoing is 1 past last incoming
         _expectedIncomingSeqNumber += 2;
 
+        // Karn's algorithm: a request resent with the same sequence number can't be timed, the response may be to the original
+        _rttSamplePending = (_expectedIncomingSeqNumber != _rttSampleSeqNumber);
+        _rttSampleSeqNumber = _expectedIncomingSeqNumber;
+        _rttTimer.start();
+
         qCDebug(FTPManagerLog) << "_sendRequestExpectAck opcode:" << MavlinkFTP::opCodeToString(static_cast<MavlinkFTP::OpCode_t>(request->hdr.opcode)) << "seqNumber:" << request->hdr.seqNumber;
 
         mavlink_message_t message;
@@ -752,6 +1012,88 @@ void FTPManager::_sendRequestExpectAck(MavlinkFTP::Request* request)
     }
 }
 
+QString FTPManager::_partFilePath(void) const
+{
+    return _downloadState.toDir.absoluteFilePath(_downloadState.fileName) + QStringLiteral(".part");
+}
+
+/// Reads the record a failed download left next to its partial file
+void FTPManager::_loadResumeState(void)
+{
+    QFile file(_partFilePath() + QStringLiteral(".json"));
+    if (!file.exists() || !file.open(QFile::ReadOnly)) {
+        return;
+    }
+
+    const QJsonObject json = QJsonDocument::fromJson(file.readAll()).object();
+    if ((json[QStringLiteral("uri")].toString() != _downloadState.fullPathOnVehicle) || (json[QStringLiteral("compId")].toInt() != _ftpCompId)) {
+        return;
+    }
+
+    const qint64 fileSize = json[QStringLiteral("fileSize")].toInteger();
+    const qint64 fileCRC = json[QStringLiteral("crc")].toInteger(-1);
+    if ((fileSize <= 0) || (fileSize > std::numeric_limits<uint32_t>::max()) || (fileCRC < 0) || (fileCRC > std::numeric_limits<uint32_t>::max())) {
+        return;
+    }
+
+    QList<MissingData_t> rgMissingData;
+    for (const QJsonValue& value: json[QStringLiteral("missing")].toArray()) {
+        const QJsonArray range = value.toArray();
+        if (range.count() != 2) {
+            return;
+        }
+        const qint64 offset = range[0].toInteger(-1);
+        const qint64 cBytesMissing = range[1].toInteger(-1);
+        if ((offset < 0) || (cBytesMissing <= 0) || ((offset + cBytesMissing) > fileSize)) {
+            return;
+        }
+        rgMissingData.append({ static_cast<uint32_t>(offset), static_cast<uint32_t>(cBytesMissing) });
+    }
+
+    _downloadState.resumeFileSize       = static_cast<uint32_t>(fileSize);
+    _downloadState.resumeFileCRC        = static_cast<uint32_t>(fileCRC);
+    _downloadState.rgResumeMissingData  = rgMissingData;
+}
+
+/// Records what is still missing from the partial file, so the next download of the same file only fetches that
+void FTPManager::_saveResumeState(void)
+{
+    QList<MissingData_t> rgMissingData = _downloadState.rgMissingData;
+    for (const ReadInFlight_t& read: _downloadState.rgReadsInFlight) {
+        rgMissingData.append({ read.offset, read.cBytes });
+    }
+    if (_downloadState.expectedOffset < _downloadState.fileSize) {
+        rgMissingData.append({ _downloadState.expectedOffset, _downloadState.fileSize - _downloadState.expectedOffset });
+    }
+
+    QJsonArray missing;
+    for (const MissingData_t& missingData: rgMissingData) {
+        missing.append(QJsonArray({ static_cast<qint64>(missingData.offset), static_cast<qint64>(missingData.cBytesMissing) }));
+    }
+
+    QJsonObject json;
+    json[QStringLiteral("uri")]         = _downloadState.fullPathOnVehicle;
+    json[QStringLiteral("compId")]      = _ftpCompId;
+    json[QStringLiteral("fileSize")]    = static_cast<qint64>(_downloadState.fileSize);
+    json[QStringLiteral("crc")]         = static_cast<qint64>(_downloadState.fileCRC);
+    json[QStringLiteral("missing")]     = missing;
+
+    QSaveFile file(_partFilePath() + QStringLiteral(".json"));
+    if (!file.open(QFile::WriteOnly) || (file.write(QJsonDocument(json).toJson(QJsonDocument::Compact)) < 0) || !file.commit()) {
+        qCDebug(FTPManagerLog) << "_saveResumeState: unable to save" << file.fileName() << file.errorString();
+        _removeResumeState();
+        return;
+    }
+
+    qCDebug(FTPManagerLog) << "_saveResumeState: kept partial download" << _partFilePath() << "missing ranges" << rgMissingData.count();
+}
+
+void FTPManager::_removeResumeState(void)
+{
+    (void) QFile::remove(_partFilePath());
+    (void) QFile::remove(_partFilePath() + QStringLiteral(".json"));
+}
+
 bool FTPManager::_parseURI(uint8_t fromCompId, const QString& uri, QString& parsedURI, uint8_t& compId)
 {
     parsedURI   = uri;
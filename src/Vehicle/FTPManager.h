@@ -13,6 +13,7 @@
 
 #include <QtCore/QObject>
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QTimer>
 #include <QtCore/QLoggingCategory>
 
@@ -20,6 +21,12 @@ Q_DECLARE_LOGGING_CATEGORY(FTPManagerLog)
 
 class Vehicle;
 
+/// MAVLink FTP client.
+///
+/// Operations run one at a time, further downloads and directory listings are queued and started in the order they
+/// were requested. A download first bursts through the file and then fills in the data lost along the way with
+/// several read requests in flight at once. Timeouts follow the measured round trip time. A download which fails
+/// part way through leaves its data behind in a .part file, downloading the same file again only fetches the rest.
 class FTPManager : public QObject
 {
     Q_OBJECT
@@ -39,16 +46,19 @@ class FTPManager : public QObject
     ///                       response with the transmitted filesize. If false the transmission is tftp style
     ///                       and the indicated filesize from MAVFTP fileopen response is ignored.
     ///                       This is used for the APM parameter download where the filesize is wrong due to
-    ///                       a dynamic file creation on the vehicle.
-    /// @return true: download has started, false: error, no download
+    ///                       a dynamic file creation on the vehicle. Such downloads can't be resumed.
+    /// @return true: download has started or is queued behind the operations in progress, false: error, no download
     /// Signals downloadComplete, commandProgress
     bool download(uint8_t fromCompId, const QString& fromURI, const QString& toDir, const QString& fileName="", bool checksize = true);
 
+    /// @return The local file a download with these arguments is written to, this is the file reported by downloadComplete
+    static QString downloadFilePath(const QString& fromURI, const QString& toDir, const QString& fileName = QString());
+
 	/// Get the directory listing of the specified directory.
     ///     @param fromCompId Component id of the component to download from. If fromCompId is MAV_COMP_ID_ALL, then MAV_COMP_ID_AUTOPILOT1 is used.
     ///     @param fromURI    Directory path to list from component. May be in the format "mftp://[;comp=<id>]..." where the component id
     ///                       is specified. If component id is not specified, then the id set via fromCompId is used.
-    /// @return true: process has started, false: error
+    /// @return true: process has started or is queued behind the operations in progress, false: error
     /// Signals listDirectoryComplete
     bool listDirectory(uint8_t fromCompId, const QString& fromURI);
 
@@ -56,15 +66,30 @@ class FTPManager : public QObject
     /// This will emit downloadComplete() when done, and if there's currently a download in progress
     void cancelDownload();
 
+    /// Number of read requests kept in flight while filling in missing data, 1 fills the gaps one at a time
+    void setMaxReadsInFlight(int maxReadsInFlight) { _maxReadsInFlight = qMax(1, maxReadsInFlight); }
+    int maxReadsInFlight() const { return _maxReadsInFlight; }
+
+    /// @return Current ack/nak timeout, derived from the measured round trip times
+    int ackOrNakTimeoutMsecs() const { return _rtoMsecs; }
+
     static constexpr const char* mavlinkFTPScheme = "mftp";
 
+    /// Vehicles queue incoming requests in small buffers (ArduPilot holds 5), more would only be dropped
+    static constexpr int kDefaultMaxReadsInFlight = 4;
+
+    /// Message ids consumed by _mavlinkMessageReceived, Vehicle only routes these to us
+    static constexpr uint32_t handledMessageIds[] = { MAVLINK_MSG_ID_FILE_TRANSFER_PROTOCOL };
+
 signals:
     void downloadComplete       (const QString& file, const QString& errorMsg);
     void listDirectoryComplete  (const QStringList& dirList, const QString& errorMsg);
 
     /// Signalled during a lengthy command to show progress
+    ///     @param file Local file of the download, the same as passed to downloadComplete. Downloads may be queued
+    ///                 behind each other, so this tells which one is progressing.
     ///     @param value Amount of progress: 0.0 = none, 1.0 = complete
-    void commandProgress(float value);
+    void commandProgress(const QString& file, float value);
 	
 private slots:
     void _ackOrNakTimeout(void);
@@ -85,18 +110,37 @@ private slots:
         uint32_t cBytesMissing;
     };
 
+    /// A kCmdReadFile request of the missing blocks phase which has not been answered yet
+    struct ReadInFlight_t {
+        uint32_t        offset;
+        uint32_t        cBytes;
+        uint16_t        firstSeqNumber;     ///< Sequence number of the response to the first request
+        uint16_t        lastSeqNumber;      ///< Sequence number of the response to the latest (re)request
+        int             retryCount;
+        int             timeoutMsecs;
+        QElapsedTimer   sent;
+    };
+
     struct DownloadState_t {
         uint8_t                 sessionId;
         uint32_t                expectedOffset;         ///< offset which should be coming next
         uint32_t                bytesWritten;
-        QList<MissingData_t>    rgMissingData;
+        QList<MissingData_t>    rgMissingData;          ///< Missing data not requested yet
+        QList<ReadInFlight_t>   rgReadsInFlight;
         QString                 fullPathOnVehicle;      ///< Fully qualified path to file on vehicle
         QDir                    toDir;                  ///< Directory to download file to
         QString                 fileName;               ///< Filename (no path) for download file
         uint32_t                fileSize;               ///< Size of file being downloaded
-        QFile                   file;
+        QFile                   file;                   ///< Partial file, renamed to fileName once complete
         int                     retryCount;
         bool                    checksize;
+        bool                    resumed;                ///< Only the data missing from a previous attempt is downloaded
+        bool                    cancelled;
+        uint32_t                fileCRC;                ///< CRC32 of the file on the vehicle
+        bool                    fileCRCValid;           ///< The vehicle reported the CRC, a partial download can only be resumed with it
+        uint32_t                resumeFileSize;         ///< File size recorded by a previous attempt, 0 for none
+        uint32_t                resumeFileCRC;          ///< File CRC32 recorded by a previous attempt
+        QList<MissingData_t>    rgResumeMissingData;    ///< Data still missing after the previous attempt
 
         bool inProgress() const { return fileSize > 0; }
 
@@ -106,13 +150,31 @@ private slots:
             bytesWritten    = 0;
             retryCount      = 0;
             fileSize        = 0;
+            resumed         = false;
+            cancelled       = false;
+            fileCRC         = 0;
+            fileCRCValid    = false;
+            resumeFileSize  = 0;
+            resumeFileCRC   = 0;
             fullPathOnVehicle.clear();
             fileName.clear();
             rgMissingData.clear();
+            rgReadsInFlight.clear();
+            rgResumeMissingData.clear();
             file.close();
         }
     };
 
+    /// Download or directory listing waiting for the operation in progress to finish
+    struct PendingOperation_t {
+        bool        listDirectory;
+        uint8_t     fromCompId;
+        QString     fromURI;
+        QString     toDir;
+        QString     fileName;
+        bool        checksize;
+    };
+
     struct ListDirectoryState_t {
         uint8_t     sessionId;
         uint32_t    expectedOffset;         ///< offset which should be coming next
@@ -132,6 +194,9 @@ private slots:
     };
 
     void    _mavlinkMessageReceived     (const mavlink_message_t& message);
+    bool    _startDownload              (uint8_t fromCompId, const QString& fromURI, const QString& toDir, const QString& fileName, bool checksize);
+    bool    _startListDirectory         (uint8_t fromCompId, const QString& fromURI);
+    void    _startNextPendingOperation  (void);
     void    _startStateMachine          (void);
     void    _advanceStateMachine        (void);
     void    _listDirectoryBegin         (void);
@@ -140,6 +205,9 @@ private slots:
     void    _openFileROBegin            (void);
     void    _openFileROAckOrNak         (const MavlinkFTP::Request* ackOrNak);
     void    _openFileROTimeout          (void);
+    void    _calcFileCRCBegin           (void);
+    void    _calcFileCRCAckOrNak        (const MavlinkFTP::Request* ackOrNak);
+    void    _calcFileCRCTimeout         (void);
     void    _burstReadFileBegin         (void);
     void    _burstReadFileAckOrNak      (const MavlinkFTP::Request* ackOrNak);
     void    _burstReadFileTimeout       (void);
@@ -154,10 +222,20 @@ private slots:
     void    _downloadCompleteNoError    (void) { _downloadComplete(QString()); }
     void    _downloadComplete           (const QString& errorMsg);
     void    _fillRequestDataWithString(MavlinkFTP::Request* request, const QString& str);
-    void    _fillMissingBlocksWorker    (bool firstRequest);
+    void    _fillMissingBlocksWorker    (void);
+    void    _sendReadRequest            (ReadInFlight_t& read);
+    void    _startReadsInFlightTimer    (void);
     void    _burstReadFileWorker        (bool firstRequest);
+    void    _calcFileCRCWorker          (void);
+    void    _openPartFile               (void);
     void    _listDirectoryWorker        (bool firstRequest);
-    bool    _parseURI                   (uint8_t fromCompId, const QString& uri, QString& parsedURI, uint8_t& compId);
+    void    _rttSample                  (double rttMsecs);
+    void    _loadResumeState            (void);
+    void    _saveResumeState            (void);
+    void    _removeResumeState          (void);
+    QString _partFilePath               (void) const;
+    static bool _parseURI               (uint8_t fromCompId, const QString& uri, QString& parsedURI, uint8_t& compId);
+    static QString _fileNameFromPath    (const QString& fullPathOnVehicle);
     bool    _isListDirectoryStateMachine(void);
     void    _listDirectoryCompleteNoError(void) { _listDirectoryComplete(QString()); }
     void    _listDirectoryComplete      (const QString& errorMsg);
@@ -167,16 +245,30 @@ private slots:
     void    _terminateSessionTimeout    (void);
     void    _terminateComplete          (void);
 
-    Vehicle*                _vehicle;
-    uint8_t                 _ftpCompId = MAV_COMP_ID_AUTOPILOT1;
-    QList<StateFunctions_t> _rgStateMachine;
-    DownloadState_t         _downloadState;
-    ListDirectoryState_t    _listDirectoryState;
-    QTimer                  _ackOrNakTimeoutTimer;
-    int                     _currentStateMachineIndex   = -1;
-    uint16_t                _expectedIncomingSeqNumber  = 0;
-    
-    static const int _ackOrNakTimeoutMsecs  = 1000;
-    static const int _maxRetry              = 3;
+    Vehicle*                    _vehicle;
+    uint8_t                     _ftpCompId = MAV_COMP_ID_AUTOPILOT1;
+    QList<StateFunctions_t>     _rgStateMachine;
+    QList<PendingOperation_t>   _pendingOperations;
+    DownloadState_t             _downloadState;
+    ListDirectoryState_t        _listDirectoryState;
+    QTimer                      _ackOrNakTimeoutTimer;
+    int                         _currentStateMachineIndex   = -1;
+    uint16_t                    _expectedIncomingSeqNumber  = 0;
+    int                         _maxReadsInFlight           = kDefaultMaxReadsInFlight;
+
+    // Round trip time estimate (RFC 6298) the ack/nak timeout is derived from
+    QElapsedTimer               _rttTimer;
+    uint16_t                    _rttSampleSeqNumber         = 0;        ///< Response which completes the current measurement
+    bool                        _rttSamplePending           = false;
+    double                      _srttMsecs                  = -1;       ///< Smoothed round trip time, < 0 until the first sample
+    double                      _rttVarMsecs                = 0;
+    int                         _rtoMsecs                   = _ackOrNakTimeoutMsecs;
+    int                         _minRtoMsecs                = _minAckOrNakTimeoutMsecs;
+    int                         _burstTimeoutMsecs          = _ackOrNakTimeoutMsecs;    ///< Wait for the next packet within a burst
+
+    static const int _ackOrNakTimeoutMsecs      = 1000;     ///< Until the first round trip time is measured
+    static const int _minAckOrNakTimeoutMsecs   = 200;
+    static const int _maxAckOrNakTimeoutMsecs   = 4000;
+    static const int _maxRetry                  = 3;
 };
 
@@ -12,6 +12,8 @@
 TerrainFactGroup::TerrainFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/TerrainFactGroup.json"), parent)
 {
+    _setHandledMessageIds({});
+
     _addFact(&_blocksPendingFact);
     _addFact(&_blocksLoadedFact);
 }
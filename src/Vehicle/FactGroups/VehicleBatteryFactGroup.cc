@@ -14,6 +14,12 @@
 VehicleBatteryFactGroup::VehicleBatteryFactGroup(uint8_t batteryId, QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/BatteryFact.json"), parent)
 {
+    _setHandledMessageIds({
+        MAVLINK_MSG_ID_HIGH_LATENCY,
+        MAVLINK_MSG_ID_HIGH_LATENCY2,
+        MAVLINK_MSG_ID_BATTERY_STATUS,
+    });
+
     _addFact(&_batteryIdFact);
     _addFact(&_batteryFunctionFact);
     _addFact(&_batteryTypeFact);
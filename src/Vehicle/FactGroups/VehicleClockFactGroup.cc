@@ -13,6 +13,8 @@
 VehicleClockFactGroup::VehicleClockFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/ClockFact.json"), parent)
 {
+    _setHandledMessageIds({});
+
     _addFact(&_currentTimeFact);
     _addFact(&_currentUTCTimeFact);
     _addFact(&_currentDateFact);
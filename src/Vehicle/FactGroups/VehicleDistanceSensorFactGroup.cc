@@ -13,6 +13,8 @@
 VehicleDistanceSensorFactGroup::VehicleDistanceSensorFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/DistanceSensorFact.json"), parent)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_DISTANCE_SENSOR });
+
     _addFact(&_rotationNoneFact);
     _addFact(&_rotationYaw45Fact);
     _addFact(&_rotationYaw90Fact);
@@ -13,6 +13,8 @@
 VehicleEFIFactGroup::VehicleEFIFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/EFIFact.json"), parent)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_EFI_STATUS });
+
     _addFact(&_healthFact);
     _addFact(&_ecuIndexFact);
     _addFact(&_rpmFact);
@@ -13,6 +13,8 @@
 VehicleEscStatusFactGroup::VehicleEscStatusFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/EscStatusFactGroup.json"), parent)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_ESC_STATUS });
+
     _addFact(&_indexFact);
 
     _addFact(&_rpmFirstFact);
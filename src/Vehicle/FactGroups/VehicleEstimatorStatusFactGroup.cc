@@ -13,6 +13,8 @@
 VehicleEstimatorStatusFactGroup::VehicleEstimatorStatusFactGroup(QObject *parent)
     : FactGroup(500, QStringLiteral(":/json/Vehicle/EstimatorStatusFactGroup.json"), parent)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_ESTIMATOR_STATUS });
+
     _addFact(&_goodAttitudeEstimateFact);
     _addFact(&_goodHorizVelEstimateFact);
     _addFact(&_goodVertVelEstimateFact);
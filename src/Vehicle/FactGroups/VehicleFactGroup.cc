@@ -17,6 +17,18 @@
 VehicleFactGroup::VehicleFactGroup(QObject *parent)
     : FactGroup(100, QStringLiteral(":/json/Vehicle/VehicleFact.json"), parent)
 {
+    _setHandledMessageIds({
+        MAVLINK_MSG_ID_ATTITUDE,
+        MAVLINK_MSG_ID_ATTITUDE_QUATERNION,
+        MAVLINK_MSG_ID_ALTITUDE,
+        MAVLINK_MSG_ID_VFR_HUD,
+        MAVLINK_MSG_ID_NAV_CONTROLLER_OUTPUT,
+        MAVLINK_MSG_ID_RAW_IMU,
+#ifndef QGC_NO_ARDUPILOT_DIALECT
+        MAVLINK_MSG_ID_RANGEFINDER,
+#endif
+    });
+
     _addFact(&_rollFact);
     _addFact(&_pitchFact);
     _addFact(&_headingFact);
@@ -97,9 +109,9 @@ void VehicleFactGroup::_handleAttitudeWorker(double rollRadians, double pitchRad
     // truncate to integer so widget never displays 360
     yawDegrees = trunc(yawDegrees);
 
-    roll()->setRawValue(rollDegrees);
-    pitch()->setRawValue(pitchDegrees);
-    heading()->setRawValue(yawDegrees);
+    roll()->setRawDouble(rollDegrees);
+    pitch()->setRawDouble(pitchDegrees);
+    heading()->setRawDouble(yawDegrees);
 }
 
 void VehicleFactGroup::_handleAttitude(Vehicle *vehicle, const mavlink_message_t &message)
@@ -127,8 +139,8 @@ void VehicleFactGroup::_handleAltitude(const mavlink_message_t &message)
 
     // Data from ALTITUDE message takes precedence over gps messages
     _altitudeMessageAvailable = true;
-    altitudeRelative()->setRawValue(altitude.altitude_relative);
-    altitudeAMSL()->setRawValue(altitude.altitude_amsl);
+    altitudeRelative()->setRawDouble(altitude.altitude_relative);
+    altitudeAMSL()->setRawDouble(altitude.altitude_amsl);
 
     _setTelemetryAvailable(true);
 }
@@ -161,9 +173,9 @@ void VehicleFactGroup::_handleAttitudeQuaternion(Vehicle *vehicle, const mavlink
 
     _handleAttitudeWorker(attRoll, attPitch, attYaw);
 
-    rollRate()->setRawValue(qRadiansToDegrees(rates[0]));
-    pitchRate()->setRawValue(qRadiansToDegrees(rates[1]));
-    yawRate()->setRawValue(qRadiansToDegrees(rates[2]));
+    rollRate()->setRawDouble(qRadiansToDegrees(rates[0]));
+    pitchRate()->setRawDouble(qRadiansToDegrees(rates[1]));
+    yawRate()->setRawDouble(qRadiansToDegrees(rates[2]));
 
     _setTelemetryAvailable(true);
 }
@@ -173,10 +185,10 @@ void VehicleFactGroup::_handleNavControllerOutput(const mavlink_message_t &messa
     mavlink_nav_controller_output_t navControllerOutput{};
     mavlink_msg_nav_controller_output_decode(&message, &navControllerOutput);
 
-    altitudeTuningSetpoint()->setRawValue(_altitudeTuningFact.rawValue().toDouble() - navControllerOutput.alt_error);
-    xTrackError()->setRawValue(navControllerOutput.xtrack_error);
-    airSpeedSetpoint()->setRawValue(_airSpeedFact.rawValue().toDouble() - navControllerOutput.aspd_error);
-    distanceToNextWP()->setRawValue(navControllerOutput.wp_dist);
+    altitudeTuningSetpoint()->setRawDouble(_altitudeTuningFact.rawValue().toDouble() - navControllerOutput.alt_error);
+    xTrackError()->setRawDouble(navControllerOutput.xtrack_error);
+    airSpeedSetpoint()->setRawDouble(_airSpeedFact.rawValue().toDouble() - navControllerOutput.aspd_error);
+    distanceToNextWP()->setRawDouble(navControllerOutput.wp_dist);
 
     _setTelemetryAvailable(true);
 }
@@ -186,16 +198,16 @@ void VehicleFactGroup::_handleVfrHud(const mavlink_message_t &message)
     mavlink_vfr_hud_t vfrHud{};
     mavlink_msg_vfr_hud_decode(&message, &vfrHud);
 
-    airSpeed()->setRawValue(qIsNaN(vfrHud.airspeed) ? 0 : vfrHud.airspeed);
-    groundSpeed()->setRawValue(qIsNaN(vfrHud.groundspeed) ? 0 : vfrHud.groundspeed);
-    climbRate()->setRawValue(qIsNaN(vfrHud.climb) ? 0 : vfrHud.climb);
-    throttlePct()->setRawValue(static_cast<int16_t>(vfrHud.throttle));
+    airSpeed()->setRawDouble(qIsNaN(vfrHud.airspeed) ? 0 : vfrHud.airspeed);
+    groundSpeed()->setRawDouble(qIsNaN(vfrHud.groundspeed) ? 0 : vfrHud.groundspeed);
+    climbRate()->setRawDouble(qIsNaN(vfrHud.climb) ? 0 : vfrHud.climb);
+    throttlePct()->setRawInt(static_cast<int16_t>(vfrHud.throttle));
     if (qIsNaN(_altitudeTuningOffset)) {
         _altitudeTuningOffset = vfrHud.alt;
     }
-    altitudeTuning()->setRawValue(vfrHud.alt - _altitudeTuningOffset);
+    altitudeTuning()->setRawDouble(vfrHud.alt - _altitudeTuningOffset);
     if (!qIsNaN(vfrHud.groundspeed) && !qIsNaN(_distanceToHomeFact.cookedValue().toDouble())) {
-      timeToHome()->setRawValue(_distanceToHomeFact.cookedValue().toDouble() / vfrHud.groundspeed);
+      timeToHome()->setRawDouble(_distanceToHomeFact.cookedValue().toDouble() / vfrHud.groundspeed);
     }
 
     _setTelemetryAvailable(true);
@@ -217,7 +229,7 @@ void VehicleFactGroup::_handleRangefinder(const mavlink_message_t &message)
     mavlink_rangefinder_t rangefinder{};
     mavlink_msg_rangefinder_decode(&message, &rangefinder);
 
-    rangeFinderDist()->setRawValue(qIsNaN(rangefinder.distance) ? 0 : rangefinder.distance);
+    rangeFinderDist()->setRawDouble(qIsNaN(rangefinder.distance) ? 0 : rangefinder.distance);
 
     _setTelemetryAvailable(true);
 }
@@ -17,7 +17,10 @@ class VehicleGPS2FactGroup : public VehicleGPSFactGroup
 
 public:
     explicit VehicleGPS2FactGroup(QObject *parent = nullptr)
-        : VehicleGPSFactGroup(parent) {}
+        : VehicleGPSFactGroup(parent)
+    {
+        _setHandledMessageIds({ MAVLINK_MSG_ID_GPS2_RAW });
+    }
 
     // Overrides from VehicleGPSFactGroup
     void handleMessage(Vehicle *vehicle, const mavlink_message_t &message) final;
@@ -16,6 +16,12 @@
 VehicleGPSFactGroup::VehicleGPSFactGroup(QObject *parent)
     : FactGroup(1000, ":/json/Vehicle/GPSFact.json", parent)
 {
+    _setHandledMessageIds({
+        MAVLINK_MSG_ID_GPS_RAW_INT,
+        MAVLINK_MSG_ID_HIGH_LATENCY,
+        MAVLINK_MSG_ID_HIGH_LATENCY2,
+    });
+
     _addFact(&_latFact);
     _addFact(&_lonFact);
     _addFact(&_mgrsFact);
@@ -57,14 +63,14 @@ void VehicleGPSFactGroup::_handleGpsRawInt(const mavlink_message_t &message)
     mavlink_gps_raw_int_t gpsRawInt{};
     mavlink_msg_gps_raw_int_decode(&message, &gpsRawInt);
 
-    lat()->setRawValue(gpsRawInt.lat * 1e-7);
-    lon()->setRawValue(gpsRawInt.lon * 1e-7);
+    lat()->setRawDouble(gpsRawInt.lat * 1e-7);
+    lon()->setRawDouble(gpsRawInt.lon * 1e-7);
     mgrs()->setRawValue(QGCGeo::convertGeoToMGRS(QGeoCoordinate(gpsRawInt.lat * 1e-7, gpsRawInt.lon * 1e-7)));
-    count()->setRawValue((gpsRawInt.satellites_visible == 255) ? 0 : gpsRawInt.satellites_visible);
-    hdop()->setRawValue((gpsRawInt.eph == UINT16_MAX) ? qQNaN() : (gpsRawInt.eph / 100.0));
-    vdop()->setRawValue((gpsRawInt.epv == UINT16_MAX) ? qQNaN() : (gpsRawInt.epv / 100.0));
-    courseOverGround()->setRawValue((gpsRawInt.cog == UINT16_MAX) ? qQNaN() : (gpsRawInt.cog / 100.0));
-    lock()->setRawValue(gpsRawInt.fix_type);
+    count()->setRawInt((gpsRawInt.satellites_visible == 255) ? 0 : gpsRawInt.satellites_visible);
+    hdop()->setRawDouble((gpsRawInt.eph == UINT16_MAX) ? qQNaN() : (gpsRawInt.eph / 100.0));
+    vdop()->setRawDouble((gpsRawInt.epv == UINT16_MAX) ? qQNaN() : (gpsRawInt.epv / 100.0));
+    courseOverGround()->setRawDouble((gpsRawInt.cog == UINT16_MAX) ? qQNaN() : (gpsRawInt.cog / 100.0));
+    lock()->setRawInt(gpsRawInt.fix_type);
 
     _setTelemetryAvailable(true);
 }
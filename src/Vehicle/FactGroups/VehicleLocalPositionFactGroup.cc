@@ -13,6 +13,8 @@
 VehicleLocalPositionFactGroup::VehicleLocalPositionFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/LocalPositionFact.json"), parent)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_LOCAL_POSITION_NED });
+
     _addFact(&_xFact);
     _addFact(&_yFact);
     _addFact(&_zFact);
@@ -39,13 +41,13 @@ void VehicleLocalPositionFactGroup::handleMessage(Vehicle *vehicle, const mavlin
     mavlink_local_position_ned_t localPosition{};
     mavlink_msg_local_position_ned_decode(&message, &localPosition);
 
-    x()->setRawValue(localPosition.x);
-    y()->setRawValue(localPosition.y);
-    z()->setRawValue(localPosition.z);
+    x()->setRawDouble(localPosition.x);
+    y()->setRawDouble(localPosition.y);
+    z()->setRawDouble(localPosition.z);
 
-    vx()->setRawValue(localPosition.vx);
-    vy()->setRawValue(localPosition.vy);
-    vz()->setRawValue(localPosition.vz);
+    vx()->setRawDouble(localPosition.vx);
+    vy()->setRawDouble(localPosition.vy);
+    vz()->setRawDouble(localPosition.vz);
 
     _setTelemetryAvailable(true);
 }
@@ -13,6 +13,8 @@
 VehicleRPMFactGroup::VehicleRPMFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/RPMFact.json"), parent)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_RAW_RPM });
+
     _addFact(&_rpm1Fact);
     _addFact(&_rpm2Fact);
     _addFact(&_rpm3Fact);
@@ -15,6 +15,8 @@
 VehicleSetpointFactGroup::VehicleSetpointFactGroup(QObject *parent)
     : FactGroup(1000, QStringLiteral(":/json/Vehicle/SetpointFact.json"), parent)
 {
+    _setHandledMessageIds({ MAVLINK_MSG_ID_ATTITUDE_TARGET });
+
     _addFact(&_rollFact);
     _addFact(&_pitchFact);
     _addFact(&_yawFact);
@@ -44,16 +46,16 @@ void VehicleSetpointFactGroup::handleMessage(Vehicle *vehicle, const mavlink_mes
     float targetRoll, targetPitch, targetYaw;
     mavlink_quaternion_to_euler(attitudeTarget.q, &targetRoll, &targetPitch, &targetYaw);
 
-    roll()->setRawValue(qRadiansToDegrees(targetRoll));
-    pitch()->setRawValue(qRadiansToDegrees(targetPitch));
+    roll()->setRawDouble(qRadiansToDegrees(targetRoll));
+    pitch()->setRawDouble(qRadiansToDegrees(targetPitch));
     if (targetYaw < 0.f) {
         targetYaw += 2.f * static_cast<float>(M_PI); // bring to range [0, 2pi] to match the heading angle
     }
-    yaw()->setRawValue(qRadiansToDegrees(targetYaw));
+    yaw()->setRawDouble(qRadiansToDegrees(targetYaw));
 
-    rollRate()->setRawValue(qRadiansToDegrees(attitudeTarget.body_roll_rate));
-    pitchRate()->setRawValue(qRadiansToDegrees(attitudeTarget.body_pitch_rate));
-    yawRate()->setRawValue(qRadiansToDegrees(attitudeTarget.body_yaw_rate));
+    rollRate()->setRawDouble(qRadiansToDegrees(attitudeTarget.body_roll_rate));
+    pitchRate()->setRawDouble(qRadiansToDegrees(attitudeTarget.body_pitch_rate));
+    yawRate()->setRawDouble(qRadiansToDegrees(attitudeTarget.body_yaw_rate));
 
     _setTelemetryAvailable(true);
 }
@@ -32,11 +32,14 @@
 #endif
 #include "QGCLoggingCategory.h"
 
+#include <algorithm>
+
 #include <QtCore/qapplicationstatic.h>
 #include <QtCore/QTimer>
 #include <QtQml/QQmlEngine>
 
 QGC_LOGGING_CATEGORY(MultiVehicleManagerLog, "qgc.vehicle.multivehiclemanager")
+QGC_LOGGING_CATEGORY(VehicleDispatchLog, "qgc.vehicle.multivehiclemanager.dispatch")
 
 Q_APPLICATION_STATIC(MultiVehicleManager, _multiVehicleManagerInstance);
 
@@ -80,6 +83,7 @@ void MultiVehicleManager::init()
     _offlineEditingVehicle = new Vehicle(Vehicle::MAV_AUTOPILOT_TRACK, Vehicle::MAV_TYPE_TRACK, this);
 
     (void) connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::vehicleHeartbeatInfo, this, &MultiVehicleManager::_vehicleHeartbeatInfo);
+    (void) connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::messageReceived, this, &MultiVehicleManager::_mavlinkMessageReceived);
 
     _gcsHeartbeatTimer->setInterval(kGCSHeartbeatRateMSecs);
     _gcsHeartbeatTimer->setSingleShot(false);
@@ -147,6 +151,7 @@ void MultiVehicleManager::_vehicleHeartbeatInfo(LinkInterface* link, int vehicle
     (void) connect(vehicle->parameterManager(), &ParameterManager::parametersReadyChanged, this, &MultiVehicleManager::_vehicleParametersReadyChanged);
 
     _vehicles->append(vehicle);
+    _vehicleIdMap[vehicleId] = vehicle;
 
     // Send QGC heartbeat ASAP, this allows PX4 to start accepting commands
     _sendGCSHeartbeat();
@@ -209,6 +214,7 @@ void MultiVehicleManager::_deleteVehiclePhase1(Vehicle *vehicle)
     if (!found) {
         qCWarning(MultiVehicleManagerLog) << "Vehicle not found in map!";
     }
+    (void) _vehicleIdMap.remove(vehicle->id());
 
     deselectVehicle(vehicle->id());
 
@@ -385,14 +391,74 @@ bool MultiVehicleManager::_vehicleSelected(int vehicleId)
 
 Vehicle *MultiVehicleManager::getVehicleById(int vehicleId) const
 {
-    for (int i = 0; i < _vehicles->count(); i++) {
-        Vehicle *const vehicle = qobject_cast<Vehicle*>(_vehicles->get(i));
-        if (vehicle->id() == vehicleId) {
-            return vehicle;
+    return _vehicleIdMap.value(vehicleId, nullptr);
+}
+
+void MultiVehicleManager::_mavlinkMessageReceived(LinkInterface *link, const mavlink_message_t &message)
+{
+    const bool measure = VehicleDispatchLog().isDebugEnabled();
+    QElapsedTimer dispatchTimer;
+    if (measure) {
+        dispatchTimer.start();
+    }
+
+    if (message.sysid == 0) {
+        // Broadcast from a component without a system id of its own
+        const QList<Vehicle*> vehicles = _vehicleIdMap.values();
+        for (Vehicle *const vehicle : vehicles) {
+            vehicle->_mavlinkMessageReceived(link, message);
+        }
+    } else {
+        Vehicle *const vehicle = _vehicleIdMap.value(message.sysid, nullptr);
+        if (vehicle) {
+            vehicle->_mavlinkMessageReceived(link, message);
+        }
+
+        if (message.msgid == MAVLINK_MSG_ID_RADIO_STATUS) {
+            // RADIO_STATUS carries the radio's own system id, it belongs to every vehicle using the link it arrived on
+            const QList<Vehicle*> vehicles = _vehicleIdMap.values();
+            for (Vehicle *const linkVehicle : vehicles) {
+                if ((linkVehicle != vehicle) && linkVehicle->vehicleLinkManager()->containsLink(link)) {
+                    linkVehicle->_mavlinkMessageReceived(link, message);
+                }
+            }
+        }
+    }
+
+    DispatchStats &stats = _dispatchStats[message.msgid];
+    stats.count++;
+    if (measure) {
+        const qint64 elapsed = dispatchTimer.nsecsElapsed();
+        stats.totalNsecs += elapsed;
+        stats.maxNsecs = qMax(stats.maxNsecs, elapsed);
+
+        if (!_dispatchStatsLogTimer.isValid()) {
+            _dispatchStatsLogTimer.start();
+        } else if (_dispatchStatsLogTimer.hasExpired(kDispatchStatsLogIntervalMSecs)) {
+            _logDispatchStats();
+            _dispatchStatsLogTimer.restart();
         }
     }
+}
 
-    return nullptr;
+void MultiVehicleManager::_logDispatchStats()
+{
+    QList<uint32_t> msgids = _dispatchStats.keys();
+    std::sort(msgids.begin(), msgids.end(), [this](uint32_t a, uint32_t b) {
+        return _dispatchStats.value(a).totalNsecs > _dispatchStats.value(b).totalNsecs;
+    });
+
+    qCDebug(VehicleDispatchLog) << "msgid:name:count:avg(us):max(us):total(ms)";
+    for (const uint32_t msgid : std::as_const(msgids)) {
+        const DispatchStats &stats = _dispatchStats[msgid];
+        const mavlink_message_info_t *const info = mavlink_get_message_info_by_id(msgid);
+        qCDebug(VehicleDispatchLog) << msgid
+                                    << (info ? info->name : "UNKNOWN")
+                                    << stats.count
+                                    << ((stats.count > 0) ? (stats.totalNsecs / static_cast<qint64>(stats.count) / 1000) : 0)
+                                    << (stats.maxNsecs / 1000)
+                                    << (stats.totalNsecs / 1000000);
+    }
 }
 
 void MultiVehicleManager::_setActiveVehicle(Vehicle *vehicle)
@@ -13,15 +13,20 @@
 
 #pragma once
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
 #include <QtCore/QObject>
 #include <QtCore/QLoggingCategory>
 
+#include "MAVLinkLib.h"
+
 class LinkInterface;
 class Vehicle;
 class QmlObjectListModel;
 class QTimer;
 
 Q_DECLARE_LOGGING_CATEGORY(MultiVehicleManagerLog)
+Q_DECLARE_LOGGING_CATEGORY(VehicleDispatchLog)
 
 class MultiVehicleManager : public QObject
 {
@@ -54,6 +59,15 @@ class MultiVehicleManager : public QObject
     Vehicle *activeVehicle() const { return _activeVehicle; }
     void setActiveVehicle(Vehicle *vehicle);
 
+    /// Routing cost of incoming messages, per message id
+    struct DispatchStats {
+        quint64 count = 0;
+        qint64 totalNsecs = 0;  ///< Only measured while VehicleDispatchLog debug output is enabled
+        qint64 maxNsecs = 0;
+    };
+    const QHash<uint32_t, DispatchStats> &dispatchStats() const { return _dispatchStats; }
+    void resetDispatchStats() { _dispatchStats.clear(); }
+
 signals:
     void vehicleAdded(Vehicle *vehicle);
     void vehicleRemoved(Vehicle *vehicle);
@@ -69,6 +83,7 @@ private slots:
     void _sendGCSHeartbeat();
     void _vehicleHeartbeatInfo(LinkInterface *link, int vehicleId, int componentId, int vehicleFirmwareType, int vehicleType);
     void _requestProtocolVersion(unsigned version) const; /// This slot is connected to the Vehicle::requestProtocolVersion signal such that the vehicle manager tries to switch MAVLink to v2 if all vehicles support it
+    void _mavlinkMessageReceived(LinkInterface *link, const mavlink_message_t &message); /// Routes incoming messages to the vehicle with the matching system id
 
 private:
     bool _vehicleExists(int vehicleId);
@@ -78,9 +93,11 @@ private slots:
     void _setActiveVehicleAvailable(bool activeVehicleAvailable);
     bool _getParameterReadyVehicleAvailable() const { return _parameterReadyVehicleAvailable; }
     void _setParameterReadyVehicleAvailable(bool parametersReady);
+    void _logDispatchStats();
 
     QTimer *_gcsHeartbeatTimer = nullptr;           ///< Timer to emit heartbeats
     QmlObjectListModel *_vehicles = nullptr;
+    QHash<int, Vehicle*> _vehicleIdMap;             ///< Vehicles by system id, used to route incoming messages
     QmlObjectListModel *_selectedVehicles = nullptr;
     Vehicle *_offlineEditingVehicle = nullptr;      ///< Disconnected vechicle used for offline editing
     bool _activeVehicleAvailable = false;           ///< true: An active vehicle is available
@@ -88,6 +105,9 @@ private slots:
     Vehicle *_activeVehicle = nullptr;              ///< Currently active vehicle from a ui perspective
     QList<int> _ignoreVehicleIds;                   ///< List of vehicle id for which we ignore further communication
     bool _initialized = false;
+    QHash<uint32_t, DispatchStats> _dispatchStats;
+    QElapsedTimer _dispatchStatsLogTimer;
 
     static constexpr int kGCSHeartbeatRateMSecs = 1000;  ///< Heartbeat rate
+    static constexpr int kDispatchStatsLogIntervalMSecs = 10000;
 };
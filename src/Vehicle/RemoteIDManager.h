@@ -57,6 +57,9 @@ class RemoteIDManager : public QObject
 
     void mavlinkMessageReceived (mavlink_message_t& message);
 
+    /// Message ids consumed by mavlinkMessageReceived, Vehicle only routes these to us
+    static constexpr uint32_t handledMessageIds[] = { MAVLINK_MSG_ID_OPEN_DRONE_ID_ARM_STATUS };
+
     enum LocationTypes {
         TAKEOFF,
         LiveGNSS,
@@ -69,6 +69,8 @@
 
 #include <QtCore/QDateTime>
 
+#include <algorithm>
+
 QGC_LOGGING_CATEGORY(VehicleLog, "VehicleLog")
 
 #define UPDATE_TIMER 50
@@ -120,7 +122,7 @@ Vehicle::Vehicle(LinkInterface*             link,
 
     qCDebug(VehicleLog) << "Link started with Mavlink " << (MAVLinkProtocol::instance()->getCurrentVersion() >= 200 ? "V2" : "V1");
 
-    connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::messageReceived,        this, &Vehicle::_mavlinkMessageReceived);
+    // Incoming messages are routed to us by MultiVehicleManager
     connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::mavlinkMessageStatus,   this, &Vehicle::_mavlinkMessageStatus);
 
     connect(this, &Vehicle::flightModeChanged,          this, &Vehicle::_handleFlightModeChanged);
@@ -172,7 +174,13 @@ Vehicle::Vehicle(LinkInterface*             link,
 
     _firmwarePlugin->initializeVehicle(this);
     for(auto& factName: factNames()) {
-        _firmwarePlugin->adjustMetaData(vehicleType, getFact(factName)->metaData());
+        // Vehicle meta data is shared by all vehicles. Only facts the firmware actually changes get a private copy.
+        Fact* fact = getFact(factName);
+        FactMetaData adjustedMetaData(*fact->metaData());
+        _firmwarePlugin->adjustMetaData(vehicleType, &adjustedMetaData);
+        if (adjustedMetaData != *fact->metaData()) {
+            fact->setMetaData(new FactMetaData(adjustedMetaData, fact));
+        }
     }
 
     _sendMultipleTimer.start(_sendMessageMultipleIntraMessageDelay);
@@ -251,6 +259,7 @@ void Vehicle::_commonInit()
 
     connect(_firmwarePlugin, &FirmwarePlugin::toolIndicatorsChanged, this, &Vehicle::toolIndicatorsChanged);
     connect(_firmwarePlugin, &FirmwarePlugin::modeIndicatorsChanged, this, &Vehicle::modeIndicatorsChanged);
+    connect(this, &FactGroup::factGroupNamesChanged, this, [this]() { _messageRoutes.clear(); });
 
     connect(this, &Vehicle::coordinateChanged,      this, &Vehicle::_updateDistanceHeadingToHome);
     connect(this, &Vehicle::coordinateChanged,      this, &Vehicle::_updateDistanceToGCS);
@@ -450,6 +459,32 @@ void Vehicle::resetCounters()
     _heardFrom          = false;
 }
 
+const Vehicle::MessageRoute& Vehicle::_messageRoute(uint32_t msgid)
+{
+    auto it = _messageRoutes.constFind(msgid);
+    if (it != _messageRoutes.constEnd()) {
+        return *it;
+    }
+
+    const auto contains = [msgid](const auto& msgids) {
+        return std::find(std::begin(msgids), std::end(msgids), msgid) != std::end(msgids);
+    };
+
+    MessageRoute route;
+    for (FactGroup* factGroup : factGroups()) {
+        if (factGroup->handlesMessage(msgid)) {
+            route.factGroups.append(factGroup);
+        }
+    }
+    route.vehicleFactGroup      = handlesMessage(msgid);
+    route.ftpManager            = contains(FTPManager::handledMessageIds);
+    route.parameterManager      = contains(ParameterManager::handledMessageIds);
+    route.imageProtocolManager  = contains(ImageProtocolManager::handledMessageIds);
+    route.remoteIDManager       = contains(RemoteIDManager::handledMessageIds);
+
+    return *_messageRoutes.insert(msgid, route);
+}
+
 void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t message)
 {
     // If the link is already running at Mavlink V2 set our max proto version to it.
@@ -508,22 +543,36 @@ void Vehicle::_mavlinkMessageReceived(LinkInterface* link, mavlink_message_t mes
     if (!_terrainProtocolHandler->mavlinkMessageReceived(message)) {
         return;
     }
-    _ftpManager->_mavlinkMessageReceived(message);
-    _parameterManager->mavlinkMessageReceived(message);
-    (void) QMetaObject::invokeMethod(_imageProtocolManager, "mavlinkMessageReceived", Qt::AutoConnection, message);
-    _remoteIDManager->mavlinkMessageReceived(message);
+
+    // Copied, handlers may add fact groups which resets the routes
+    const MessageRoute route = _messageRoute(message.msgid);
+    if (route.ftpManager) {
+        _ftpManager->_mavlinkMessageReceived(message);
+    }
+    if (route.parameterManager) {
+        _parameterManager->mavlinkMessageReceived(message);
+    }
+    if (route.imageProtocolManager) {
+        (void) QMetaObject::invokeMethod(_imageProtocolManager, "mavlinkMessageReceived", Qt::AutoConnection, message);
+    }
+    if (route.remoteIDManager) {
+        _remoteIDManager->mavlinkMessageReceived(message);
+    }
 
     _waitForMavlinkMessageMessageReceivedHandler(message);
 
-    // Battery fact groups are created dynamically as new batteries are discovered
+    // Battery fact groups are created dynamically as new batteries are discovered, which resets the routes
     VehicleBatteryFactGroup::handleMessageForFactGroupCreation(this, message);
 
-    // Let the fact groups take a whack at the mavlink traffic
-    for (FactGroup* factGroup : factGroups()) {
+    // Let the fact groups which consume this message take a whack at it
+    const QList<FactGroup*> routeFactGroups = _messageRoute(message.msgid).factGroups;
+    for (FactGroup* factGroup : routeFactGroups) {
         factGroup->handleMessage(this, message);
     }
 
-    this->handleMessage(this, message);
+    if (route.vehicleFactGroup) {
+        this->handleMessage(this, message);
+    }
 
     switch (message.msgid) {
     case MAVLINK_MSG_ID_HOME_POSITION:
@@ -106,6 +106,7 @@ class Vehicle : public VehicleFactGroup
     friend class SendMavCommandWithHandlerTest;     // Unit test
     friend class RequestMessageTest;                // Unit test
     friend class GimbalController;                  // Allow GimbalController to call _addFactGroup
+    friend class MultiVehicleManager;               // Routes incoming messages to _mavlinkMessageReceived
 
 public:
     Vehicle(LinkInterface*          link,
@@ -1158,6 +1159,21 @@ private slots:
 
     void _waitForMavlinkMessageMessageReceivedHandler(const mavlink_message_t& message);
 
+    /// Consumers of a single message id
+    struct MessageRoute {
+        QList<FactGroup*>   factGroups;
+        bool                vehicleFactGroup        = false;
+        bool                ftpManager              = false;
+        bool                parameterManager        = false;
+        bool                imageProtocolManager    = false;
+        bool                remoteIDManager         = false;
+    };
+
+    /// @return Consumers of the message id, built the first time the id is seen
+    const MessageRoute& _messageRoute(uint32_t msgid);
+
+    QHash<uint32_t, MessageRoute> _messageRoutes;   ///< Cleared whenever the set of fact groups changes
+
     // requestMessage handling
 
     typedef struct RequestMessageInfo {
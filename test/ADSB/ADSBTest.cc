@@ -1,9 +1,12 @@
 #include "ADSBTest.h"
 #include "ADSBVehicleManager.h"
 #include "ADSBVehicle.h"
+#include "ADSBSbsParser.h"
 #include "ADSBTCPLink.h"
 #include "QmlObjectListModel.h"
 
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QTemporaryFile>
 #include <QtNetwork/QTcpServer>
 #include <QtTest/QTest>
 #include <QtTest/QSignalSpy>
@@ -20,7 +23,6 @@ void ADSBTest::_adsbVehicleTest()
 
     ADSBVehicle* const adsbVehicle = new ADSBVehicle(vehicleInfo, this);
     QVERIFY(adsbVehicle != nullptr);
-    QVERIFY(!adsbVehicle->expired());
 
     QCOMPARE(adsbVehicle->icaoAddress(), vehicleInfo.icaoAddress);
     QCOMPARE(adsbVehicle->callsign(), vehicleInfo.callsign);
@@ -51,7 +53,7 @@ void ADSBTest::_adsbTcpLinkTest()
     ADSBTCPLink* const adsbLink = new ADSBTCPLink(QHostAddress::LocalHost, 30003, this);
     QVERIFY(adsbLink);
     QVERIFY(adsbLink->init());
-    // QSignalSpy spy(adsbLink, &ADSBTCPLink::adsbVehicleUpdate);
+    QSignalSpy spy(adsbLink, &ADSBTCPLink::adsbVehiclesUpdated);
 
     bool timeout = false;
     QVERIFY(server->waitForNewConnection(1000, &timeout));
@@ -59,12 +61,16 @@ void ADSBTest::_adsbTcpLinkTest()
     QTcpSocket* const clientSocket = server->nextPendingConnection();
     QVERIFY(clientSocket != nullptr);
 
-    const QByteArray message("MSG,8D4840D6202CC371C32CE0576098");
+    const QByteArray message("MSG,3,1,1,4840D6,1,2024/01/01,00:00:00.000,2024/01/01,00:00:00.000,,35000,,,47.5,8.5,,,0,0,0,0\r\n");
     for (uint8_t i = 0; i < 50; i++) {
         (void) clientSocket->write(message);
     }
+    (void) clientSocket->flush();
 
-    // QVERIFY(spy.wait(5000));
+    QVERIFY(spy.wait(5000));
+    const QList<ADSB::VehicleInfo_t> vehicleInfos = spy.first().first().value<QList<ADSB::VehicleInfo_t>>();
+    QCOMPARE(vehicleInfos.count(), qsizetype(1));
+    QCOMPARE(vehicleInfos.first().icaoAddress, 0x4840D6u);
 
     server->close();
 }
@@ -87,3 +93,131 @@ void ADSBTest::_adsbVehicleManagerTest()
     manager->adsbVehicleUpdate(vehicleInfo);
     QCOMPARE(manager->adsbVehicles()->count(), 1);
 }
+
+void ADSBTest::_sbsParserTest()
+{
+    ADSB::TrackUpdate update;
+
+    QVERIFY(ADSBSbsParser::parseLine("MSG,1,1,1,4840D6,1,2024/01/01,00:00:00.000,2024/01/01,00:00:00.000,KLM1023 ,,,,,,,,,,,0", update));
+    QCOMPARE(update.icaoAddress, 0x4840D6u);
+    QCOMPARE(update.availableFlags, ADSB::AvailableInfoTypes(ADSB::CallsignAvailable));
+    QCOMPARE(QByteArray(update.callsign), QByteArray("KLM1023"));
+
+    QVERIFY(ADSBSbsParser::parseLine("MSG,3,1,1,4840D6,1,2024/01/01,00:00:00.000,2024/01/01,00:00:00.000,,1000H,,,47.5,8.25,,,0,1,0,0", update));
+    QCOMPARE(update.availableFlags, ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::AlertAvailable);
+    QCOMPARE(update.latitude, 47.5);
+    QCOMPARE(update.longitude, 8.25);
+    QCOMPARE(update.altitude, 1000 * 0.3048);
+    QVERIFY(update.alert);
+
+    QVERIFY(ADSBSbsParser::parseLine("MSG,4,1,1,4840D6,1,2024/01/01,00:00:00.000,2024/01/01,00:00:00.000,,,100,90,,,-640,,,,,0", update));
+    QCOMPARE(update.availableFlags, ADSB::HeadingAvailable | ADSB::VelocityAvailable | ADSB::VerticalVelAvailable);
+    QCOMPARE(update.heading, 90.);
+    QCOMPARE(update.velocity, 100 * 0.514444);
+    QCOMPARE(update.verticalVel, -640 * 0.00508);
+
+    // Surface position, unknown types, bad ICAO, missing position and truncated lines are rejected
+    QVERIFY(!ADSBSbsParser::parseLine("MSG,2,1,1,4840D6,1,2024/01/01,00:00:00.000,2024/01/01,00:00:00.000,,0,10,90,47.5,8.5,,,0,0,0,0", update));
+    QVERIFY(!ADSBSbsParser::parseLine("MSG,8,1,1,4840D6,1,2024/01/01,00:00:00.000,2024/01/01,00:00:00.000,,,,,,,,,,,,0", update));
+    QVERIFY(!ADSBSbsParser::parseLine("MSG,3,1,1,XYZ,1,2024/01/01,00:00:00.000,2024/01/01,00:00:00.000,,1000,,,47.5,8.5,,,0,0,0,0", update));
+    QVERIFY(!ADSBSbsParser::parseLine("MSG,3,1,1,4840D6,1,2024/01/01,00:00:00.000,2024/01/01,00:00:00.000,,1000,,,0,0,,,0,0,0,0", update));
+    QVERIFY(!ADSBSbsParser::parseLine("MSG,3,1,1,4840D6,1,2024/01/01", update));
+    QVERIFY(!ADSBSbsParser::parseLine("SEL,,496,2286,4CA4E5,27215,2010/02/19,18:06:07.710,2010/02/19,18:06:07.710,RYR1427", update));
+    QVERIFY(!ADSBSbsParser::parseLine("MSG", update));
+
+    // Only complete lines are consumed
+    ADSBUpdateQueue queue;
+    const QByteArray data("MSG,1,1,1,4840D6,1,,,,,KLM1023,,,,,,,,,,,0\r\nMSG,4,1,1,4840D6,1,,,,,,,100,90,,,,,,,,0\nMSG,3,1");
+    QCOMPARE(ADSBSbsParser::parseLines(data, queue), data.lastIndexOf('\n') + 1);
+    QCOMPARE(queue.count(), qsizetype(1));
+}
+
+void ADSBTest::_updateQueueTest()
+{
+    ADSBUpdateQueue queue(2);
+
+    ADSB::TrackUpdate position;
+    position.icaoAddress = 1;
+    position.latitude = 1.;
+    position.longitude = 2.;
+    position.altitude = 3.;
+    position.availableFlags = ADSB::LocationAvailable | ADSB::AltitudeAvailable;
+    QVERIFY(queue.push(position));
+
+    ADSB::TrackUpdate callsign;
+    callsign.icaoAddress = 1;
+    (void) qstrcpy(callsign.callsign, "ABC");
+    callsign.availableFlags = ADSB::CallsignAvailable;
+    QVERIFY(queue.push(callsign));
+
+    // Newer position replaces the older one for the same aircraft
+    position.latitude = 10.;
+    QVERIFY(queue.push(position));
+    QCOMPARE(queue.count(), qsizetype(1));
+
+    ADSB::TrackUpdate other;
+    other.icaoAddress = 2;
+    other.availableFlags = ADSB::HeadingAvailable;
+    QVERIFY(queue.push(other));
+
+    // Full, new aircraft are dropped but known ones are still merged
+    other.icaoAddress = 3;
+    QVERIFY(!queue.push(other));
+    QVERIFY(queue.push(callsign));
+    QCOMPARE(queue.droppedCount(), quint64(1));
+    QCOMPARE(queue.pushedCount(), quint64(5));
+
+    QList<ADSB::VehicleInfo_t> vehicleInfos;
+    queue.takeAll(vehicleInfos);
+    QVERIFY(queue.isEmpty());
+    QCOMPARE(vehicleInfos.count(), qsizetype(2));
+    QCOMPARE(vehicleInfos[0].icaoAddress, 1u);
+    QCOMPARE(vehicleInfos[0].availableFlags, ADSB::LocationAvailable | ADSB::AltitudeAvailable | ADSB::CallsignAvailable);
+    QCOMPARE(vehicleInfos[0].location, QGeoCoordinate(10., 2., 3.));
+    QCOMPARE(vehicleInfos[0].callsign, QStringLiteral("ABC"));
+    QCOMPARE(vehicleInfos[1].icaoAddress, 2u);
+}
+
+void ADSBTest::_sbsReplayBenchmark()
+{
+    // Synthetic capture of a busy receiver: 500 aircraft reporting position, velocity and identification
+    QTemporaryFile captureFile;
+    QVERIFY(captureFile.open());
+
+    QRandomGenerator random(12345);
+    constexpr int kAircraft = 500;
+    constexpr int kLines = 100000;
+    for (int i = 0; i < kLines; i++) {
+        const uint32_t icao = 0x400000 + static_cast<uint32_t>(random.bounded(kAircraft));
+        const QByteArray icaoStr = QByteArray::number(icao, 16).toUpper();
+        QByteArray line;
+        switch (i % 4) {
+        case 0:
+        case 1:
+            line = "MSG,3,1,1," + icaoStr + ",1,2024/01/01,00:00:00.000,2024/01/01,00:00:00.000,," + QByteArray::number(random.bounded(40000))
+                + ",,," + QByteArray::number(45. + random.generateDouble(), 'f', 5) + "," + QByteArray::number(7. + random.generateDouble(), 'f', 5) + ",,,0,0,0,0\r\n";
+            break;
+        case 2:
+            line = "MSG,4,1,1," + icaoStr + ",1,2024/01/01,00:00:00.000,2024/01/01,00:00:00.000,,," + QByteArray::number(random.bounded(500))
+                + "," + QByteArray::number(random.bounded(360)) + ",,,-64,,,,,0\r\n";
+            break;
+        default:
+            line = "MSG,1,1,1," + icaoStr + ",1,2024/01/01,00:00:00.000,2024/01/01,00:00:00.000,TEST" + QByteArray::number(icao % 1000) + ",,,,,,,,,,,0\r\n";
+            break;
+        }
+        QCOMPARE(captureFile.write(line), qint64(line.size()));
+    }
+    QVERIFY(captureFile.flush());
+    QVERIFY(captureFile.seek(0));
+    const QByteArray capture = captureFile.readAll();
+
+    ADSBUpdateQueue queue;
+    QList<ADSB::VehicleInfo_t> vehicleInfos;
+    QBENCHMARK {
+        QCOMPARE(ADSBSbsParser::parseLines(capture, queue), capture.size());
+        queue.takeAll(vehicleInfos);
+    }
+
+    QCOMPARE(vehicleInfos.count(), qsizetype(kAircraft));
+    QCOMPARE(queue.droppedCount(), quint64(0));
+}
@@ -10,4 +10,7 @@ private slots:
     void _adsbVehicleTest();
     void _adsbTcpLinkTest();
     void _adsbVehicleManagerTest();
+    void _sbsParserTest();
+    void _updateQueueTest();
+    void _sbsReplayBenchmark();
 };
@@ -0,0 +1,228 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ADSBTrafficIndexTest.h"
+#include "ADSBTrafficIndex.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QTest>
+
+#include <algorithm>
+
+namespace
+{
+
+ADSB::Track _track(uint32_t icaoAddress, const QGeoCoordinate &coordinate, double heading = 0., double velocity = 0.)
+{
+    ADSB::Track track;
+    track.icaoAddress = icaoAddress;
+    track.latitude = coordinate.latitude();
+    track.longitude = coordinate.longitude();
+    track.altitude = coordinate.altitude();
+    track.heading = heading;
+    track.velocity = velocity;
+    return track;
+}
+
+/// Far away traffic in many cells, so small radius queries visit cells instead of scanning everything
+void _addFiller(ADSBTrafficIndex &index)
+{
+    for (int i = 0; i < 30; i++) {
+        index.update(_track(static_cast<uint32_t>(1000 + i), QGeoCoordinate(-80. + (i * 3.), 100.)), 0);
+    }
+}
+
+} // namespace
+
+void ADSBTrafficIndexTest::_queryTest()
+{
+    ADSBTrafficIndex index;
+    const QGeoCoordinate center(47.3977, 8.5456, 500.);
+    _addFiller(index);
+
+    index.update(_track(1, center.atDistanceAndAzimuth(1000., 0., 0.)), 0);
+    index.update(_track(2, center.atDistanceAndAzimuth(5000., 90., 0.)), 0);
+    index.update(_track(3, center.atDistanceAndAzimuth(30000., 180., 0.)), 0);
+    index.update(_track(4, center.atDistanceAndAzimuth(2000., 270., 2000.)), 0);
+    QCOMPARE(index.count(), qsizetype(34));
+
+    QList<uint32_t> result;
+    index.query(center, 6000., qQNaN(), result);
+    std::sort(result.begin(), result.end());
+    QCOMPARE(result, QList<uint32_t>({ 1, 2, 4 }));
+
+    // 4 is 1500 m above
+    index.query(center, 6000., 300., result);
+    std::sort(result.begin(), result.end());
+    QCOMPARE(result, QList<uint32_t>({ 1, 2 }));
+
+    // Moving across cells keeps a single entry
+    index.update(_track(3, center.atDistanceAndAzimuth(500., 180., 0.)), 1);
+    index.update(_track(2, center.atDistanceAndAzimuth(50000., 90., 0.)), 1);
+    QCOMPARE(index.count(), qsizetype(34));
+    index.query(center, 6000., qQNaN(), result);
+    std::sort(result.begin(), result.end());
+    QCOMPARE(result, QList<uint32_t>({ 1, 3, 4 }));
+
+    // Large radius takes the scan path
+    index.query(center, 100000., qQNaN(), result);
+    QCOMPARE(result.count(), qsizetype(4));
+
+    QVERIFY(index.remove(1));
+    QVERIFY(!index.remove(1));
+    index.query(center, 6000., qQNaN(), result);
+    std::sort(result.begin(), result.end());
+    QCOMPARE(result, QList<uint32_t>({ 3, 4 }));
+
+    // Across the antimeridian
+    index.clear();
+    QCOMPARE(index.count(), qsizetype(0));
+    _addFiller(index);
+    index.update(_track(5, QGeoCoordinate(0., 179.99)), 0);
+    index.update(_track(6, QGeoCoordinate(10., 10.)), 0);
+    index.update(_track(7, QGeoCoordinate(-10., 10.)), 0);
+    index.query(QGeoCoordinate(0., -179.99), 5000., qQNaN(), result);
+    QCOMPARE(result, QList<uint32_t>({ 5 }));
+}
+
+void ADSBTrafficIndexTest::_expiryTest()
+{
+    ADSBTrafficIndex index(1000);
+    const QGeoCoordinate coordinate(47., 8.);
+
+    index.update(_track(1, coordinate), 0);
+    index.update(_track(2, coordinate), 0);
+    index.update(_track(3, coordinate), 500);
+
+    QVERIFY(index.takeExpired(1000).isEmpty());
+
+    // 2 keeps reporting
+    index.update(_track(2, coordinate), 900);
+    QCOMPARE(index.takeExpired(1001), QList<uint32_t>({ 1 }));
+    QVERIFY(!index.contains(1));
+    QCOMPARE(index.count(), qsizetype(2));
+
+    QCOMPARE(index.takeExpired(1501), QList<uint32_t>({ 3 }));
+    QVERIFY(index.takeExpired(1900).isEmpty());
+    QCOMPARE(index.takeExpired(1901), QList<uint32_t>({ 2 }));
+    QCOMPARE(index.count(), qsizetype(0));
+    QCOMPARE(index.cellCount(), qsizetype(0));
+
+    // A removed and re-added aircraft expires from its new update on
+    index.update(_track(4, coordinate), 2000);
+    QVERIFY(index.remove(4));
+    index.update(_track(4, coordinate), 2500);
+    QVERIFY(index.takeExpired(3001).isEmpty());
+    QCOMPARE(index.takeExpired(3501), QList<uint32_t>({ 4 }));
+}
+
+void ADSBTrafficIndexTest::_closestPointOfApproachTest()
+{
+    const QGeoCoordinate ownCoordinate(47., 8., 100.);
+
+    // Head on, 2 km apart closing at 100 m/s
+    const ADSB::Track own = _track(0, ownCoordinate, 0., 50.);
+    const ADSB::Track headOn = _track(1, ownCoordinate.atDistanceAndAzimuth(2000., 0., 0.), 180., 50.);
+    ADSB::TrafficConflict conflict = ADSBTrafficIndex::closestPointOfApproach(own, headOn, 60.);
+    QVERIFY(qAbs(conflict.timeToCpa - 20.) < 0.1);
+    QVERIFY(qAbs(conflict.horizontalDistance - 2000.) < 5.);
+    QVERIFY(conflict.horizontalDistanceAtCpa < 5.);
+    QVERIFY(qAbs(conflict.verticalDistanceAtCpa) < 0.1);
+
+    // Crossing 1 km to the east of our path, passes 1 km away
+    const ADSB::Track crossing = _track(2, ownCoordinate.atDistanceAndAzimuth(1000., 90., 300.), 0., 50.);
+    conflict = ADSBTrafficIndex::closestPointOfApproach(own, crossing, 60.);
+    QVERIFY(qAbs(conflict.horizontalDistanceAtCpa - 1000.) < 5.);
+    QVERIFY(qAbs(conflict.verticalDistanceAtCpa - 300.) < 0.1);
+
+    // Diverging traffic has its closest point now
+    const ADSB::Track diverging = _track(3, ownCoordinate.atDistanceAndAzimuth(2000., 180., 0.), 180., 50.);
+    conflict = ADSBTrafficIndex::closestPointOfApproach(own, diverging, 60.);
+    QCOMPARE(conflict.timeToCpa, 0.);
+    QVERIFY(qAbs(conflict.horizontalDistanceAtCpa - 2000.) < 5.);
+
+    // Closest point beyond the time limit
+    conflict = ADSBTrafficIndex::closestPointOfApproach(own, headOn, 10.);
+    QCOMPARE(conflict.timeToCpa, 10.);
+    QVERIFY(qAbs(conflict.horizontalDistanceAtCpa - 1000.) < 5.);
+
+    // Unknown altitude
+    ADSB::Track noAltitude = headOn;
+    noAltitude.altitude = qQNaN();
+    conflict = ADSBTrafficIndex::closestPointOfApproach(own, noAltitude, 60.);
+    QVERIFY(qIsNaN(conflict.verticalDistanceAtCpa));
+}
+
+void ADSBTrafficIndexTest::_conflictsTest()
+{
+    ADSBTrafficIndex index;
+    const QGeoCoordinate ownCoordinate(47., 8., 100.);
+    const ADSB::Track own = _track(0, ownCoordinate, 0., 20.);
+
+    // Head on at 40 s
+    index.update(_track(1, ownCoordinate.atDistanceAndAzimuth(4000., 0., 0.), 180., 80.), 0);
+    // Head on at 10 s
+    index.update(_track(2, ownCoordinate.atDistanceAndAzimuth(1000., 0., 0.), 180., 80.), 0);
+    // Same path but well above
+    index.update(_track(3, ownCoordinate.atDistanceAndAzimuth(1000., 0., 1000.), 180., 80.), 0);
+    // Head on, but only after the lookahead
+    index.update(_track(4, ownCoordinate.atDistanceAndAzimuth(20000., 0., 0.), 180., 80.), 0);
+    // Passing far to the side
+    index.update(_track(5, ownCoordinate.atDistanceAndAzimuth(3000., 90., 0.), 0., 20.), 0);
+    // Far away
+    index.update(_track(6, QGeoCoordinate(48., 9., 100.), 0., 0.), 0);
+
+    QList<ADSB::TrafficConflict> conflicts;
+    index.conflicts(own, ADSB::ConflictThresholds(), conflicts);
+    QCOMPARE(conflicts.count(), qsizetype(2));
+    QCOMPARE(conflicts[0].icaoAddress, 2u);
+    QCOMPARE(conflicts[1].icaoAddress, 1u);
+    QVERIFY(conflicts[0].timeToCpa < conflicts[1].timeToCpa);
+}
+
+void ADSBTrafficIndexTest::_benchmarkTraffic()
+{
+    // Busy airspace: 2500 aircraft within about 200 km, checked against 10 of our vehicles
+    constexpr int kAircraft = 2500;
+    constexpr int kVehicles = 10;
+    const QGeoCoordinate center(47.4, 8.5, 500.);
+
+    QRandomGenerator random(4242);
+    QList<ADSB::Track> tracks;
+    for (int i = 0; i < kAircraft; i++) {
+        const QGeoCoordinate coordinate = center.atDistanceAndAzimuth(random.bounded(200000.), random.bounded(360.), random.bounded(12000.));
+        tracks.append(_track(static_cast<uint32_t>(i + 1), coordinate, random.bounded(360.), random.bounded(250.)));
+    }
+
+    QList<ADSB::Track> vehicles;
+    for (int i = 0; i < kVehicles; i++) {
+        const QGeoCoordinate coordinate = center.atDistanceAndAzimuth(random.bounded(5000.), random.bounded(360.), 100.);
+        vehicles.append(_track(0, coordinate, random.bounded(360.), 15.));
+    }
+
+    ADSBTrafficIndex index;
+    QList<ADSB::TrafficConflict> conflicts;
+    qint64 nowMs = 0;
+    QBENCHMARK {
+        // One second of traffic: every aircraft moves, then the once a second expiry and conflict checks
+        nowMs += 1000;
+        for (ADSB::Track &track : tracks) {
+            const QGeoCoordinate coordinate = QGeoCoordinate(track.latitude, track.longitude).atDistanceAndAzimuth(track.velocity, track.heading);
+            track.latitude = coordinate.latitude();
+            track.longitude = coordinate.longitude();
+            index.update(track, nowMs);
+        }
+        (void) index.takeExpired(nowMs);
+        for (const ADSB::Track &vehicle : std::as_const(vehicles)) {
+            index.conflicts(vehicle, ADSB::ConflictThresholds(), conflicts);
+        }
+    }
+
+    QCOMPARE(index.count(), qsizetype(kAircraft));
+}
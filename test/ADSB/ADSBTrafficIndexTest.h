@@ -0,0 +1,15 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class ADSBTrafficIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _queryTest();
+    void _expiryTest();
+    void _closestPointOfApproachTest();
+    void _conflictsTest();
+    void _benchmarkTraffic();
+};
@@ -2,8 +2,35 @@
 #include "ExifParser.h"
 #include "GeoTagWorker.h"
 
+#include <QtCore/QBuffer>
+#include <QtCore/QDir>
+#include <QtCore/QTemporaryDir>
 #include <QtTest/QTest>
 
+QStringList ExifParserTest::_createImageSet(const QString &dir)
+{
+    QFile file(":/unittest/DSCN0010.jpg");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QStringList();
+    }
+
+    // Data behind the end of the image stands in for the large scan data of a real image
+    QByteArray image = file.readAll();
+    image.append(kImageSetPadding, '\0');
+
+    QStringList paths;
+    for (int i = 0; i < kImageSetCount; i++) {
+        const QString path = QStringLiteral("%1/IMG_%2.jpg").arg(dir).arg(i, 4, 10, QLatin1Char('0'));
+        QFile imageFile(path);
+        if (!imageFile.open(QIODevice::WriteOnly) || (imageFile.write(image) != image.size())) {
+            return QStringList();
+        }
+        paths.append(path);
+    }
+
+    return paths;
+}
+
 void ExifParserTest::_readTimeTest()
 {
     QFile file(":/unittest/DSCN0010.jpg");
@@ -23,6 +50,26 @@ void ExifParserTest::_readTimeTest()
     QCOMPARE(imageTime, expectedTime);
 }
 
+void ExifParserTest::_readHeaderTest()
+{
+    QFile file(":/unittest/DSCN0010.jpg");
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    const QByteArray header = ExifParser::readHeader(file);
+    QVERIFY(!header.isEmpty());
+    QVERIFY(header.size() < file.size());
+    QVERIFY(file.pos() < file.size());
+
+    QVERIFY(file.seek(0));
+    QCOMPARE(ExifParser::readTime(file), ExifParser::readTime(file.readAll()));
+
+    QBuffer notAnImage;
+    notAnImage.setData("not a jpeg");
+    QVERIFY(notAnImage.open(QIODevice::ReadOnly));
+    QVERIFY(ExifParser::readHeader(notAnImage).isEmpty());
+    QVERIFY(!ExifParser::readTime(notAnImage).isValid());
+}
+
 void ExifParserTest::_writeTest()
 {
     QFile file(":/unittest/DSCN0010.jpg");
@@ -44,3 +91,56 @@ void ExifParserTest::_writeTest()
     // QVERIFY(outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
     // QCOMPARE(outputFile.write(imageBuffer), imageBuffer.size());
 }
+
+void ExifParserTest::_benchmarkReadTimeHeader()
+{
+    const QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QStringList paths = _createImageSet(dir.path());
+    QCOMPARE(paths.size(), kImageSetCount);
+
+    QBENCHMARK {
+        for (const QString &path : paths) {
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::ReadOnly));
+            QVERIFY(ExifParser::readTime(file).isValid());
+        }
+    }
+}
+
+void ExifParserTest::_benchmarkReadTimeFullFile()
+{
+    const QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QStringList paths = _createImageSet(dir.path());
+    QCOMPARE(paths.size(), kImageSetCount);
+
+    QBENCHMARK {
+        for (const QString &path : paths) {
+            QFile file(path);
+            QVERIFY(file.open(QIODevice::ReadOnly));
+            QVERIFY(ExifParser::readTime(file.readAll()).isValid());
+        }
+    }
+}
+
+void ExifParserTest::_benchmarkGeoTagPipeline()
+{
+    const QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QCOMPARE(_createImageSet(dir.path()).size(), kImageSetCount);
+    const QString saveDirectory = dir.filePath(QStringLiteral("TAGGED"));
+    QVERIFY(QDir().mkpath(saveDirectory));
+
+    GeoTagWorker worker;
+    worker.setLogFile(QStringLiteral(":/unittest/SampleULog.ulg"));
+    worker.setImageDirectory(dir.path() + QStringLiteral("/"));
+    worker.setSaveDirectory(saveDirectory);
+
+    // Time stamps are read from every image in parallel, then the matched images are tagged in parallel
+    QBENCHMARK {
+        QVERIFY(worker.process());
+    }
+
+    QVERIFY(!QDir(saveDirectory).entryList(QDir::Files).isEmpty());
+}
@@ -10,6 +10,18 @@ class ExifParserTest : public UnitTest
     ExifParserTest() = default;
 
 private slots:
-	void _readTimeTest();
-	void _writeTest();
+    void _readTimeTest();
+    void _readHeaderTest();
+    void _writeTest();
+    void _benchmarkReadTimeHeader();
+    void _benchmarkReadTimeFullFile();
+    void _benchmarkGeoTagPipeline();
+
+private:
+    /// Fills dir with copies of the sample image padded to the size of a mapping camera image
+    ///     @return Paths of the images
+    static QStringList _createImageSet(const QString &dir);
+
+    static constexpr int kImageSetCount = 32;
+    static constexpr qsizetype kImageSetPadding = 4 * 1024 * 1024;
 };
@@ -9,6 +9,7 @@
 
 #include "LogDownloadTest.h"
 #include "LogDownloadController.h"
+#include "LogDownloadWriter.h"
 #include "LogEntry.h"
 #include "MockLink.h"
 #include "MultiSignalSpyV2.h"
@@ -18,6 +19,8 @@
 #include "MAVLinkProtocol.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QSignalSpy>
 #include <QtTest/QTest>
 
 void LogDownloadTest::_downloadTest()
@@ -59,3 +62,98 @@ void LogDownloadTest::_downloadTest()
 
     (void) QFile::remove(downloadFile);
 }
+
+void LogDownloadTest::_windowTest()
+{
+    constexpr uint32_t window = LogDownloadData::kWindowBins;
+    constexpr uint32_t slide = LogDownloadData::kSlideBins;
+
+    QGCLogEntry entry(0, QDateTime(), (40 * LogDownloadData::kChunkSize) - 10);
+    LogDownloadData data(&entry);
+    const uint32_t numBins = data.numBins();
+    QCOMPARE(numBins, 40 * LogDownloadData::kTableBins);
+    data.bin_table = QBitArray(numBins, false);
+
+    // Stream the first window, losing bin 10
+    uint32_t start = 0, end = 0;
+    QVERIFY(!data.nextRequest(start, end));
+    QCOMPARE(start, 0u);
+    QCOMPARE(end, window);
+    data.request_start = start;
+    data.request_end = end;
+
+    for (uint32_t bin = 0; bin < (window - slide); bin++) {
+        if (bin != 10) {
+            QVERIFY(data.setReceived(bin));
+        }
+    }
+    QCOMPARE(data.first_missing, 10u);
+    QVERIFY(!data.setReceived(0));
+
+    // The gap holds the window back so the stream can't slide
+    QVERIFY(!data.shouldSlide(window - slide - 1));
+    for (uint32_t bin = window - slide; bin < window; bin++) {
+        QVERIFY(data.setReceived(bin));
+    }
+
+    QVERIFY(data.nextRequest(start, end));
+    QCOMPARE(start, 10u);
+    QCOMPARE(end, 11u);
+
+    QVERIFY(data.setReceived(10));
+    QCOMPARE(data.first_missing, window);
+
+    // Next window arrives out of order and is reassembled
+    QVERIFY(!data.nextRequest(start, end));
+    QCOMPARE(start, window);
+    QCOMPARE(end, 2 * window);
+    data.request_start = start;
+    data.request_end = end;
+
+    for (uint32_t bin = (2 * window) - 1; bin >= window; bin--) {
+        QVERIFY(data.setReceived(bin));
+    }
+    QCOMPARE(data.first_missing, 2 * window);
+
+    // With no gaps the stream slides before it drains
+    data.request_start = 2 * window;
+    data.request_end = 3 * window;
+    for (uint32_t bin = 2 * window; bin < ((3 * window) - slide - 1); bin++) {
+        QVERIFY(data.setReceived(bin));
+        QVERIFY(!data.shouldSlide(bin));
+    }
+    QVERIFY(data.setReceived((3 * window) - slide - 1));
+    QVERIFY(data.shouldSlide((3 * window) - slide - 1));
+
+    for (uint32_t bin = 0; bin < numBins; bin++) {
+        (void) data.setReceived(bin);
+    }
+    QVERIFY(data.complete());
+}
+
+void LogDownloadTest::_writerTest()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString fileName = tempDir.filePath(QStringLiteral("log.bin"));
+
+    LogDownloadWriter writer;
+    QSignalSpy spyFailed(&writer, &LogDownloadWriter::writeFailed);
+
+    writer.open(fileName, 10);
+    writer.write(5, QByteArrayLiteral("fghij"));
+    writer.write(0, QByteArrayLiteral("abcde"));
+    writer.close();
+    writer.waitForIdle();
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), QByteArrayLiteral("abcdefghij"));
+    file.close();
+
+    writer.open(fileName, 10);
+    writer.discard();
+    writer.waitForIdle();
+    QVERIFY(!QFile::exists(fileName));
+    QCOMPARE(spyFailed.count(), 0);
+}
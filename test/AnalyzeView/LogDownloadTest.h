@@ -8,4 +8,6 @@ class LogDownloadTest : public UnitTest
 
 private slots:
     void _downloadTest();
+    void _windowTest();
+    void _writerTest();
 };
@@ -0,0 +1,112 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkChartBufferTest.h"
+#include "MAVLinkChartBuffer.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QtNumeric>
+#include <QtTest/QTest>
+
+#include <cmath>
+
+void MAVLinkChartBufferTest::_ringTest()
+{
+    MAVLinkChartBuffer buffer(4);
+    QVERIFY(buffer.isEmpty());
+    QVERIFY(!buffer.hasRange());
+
+    for (int i = 0; i < 6; i++) {
+        buffer.append(i, i * 10);
+    }
+
+    QCOMPARE(buffer.count(), qsizetype(4));
+    QCOMPARE(buffer.x(0), 2.);
+    QCOMPARE(buffer.y(3), 50.);
+    QCOMPARE(buffer.lowerBound(3.5), qsizetype(2));
+    QCOMPARE(buffer.lowerBound(100), qsizetype(4));
+
+    buffer.clear();
+    QVERIFY(buffer.isEmpty());
+    QVERIFY(!buffer.hasRange());
+}
+
+void MAVLinkChartBufferTest::_minMaxTest()
+{
+    constexpr qsizetype capacity = 64;
+    MAVLinkChartBuffer buffer(capacity);
+    QRandomGenerator random(1);
+
+    for (int i = 0; i < 2000; i++) {
+        const qreal v = ((i % 97) == 1) ? qQNaN() : (random.bounded(2000) - 1000) / 10.;
+        buffer.append(i, v);
+
+        qreal vmin = std::numeric_limits<qreal>::max();
+        qreal vmax = std::numeric_limits<qreal>::lowest();
+        for (qsizetype j = 0; j < buffer.count(); j++) {
+            if (!qIsNaN(buffer.y(j))) {
+                vmin = qMin(vmin, buffer.y(j));
+                vmax = qMax(vmax, buffer.y(j));
+            }
+        }
+
+        QVERIFY(buffer.hasRange());
+        QCOMPARE(buffer.min(), vmin);
+        QCOMPARE(buffer.max(), vmax);
+    }
+}
+
+void MAVLinkChartBufferTest::_decimateTest()
+{
+    MAVLinkChartBuffer buffer(10000);
+    for (int i = 0; i < 10000; i++) {
+        buffer.append(i, std::sin(i / 50.) + ((i == 5000) ? 10. : 0.));
+    }
+
+    QList<QPointF> points;
+    buffer.decimate(2000, 8000, 100, points);
+    QVERIFY(points.count() <= 201);
+    QVERIFY(points.count() > 100);
+
+    // Runs in from the edge, stays in time order and keeps the spike
+    QCOMPARE(points.first().x(), 1999.);
+    bool spike = false;
+    for (qsizetype i = 1; i < points.count(); i++) {
+        QVERIFY(points[i].x() > points[i - 1].x());
+        QVERIFY(points[i].x() <= 8000.);
+        spike |= (points[i].y() > 9.);
+    }
+    QVERIFY(spike);
+
+    // Small windows are not decimated
+    buffer.decimate(100, 149, 100, points);
+    QCOMPARE(points.count(), qsizetype(51));
+    QCOMPARE(points.last().x(), 149.);
+
+    buffer.decimate(20000, 30000, 100, points);
+    QCOMPARE(points.count(), qsizetype(1));
+}
+
+void MAVLinkChartBufferTest::_benchmarkAppend()
+{
+    MAVLinkChartBuffer buffer;
+    QList<QPointF> points;
+    qreal x = 0;
+
+    // A minute of a 200Hz field, charted at 15Hz
+    QBENCHMARK {
+        for (int i = 0; i < (200 * 60); i++) {
+            buffer.append(x, std::sin(x / 100.));
+            x += 5.;
+            if ((i % 13) == 0) {
+                buffer.decimate(x - 5000., x, 1000, points);
+            }
+        }
+    }
+}
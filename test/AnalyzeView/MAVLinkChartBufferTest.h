@@ -0,0 +1,14 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkChartBufferTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _ringTest();
+    void _minMaxTest();
+    void _decimateTest();
+    void _benchmarkAppend();
+};
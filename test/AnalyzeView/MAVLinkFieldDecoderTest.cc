@@ -0,0 +1,87 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkFieldDecoderTest.h"
+#include "MAVLinkFieldDecoder.h"
+
+#include <QtTest/QTest>
+
+namespace
+{
+
+qsizetype _fieldIndex(uint32_t msgid, const char *name)
+{
+    const mavlink_message_info_t *const msgInfo = mavlink_get_message_info_by_id(msgid);
+    for (unsigned int i = 0; i < msgInfo->num_fields; ++i) {
+        if (qstrcmp(msgInfo->fields[i].name, name) == 0) {
+            return static_cast<qsizetype>(i);
+        }
+    }
+
+    return -1;
+}
+
+} // namespace
+
+void MAVLinkFieldDecoderTest::_decodeTest()
+{
+    mavlink_message_t message{};
+    (void) mavlink_msg_heartbeat_pack_chan(1, 1, MAVLINK_COMM_0, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, MAV_MODE_FLAG_SAFETY_ARMED, 0x12345678, MAV_STATE_ACTIVE);
+
+    const MAVLinkFieldDecoder *const decoder = MAVLinkFieldDecoder::forMessage(MAVLINK_MSG_ID_HEARTBEAT);
+    QVERIFY(decoder);
+    QCOMPARE(decoder->count(), qsizetype(6));
+
+    std::vector<double> values(static_cast<size_t>(decoder->count()));
+    decoder->decode(message, values.data());
+
+    QCOMPARE(values[static_cast<size_t>(_fieldIndex(MAVLINK_MSG_ID_HEARTBEAT, "type"))], static_cast<double>(MAV_TYPE_QUADROTOR));
+    QCOMPARE(values[static_cast<size_t>(_fieldIndex(MAVLINK_MSG_ID_HEARTBEAT, "autopilot"))], static_cast<double>(MAV_AUTOPILOT_PX4));
+    QCOMPARE(values[static_cast<size_t>(_fieldIndex(MAVLINK_MSG_ID_HEARTBEAT, "custom_mode"))], static_cast<double>(0x12345678));
+    QCOMPARE(values[static_cast<size_t>(_fieldIndex(MAVLINK_MSG_ID_HEARTBEAT, "system_status"))], static_cast<double>(MAV_STATE_ACTIVE));
+
+    (void) mavlink_msg_attitude_pack_chan(1, 1, MAVLINK_COMM_0, &message, 1000, 0.5f, -0.25f, 3.f, 0.f, 0.f, -1.5f);
+    const MAVLinkFieldDecoder *const attitude = MAVLinkFieldDecoder::forMessage(MAVLINK_MSG_ID_ATTITUDE);
+    QVERIFY(attitude);
+    QCOMPARE(attitude->decode(message, _fieldIndex(MAVLINK_MSG_ID_ATTITUDE, "time_boot_ms")), 1000.);
+    QCOMPARE(attitude->decode(message, _fieldIndex(MAVLINK_MSG_ID_ATTITUDE, "pitch")), -0.25);
+    QCOMPARE(attitude->decode(message, _fieldIndex(MAVLINK_MSG_ID_ATTITUDE, "yawspeed")), -1.5);
+
+    // Char arrays can't be charted
+    const MAVLinkFieldDecoder *const statusText = MAVLinkFieldDecoder::forMessage(MAVLINK_MSG_ID_STATUSTEXT);
+    QVERIFY(statusText);
+    QVERIFY(!statusText->field(_fieldIndex(MAVLINK_MSG_ID_STATUSTEXT, "text")).numeric);
+    QVERIFY(statusText->field(_fieldIndex(MAVLINK_MSG_ID_STATUSTEXT, "severity")).numeric);
+}
+
+void MAVLinkFieldDecoderTest::_cacheTest()
+{
+    const MAVLinkFieldDecoder *const decoder = MAVLinkFieldDecoder::forMessage(MAVLINK_MSG_ID_ATTITUDE);
+    QVERIFY(decoder);
+    QCOMPARE(MAVLinkFieldDecoder::forMessage(MAVLINK_MSG_ID_ATTITUDE), decoder);
+    QVERIFY(!MAVLinkFieldDecoder::forMessage(0xFFFFFF));
+}
+
+void MAVLinkFieldDecoderTest::_benchmarkDecode()
+{
+    mavlink_message_t message{};
+    (void) mavlink_msg_highres_imu_pack_chan(1, 1, MAVLINK_COMM_0, &message, 1, 1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f, 13.f, 0xFFFF, 0);
+
+    const MAVLinkFieldDecoder *const decoder = MAVLinkFieldDecoder::forMessage(MAVLINK_MSG_ID_HIGHRES_IMU);
+    QVERIFY(decoder);
+    std::vector<double> values(static_cast<size_t>(decoder->count()));
+
+    // A second of a 200Hz IMU stream on each of ten vehicles
+    QBENCHMARK {
+        for (int i = 0; i < 2000; i++) {
+            decoder->decode(message, values.data());
+        }
+    }
+    QCOMPARE(values[static_cast<size_t>(_fieldIndex(MAVLINK_MSG_ID_HIGHRES_IMU, "zgyro"))], 6.);
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkFieldDecoderTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _decodeTest();
+    void _cacheTest();
+    void _benchmarkDecode();
+};
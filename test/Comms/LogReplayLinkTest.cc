@@ -0,0 +1,82 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "LogReplayLinkTest.h"
+#include "LinkManager.h"
+#include "LogReplayLink.h"
+#include "MAVLinkProtocol.h"
+#include "QGCTemporaryFile.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QtEndian>
+#include <QtTest/QTest>
+
+void LogReplayLinkTest::cleanup()
+{
+    LinkManager::instance()->disconnectAll();
+    QTRY_COMPARE(LinkManager::instance()->links().count(), 0);
+
+    UnitTest::cleanup();
+}
+
+void LogReplayLinkTest::_testUnpacedReplay()
+{
+    // An hour of ATTITUDE at 50Hz would take an hour to replay in log time.
+    // No HEARTBEAT, so no vehicle is created and the link can go away right after.
+    constexpr int messageCount = 180000;
+    constexpr quint64 startUSecs = Q_UINT64_C(1700000000000000);
+    constexpr quint64 intervalUSecs = 20000;
+
+    const QString fileName = QGCTemporaryFile::newTempFileFullyQualifiedName(QStringLiteral("LogReplayLinkTestXXXXXX.tlog"));
+    {
+        QByteArray log;
+        for (int i = 0; i < messageCount; i++) {
+            mavlink_attitude_t attitude{};
+            attitude.time_boot_ms = static_cast<uint32_t>(i * (intervalUSecs / 1000));
+            mavlink_message_t message{};
+            (void) mavlink_msg_attitude_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, &attitude);
+
+            char timestamp[sizeof(quint64)];
+            qToBigEndian(startUSecs + (static_cast<quint64>(i) * intervalUSecs), timestamp);
+            (void) log.append(timestamp, sizeof(timestamp));
+
+            uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+            const uint16_t frameLen = mavlink_msg_to_send_buffer(frame, &message);
+            (void) log.append(reinterpret_cast<const char*>(frame), frameLen);
+        }
+
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        QCOMPARE(file.write(log), log.size());
+    }
+
+    QObject context;
+    LogReplayLink *link = nullptr;
+    int receivedCount = 0;
+    (void) connect(MAVLinkProtocol::instance(), &MAVLinkProtocol::messageReceived, &context, [&link, &receivedCount](LinkInterface *messageLink, const mavlink_message_t &message) {
+        if ((messageLink == link) && (message.msgid == MAVLINK_MSG_ID_ATTITUDE)) {
+            receivedCount++;
+        }
+    });
+
+    link = LinkManager::instance()->startLogReplay(fileName, true /* unpaced */);
+    QVERIFY(link);
+
+    bool atEnd = false;
+    (void) connect(link, &LogReplayLink::playbackAtEnd, &context, [&atEnd]() { atEnd = true; });
+
+    QTRY_VERIFY_WITH_TIMEOUT(atEnd, 30000);
+    QCOMPARE(receivedCount, messageCount);
+
+    link->disconnect();
+    QTRY_COMPARE(LinkManager::instance()->links().count(), 0);
+
+    (void) QFile::remove(fileName);
+    (void) QFile::remove(TlogIndex::indexFilename(fileName));
+}
@@ -0,0 +1,97 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkForwarderTest.h"
+#include "MAVLinkForwarder.h"
+
+#include <QtTest/QTest>
+
+static constexpr qint64 kNsecsPerSec = 1000 * 1000 * 1000;
+
+mavlink_message_t MAVLinkForwarderTest::_message(uint8_t sysid, uint8_t compid, uint32_t msgid)
+{
+    // The filter only looks at the header
+    mavlink_message_t message{};
+    message.sysid = sysid;
+    message.compid = compid;
+    message.msgid = msgid;
+    return message;
+}
+
+void MAVLinkForwarderTest::_testPassThrough()
+{
+    MAVLinkForwardFilter filter;
+    for (int i = 0; i < 100; i++) {
+        QVERIFY(filter.accept(_message(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_ATTITUDE), i));
+    }
+
+    // Settings left empty behave the same
+    MAVLinkForwardFilter emptyFilter(QString(), QString(), 0);
+    QVERIFY(emptyFilter.accept(_message(255, 0, MAVLINK_MSG_ID_HEARTBEAT), 0));
+}
+
+void MAVLinkForwarderTest::_testSysIdFilter()
+{
+    MAVLinkForwardFilter filter(QStringLiteral("1, 3,bogus,300"), QString(), 0);
+
+    QVERIFY(filter.accept(_message(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_HEARTBEAT), 0));
+    QVERIFY(!filter.accept(_message(2, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_HEARTBEAT), 0));
+    QVERIFY(filter.accept(_message(3, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_HEARTBEAT), 0));
+    QVERIFY(!filter.accept(_message(44, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_HEARTBEAT), 0));
+}
+
+void MAVLinkForwarderTest::_testMsgIdFilter()
+{
+    MAVLinkForwardFilter includeFilter(QString(), QStringLiteral("0,30"), 0);
+    QVERIFY(includeFilter.accept(_message(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_HEARTBEAT), 0));
+    QVERIFY(includeFilter.accept(_message(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_ATTITUDE), 0));
+    QVERIFY(!includeFilter.accept(_message(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_GLOBAL_POSITION_INT), 0));
+
+    MAVLinkForwardFilter excludeFilter(QString(), QStringLiteral("-30"), 0);
+    QVERIFY(excludeFilter.accept(_message(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_HEARTBEAT), 0));
+    QVERIFY(!excludeFilter.accept(_message(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_ATTITUDE), 0));
+    QVERIFY(excludeFilter.accept(_message(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_GLOBAL_POSITION_INT), 0));
+}
+
+void MAVLinkForwarderTest::_testRateLimit()
+{
+    MAVLinkForwardFilter filter(QString(), QString(), 10);
+
+    // 50 Hz with some jitter for ten seconds must come out at 10 Hz
+    int attitudeCount = 0;
+    int gimbalAttitudeCount = 0;
+    int paramCount = 0;
+    for (int i = 0; i < 500; i++) {
+        const qint64 nowNsecs = (i * kNsecsPerSec / 50) + (((i % 3) - 1) * kNsecsPerSec / 1000);
+        if (filter.accept(_message(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_ATTITUDE), nowNsecs)) {
+            attitudeCount++;
+        }
+        // Other components are separate streams
+        if (filter.accept(_message(1, MAV_COMP_ID_GIMBAL, MAVLINK_MSG_ID_ATTITUDE), nowNsecs)) {
+            gimbalAttitudeCount++;
+        }
+        // Replies are never limited
+        if (filter.accept(_message(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_PARAM_VALUE), nowNsecs)) {
+            paramCount++;
+        }
+    }
+
+    QVERIFY(qAbs(attitudeCount - 100) <= 1);
+    QCOMPARE(gimbalAttitudeCount, attitudeCount);
+    QCOMPARE(paramCount, 500);
+
+    // A stream slower than the limit passes untouched
+    int slowCount = 0;
+    for (int i = 0; i < 50; i++) {
+        if (filter.accept(_message(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_MSG_ID_SYS_STATUS), i * kNsecsPerSec / 5)) {
+            slowCount++;
+        }
+    }
+    QCOMPARE(slowCount, 50);
+}
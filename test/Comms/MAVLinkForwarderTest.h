@@ -0,0 +1,26 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkForwarderTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testPassThrough();
+    void _testSysIdFilter();
+    void _testMsgIdFilter();
+    void _testRateLimit();
+
+private:
+    static mavlink_message_t _message(uint8_t sysid, uint8_t compid, uint32_t msgid);
+};
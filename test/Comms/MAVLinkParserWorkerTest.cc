@@ -0,0 +1,128 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkParserWorkerTest.h"
+#include "LinkManager.h"
+#include "MavlinkSettings.h"
+#include "SettingsManager.h"
+#include "UDPLink.h"
+
+#include <QtNetwork/QUdpSocket>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+void MAVLinkParserWorkerTest::init()
+{
+    UnitTest::init();
+
+    _packV2Channel = LinkManager::instance()->allocateMavlinkChannel();
+    _packV1Channel = LinkManager::instance()->allocateMavlinkChannel();
+    QVERIFY(_packV2Channel != LinkManager::invalidMavlinkChannel());
+    QVERIFY(_packV1Channel != LinkManager::invalidMavlinkChannel());
+}
+
+void MAVLinkParserWorkerTest::cleanup()
+{
+    LinkManager::instance()->freeMavlinkChannel(_packV1Channel);
+    LinkManager::instance()->freeMavlinkChannel(_packV2Channel);
+
+    UnitTest::cleanup();
+}
+
+QByteArray MAVLinkParserWorkerTest::_buildFrames(int count, QList<mavlink_message_t> &messages)
+{
+    mavlink_get_channel_status(_packV1Channel)->flags |= MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+    mavlink_get_channel_status(_packV2Channel)->flags &= ~MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+
+    QByteArray frames;
+    for (int i = 0; i < count; i++) {
+        mavlink_attitude_t attitude{};
+        attitude.time_boot_ms = static_cast<uint32_t>(i);
+        attitude.roll = 0.01f * i;
+
+        mavlink_message_t message{};
+        (void) mavlink_msg_attitude_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, ((i % 3) == 2) ? _packV1Channel : _packV2Channel, &message, &attitude);
+        messages.append(message);
+
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+        (void) frames.append(reinterpret_cast<const char*>(buffer), len);
+    }
+
+    return frames;
+}
+
+void MAVLinkParserWorkerTest::_testWorkerDecode()
+{
+    MavlinkSettings *const mavlinkSettings = SettingsManager::instance()->mavlinkSettings();
+    Fact *const parseOnLinkThreads = mavlinkSettings->parseMavlinkOnLinkThreads();
+    const QVariant savedParseOnLinkThreads = parseOnLinkThreads->rawValue();
+    parseOnLinkThreads->setRawValue(true);
+
+    UDPConfiguration *const udpConfig = new UDPConfiguration(QStringLiteral("MAVLinkParserWorkerTest"));
+    udpConfig->setDynamic(true);
+    udpConfig->setLocalPort(kLocalPort);
+    SharedLinkConfigurationPtr config(udpConfig);
+    const bool linkCreated = LinkManager::instance()->createConnectedLink(config);
+    parseOnLinkThreads->setRawValue(savedParseOnLinkThreads);
+    QVERIFY(linkCreated);
+
+    LinkInterface *const link = config->link();
+    QVERIFY(link);
+    QTRY_VERIFY(link->isConnected());
+
+    QSignalSpy messagesSpy(link, &LinkInterface::messagesReceived);
+    QSignalSpy bytesSpy(link, &LinkInterface::bytesReceived);
+
+    // The worker must leave the channel status to the main thread
+    const mavlink_status_t channelStatus = *mavlink_get_channel_status(link->mavlinkChannel());
+
+    QList<mavlink_message_t> expected;
+    const QByteArray frames = _buildFrames(30, expected);
+
+    QUdpSocket socket;
+    QCOMPARE(socket.writeDatagram(frames, QHostAddress::LocalHost, kLocalPort), frames.size());
+
+    QList<mavlink_message_t> actual;
+    while (actual.size() < expected.size()) {
+        QVERIFY(!messagesSpy.isEmpty() || messagesSpy.wait());
+        actual.append(messagesSpy.takeFirst().at(1).value<QList<mavlink_message_t>>());
+    }
+    QCOMPARE(bytesSpy.count(), 0);
+    QCOMPARE(actual.size(), expected.size());
+    for (qsizetype i = 0; i < expected.size(); i++) {
+        QCOMPARE(actual[i].magic, expected[i].magic);
+        QCOMPARE(actual[i].seq, expected[i].seq);
+        QCOMPARE(actual[i].msgid, expected[i].msgid);
+        QCOMPARE(actual[i].checksum, expected[i].checksum);
+    }
+
+    const mavlink_status_t *const status = mavlink_get_channel_status(link->mavlinkChannel());
+    QCOMPARE(status->flags, channelStatus.flags);
+    QCOMPARE(status->parse_state, channelStatus.parse_state);
+    QCOMPARE(status->packet_rx_success_count, channelStatus.packet_rx_success_count);
+
+    // With signing enabled the data goes back to the main thread to be checked against the channel signing state
+    Fact *const signingKey = mavlinkSettings->mavlink2SigningKey();
+    const QVariant savedSigningKey = signingKey->rawValue();
+    signingKey->setRawValue(QByteArrayLiteral("MAVLinkParserWorkerTest"));
+    QVERIFY(link->initMavlinkSigning());
+    QVERIFY(link->signingEnabled());
+
+    QCOMPARE(socket.writeDatagram(frames, QHostAddress::LocalHost, kLocalPort), frames.size());
+    QVERIFY(bytesSpy.wait());
+    QCOMPARE(bytesSpy.takeFirst().at(1).toByteArray(), frames);
+    QCOMPARE(messagesSpy.count(), 0);
+
+    signingKey->setRawValue(savedSigningKey);
+    QVERIFY(link->initMavlinkSigning());
+    QVERIFY(!link->signingEnabled());
+
+    LinkManager::instance()->disconnectAll();
+}
@@ -0,0 +1,34 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+#include "MAVLinkLib.h"
+
+class MAVLinkParserWorkerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init() final;
+    void cleanup() final;
+
+    void _testWorkerDecode();
+
+private:
+    /// ATTITUDE messages, every third one MAVLink 1
+    QByteArray _buildFrames(int count, QList<mavlink_message_t> &messages);
+
+    static constexpr quint16 kLocalPort = 14598;
+
+    /// Reserved through LinkManager in init() and released in cleanup() so the link under test gets its own channel
+    uint8_t _packV2Channel = 0;
+    uint8_t _packV1Channel = 0;
+};
@@ -0,0 +1,217 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TelemetryLogWriterTest.h"
+#include "TelemetryLogQueue.h"
+#include "TelemetryLogWriter.h"
+#include "QGCTemporaryFile.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QThread>
+#include <QtCore/QtEndian>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+#include <algorithm>
+
+mavlink_message_t TelemetryLogWriterTest::_attitudeMessage(uint32_t timeBootMs)
+{
+    mavlink_attitude_t attitude{};
+    attitude.time_boot_ms = timeBootMs;
+    attitude.roll = 0.1f;
+
+    mavlink_message_t message{};
+    (void) mavlink_msg_attitude_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, &attitude);
+    return message;
+}
+
+void TelemetryLogWriterTest::_testQueueRecords()
+{
+    TelemetryLogQueue queue(64);
+
+    const mavlink_message_t message = _attitudeMessage(1);
+    uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t frameLen = mavlink_msg_to_send_buffer(frame, &message);
+
+    // Larger than one slot, must come out in one piece behind a single timestamp
+    QByteArray bytes(TelemetryLogQueue::kSlotDataSize * 2 + 17, Qt::Uninitialized);
+    for (qsizetype i = 0; i < bytes.size(); i++) {
+        bytes[i] = static_cast<char>(i);
+    }
+
+    QVERIFY(queue.push(1000, message));
+    QVERIFY(queue.push(2000, bytes));
+    QCOMPARE(queue.size(), 4u);
+
+    QByteArray block;
+    QCOMPARE(queue.pop(block, 1024 * 1024), 4u);
+    QCOMPARE(queue.size(), 0u);
+    QCOMPARE(block.size(), static_cast<qsizetype>(sizeof(quint64) + frameLen + sizeof(quint64) + bytes.size()));
+
+    const char *data = block.constData();
+    QCOMPARE(qFromBigEndian<quint64>(data), 1000u);
+    data += sizeof(quint64);
+    QVERIFY(memcmp(data, frame, frameLen) == 0);
+    data += frameLen;
+    QCOMPARE(qFromBigEndian<quint64>(data), 2000u);
+    data += sizeof(quint64);
+    QVERIFY(memcmp(data, bytes.constData(), bytes.size()) == 0);
+}
+
+void TelemetryLogWriterTest::_testQueueOverflow()
+{
+    TelemetryLogQueue queue(16);
+    const mavlink_message_t message = _attitudeMessage(1);
+
+    for (int i = 0; i < 16; i++) {
+        QVERIFY(queue.push(i, message));
+    }
+    QVERIFY(!queue.push(16, message));
+    QVERIFY(!queue.push(17, message));
+    QCOMPARE(queue.droppedCount(), 2u);
+
+    // Records which would take more than a quarter of the queue are never accepted
+    QVERIFY(!queue.push(18, QByteArray(TelemetryLogQueue::kSlotDataSize * 5, 'x')));
+    QCOMPARE(queue.droppedCount(), 3u);
+
+    QByteArray block;
+    QCOMPARE(queue.pop(block, 1024 * 1024), 16u);
+    QVERIFY(queue.push(19, message));
+
+    queue.discard();
+    QCOMPARE(queue.size(), 0u);
+}
+
+void TelemetryLogWriterTest::_testQueueConcurrentProducers()
+{
+    static constexpr int kProducerCount = 4;
+    static constexpr int kRecordsPerProducer = 20000;
+    static constexpr qsizetype kRecordSize = 40;
+
+    TelemetryLogQueue queue(1024);
+
+    QList<QThread*> producers;
+    for (int producer = 0; producer < kProducerCount; producer++) {
+        producers.append(QThread::create([&queue, producer]() {
+            const QByteArray record(kRecordSize, static_cast<char>('a' + producer));
+            const QByteArray largeRecord(TelemetryLogQueue::kSlotDataSize + 1, static_cast<char>('a' + producer));
+            for (int i = 0; i < kRecordsPerProducer; i++) {
+                // Every third record spans two slots
+                const QByteArrayView data = ((i % 3) == 0) ? QByteArrayView(largeRecord) : QByteArrayView(record);
+                while (!queue.push(static_cast<quint64>(producer), data)) {
+                    QThread::yieldCurrentThread();
+                }
+            }
+        }));
+        producers.last()->start();
+    }
+
+    QByteArray stream;
+    bool done = false;
+    while (!done) {
+        done = std::all_of(producers.cbegin(), producers.cend(), [](const QThread *thread) { return thread->isFinished(); });
+        (void) queue.pop(stream, stream.size() + 64 * 1024);
+    }
+    (void) queue.pop(stream, stream.size() + 64 * 1024 * 1024);
+
+    for (QThread *thread : std::as_const(producers)) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+
+    // Walk the stream, every record must be intact and carry its producer's timestamp
+    int recordCounts[kProducerCount] = {};
+    qsizetype pos = 0;
+    while (pos < stream.size()) {
+        const quint64 producer = qFromBigEndian<quint64>(stream.constData() + pos);
+        QVERIFY(producer < kProducerCount);
+        pos += sizeof(quint64);
+
+        const qsizetype recordSize = ((recordCounts[producer] % 3) == 0) ? (TelemetryLogQueue::kSlotDataSize + 1) : kRecordSize;
+        QVERIFY(pos + recordSize <= stream.size());
+        for (qsizetype i = 0; i < recordSize; i++) {
+            QCOMPARE(stream[pos + i], static_cast<char>('a' + producer));
+        }
+        pos += recordSize;
+        recordCounts[producer]++;
+    }
+
+    for (int producer = 0; producer < kProducerCount; producer++) {
+        QCOMPARE(recordCounts[producer], kRecordsPerProducer);
+    }
+}
+
+void TelemetryLogWriterTest::_testWriterLatency()
+{
+    const QString fileName = QGCTemporaryFile::newTempFileFullyQualifiedName(QStringLiteral("TelemetryLogWriterTestXXXXXX.tlog"));
+
+    TelemetryLogWriter writer;
+    writer.setMaxLatency(100);
+    QVERIFY(writer.open(fileName));
+    QVERIFY(writer.isOpen());
+
+    const mavlink_message_t message = _attitudeMessage(1);
+    uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+    const qsizetype recordSize = sizeof(quint64) + mavlink_msg_to_send_buffer(frame, &message);
+
+    for (int i = 0; i < 10; i++) {
+        writer.logMessage(message);
+    }
+
+    // Far less than a block, so only the latency limit gets this to disk while the file is still open
+    QVERIFY(QTest::qWaitFor([&fileName, recordSize]() { return QFileInfo(fileName).size() == (10 * recordSize); }, 2000));
+
+    writer.logBytes(QByteArrayView(reinterpret_cast<const char*>(frame), recordSize - sizeof(quint64)));
+    QCOMPARE(writer.close(), 11 * recordSize);
+    QVERIFY(!writer.isOpen());
+    QCOMPARE(writer.close(), -1);
+
+    QVERIFY(QFile::remove(fileName));
+}
+
+void TelemetryLogWriterTest::_testWriterDropSignal()
+{
+    const QString fileName = QGCTemporaryFile::newTempFileFullyQualifiedName(QStringLiteral("TelemetryLogWriterTestXXXXXX.tlog"));
+
+    TelemetryLogWriter writer;
+    writer.setMaxLatency(10000);
+    QSignalSpy spyDropped(&writer, &TelemetryLogWriter::dataDropped);
+    QVERIFY(writer.open(fileName));
+
+    // Each record takes a quarter of the queue, the log thread cannot possibly keep up with these
+    const QByteArray record(TelemetryLogQueue::kSlotDataSize * (TelemetryLogQueue::kDefaultSlotCount / 4), 'x');
+    for (int i = 0; i < 64; i++) {
+        writer.logBytes(record);
+    }
+
+    QVERIFY(spyDropped.wait(5000) || !spyDropped.isEmpty());
+    QVERIFY(spyDropped.last().at(0).toULongLong() > 0);
+
+    QVERIFY(writer.close() > 0);
+    QVERIFY(QFile::remove(fileName));
+}
+
+void TelemetryLogWriterTest::_benchmarkLogMessage()
+{
+    const QString fileName = QGCTemporaryFile::newTempFileFullyQualifiedName(QStringLiteral("TelemetryLogWriterTestXXXXXX.tlog"));
+
+    TelemetryLogWriter writer;
+    QVERIFY(writer.open(fileName));
+
+    const mavlink_message_t message = _attitudeMessage(1);
+    QBENCHMARK {
+        for (int i = 0; i < 1000; i++) {
+            writer.logMessage(message);
+        }
+    }
+
+    QVERIFY(writer.close() > 0);
+    QVERIFY(QFile::remove(fileName));
+}
@@ -0,0 +1,28 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class TelemetryLogWriterTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testQueueRecords();
+    void _testQueueOverflow();
+    void _testQueueConcurrentProducers();
+    void _testWriterLatency();
+    void _testWriterDropSignal();
+    void _benchmarkLogMessage();
+
+private:
+    static mavlink_message_t _attitudeMessage(uint32_t timeBootMs);
+};
@@ -0,0 +1,326 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TlogIndexTest.h"
+#include "TlogIndex.h"
+#include "MAVLinkLib.h"
+#include "QGCTemporaryFile.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QtEndian>
+#include <QtTest/QTest>
+
+QByteArray TlogIndexTest::_buildLog(qsizetype count, int garbageEvery, QList<qsizetype> *offsets)
+{
+    QByteArray log;
+    log.reserve(count * 48);
+
+    for (int i = 0; i < count; i++) {
+        if ((garbageEvery > 0) && (i > 0) && ((i % garbageEvery) == 0)) {
+            // Includes start-of-frame markers which must not be mistaken for records
+            (void) log.append("\xFD\x09\x00junk\xFE\x03", 9);
+        }
+
+        mavlink_message_t message{};
+        if ((i % 2) == 0) {
+            (void) mavlink_msg_heartbeat_pack_chan(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, 0, 0, MAV_STATE_ACTIVE);
+        } else {
+            mavlink_attitude_t attitude{};
+            attitude.time_boot_ms = static_cast<uint32_t>(i);
+            attitude.roll = 0.1f;
+            (void) mavlink_msg_attitude_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, &message, &attitude);
+        }
+
+        if (offsets) {
+            offsets->append(log.size());
+        }
+
+        char timestamp[sizeof(quint64)];
+        qToBigEndian(kStartUSecs + (static_cast<quint64>(i) * kIntervalUSecs), timestamp);
+        (void) log.append(timestamp, sizeof(timestamp));
+
+        uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+        const uint16_t frameLen = mavlink_msg_to_send_buffer(frame, &message);
+        (void) log.append(reinterpret_cast<const char*>(frame), frameLen);
+    }
+
+    return log;
+}
+
+QString TlogIndexTest::_writeLog(const QByteArray &log)
+{
+    const QString fileName = QGCTemporaryFile::newTempFileFullyQualifiedName(QStringLiteral("TlogIndexTestXXXXXX.tlog"));
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || (file.write(log) != log.size())) {
+        return QString();
+    }
+
+    return fileName;
+}
+
+void TlogIndexTest::_removeLog(const QString &fileName)
+{
+    (void) QFile::remove(fileName);
+    (void) QFile::remove(TlogIndex::indexFilename(fileName));
+}
+
+void TlogIndexTest::_testBuild()
+{
+    constexpr qsizetype count = 1000;
+    QList<qsizetype> offsets;
+    const QByteArray log = _buildLog(count, 7, &offsets);
+
+    TlogIndex index;
+    index.build(log);
+
+    QCOMPARE(index.count(), count);
+    QVERIFY(!index.isLoaded());
+    QCOMPARE(index.startTimeUSecs(), kStartUSecs);
+    QCOMPARE(index.endTimeUSecs(), kStartUSecs + ((count - 1) * kIntervalUSecs));
+
+    for (int i = 0; i < count; i++) {
+        const TlogIndex::Entry &entry = index.at(i);
+        QCOMPARE(entry.timestampUSecs, kStartUSecs + (static_cast<quint64>(i) * kIntervalUSecs));
+        QCOMPARE(entry.offset(), static_cast<quint64>(offsets[i]));
+        QCOMPARE(entry.msgid(), static_cast<uint32_t>(((i % 2) == 0) ? MAVLINK_MSG_ID_HEARTBEAT : MAVLINK_MSG_ID_ATTITUDE));
+
+        // The frame must decode to exactly one message
+        const QByteArrayView frame = TlogIndex::frame(log, entry);
+        mavlink_reset_channel_status(MAVLINK_COMM_0);
+        int messageCount = 0;
+        for (const char byte : frame) {
+            mavlink_message_t message;
+            mavlink_status_t status;
+            if (mavlink_parse_char(MAVLINK_COMM_0, static_cast<uint8_t>(byte), &message, &status) == MAVLINK_FRAMING_OK) {
+                QCOMPARE(static_cast<uint32_t>(message.msgid), entry.msgid());
+                messageCount++;
+            }
+        }
+        QCOMPARE(messageCount, 1);
+    }
+
+    // A truncated final record is not indexed
+    index.build(QByteArrayView(log).chopped(3));
+    QCOMPARE(index.count(), count - 1);
+
+    index.build(QByteArrayView());
+    QVERIFY(index.isEmpty());
+    QCOMPARE(index.seek(kStartUSecs), static_cast<qsizetype>(0));
+}
+
+void TlogIndexTest::_testSidecar()
+{
+    constexpr qsizetype count = 500;
+    QByteArray log = _buildLog(count, 0);
+    const QString fileName = _writeLog(log);
+    QVERIFY(!fileName.isEmpty());
+
+    TlogIndex built;
+    built.open(fileName, log);
+    QVERIFY(!built.isLoaded());
+    QCOMPARE(built.count(), count);
+    QVERIFY(QFile::exists(TlogIndex::indexFilename(fileName)));
+
+    TlogIndex loaded;
+    loaded.open(fileName, log);
+    QVERIFY(loaded.isLoaded());
+    QCOMPARE(loaded.count(), count);
+    for (int i = 0; i < count; i++) {
+        QCOMPARE(loaded.at(i).timestampUSecs, built.at(i).timestampUSecs);
+        QCOMPARE(loaded.at(i).packed, built.at(i).packed);
+    }
+
+    // A log which changed after it was indexed must be indexed again
+    loaded.clear();
+    log = _buildLog(count + 1, 0);
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QCOMPARE(file.write(log), log.size());
+    }
+
+    TlogIndex rebuilt;
+    rebuilt.open(fileName, log);
+    QVERIFY(!rebuilt.isLoaded());
+    QCOMPARE(rebuilt.count(), count + 1);
+
+    rebuilt.clear();
+    _removeLog(fileName);
+}
+
+void TlogIndexTest::_testSeek()
+{
+    constexpr qsizetype count = 100;
+    const QByteArray log = _buildLog(count, 0);
+
+    TlogIndex index;
+    index.build(log);
+
+    const quint64 endUSecs = index.endTimeUSecs();
+    const QList<quint64> targets = {
+        0,
+        kStartUSecs,
+        kStartUSecs + 1,
+        kStartUSecs + kIntervalUSecs - 1,
+        kStartUSecs + (50 * kIntervalUSecs),
+        endUSecs - 1,
+        endUSecs,
+        endUSecs + 1,
+    };
+
+    for (const quint64 target : targets) {
+        qsizetype expected = 0;
+        while ((expected < index.count()) && (index.at(expected).timestampUSecs < target)) {
+            expected++;
+        }
+        QCOMPARE(index.seek(target), expected);
+    }
+}
+
+void TlogIndexTest::_testCorruptSidecar()
+{
+    constexpr qsizetype count = 100;
+    const QByteArray log = _buildLog(count, 0);
+    const QString fileName = _writeLog(log);
+    QVERIFY(!fileName.isEmpty());
+
+    TlogIndex built;
+    built.open(fileName, log);
+    QCOMPARE(built.count(), count);
+
+    // Point the last entry past the end of the log, the header still matches
+    const QString sidecar = TlogIndex::indexFilename(fileName);
+    {
+        QFile file(sidecar);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        TlogIndex::Entry entry = built.at(count - 1);
+        entry.packed = (entry.packed & ~TlogIndex::kOffsetMask) | static_cast<quint64>(log.size() - 4);
+        QVERIFY(file.seek(file.size() - static_cast<qint64>(sizeof(entry))));
+        QCOMPARE(file.write(reinterpret_cast<const char*>(&entry), sizeof(entry)), static_cast<qint64>(sizeof(entry)));
+
+        QVERIFY(TlogIndex::frame(log, entry).isEmpty());
+    }
+
+    TlogIndex loaded;
+    QVERIFY(!loaded.load(sidecar, QFileInfo(fileName)));
+    QVERIFY(loaded.isEmpty());
+
+    // Opening falls back to indexing the log again
+    TlogIndex rebuilt;
+    rebuilt.open(fileName, log);
+    QVERIFY(!rebuilt.isLoaded());
+    QCOMPARE(rebuilt.count(), count);
+    for (int i = 0; i < count; i++) {
+        QCOMPARE(rebuilt.at(i).packed, built.at(i).packed);
+    }
+
+    built.clear();
+    rebuilt.clear();
+    _removeLog(fileName);
+}
+
+void TlogIndexTest::_testUnknownMessages()
+{
+    QByteArray log = _buildLog(4, 0);
+
+    // A message of another dialect, followed by one more known record
+    mavlink_message_t message{};
+    (void) memset(_MAV_PAYLOAD_NON_CONST(&message), 0x42, 20);
+    message.msgid = kUnknownMsgId;
+    (void) mavlink_finalize_message_chan(&message, 1, MAV_COMP_ID_AUTOPILOT1, MAVLINK_COMM_0, 20, 20, 0);
+
+    char timestamp[sizeof(quint64)];
+    qToBigEndian(kStartUSecs + (4 * kIntervalUSecs), timestamp);
+    const qsizetype unknownOffset = log.size();
+    (void) log.append(timestamp, sizeof(timestamp));
+    uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+    const uint16_t frameLen = mavlink_msg_to_send_buffer(frame, &message);
+    (void) log.append(reinterpret_cast<const char*>(frame), frameLen);
+
+    const QByteArray tail = _buildLog(1, 0);
+    (void) log.append(tail);
+
+    TlogIndex index;
+    index.build(log);
+    QCOMPARE(index.count(), static_cast<qsizetype>(6));
+    QCOMPARE(index.at(4).offset(), static_cast<quint64>(unknownOffset));
+    QCOMPARE(index.at(4).msgid(), kUnknownMsgId);
+    QCOMPARE(TlogIndex::frame(log, index.at(4)).toByteArray(), QByteArray(reinterpret_cast<const char*>(frame), frameLen));
+
+    // Without a record following it there is nothing to tell it apart from garbage
+    index.build(QByteArrayView(log).chopped(tail.size() + 1));
+    QCOMPARE(index.count(), static_cast<qsizetype>(4));
+}
+
+void TlogIndexTest::_benchmarkBuild()
+{
+    const QByteArray log = _buildLog(200000, 1000);
+
+    TlogIndex index;
+    QBENCHMARK {
+        index.build(log);
+    }
+
+    QCOMPARE(index.count(), static_cast<qsizetype>(200000));
+}
+
+void TlogIndexTest::_benchmarkLoad()
+{
+    const QByteArray log = _buildLog(200000, 1000);
+    const QString fileName = _writeLog(log);
+    QVERIFY(!fileName.isEmpty());
+
+    TlogIndex index;
+    index.open(fileName, log);
+    QVERIFY(!index.isLoaded());
+
+    const QFileInfo logInfo(fileName);
+    const QString indexFilename = TlogIndex::indexFilename(fileName);
+    QBENCHMARK {
+        QVERIFY(index.load(indexFilename, logInfo));
+    }
+
+    QCOMPARE(index.count(), static_cast<qsizetype>(200000));
+
+    index.clear();
+    _removeLog(fileName);
+}
+
+void TlogIndexTest::_benchmarkSeekAccuracy()
+{
+    constexpr qsizetype count = 200000;
+    const QByteArray log = _buildLog(count, 1000);
+
+    TlogIndex index;
+    index.build(log);
+
+    // Random log times, each must land on the first message at or after it
+    QList<quint64> targets;
+    QList<qsizetype> expected;
+    for (int i = 0; i < 10000; i++) {
+        const quint64 relativeUSecs = QRandomGenerator::global()->bounded(static_cast<quint64>(count - 1) * kIntervalUSecs);
+        targets.append(kStartUSecs + relativeUSecs);
+        expected.append(static_cast<qsizetype>((relativeUSecs + kIntervalUSecs - 1) / kIntervalUSecs));
+    }
+
+    qsizetype misses = 0;
+    QBENCHMARK {
+        misses = 0;
+        for (qsizetype i = 0; i < targets.size(); i++) {
+            if (index.seek(targets[i]) != expected[i]) {
+                misses++;
+            }
+        }
+    }
+
+    QCOMPARE(misses, 0);
+}
@@ -0,0 +1,38 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class TlogIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testBuild();
+    void _testSidecar();
+    void _testSeek();
+    void _testCorruptSidecar();
+    void _testUnknownMessages();
+    void _benchmarkBuild();
+    void _benchmarkLoad();
+    void _benchmarkSeekAccuracy();
+
+private:
+    /// Alternating HEARTBEAT and ATTITUDE records, kIntervalUSecs apart
+    ///     @param garbageEvery Insert a few bytes of junk between records after every this many, 0 for none
+    static QByteArray _buildLog(qsizetype count, int garbageEvery, QList<qsizetype> *offsets = nullptr);
+    static QString _writeLog(const QByteArray &log);
+    static void _removeLog(const QString &fileName);
+
+    static constexpr quint64 kStartUSecs = Q_UINT64_C(1700000000000000);
+    static constexpr quint64 kIntervalUSecs = 2500;
+    static constexpr uint32_t kUnknownMsgId = 0xFFFFFE;
+};
@@ -0,0 +1,137 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "FactTypedValueTest.h"
+#include "Fact.h"
+
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+void FactTypedValueTest::_testSetRawDouble()
+{
+    Fact fact(0, QStringLiteral("test"), FactMetaData::valueTypeDouble);
+    QSignalSpy valueChangedSpy(&fact, &Fact::valueChanged);
+    QSignalSpy rawValueChangedSpy(&fact, &Fact::rawValueChanged);
+    QSignalSpy containerSpy(&fact, &Fact::containerRawValueChanged);
+
+    fact.setRawDouble(1.5);
+    QCOMPARE(valueChangedSpy.count(), 1);
+    QCOMPARE(rawValueChangedSpy.count(), 1);
+    QCOMPARE(valueChangedSpy.takeFirst().at(0).toDouble(), 1.5);
+    QCOMPARE(fact.rawValue().typeId(), qMetaTypeId<double>());
+    QCOMPARE(fact.rawValue().toDouble(), 1.5);
+
+    // Unchanged values are not signalled, including NaN
+    fact.setRawDouble(1.5);
+    QCOMPARE(valueChangedSpy.count(), 0);
+    fact.setRawDouble(qQNaN());
+    fact.setRawDouble(qQNaN());
+    QCOMPARE(valueChangedSpy.count(), 1);
+    QVERIFY(qIsNaN(fact.rawValue().toDouble()));
+
+    // Telemetry values are never sent to the vehicle
+    QCOMPARE(containerSpy.count(), 0);
+
+    // Mixing with the QVariant setter stays consistent
+    fact.setRawValue(2.5);
+    QCOMPARE(fact.rawValue().toDouble(), 2.5);
+    fact.setRawDouble(2.5);
+    QCOMPARE(valueChangedSpy.count(), 2);
+
+    // Float facts keep float precision
+    Fact floatFact(0, QStringLiteral("float"), FactMetaData::valueTypeFloat);
+    floatFact.setRawDouble(0.1);
+    QCOMPARE(floatFact.rawValue().typeId(), qMetaTypeId<float>());
+    QCOMPARE(floatFact.rawValue().toFloat(), 0.1f);
+}
+
+void FactTypedValueTest::_testSetRawInt()
+{
+    Fact fact(0, QStringLiteral("test"), FactMetaData::valueTypeUint32);
+    QSignalSpy valueChangedSpy(&fact, &Fact::valueChanged);
+
+    fact.setRawInt(4000000000LL);
+    QCOMPARE(valueChangedSpy.count(), 1);
+    QCOMPARE(fact.rawValue().typeId(), qMetaTypeId<uint>());
+    QCOMPARE(fact.rawValue().toUInt(), 4000000000U);
+
+    fact.setRawInt(4000000000LL);
+    QCOMPARE(valueChangedSpy.count(), 1);
+
+    Fact int16Fact(0, QStringLiteral("int16"), FactMetaData::valueTypeInt16);
+    int16Fact.setRawInt(-12);
+    QCOMPARE(int16Fact.rawValue().typeId(), qMetaTypeId<int>());
+    QCOMPARE(int16Fact.rawValue().toInt(), -12);
+
+    // Integer values on floating point facts go through the double path
+    Fact doubleFact(0, QStringLiteral("double"), FactMetaData::valueTypeDouble);
+    doubleFact.setRawInt(3);
+    QCOMPARE(doubleFact.rawValue().typeId(), qMetaTypeId<double>());
+    QCOMPARE(doubleFact.rawValue().toDouble(), 3.0);
+}
+
+void FactTypedValueTest::_testDeferredSignal()
+{
+    Fact fact(0, QStringLiteral("test"), FactMetaData::valueTypeDouble);
+    fact.setSendValueChangedSignals(false);
+    QSignalSpy valueChangedSpy(&fact, &Fact::valueChanged);
+
+    fact.setRawDouble(1.0);
+    fact.setRawDouble(2.0);
+    QCOMPARE(valueChangedSpy.count(), 0);
+    QVERIFY(fact.deferredValueChangeSignal());
+
+    fact.sendDeferredValueChangedSignal();
+    QCOMPARE(valueChangedSpy.count(), 1);
+    QCOMPARE(valueChangedSpy.takeFirst().at(0).toDouble(), 2.0);
+    QVERIFY(!fact.deferredValueChangeSignal());
+}
+
+void FactTypedValueTest::_testFallback()
+{
+    // Mismatched types use the validating QVariant path
+    Fact intFact(0, QStringLiteral("int"), FactMetaData::valueTypeInt32);
+    intFact.setRawDouble(7.0);
+    QCOMPARE(intFact.rawValue().typeId(), qMetaTypeId<int>());
+    QCOMPARE(intFact.rawValue().toInt(), 7);
+
+    Fact stringFact(0, QStringLiteral("string"), FactMetaData::valueTypeString);
+    stringFact.setRawInt(42);
+    QCOMPARE(stringFact.rawValue().typeId(), qMetaTypeId<QString>());
+    QCOMPARE(stringFact.rawValue().toString(), QStringLiteral("42"));
+}
+
+void FactTypedValueTest::_benchmarkTelemetryUpdate_data()
+{
+    QTest::addColumn<bool>("typed");
+
+    QTest::newRow("setRawValue")    << false;
+    QTest::newRow("setRawDouble")   << true;
+}
+
+void FactTypedValueTest::_benchmarkTelemetryUpdate()
+{
+    QFETCH(bool, typed);
+
+    // Same setup as a rate limited FactGroup
+    Fact fact(0, QStringLiteral("test"), FactMetaData::valueTypeDouble);
+    fact.setSendValueChangedSignals(false);
+
+    double value = 0;
+    QBENCHMARK {
+        for (int i=0; i<1000; i++) {
+            value += 0.1;
+            if (typed) {
+                fact.setRawDouble(value);
+            } else {
+                fact.setRawValue(value);
+            }
+        }
+    }
+}
@@ -0,0 +1,299 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ParameterMetaDataSnapshotTest.h"
+#include "ParameterMetaDataSnapshot.h"
+#include "APMParameterMetaData.h"
+#include "PX4ParameterMetaData.h"
+#include "FactMetaData.h"
+#include "QGCTemporaryFile.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QXmlStreamReader>
+#include <QtTest/QTest>
+
+void ParameterMetaDataSnapshotTest::init()
+{
+    UnitTest::init();
+
+    _removeSnapshots();
+}
+
+void ParameterMetaDataSnapshotTest::cleanup()
+{
+    _removeSnapshots();
+
+    UnitTest::cleanup();
+}
+
+void ParameterMetaDataSnapshotTest::_removeSnapshots()
+{
+    QDir snapshotDir = ParameterMetaDataSnapshot::snapshotDir();
+    (void) snapshotDir.removeRecursively();
+}
+
+QStringList ParameterMetaDataSnapshotTest::_parameterNames(const QString &metaDataFile, const QString &elementName)
+{
+    QFile file(metaDataFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QStringList();
+    }
+
+    QStringList names;
+    QXmlStreamReader xml(file.readAll());
+    while (!xml.atEnd()) {
+        if (xml.isStartElement() && (xml.name() == elementName)) {
+            const QString name = xml.attributes().value("name").toString().split(':').last();
+            if (!names.contains(name)) {
+                names.append(name);
+            }
+        }
+        (void) xml.readNext();
+    }
+
+    return names;
+}
+
+void ParameterMetaDataSnapshotTest::_testWriteOpen()
+{
+    const QString sourceFile = QGCTemporaryFile::newTempFileFullyQualifiedName(QStringLiteral("ParameterMetaDataSnapshotTestXXXXXX.xml"));
+    QFile source(sourceFile);
+    QVERIFY(source.open(QIODevice::WriteOnly));
+    (void) source.write("<parameters/>");
+    source.close();
+
+    QHash<QString, QByteArray> records;
+    (void) records.insert(QStringLiteral("ALPHA"), QByteArrayLiteral("alpha"));
+    (void) records.insert(QStringLiteral("BRAVO"), QByteArray(1000, 'b'));
+    QVERIFY(ParameterMetaDataSnapshot::write(sourceFile, QStringLiteral("Test"), records));
+
+    ParameterMetaDataSnapshot snapshot;
+    QVERIFY(snapshot.open(sourceFile, QStringLiteral("Test")));
+    QCOMPARE(snapshot.count(), 2);
+    QVERIFY(snapshot.contains(QStringLiteral("ALPHA")));
+    QVERIFY(!snapshot.contains(QStringLiteral("CHARLIE")));
+    QCOMPARE(snapshot.record(QStringLiteral("ALPHA")), QByteArrayLiteral("alpha"));
+    QCOMPARE(snapshot.record(QStringLiteral("BRAVO")), QByteArray(1000, 'b'));
+    QVERIFY(snapshot.record(QStringLiteral("CHARLIE")).isEmpty());
+    snapshot.close();
+
+    // Snapshots of the same source written by another loader are separate
+    QVERIFY(!snapshot.open(sourceFile, QStringLiteral("Other")));
+
+    (void) QFile::remove(sourceFile);
+}
+
+void ParameterMetaDataSnapshotTest::_testStaleSource()
+{
+    const QString sourceFile = QGCTemporaryFile::newTempFileFullyQualifiedName(QStringLiteral("ParameterMetaDataSnapshotTestXXXXXX.xml"));
+    QFile source(sourceFile);
+    QVERIFY(source.open(QIODevice::WriteOnly));
+    (void) source.write("<parameters/>");
+    source.close();
+
+    QHash<QString, QByteArray> records;
+    (void) records.insert(QStringLiteral("ALPHA"), QByteArrayLiteral("alpha"));
+    QVERIFY(ParameterMetaDataSnapshot::write(sourceFile, QStringLiteral("Test"), records));
+
+    ParameterMetaDataSnapshot snapshot;
+    QVERIFY(snapshot.open(sourceFile, QStringLiteral("Test")));
+    snapshot.close();
+
+    QVERIFY(source.open(QIODevice::Append));
+    (void) source.write("<!-- updated -->");
+    source.close();
+    QVERIFY(!snapshot.open(sourceFile, QStringLiteral("Test")));
+
+    // A missing snapshot is not an error
+    _removeSnapshots();
+    QVERIFY(!snapshot.open(sourceFile, QStringLiteral("Test")));
+
+    (void) QFile::remove(sourceFile);
+}
+
+void ParameterMetaDataSnapshotTest::_testCorruptSnapshot()
+{
+    const QString sourceFile = QGCTemporaryFile::newTempFileFullyQualifiedName(QStringLiteral("ParameterMetaDataSnapshotTestXXXXXX.xml"));
+    QFile source(sourceFile);
+    QVERIFY(source.open(QIODevice::WriteOnly));
+    (void) source.write("<parameters/>");
+    source.close();
+
+    QHash<QString, QByteArray> records;
+    (void) records.insert(QStringLiteral("ALPHA"), QByteArrayLiteral("alpha"));
+    QVERIFY(ParameterMetaDataSnapshot::write(sourceFile, QStringLiteral("Test"), records));
+
+    // A record count far beyond what the file can hold must not be trusted
+    QFile snapshotFile(ParameterMetaDataSnapshot::snapshotFilename(sourceFile, QStringLiteral("Test")));
+    QVERIFY(snapshotFile.open(QIODevice::ReadWrite));
+    QDataStream stream(&snapshotFile);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString sourceKey;
+    stream >> magic >> version >> sourceKey;
+    QCOMPARE(stream.status(), QDataStream::Ok);
+    stream << std::numeric_limits<quint32>::max();
+    snapshotFile.close();
+
+    ParameterMetaDataSnapshot snapshot;
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Corrupt snapshot record count")));
+    QVERIFY(!snapshot.open(sourceFile, QStringLiteral("Test")));
+    QCOMPARE(snapshot.count(), 0);
+
+    // An index cut short is found as well
+    QVERIFY(ParameterMetaDataSnapshot::write(sourceFile, QStringLiteral("Test"), records));
+    QVERIFY(snapshotFile.open(QIODevice::ReadWrite));
+    QVERIFY(snapshotFile.resize(snapshotFile.size() - records.value(QStringLiteral("ALPHA")).size() - 10));
+    snapshotFile.close();
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Corrupt snapshot")));
+    QVERIFY(!snapshot.open(sourceFile, QStringLiteral("Test")));
+
+    (void) QFile::remove(sourceFile);
+}
+
+void ParameterMetaDataSnapshotTest::_testFactMetaDataRecord()
+{
+    FactMetaData metaData(FactMetaData::valueTypeFloat, QStringLiteral("TEST_PARAM"));
+    metaData.setCategory(QStringLiteral("Standard"));
+    metaData.setGroup(QStringLiteral("Test"));
+    metaData.setShortDescription(QStringLiteral("Short"));
+    metaData.setLongDescription(QStringLiteral("Long description"));
+    metaData.setRawUnits(QStringLiteral("m"));
+    metaData.setRawMin(-10.0f);
+    metaData.setRawMax(10.0f);
+    metaData.setRawDefaultValue(2.5f);
+    metaData.setDecimalPlaces(3);
+    metaData.setRawIncrement(0.5);
+    metaData.setVehicleRebootRequired(true);
+
+    FactMetaData *decoded = FactMetaData::createFromSnapshotRecord(metaData.toSnapshotRecord(), this);
+    QVERIFY(decoded);
+    QVERIFY(*decoded == metaData);
+    QCOMPARE(decoded->cookedUnits(), metaData.cookedUnits());
+    delete decoded;
+
+    FactMetaData bitmaskMetaData(FactMetaData::valueTypeUint32, QStringLiteral("TEST_BITMASK"));
+    bitmaskMetaData.addBitmaskInfo(QStringLiteral("Bit 0"), 1u);
+    bitmaskMetaData.addBitmaskInfo(QStringLiteral("Bit 1"), 2u);
+    bitmaskMetaData.setVolatileValue(true);
+
+    decoded = FactMetaData::createFromSnapshotRecord(bitmaskMetaData.toSnapshotRecord(), this);
+    QVERIFY(decoded);
+    QVERIFY(*decoded == bitmaskMetaData);
+    delete decoded;
+
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Snapshot record is truncated")));
+    QVERIFY(!FactMetaData::createFromSnapshotRecord(metaData.toSnapshotRecord().left(10), this));
+}
+
+void ParameterMetaDataSnapshotTest::_testAPMSnapshot()
+{
+    const QStringList names = _parameterNames(kAPMMetaDataFile, QStringLiteral("param"));
+    QVERIFY(names.count() > 100);
+
+    APMParameterMetaData xmlMetaData;
+    xmlMetaData.loadParameterFactMetaDataFile(kAPMMetaDataFile);
+
+    const QStringList snapshotFiles = ParameterMetaDataSnapshot::snapshotDir().entryList(QDir::Files);
+    QCOMPARE(snapshotFiles.count(), 1);
+
+    // The second load must come from the snapshot, so it must not be rewritten
+    QFile snapshotFile(ParameterMetaDataSnapshot::snapshotDir().filePath(snapshotFiles.first()));
+    const QDateTime stamp(QDate(2000, 1, 1), QTime(0, 0));
+    QVERIFY(snapshotFile.open(QIODevice::ReadWrite));
+    QVERIFY(snapshotFile.setFileTime(stamp, QFileDevice::FileModificationTime));
+    snapshotFile.close();
+
+    APMParameterMetaData snapshotMetaData;
+    snapshotMetaData.loadParameterFactMetaDataFile(kAPMMetaDataFile);
+    QCOMPARE(snapshotFile.fileTime(QFileDevice::FileModificationTime), stamp);
+
+    for (const QString &name : names) {
+        const FactMetaData *const xmlFactMetaData = xmlMetaData.getMetaDataForFact(name, MAV_TYPE_QUADROTOR, FactMetaData::valueTypeFloat);
+        const FactMetaData *const snapshotFactMetaData = snapshotMetaData.getMetaDataForFact(name, MAV_TYPE_QUADROTOR, FactMetaData::valueTypeFloat);
+        QVERIFY2(*xmlFactMetaData == *snapshotFactMetaData, qPrintable(name));
+    }
+
+    // Unknown parameters still get generic meta data
+    const FactMetaData *const genericMetaData = snapshotMetaData.getMetaDataForFact(QStringLiteral("NOT_A_PARAM"), MAV_TYPE_QUADROTOR, FactMetaData::valueTypeInt32);
+    QCOMPARE(genericMetaData->type(), FactMetaData::valueTypeInt32);
+}
+
+void ParameterMetaDataSnapshotTest::_testPX4Snapshot()
+{
+    const QStringList names = _parameterNames(kPX4MetaDataFile, QStringLiteral("parameter"));
+    QVERIFY(names.count() > 100);
+
+    PX4ParameterMetaData xmlMetaData;
+    xmlMetaData.loadParameterFactMetaDataFile(kPX4MetaDataFile);
+    QCOMPARE(ParameterMetaDataSnapshot::snapshotDir().entryList(QDir::Files).count(), 1);
+
+    PX4ParameterMetaData snapshotMetaData;
+    snapshotMetaData.loadParameterFactMetaDataFile(kPX4MetaDataFile);
+
+    for (const QString &name : names) {
+        const FactMetaData *const xmlFactMetaData = xmlMetaData.getMetaDataForFact(name, MAV_TYPE_QUADROTOR, FactMetaData::valueTypeFloat);
+        const FactMetaData *const snapshotFactMetaData = snapshotMetaData.getMetaDataForFact(name, MAV_TYPE_QUADROTOR, FactMetaData::valueTypeFloat);
+        QVERIFY2(*xmlFactMetaData == *snapshotFactMetaData, qPrintable(name));
+    }
+}
+
+void ParameterMetaDataSnapshotTest::_benchmarkLoad_data()
+{
+    QTest::addColumn<bool>("px4");
+    QTest::addColumn<bool>("snapshot");
+
+    // First connect parses the source and compiles the snapshot, later connects only map it
+    QTest::newRow("APM first connect") << false << false;
+    QTest::newRow("APM snapshot") << false << true;
+    QTest::newRow("PX4 first connect") << true << false;
+    QTest::newRow("PX4 snapshot") << true << true;
+}
+
+void ParameterMetaDataSnapshotTest::_benchmarkLoad()
+{
+    QFETCH(bool, px4);
+    QFETCH(bool, snapshot);
+
+    // Meta data is requested for every parameter the vehicle reports once the parameter load completes
+    const QString metaDataFile = px4 ? kPX4MetaDataFile : kAPMMetaDataFile;
+    const QStringList names = _parameterNames(metaDataFile, px4 ? QStringLiteral("parameter") : QStringLiteral("param"));
+
+    const auto connect = [&]() {
+        if (px4) {
+            PX4ParameterMetaData metaData;
+            metaData.loadParameterFactMetaDataFile(metaDataFile);
+            for (const QString &name : names) {
+                (void) metaData.getMetaDataForFact(name, MAV_TYPE_QUADROTOR, FactMetaData::valueTypeFloat);
+            }
+        } else {
+            APMParameterMetaData metaData;
+            metaData.loadParameterFactMetaDataFile(metaDataFile);
+            for (const QString &name : names) {
+                (void) metaData.getMetaDataForFact(name, MAV_TYPE_QUADROTOR, FactMetaData::valueTypeFloat);
+            }
+        }
+    };
+
+    if (snapshot) {
+        connect();
+    }
+
+    QBENCHMARK {
+        if (!snapshot) {
+            _removeSnapshots();
+        }
+        connect();
+    }
+}
@@ -0,0 +1,40 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class ParameterMetaDataSnapshotTest : public UnitTest
+{
+    Q_OBJECT
+
+protected slots:
+    void init() override;
+    void cleanup() override;
+
+private slots:
+    void _testWriteOpen();
+    void _testStaleSource();
+    void _testCorruptSnapshot();
+    void _testFactMetaDataRecord();
+    void _testAPMSnapshot();
+    void _testPX4Snapshot();
+    void _benchmarkLoad_data();
+    void _benchmarkLoad();
+
+private:
+    /// @return Names of all parameters in the meta data file, this stands in for the parameters a vehicle reports
+    ///     @param elementName Xml element of a parameter
+    static QStringList _parameterNames(const QString &metaDataFile, const QString &elementName);
+    static void _removeSnapshots();
+
+    static constexpr const char *kAPMMetaDataFile = ":/FirmwarePlugin/APM/APMParameterFactMetaData.Copter.4.5.xml";
+    static constexpr const char *kPX4MetaDataFile = ":/FirmwarePlugin/PX4/PX4ParameterFactMetaData.xml";
+};
@@ -0,0 +1,339 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "MAVLinkFrameParserTest.h"
+#include "MAVLinkFrameParser.h"
+#include "LinkManager.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QtEndian>
+#include <QtTest/QTest>
+
+/// Set this environment variable to the path of a recorded .tlog to benchmark against a real capture
+static constexpr const char *kCaptureEnvVar = "QGC_TLOG_BENCHMARK_FILE";
+
+/// Links typically hand over data in chunks of this size
+static constexpr qsizetype kLinkChunkSize = 1024;
+
+void MAVLinkFrameParserTest::init()
+{
+    UnitTest::init();
+
+    _bytewiseChannel = LinkManager::instance()->allocateMavlinkChannel();
+    _bulkChannel = LinkManager::instance()->allocateMavlinkChannel();
+    QVERIFY(_bytewiseChannel != LinkManager::invalidMavlinkChannel());
+    QVERIFY(_bulkChannel != LinkManager::invalidMavlinkChannel());
+}
+
+void MAVLinkFrameParserTest::cleanup()
+{
+    LinkManager::instance()->freeMavlinkChannel(_bulkChannel);
+    LinkManager::instance()->freeMavlinkChannel(_bytewiseChannel);
+
+    UnitTest::cleanup();
+}
+
+QByteArray MAVLinkFrameParserTest::buildCapture(int messageCount)
+{
+    // Packing only touches the sequence number and output version of a channel, but a link may still be using it
+    const uint8_t packV2Channel = LinkManager::instance()->allocateMavlinkChannel();
+    const uint8_t packV1Channel = LinkManager::instance()->allocateMavlinkChannel();
+    if ((packV2Channel == LinkManager::invalidMavlinkChannel()) || (packV1Channel == LinkManager::invalidMavlinkChannel())) {
+        LinkManager::instance()->freeMavlinkChannel(packV1Channel);
+        LinkManager::instance()->freeMavlinkChannel(packV2Channel);
+        return QByteArray();
+    }
+
+    mavlink_status_t *const v1Status = mavlink_get_channel_status(packV1Channel);
+    v1Status->flags |= MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+    mavlink_status_t *const v2Status = mavlink_get_channel_status(packV2Channel);
+    v2Status->flags &= ~MAVLINK_STATUS_FLAG_OUT_MAVLINK1;
+
+    QByteArray capture;
+    quint64 timestamp = 1700000000000000ULL;
+
+    for (int i = 0; i < messageCount; i++) {
+        mavlink_message_t message{};
+        switch (i % 8) {
+        case 0:
+        {
+            const mavlink_heartbeat_t heartbeat{0, MAV_TYPE_QUADROTOR, MAV_AUTOPILOT_PX4, MAV_MODE_FLAG_SAFETY_ARMED, MAV_STATE_ACTIVE, 3};
+            (void) mavlink_msg_heartbeat_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, packV2Channel, &message, &heartbeat);
+            break;
+        }
+        case 1:
+        case 5:
+        {
+            mavlink_attitude_t attitude{};
+            attitude.time_boot_ms = static_cast<uint32_t>(i);
+            attitude.roll = 0.01f * i;
+            attitude.pitch = -0.02f * i;
+            attitude.yaw = 0.5f;
+            (void) mavlink_msg_attitude_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, packV2Channel, &message, &attitude);
+            break;
+        }
+        case 2:
+        {
+            mavlink_global_position_int_t position{};
+            position.time_boot_ms = static_cast<uint32_t>(i);
+            position.lat = 473977420 + i;
+            position.lon = 85455940 - i;
+            position.alt = 488000;
+            (void) mavlink_msg_global_position_int_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, packV2Channel, &message, &position);
+            break;
+        }
+        case 3:
+        {
+            // Mostly empty payload, exercises MAVLink 2 payload truncation
+            mavlink_statustext_t statusText{};
+            statusText.severity = MAV_SEVERITY_INFO;
+            (void) strncpy(statusText.text, "MAVLinkFrameParserTest", sizeof(statusText.text));
+            (void) mavlink_msg_statustext_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, packV2Channel, &message, &statusText);
+            break;
+        }
+        case 4:
+        {
+            const mavlink_heartbeat_t heartbeat{0, MAV_TYPE_GIMBAL, MAV_AUTOPILOT_INVALID, 0, MAV_STATE_ACTIVE, 3};
+            (void) mavlink_msg_heartbeat_encode_chan(2, MAV_COMP_ID_GIMBAL, packV1Channel, &message, &heartbeat);
+            break;
+        }
+        case 6:
+        {
+            mavlink_sys_status_t sysStatus{};
+            sysStatus.voltage_battery = 12600;
+            sysStatus.battery_remaining = 87;
+            (void) mavlink_msg_sys_status_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, packV2Channel, &message, &sysStatus);
+            break;
+        }
+        default:
+        {
+            mavlink_vfr_hud_t vfrHud{};
+            vfrHud.groundspeed = 12.f;
+            vfrHud.throttle = 55;
+            (void) mavlink_msg_vfr_hud_encode_chan(1, MAV_COMP_ID_AUTOPILOT1, packV2Channel, &message, &vfrHud);
+            break;
+        }
+        }
+
+        uint8_t buffer[sizeof(quint64) + MAVLINK_MAX_PACKET_LEN];
+        qToBigEndian(timestamp, buffer);
+        const uint16_t len = mavlink_msg_to_send_buffer(buffer + sizeof(quint64), &message);
+
+        // Every so often corrupt a frame or the message id to exercise resynchronisation
+        if ((i % 97) == 96) {
+            buffer[sizeof(quint64) + len - 1] ^= 0x5A;
+        } else if ((i % 131) == 130) {
+            buffer[sizeof(quint64) + 7] = 0xFF;
+            buffer[sizeof(quint64) + 8] = 0xFF;
+            buffer[sizeof(quint64) + 9] = 0xFF;
+        }
+
+        (void) capture.append(reinterpret_cast<const char*>(buffer), sizeof(quint64) + len);
+        timestamp += 10000;
+    }
+
+    LinkManager::instance()->freeMavlinkChannel(packV1Channel);
+    LinkManager::instance()->freeMavlinkChannel(packV2Channel);
+
+    return capture;
+}
+
+QByteArray MAVLinkFrameParserTest::_loadCapture()
+{
+    const QString captureFile = qEnvironmentVariable(kCaptureEnvVar);
+    if (!captureFile.isEmpty()) {
+        QFile file(captureFile);
+        if (file.open(QIODevice::ReadOnly)) {
+            return file.readAll();
+        }
+        qWarning() << "Unable to open" << captureFile << file.errorString();
+    }
+
+    return buildCapture(20000);
+}
+
+void MAVLinkFrameParserTest::_resetChannel(uint8_t channel)
+{
+    // mavlink_reset_channel_status only resets the parse state, counters must start from zero as well
+    *mavlink_get_channel_status(channel) = mavlink_status_t{};
+}
+
+void MAVLinkFrameParserTest::_compareMessages(const QList<mavlink_message_t> &expected, const QList<mavlink_message_t> &actual)
+{
+    QCOMPARE(actual.size(), expected.size());
+
+    for (qsizetype i = 0; i < expected.size(); i++) {
+        const mavlink_message_t &e = expected[i];
+        const mavlink_message_t &a = actual[i];
+        QCOMPARE(a.magic, e.magic);
+        QCOMPARE(a.len, e.len);
+        QCOMPARE(a.incompat_flags, e.incompat_flags);
+        QCOMPARE(a.compat_flags, e.compat_flags);
+        QCOMPARE(a.seq, e.seq);
+        QCOMPARE(a.sysid, e.sysid);
+        QCOMPARE(a.compid, e.compid);
+        QCOMPARE(a.msgid, e.msgid);
+        QCOMPARE(a.checksum, e.checksum);
+        QCOMPARE(a.ck[0], e.ck[0]);
+        QCOMPARE(a.ck[1], e.ck[1]);
+        QVERIFY(memcmp(_MAV_PAYLOAD(&a), _MAV_PAYLOAD(&e), e.len) == 0);
+    }
+}
+
+void MAVLinkFrameParserTest::_compareStatus(uint8_t expectedChannel, uint8_t actualChannel)
+{
+    const mavlink_status_t *const expected = mavlink_get_channel_status(expectedChannel);
+    const mavlink_status_t *const actual = mavlink_get_channel_status(actualChannel);
+
+    QCOMPARE(actual->parse_state, expected->parse_state);
+    QCOMPARE(actual->packet_rx_success_count, expected->packet_rx_success_count);
+    QCOMPARE(actual->packet_rx_drop_count, expected->packet_rx_drop_count);
+    QCOMPARE(actual->current_rx_seq, expected->current_rx_seq);
+    QCOMPARE(actual->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1, expected->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1);
+}
+
+void MAVLinkFrameParserTest::_testMatchesBytewise()
+{
+    const QByteArray capture = buildCapture(1000);
+    QVERIFY(!capture.isEmpty());
+
+    _resetChannel(_bytewiseChannel);
+    _resetChannel(_bulkChannel);
+
+    QList<mavlink_message_t> expected;
+    QList<mavlink_message_t> actual;
+    (void) MAVLinkFrameParser::parseBytewise(_bytewiseChannel, capture, expected);
+    (void) MAVLinkFrameParser::parse(_bulkChannel, capture, actual);
+
+    QVERIFY(expected.size() > 500);
+    _compareMessages(expected, actual);
+    _compareStatus(_bytewiseChannel, _bulkChannel);
+}
+
+void MAVLinkFrameParserTest::_testSplitFrames()
+{
+    const QByteArray capture = buildCapture(500);
+    QVERIFY(!capture.isEmpty());
+
+    _resetChannel(_bytewiseChannel);
+    QList<mavlink_message_t> expected;
+    (void) MAVLinkFrameParser::parseBytewise(_bytewiseChannel, capture, expected);
+
+    // Frames which straddle buffers must come out the same as frames wholly inside one
+    static constexpr qsizetype rgChunkSizes[] = { 1, 7, 64, 333, kLinkChunkSize };
+    for (const qsizetype chunkSize : rgChunkSizes) {
+        _resetChannel(_bulkChannel);
+
+        QList<mavlink_message_t> actual;
+        for (qsizetype pos = 0; pos < capture.size(); pos += chunkSize) {
+            (void) MAVLinkFrameParser::parse(_bulkChannel, QByteArrayView(capture).sliced(pos, qMin(chunkSize, capture.size() - pos)), actual);
+        }
+
+        _compareMessages(expected, actual);
+        _compareStatus(_bytewiseChannel, _bulkChannel);
+    }
+}
+
+void MAVLinkFrameParserTest::_testFrameBytes()
+{
+    const QByteArray capture = buildCapture(500);
+    QVERIFY(!capture.isEmpty());
+
+    _resetChannel(_bytewiseChannel);
+    QList<mavlink_message_t> expected;
+    (void) MAVLinkFrameParser::parseBytewise(_bytewiseChannel, capture, expected);
+
+    // The test packers already truncate the payload, so re-serializing gives back the wire bytes
+    QByteArray expectedFrames;
+    for (const mavlink_message_t &message : std::as_const(expected)) {
+        uint8_t buffer[MAVLINK_MAX_PACKET_LEN];
+        const uint16_t len = mavlink_msg_to_send_buffer(buffer, &message);
+        QCOMPARE(MAVLinkFrameParser::frameLength(message), static_cast<qsizetype>(len));
+        (void) expectedFrames.append(reinterpret_cast<const char*>(buffer), len);
+    }
+
+    static constexpr qsizetype rgChunkSizes[] = { 1, 7, kLinkChunkSize, 1024 * 1024 };
+    for (const qsizetype chunkSize : rgChunkSizes) {
+        _resetChannel(_bulkChannel);
+
+        QList<mavlink_message_t> actual;
+        QByteArray frames;
+        for (qsizetype pos = 0; pos < capture.size(); pos += chunkSize) {
+            (void) MAVLinkFrameParser::parse(_bulkChannel, QByteArrayView(capture).sliced(pos, qMin(chunkSize, capture.size() - pos)), actual, &frames);
+        }
+
+        _compareMessages(expected, actual);
+        QCOMPARE(frames, expectedFrames);
+    }
+}
+
+void MAVLinkFrameParserTest::_testPrivateState()
+{
+    const QByteArray capture = buildCapture(500);
+    QVERIFY(!capture.isEmpty());
+
+    _resetChannel(_bytewiseChannel);
+    QList<mavlink_message_t> expected;
+    (void) MAVLinkFrameParser::parseBytewise(_bytewiseChannel, capture, expected);
+
+    static constexpr qsizetype rgChunkSizes[] = { 1, 7, kLinkChunkSize };
+    for (const qsizetype chunkSize : rgChunkSizes) {
+        _resetChannel(_bulkChannel);
+
+        MAVLinkFrameParser::ParserState state;
+        QList<mavlink_message_t> actual;
+        for (qsizetype pos = 0; pos < capture.size(); pos += chunkSize) {
+            (void) MAVLinkFrameParser::parse(state, QByteArrayView(capture).sliced(pos, qMin(chunkSize, capture.size() - pos)), actual);
+        }
+
+        _compareMessages(expected, actual);
+
+        const mavlink_status_t *const bytewiseStatus = mavlink_get_channel_status(_bytewiseChannel);
+        QCOMPARE(state.status.packet_rx_success_count, bytewiseStatus->packet_rx_success_count);
+        QCOMPARE(state.status.packet_rx_drop_count, bytewiseStatus->packet_rx_drop_count);
+        QCOMPARE(state.status.flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1, bytewiseStatus->flags & MAVLINK_STATUS_FLAG_IN_MAVLINK1);
+
+        // The channel status is left alone
+        QCOMPARE(mavlink_get_channel_status(_bulkChannel)->packet_rx_success_count, static_cast<uint16_t>(0));
+    }
+}
+
+void MAVLinkFrameParserTest::_benchmarkBytewise()
+{
+    const QByteArray capture = _loadCapture();
+    QList<mavlink_message_t> messages;
+    messages.reserve(capture.size() / MAVLINK_NUM_NON_PAYLOAD_BYTES);
+
+    QBENCHMARK {
+        _resetChannel(_bytewiseChannel);
+        messages.clear();
+        for (qsizetype pos = 0; pos < capture.size(); pos += kLinkChunkSize) {
+            (void) MAVLinkFrameParser::parseBytewise(_bytewiseChannel, QByteArrayView(capture).sliced(pos, qMin(kLinkChunkSize, capture.size() - pos)), messages);
+        }
+    }
+
+    QVERIFY(!messages.isEmpty());
+}
+
+void MAVLinkFrameParserTest::_benchmarkBulk()
+{
+    const QByteArray capture = _loadCapture();
+    QList<mavlink_message_t> messages;
+    messages.reserve(capture.size() / MAVLINK_NUM_NON_PAYLOAD_BYTES);
+
+    QBENCHMARK {
+        _resetChannel(_bulkChannel);
+        messages.clear();
+        for (qsizetype pos = 0; pos < capture.size(); pos += kLinkChunkSize) {
+            (void) MAVLinkFrameParser::parse(_bulkChannel, QByteArrayView(capture).sliced(pos, qMin(kLinkChunkSize, capture.size() - pos)), messages);
+        }
+    }
+
+    QVERIFY(!messages.isEmpty());
+}
@@ -0,0 +1,44 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class MAVLinkFrameParserTest : public UnitTest
+{
+    Q_OBJECT
+
+public:
+    MAVLinkFrameParserTest() = default;
+
+    /// Builds a synthetic telemetry capture in tlog format (8 byte timestamp followed by the frame)
+    static QByteArray buildCapture(int messageCount);
+
+private slots:
+    void init() final;
+    void cleanup() final;
+
+    void _testMatchesBytewise();
+    void _testSplitFrames();
+    void _testFrameBytes();
+    void _testPrivateState();
+    void _benchmarkBytewise();
+    void _benchmarkBulk();
+
+private:
+    static QByteArray _loadCapture();
+    static void _resetChannel(uint8_t channel);
+    static void _compareMessages(const QList<mavlink_message_t> &expected, const QList<mavlink_message_t> &actual);
+    static void _compareStatus(uint8_t expectedChannel, uint8_t actualChannel);
+
+    /// Reserved through LinkManager in init() and released in cleanup() so no link shares their parse state
+    uint8_t _bytewiseChannel = 0;
+    uint8_t _bulkChannel = 0;
+};
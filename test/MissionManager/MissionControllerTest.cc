@@ -17,7 +17,9 @@
 #include "AppSettings.h"
 #include "PlanViewSettings.h"
 #include "MultiSignalSpy.h"
+#include "QmlObjectListModel.h"
 
+#include <QtTest/QSignalSpy>
 #include <QtTest/QTest>
 
 MissionControllerTest::MissionControllerTest(void)
@@ -291,3 +293,80 @@ void MissionControllerTest::_testGlobalAltMode(void)
         }
     }
 }
+
+/// Adds waypoints heading due east, each wpDistance from the previous one
+void MissionControllerTest::_addStraightMission(int cMissionItems, double wpDistance)
+{
+    QGeoCoordinate currentCoord(47.633550640000003, -122.08982199);
+    for (int i=1; i<=cMissionItems; i++) {
+        _missionController->insertSimpleMissionItem(currentCoord, i);
+        currentCoord = currentCoord.atDistanceAndAzimuth(wpDistance, 90);
+    }
+}
+
+void MissionControllerTest::_testIncrementalFlightStatusRecalc(void)
+{
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+
+    const int       cMissionItems = 20;
+    const double    wpDistance =    100;
+    _addStraightMission(cMissionItems, wpDistance);
+    QTest::qWait(100); // Recalcs in MissionController are queued to remove dups. Allow return to main message loop.
+
+    QmlObjectListModel* visualItems = _missionController->visualItems();
+    QVERIFY(qAbs(_missionController->missionTotalDistance() - ((cMissionItems - 1) * wpDistance)) < 1);
+
+    // Moving an item only updates the items from there on, and the totals are signalled once
+    VisualMissionItem* earlyItem = visualItems->value<VisualMissionItem*>(5);
+    VisualMissionItem* movedItem = visualItems->value<VisualMissionItem*>(15);
+    QSignalSpy earlyItemSpy(earlyItem, &VisualMissionItem::distanceFromStartChanged);
+    QSignalSpy plannedDistanceSpy(_missionController, &MissionController::missionPlannedDistanceChanged);
+    movedItem->setCoordinate(movedItem->coordinate().atDistanceAndAzimuth(wpDistance, 0));
+    QTest::qWait(100);
+    QCOMPARE(earlyItemSpy.count(), 0);
+    QCOMPARE(plannedDistanceSpy.count(), 1);
+
+    // Cumulative values must still match a walk over the whole mission
+    double distanceFromStart = 0;
+    for (int i=1; i<visualItems->count(); i++) {
+        VisualMissionItem* item = visualItems->value<VisualMissionItem*>(i);
+        distanceFromStart += item->distance();
+        QVERIFY(qAbs(item->distanceFromStart() - distanceFromStart) < 0.01);
+    }
+    QVERIFY(qAbs(_missionController->missionTotalDistance() - distanceFromStart) < 0.01);
+    QVERIFY(distanceFromStart > ((cMissionItems - 1) * wpDistance) + 50);
+
+    // Moving it back restores the original totals
+    movedItem->setCoordinate(movedItem->coordinate().atDistanceAndAzimuth(wpDistance, 180));
+    QTest::qWait(100);
+    QVERIFY(qAbs(_missionController->missionTotalDistance() - ((cMissionItems - 1) * wpDistance)) < 1);
+}
+
+void MissionControllerTest::_benchmarkFlightStatusRecalc_data(void)
+{
+    QTest::addColumn<bool>("editLastItem");
+
+    QTest::newRow("first item") << false;
+    QTest::newRow("last item")  << true;
+}
+
+void MissionControllerTest::_benchmarkFlightStatusRecalc(void)
+{
+    QFETCH(bool, editLastItem);
+
+    _initForFirmwareType(MAV_AUTOPILOT_PX4);
+
+    // Large missions are typically imported from corridor/survey plans
+    _addStraightMission(1000, 50);
+    QTest::qWait(100);
+
+    QmlObjectListModel* visualItems = _missionController->visualItems();
+    VisualMissionItem* item = visualItems->value<VisualMissionItem*>(editLastItem ? visualItems->count() - 1 : 1);
+    double azimuth = 0;
+    QBENCHMARK {
+        item->setCoordinate(item->coordinate().atDistanceAndAzimuth(10, azimuth));
+        azimuth += 90;
+        QCoreApplication::processEvents();
+    }
+}
+
@@ -32,6 +32,9 @@ private slots:
     void _testGlobalAltMode             (void);
     void _testGimbalRecalc              (void);
     void _testVehicleYawRecalc          (void);
+    void _testIncrementalFlightStatusRecalc(void);
+    void _benchmarkFlightStatusRecalc_data(void);
+    void _benchmarkFlightStatusRecalc   (void);
 
 private:
 #if 0
@@ -47,6 +50,7 @@ private slots:
     void _testOfflineToOnlineWorker(MAV_AUTOPILOT firmwareType);
 #endif
     void _setupVisualItemSignals(VisualMissionItem* visualItem);
+    void _addStraightMission(int cMissionItems, double wpDistance);
 
     // MissiomItems signals
 
@@ -0,0 +1,202 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "SurveyTransectGeneratorTest.h"
+#include "SurveyTransectGenerator.h"
+#include "SurveyComplexItem.h"
+#include "CameraCalc.h"
+#include "MissionItem.h"
+
+#include <QtTest/QTest>
+
+QList<QGeoCoordinate> SurveyTransectGeneratorTest::_squarePolygon(double edgeDistance)
+{
+    QList<QGeoCoordinate> vertices;
+
+    vertices.append(QGeoCoordinate(47.633550640000003, -122.08982199));
+    vertices.append(vertices[0].atDistanceAndAzimuth(edgeDistance, 90));
+    vertices.append(vertices[1].atDistanceAndAzimuth(edgeDistance, 180));
+    vertices.append(vertices[2].atDistanceAndAzimuth(edgeDistance, -90.0));
+
+    return vertices;
+}
+
+void SurveyTransectGeneratorTest::_testSquareTransects(void)
+{
+    SurveyTransectGenerator::Params params;
+    params.polygon =        _squarePolygon(100);
+    params.gridSpacing =    49;
+
+    // North/south transects 49m apart, spanning the full height of the square
+    SurveyTransectGenerator::Transects transects = SurveyTransectGenerator::generate(params);
+    QCOMPARE(transects.count(), qsizetype(2));
+    for (const QList<TransectStyleComplexItem::CoordInfo_t>& transect : transects) {
+        QCOMPARE(transect.count(), qsizetype(2));
+        QCOMPARE(transect[0].coordType, TransectStyleComplexItem::CoordTypeSurveyEntry);
+        QCOMPARE(transect[1].coordType, TransectStyleComplexItem::CoordTypeSurveyExit);
+        QVERIFY(qAbs(transect[0].coord.distanceTo(transect[1].coord) - 100) < 1);
+    }
+
+    // Lawnmower pattern: the second transect flies back the other way
+    QVERIFY(qAbs(transects[0][0].coord.azimuthTo(transects[0][1].coord) - transects[1][0].coord.azimuthTo(transects[1][1].coord)) > 170);
+
+    // Entry from the bottom right flips both the transect order and the points within them
+    SurveyTransectGenerator::Params reversedParams = params;
+    reversedParams.reverseTransectPoints = true;
+    reversedParams.reverseTransectOrder = true;
+    const SurveyTransectGenerator::Transects reversed = SurveyTransectGenerator::generate(reversedParams);
+    QCOMPARE(reversed.count(), qsizetype(2));
+    QVERIFY(reversed[0][0].coord.distanceTo(transects[1][0].coord) < 0.01);
+
+    params.refly90Degrees = true;
+    params.turnaroundDistance = 10;
+    params.hoverAndCapture = true;
+    params.triggerDistance = 25;
+    transects = SurveyTransectGenerator::generate(params);
+    QCOMPARE(transects.count(), qsizetype(4));
+    for (const QList<TransectStyleComplexItem::CoordInfo_t>& transect : transects) {
+        // Turnaround, entry, 3 or 4 hover points, exit, turnaround
+        QVERIFY(transect.count() >= 7);
+        QCOMPARE(transect.first().coordType, TransectStyleComplexItem::CoordTypeTurnaround);
+        QCOMPARE(transect.last().coordType, TransectStyleComplexItem::CoordTypeTurnaround);
+        QVERIFY(qIsNaN(transect.first().coord.altitude()));
+        QCOMPARE(transect[2].coordType, TransectStyleComplexItem::CoordTypeInteriorHoverTrigger);
+    }
+}
+
+void SurveyTransectGeneratorTest::_testConcavePolygon(void)
+{
+    // U shape opening to the north, the transects across the notch still span the whole polygon
+    const QGeoCoordinate origin(47.633550640000003, -122.08982199);
+    SurveyTransectGenerator::Params params;
+    params.polygon.append(origin);
+    params.polygon.append(params.polygon[0].atDistanceAndAzimuth(300, 90));
+    params.polygon.append(params.polygon[1].atDistanceAndAzimuth(300, 0));
+    params.polygon.append(params.polygon[2].atDistanceAndAzimuth(100, -90));
+    params.polygon.append(params.polygon[3].atDistanceAndAzimuth(280, 180));
+    params.polygon.append(params.polygon[4].atDistanceAndAzimuth(100, -90));
+    params.polygon.append(params.polygon[5].atDistanceAndAzimuth(280, 0));
+    params.polygon.append(params.polygon[6].atDistanceAndAzimuth(100, -90));
+    params.gridAngle = 90;
+    params.gridSpacing = 45;
+
+    const SurveyTransectGenerator::Transects transects = SurveyTransectGenerator::generate(params);
+    QCOMPARE(transects.count(), qsizetype(6));
+    for (const QList<TransectStyleComplexItem::CoordInfo_t>& transect : transects) {
+        QCOMPARE(transect.count(), qsizetype(2));
+        QVERIFY(qAbs(transect[0].coord.distanceTo(transect[1].coord) - 300) < 1);
+    }
+
+    // Every grid angle finds transects through the polygon
+    for (int gridAngle=-180; gridAngle<=180; gridAngle+=15) {
+        params.gridAngle = gridAngle;
+        QVERIFY(SurveyTransectGenerator::generate(params).count() > 1);
+    }
+}
+
+void SurveyTransectGeneratorTest::_testCancel(void)
+{
+    SurveyTransectGenerator::Params params;
+    params.polygon = _squarePolygon(1000);
+    params.gridSpacing = 10;
+
+    std::atomic_bool cancel(false);
+    QVERIFY(SurveyTransectGenerator::generate(params, &cancel).count() > 0);
+
+    cancel = true;
+    QVERIFY(SurveyTransectGenerator::generate(params, &cancel).isEmpty());
+}
+
+void SurveyTransectGeneratorTest::_testEstimateCost(void)
+{
+    SurveyTransectGenerator::Params params;
+    QCOMPARE(SurveyTransectGenerator::estimateCost(params), qint64(0));
+
+    params.polygon = _squarePolygon(100);
+    params.gridSpacing = 49;
+    const qint64 cost = SurveyTransectGenerator::estimateCost(params);
+    QVERIFY(cost > 0);
+    QVERIFY(cost < SurveyComplexItem::backgroundTransectsCost);
+
+    params.refly90Degrees = true;
+    QCOMPARE(SurveyTransectGenerator::estimateCost(params), cost * 2);
+    params.refly90Degrees = false;
+
+    params.hoverAndCapture = true;
+    params.triggerDistance = 1;
+    QVERIFY(SurveyTransectGenerator::estimateCost(params) > cost);
+
+    params.polygon = _squarePolygon(1000);
+    QVERIFY(SurveyTransectGenerator::estimateCost(params) >= SurveyComplexItem::backgroundTransectsCost);
+}
+
+void SurveyTransectGeneratorTest::_testBackgroundRebuild(void)
+{
+    SurveyComplexItem* surveyItem = new SurveyComplexItem(_masterController, false /* flyView */, QString() /* kmlFile */);
+    surveyItem->cameraCalc()->adjustedFootprintSide()->setRawValue(25);
+    surveyItem->cameraCalc()->adjustedFootprintFrontal()->setRawValue(2);
+    surveyItem->hoverAndCapture()->setRawValue(true);
+    surveyItem->gridAngle()->setRawValue(0);
+
+    SurveyTransectGenerator::Params params;
+    params.polygon =            _squarePolygon(1000);
+    params.gridSpacing =        25;
+    params.hoverAndCapture =    true;
+    params.triggerDistance =    2;
+    params.turnaroundDistance = qMax(0.0, surveyItem->turnAroundDistance()->rawValue().toDouble());
+    QVERIFY(SurveyTransectGenerator::estimateCost(params) >= SurveyComplexItem::backgroundTransectsCost);
+
+    // Setting the polygon starts a background rebuild, the grid angle change supersedes it
+    surveyItem->surveyAreaPolygon()->appendVertices(params.polygon);
+    QVERIFY(surveyItem->transectsPending());
+    surveyItem->gridAngle()->setRawValue(45);
+    QVERIFY(surveyItem->transectsPending());
+
+    params.gridAngle = 45;
+    const qsizetype expectedCount = SurveyTransectGenerator::generate(params).count();
+    QTRY_VERIFY(!surveyItem->transectsPending());
+    QCOMPARE(qsizetype(surveyItem->_transectCount()), expectedCount);
+    QVERIFY(!surveyItem->visualTransectPoints().isEmpty());
+
+    // Mission items are built from the latest transects even while a rebuild is still in progress
+    surveyItem->gridAngle()->setRawValue(90);
+    QVERIFY(surveyItem->transectsPending());
+    QList<MissionItem*> items;
+    surveyItem->appendMissionItems(items, this);
+    QVERIFY(!surveyItem->transectsPending());
+    QVERIFY(!items.isEmpty());
+
+    params.gridAngle = 90;
+    QCOMPARE(qsizetype(surveyItem->_transectCount()), SurveyTransectGenerator::generate(params).count());
+
+    // Small surveys are still rebuilt in place
+    surveyItem->cameraCalc()->adjustedFootprintFrontal()->setRawValue(500);
+    QVERIFY(!surveyItem->transectsPending());
+}
+
+void SurveyTransectGeneratorTest::_benchmarkGenerate(void)
+{
+    // Star shaped polygon with 400 vertices, so most transects cross many edges
+    const QGeoCoordinate center(47.633550640000003, -122.08982199);
+    const int cVertices = 400;
+    SurveyTransectGenerator::Params params;
+    for (int i=0; i<cVertices; i++) {
+        params.polygon.append(center.atDistanceAndAzimuth((i & 1) ? 1500 : 2000, (360.0 * i) / cVertices));
+    }
+    params.gridAngle = 30;
+    params.gridSpacing = 5;
+    params.refly90Degrees = true;
+    params.turnaroundDistance = 10;
+
+    SurveyTransectGenerator::Transects transects;
+    QBENCHMARK {
+        transects = SurveyTransectGenerator::generate(params);
+    }
+    QVERIFY(transects.count() > 1000);
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "TransectStyleComplexItemTestBase.h"
+
+#include <QtPositioning/QGeoCoordinate>
+
+/// Unit test for SurveyTransectGenerator and the background transect rebuild of SurveyComplexItem
+class SurveyTransectGeneratorTest : public TransectStyleComplexItemTestBase
+{
+    Q_OBJECT
+
+private slots:
+    void _testSquareTransects(void);
+    void _testConcavePolygon(void);
+    void _testCancel(void);
+    void _testEstimateCost(void);
+    void _testBackgroundRebuild(void);
+    void _benchmarkGenerate(void);
+
+private:
+    QList<QGeoCoordinate> _squarePolygon(double edgeDistance);
+};
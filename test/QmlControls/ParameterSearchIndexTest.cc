@@ -0,0 +1,243 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "ParameterSearchIndexTest.h"
+#include "ParameterSearchIndex.h"
+#include "Fact.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QRegularExpression>
+#include <QtTest/QTest>
+
+#include <algorithm>
+
+Fact *ParameterSearchIndexTest::_createFact(const QString &name, const QString &shortDescription, const QString &longDescription)
+{
+    Fact *const fact = new Fact(1, name, FactMetaData::valueTypeFloat, this);
+    FactMetaData *const metaData = new FactMetaData(FactMetaData::valueTypeFloat, fact);
+    metaData->setShortDescription(shortDescription);
+    metaData->setLongDescription(longDescription);
+    fact->setMetaData(metaData);
+    return fact;
+}
+
+QList<Fact*> ParameterSearchIndexTest::_createFacts()
+{
+    return {
+        _createFact(QStringLiteral("ARMING_CHECK"), QStringLiteral("Arm Checks to Perform (bitmask)"), QStringLiteral("Checks prior to arming motor.\nThis is a bitmask of checks.")),
+        _createFact(QStringLiteral("ATC_RAT_PIT_P"), QStringLiteral("Pitch axis rate controller P gain"), QStringLiteral("Pitch axis rate controller P gain. Converts the difference between desired pitch rate and actual pitch rate into a motor speed output")),
+        _createFact(QStringLiteral("ATC_RAT_RLL_P"), QStringLiteral("Roll axis rate controller P gain"), QStringLiteral("Roll axis rate controller P gain. Converts the difference between desired roll rate and actual roll rate into a motor speed output")),
+        _createFact(QStringLiteral("BATT_CAPACITY"), QStringLiteral("Battery capacity"), QStringLiteral("Capacity of the battery in mAh when full")),
+        _createFact(QStringLiteral("RC1_MIN"), QStringLiteral("RC min PWM"), QStringLiteral("RC minimum PWM pulse width in microseconds. Typically 1000 is lower limit, 1500 is neutral and 2000 is upper limit.")),
+        _createFact(QStringLiteral("WPNAV_SPEED"), QStringLiteral("Waypoint Horizontal Speed Target"), QStringLiteral("Defines the speed in cm/s which the aircraft will attempt to maintain horizontally during a WP mission")),
+    };
+}
+
+QList<Fact*> ParameterSearchIndexTest::_createLargeFactSet(int count)
+{
+    static const QStringList words = {
+        QStringLiteral("roll"), QStringLiteral("pitch"), QStringLiteral("yaw"), QStringLiteral("rate"), QStringLiteral("controller"),
+        QStringLiteral("gain"), QStringLiteral("maximum"), QStringLiteral("minimum"), QStringLiteral("altitude"), QStringLiteral("speed"),
+        QStringLiteral("battery"), QStringLiteral("voltage"), QStringLiteral("failsafe"), QStringLiteral("enable"), QStringLiteral("the"),
+        QStringLiteral("of"), QStringLiteral("and"), QStringLiteral("in"), QStringLiteral("output"), QStringLiteral("filter"),
+        QStringLiteral("frequency"), QStringLiteral("servo"), QStringLiteral("channel"), QStringLiteral("compass"), QStringLiteral("offset"),
+        QStringLiteral("throttle"), QStringLiteral("mission"), QStringLiteral("waypoint"), QStringLiteral("radius"), QStringLiteral("(cm/s)"),
+    };
+    static const QStringList groups = {
+        QStringLiteral("ATC"), QStringLiteral("BATT"), QStringLiteral("COMPASS"), QStringLiteral("FS"), QStringLiteral("INS"),
+        QStringLiteral("PSC"), QStringLiteral("RC"), QStringLiteral("SERVO"), QStringLiteral("WPNAV"), QStringLiteral("EK3"),
+    };
+
+    QRandomGenerator random(42);
+    const auto sentence = [&](int wordCount) {
+        QStringList sentenceWords;
+        for (int i = 0; i < wordCount; i++) {
+            sentenceWords.append(words[random.bounded(static_cast<int>(words.count()))]);
+        }
+        return sentenceWords.join(' ');
+    };
+
+    QList<Fact*> facts;
+    for (int i = 0; i < count; i++) {
+        const QString name = QStringLiteral("%1_%2%3").arg(groups[i % groups.count()], words[random.bounded(static_cast<int>(words.count() - 1))].toUpper()).arg(i);
+        facts.append(_createFact(name, sentence(5), sentence(40)));
+    }
+
+    return facts;
+}
+
+QList<Fact*> ParameterSearchIndexTest::_linearSearch(const QList<Fact*> &facts, const QStringList &terms)
+{
+    QList<Fact*> sortedFacts = facts;
+    std::sort(sortedFacts.begin(), sortedFacts.end(), [](const Fact *fact1, const Fact *fact2) { return (fact1->name() < fact2->name()); });
+
+    QList<Fact*> matches;
+    for (Fact *const fact : sortedFacts) {
+        bool matched = true;
+        for (const QString &term : terms) {
+            const QRegularExpression re(term, QRegularExpression::CaseInsensitiveOption);
+            if (re.isValid()) {
+                if (!fact->name().contains(re) && !fact->shortDescription().contains(re) && !fact->longDescription().contains(re)) {
+                    matched = false;
+                }
+            } else if (!fact->name().contains(term, Qt::CaseInsensitive) &&
+                       !fact->shortDescription().contains(term, Qt::CaseInsensitive) &&
+                       !fact->longDescription().contains(term, Qt::CaseInsensitive)) {
+                matched = false;
+            }
+        }
+        if (matched) {
+            matches.append(fact);
+        }
+    }
+
+    return matches;
+}
+
+void ParameterSearchIndexTest::_testLiteralSearch()
+{
+    const QList<Fact*> facts = _createFacts();
+
+    ParameterSearchIndex index;
+    for (Fact *const fact : facts) {
+        index.addFact(fact);
+    }
+    QCOMPARE(index.count(), facts.count());
+
+    QCOMPARE(index.search(QStringList()), facts);
+    QCOMPARE(index.search({ QStringLiteral("rll") }), QList<Fact*>({ facts[2] }));
+    QCOMPARE(index.search({ QStringLiteral("CAPACITY") }), QList<Fact*>({ facts[3] }));
+
+    const QList<QStringList> queries = {
+        { QStringLiteral("rate") },
+        { QStringLiteral("roll"), QStringLiteral("gain") },
+        { QStringLiteral("r") },
+        { QStringLiteral("_p") },
+        { QStringLiteral("pwm") },
+        { QStringLiteral("mah") },
+        { QStringLiteral("1500") },
+        { QStringLiteral("xyz") },
+        { QStringLiteral("bitmask") },
+        { QStringLiteral("motor"), QStringLiteral("speed") },
+    };
+    for (const QStringList &terms : queries) {
+        QVERIFY2(index.search(terms) == _linearSearch(facts, terms), qPrintable(terms.join(' ')));
+    }
+}
+
+void ParameterSearchIndexTest::_testRegexSearch()
+{
+    const QList<Fact*> facts = _createFacts();
+
+    ParameterSearchIndex index;
+    for (Fact *const fact : facts) {
+        index.addFact(fact);
+    }
+
+    QCOMPARE(index.search({ QStringLiteral("^ATC") }), QList<Fact*>({ facts[1], facts[2] }));
+
+    const QList<QStringList> queries = {
+        { QStringLiteral("rll|arm") },
+        { QStringLiteral("gain$") },
+        { QStringLiteral("(bitmask)") },
+        { QStringLiteral("(") },                        // Invalid expression is matched as text
+        { QStringLiteral("cm/s") },
+        { QStringLiteral("rate"), QStringLiteral("p.t") },
+        { QStringLiteral("checks\\.") },
+    };
+    for (const QStringList &terms : queries) {
+        QVERIFY2(index.search(terms) == _linearSearch(facts, terms), qPrintable(terms.join(' ')));
+    }
+}
+
+void ParameterSearchIndexTest::_testNarrowingSearch()
+{
+    const QList<Fact*> facts = _createLargeFactSet(500);
+
+    ParameterSearchIndex index;
+    for (Fact *const fact : facts) {
+        index.addFact(fact);
+    }
+
+    // Typing, deleting and retyping must give the same results as a full search every time
+    const QStringList queries = {
+        QStringLiteral("r"), QStringLiteral("ro"), QStringLiteral("rol"), QStringLiteral("roll"), QStringLiteral("roll "),
+        QStringLiteral("roll g"), QStringLiteral("roll ga"), QStringLiteral("roll gain"), QStringLiteral("roll gai"),
+        QStringLiteral("roll"), QStringLiteral("roll ra.e"), QStringLiteral("roll ra.e o"), QStringLiteral("oll"),
+        QStringLiteral("atc_"), QStringLiteral("atc_roll"), QStringLiteral(""), QStringLiteral("throttle"),
+    };
+    for (const QString &query : queries) {
+        const QStringList terms = query.split(' ', Qt::SkipEmptyParts);
+        QVERIFY2(index.search(terms) == _linearSearch(facts, terms), qPrintable(query));
+    }
+}
+
+void ParameterSearchIndexTest::_testFactAdded()
+{
+    QList<Fact*> facts = _createFacts();
+
+    ParameterSearchIndex index;
+    for (Fact *const fact : facts) {
+        index.addFact(fact);
+    }
+
+    const QStringList terms = { QStringLiteral("rate") };
+    QCOMPARE(index.search(terms).count(), 2);
+
+    // Added out of name order, results must still be sorted
+    Fact *const addedFact = _createFact(QStringLiteral("ACRO_RP_RATE"), QStringLiteral("Acro Roll and Pitch Rate"), QString());
+    facts.append(addedFact);
+    index.addFact(addedFact);
+
+    const QList<Fact*> matches = index.search(terms);
+    QCOMPARE(matches.count(), 3);
+    QCOMPARE(matches.first(), addedFact);
+    QCOMPARE(matches, _linearSearch(facts, terms));
+
+    index.clear();
+    QCOMPARE(index.count(), 0);
+    QVERIFY(index.search(terms).isEmpty());
+}
+
+void ParameterSearchIndexTest::_benchmarkSearch_data()
+{
+    QTest::addColumn<bool>("indexed");
+
+    QTest::newRow("linear") << false;
+    QTest::newRow("indexed") << true;
+}
+
+void ParameterSearchIndexTest::_benchmarkSearch()
+{
+    QFETCH(bool, indexed);
+
+    const QList<Fact*> facts = _createLargeFactSet(1500);
+
+    ParameterSearchIndex index;
+    for (Fact *const fact : facts) {
+        index.addFact(fact);
+    }
+
+    // One search per keystroke
+    const QString query = QStringLiteral("roll rate gain");
+    QList<QStringList> keystrokes;
+    for (qsizetype i = 1; i <= query.size(); i++) {
+        keystrokes.append(query.left(i).split(' ', Qt::SkipEmptyParts));
+    }
+
+    QBENCHMARK {
+        for (const QStringList &terms : keystrokes) {
+            if (indexed) {
+                (void) index.search(terms);
+            } else {
+                (void) _linearSearch(facts, terms);
+            }
+        }
+    }
+}
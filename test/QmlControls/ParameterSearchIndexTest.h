@@ -0,0 +1,37 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+class Fact;
+
+class ParameterSearchIndexTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testLiteralSearch();
+    void _testRegexSearch();
+    void _testNarrowingSearch();
+    void _testFactAdded();
+    void _benchmarkSearch_data();
+    void _benchmarkSearch();
+
+private:
+    Fact *_createFact(const QString &name, const QString &shortDescription, const QString &longDescription);
+    QList<Fact*> _createFacts();
+
+    /// ArduPilot sized parameter set with long descriptions
+    QList<Fact*> _createLargeFactSet(int count);
+
+    /// Search the way ParameterEditorController did before it had an index
+    static QList<Fact*> _linearSearch(const QList<Fact*> &facts, const QStringList &terms);
+};
@@ -0,0 +1,299 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "QGCTileCacheWorkerTest.h"
+#include "QGCTileCacheWorker.h"
+#include "QGCTileFetchPool.h"
+#include "QGCMapTasks.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QMutex>
+#include <QtCore/QPointer>
+#include <QtCore/QStringList>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+#include <algorithm>
+
+void QGCTileCacheWorkerTest::init()
+{
+    UnitTest::init();
+
+    _tempDir = new QTemporaryDir();
+    QVERIFY(_tempDir->isValid());
+
+    _startWorker();
+}
+
+void QGCTileCacheWorkerTest::cleanup()
+{
+    _stopWorker();
+
+    delete _tempDir;
+    _tempDir = nullptr;
+
+    UnitTest::cleanup();
+}
+
+QString QGCTileCacheWorkerTest::_databasePath() const
+{
+    return _tempDir->filePath(QStringLiteral("qgcMapCache.db"));
+}
+
+void QGCTileCacheWorkerTest::_startWorker()
+{
+    _worker = new QGCCacheWorker(this);
+    _worker->setDatabaseFile(_databasePath());
+
+    // Wired up the same way as in QGCMapEngine
+    _fetchPool = new QGCTileFetchPool(this);
+    _fetchPool->setDatabaseFile(_databasePath());
+    (void) connect(_worker, &QGCCacheWorker::databaseAboutToBeReplaced, _fetchPool, &QGCTileFetchPool::suspend, Qt::DirectConnection);
+    (void) connect(_worker, &QGCCacheWorker::databaseReplaced, _fetchPool, &QGCTileFetchPool::reopenDatabase, Qt::DirectConnection);
+
+    // The worker only takes other tasks once the database is up, which is signalled by the first totals update
+    QObject context;
+    bool initialized = false;
+    (void) connect(_worker, &QGCCacheWorker::updateTotals, &context, [&initialized]() { initialized = true; }, Qt::QueuedConnection);
+    QVERIFY(_worker->enqueueTask(new QGCMapTask(QGCMapTask::taskInit)));
+    QTRY_VERIFY_WITH_TIMEOUT(initialized, 5000);
+}
+
+void QGCTileCacheWorkerTest::_stopWorker()
+{
+    delete _fetchPool;
+    _fetchPool = nullptr;
+
+    if (_worker) {
+        _worker->stop();
+        QVERIFY(_worker->wait(5000));
+        delete _worker;
+        _worker = nullptr;
+    }
+}
+
+QByteArray QGCTileCacheWorkerTest::_tileImage(int index, qsizetype size)
+{
+    QByteArray img(size, static_cast<char>(index));
+    img.prepend(QByteArray::number(index));
+    return img;
+}
+
+void QGCTileCacheWorkerTest::_saveTile(const QString &hash, const QByteArray &img)
+{
+    QGCCacheTile* const tile = new QGCCacheTile(hash, img, QStringLiteral("png"), QStringLiteral("Test"));
+    QVERIFY(_worker->enqueueTask(new QGCSaveTileTask(tile)));
+}
+
+QByteArray QGCTileCacheWorkerTest::_fetchTile(const QString &hash, bool fromPool)
+{
+    // Connections die with the context should the wait time out
+    QObject context;
+    bool done = false;
+    QByteArray img;
+
+    QGCFetchTileTask* const task = new QGCFetchTileTask(hash);
+    (void) connect(task, &QGCFetchTileTask::tileFetched, &context, [&done, &img](QGCCacheTile *tile) {
+        img = tile->img();
+        delete tile;
+        done = true;
+    }, Qt::QueuedConnection);
+    (void) connect(task, &QGCMapTask::error, &context, [&done]() { done = true; }, Qt::QueuedConnection);
+
+    if (fromPool) {
+        _fetchPool->enqueueTask(task);
+    } else if (!_worker->enqueueTask(task)) {
+        return QByteArray();
+    }
+
+    // Bulk saves in the benchmark may take a while on slow disks
+    (void) QTest::qWaitFor([&done]() { return done; }, 60000);
+    return img;
+}
+
+void QGCTileCacheWorkerTest::_testSaveAndFetch()
+{
+    for (int i = 0; i < 3; i++) {
+        _saveTile(QStringLiteral("tile-%1").arg(i), _tileImage(i, 1024));
+    }
+
+    for (int i = 0; i < 3; i++) {
+        QCOMPARE(_fetchTile(QStringLiteral("tile-%1").arg(i)), _tileImage(i, 1024));
+    }
+    QVERIFY(_fetchTile(QStringLiteral("tile-missing")).isEmpty());
+}
+
+void QGCTileCacheWorkerTest::_testDuplicateInBatch()
+{
+    // Queued back to back these end up in the same transaction, the duplicate must not take the others down with it
+    _saveTile(QStringLiteral("tile-0"), _tileImage(0, 1024));
+    _saveTile(QStringLiteral("tile-0"), _tileImage(1, 1024));
+    _saveTile(QStringLiteral("tile-1"), _tileImage(2, 1024));
+
+    QCOMPARE(_fetchTile(QStringLiteral("tile-0")), _tileImage(0, 1024));
+    QCOMPARE(_fetchTile(QStringLiteral("tile-1")), _tileImage(2, 1024));
+}
+
+void QGCTileCacheWorkerTest::_testFetchPool()
+{
+    for (int i = 0; i < 20; i++) {
+        _saveTile(QStringLiteral("tile-%1").arg(i), _tileImage(i, 1024));
+    }
+    QVERIFY(!_fetchTile(QStringLiteral("tile-19")).isEmpty());
+
+    for (int i = 0; i < 20; i++) {
+        QCOMPARE(_fetchTileFromPool(QStringLiteral("tile-%1").arg(i)), _tileImage(i, 1024));
+    }
+    QVERIFY(_fetchTileFromPool(QStringLiteral("tile-missing")).isEmpty());
+}
+
+void QGCTileCacheWorkerTest::_testFetchPoolCanceled()
+{
+    _saveTile(QStringLiteral("tile-0"), _tileImage(0, 1024));
+    QVERIFY(!_fetchTile(QStringLiteral("tile-0")).isEmpty());
+
+    QObject context;
+    bool answered = false;
+    QGCFetchTileTask* const task = new QGCFetchTileTask(QStringLiteral("tile-0"), 10);
+    const QPointer<QGCFetchTileTask> taskPointer(task);
+    (void) connect(task, &QGCFetchTileTask::tileFetched, &context, [&answered](QGCCacheTile *tile) {
+        delete tile;
+        answered = true;
+    }, Qt::QueuedConnection);
+    (void) connect(task, &QGCMapTask::error, &context, [&answered]() { answered = true; }, Qt::QueuedConnection);
+    task->cancel();
+    _fetchPool->enqueueTask(task);
+
+    // Dropped without an answer
+    QTRY_VERIFY_WITH_TIMEOUT(taskPointer.isNull(), 5000);
+    QVERIFY(!answered);
+}
+
+void QGCTileCacheWorkerTest::_testFetchPoolReopen()
+{
+    _saveTile(QStringLiteral("tile-0"), _tileImage(0, 1024));
+    QVERIFY(!_fetchTile(QStringLiteral("tile-0")).isEmpty());
+    QCOMPARE(_fetchTileFromPool(QStringLiteral("tile-0")), _tileImage(0, 1024));
+
+    // The readers have to let go of the old tables
+    QObject context;
+    bool reset = false;
+    QGCResetTask* const task = new QGCResetTask();
+    (void) connect(task, &QGCResetTask::resetCompleted, &context, [&reset]() { reset = true; }, Qt::QueuedConnection);
+    QVERIFY(_worker->enqueueTask(task));
+    QTRY_VERIFY_WITH_TIMEOUT(reset, 5000);
+
+    QVERIFY(_fetchTileFromPool(QStringLiteral("tile-0")).isEmpty());
+    _saveTile(QStringLiteral("tile-0"), _tileImage(1, 1024));
+    QVERIFY(!_fetchTile(QStringLiteral("tile-0")).isEmpty());
+    QCOMPARE(_fetchTileFromPool(QStringLiteral("tile-0")), _tileImage(1, 1024));
+}
+
+void QGCTileCacheWorkerTest::_testImportReplaceDuringFetches()
+{
+    constexpr int fetchCount = 50;
+    const QString tileHash = QStringLiteral("tile-0");
+
+    // Build the database to import, it holds a different image for the same tile
+    _saveTile(tileHash, _tileImage(1, 1024));
+    QVERIFY(!_fetchTile(tileHash).isEmpty());
+    _stopWorker();
+    const QString importPath = _tempDir->filePath(QStringLiteral("import.db"));
+    QVERIFY(QFile::copy(_databasePath(), importPath));
+    // Closing the last connection checkpoints the write ahead log, only the database file itself is left
+    QVERIFY(QFile::remove(_databasePath()));
+    QVERIFY(!QFile::exists(_databasePath() + QStringLiteral("-wal")));
+    _startWorker();
+
+    _saveTile(tileHash, _tileImage(0, 1024));
+    QVERIFY(!_fetchTile(tileHash).isEmpty());
+
+    // Fetch answers come from the reader threads and the replace signals from the worker thread
+    QMutex mutex;
+    QStringList events;
+    QObject context;
+    const auto logEvent = [&mutex, &events](const QString &event) {
+        const QMutexLocker locker(&mutex);
+        events.append(event);
+    };
+    const auto enqueueFetches = [this, &context, &logEvent, &tileHash](const QString &name) {
+        for (int i = 0; i < fetchCount; i++) {
+            QGCFetchTileTask* const task = new QGCFetchTileTask(tileHash);
+            (void) connect(task, &QGCFetchTileTask::tileFetched, &context, [&logEvent, name](QGCCacheTile *tile) {
+                logEvent(QStringLiteral("%1:%2").arg(name, (tile->img() == _tileImage(1, 1024)) ? QStringLiteral("imported") : QStringLiteral("old")));
+                delete tile;
+            }, Qt::DirectConnection);
+            (void) connect(task, &QGCMapTask::error, &context, [&logEvent, name]() {
+                logEvent(QStringLiteral("%1:error").arg(name));
+            }, Qt::DirectConnection);
+            _fetchPool->enqueueTask(task);
+        }
+    };
+
+    // Connected after the fetch pool, so it is already suspended when this runs. Fetches queued now are held until the
+    // imported database is in place.
+    (void) connect(_worker, &QGCCacheWorker::databaseAboutToBeReplaced, &context, [&logEvent, &enqueueFetches]() {
+        logEvent(QStringLiteral("aboutToBeReplaced"));
+        enqueueFetches(QStringLiteral("held"));
+    }, Qt::DirectConnection);
+
+    // Logged before the pool resumes
+    (void) disconnect(_worker, &QGCCacheWorker::databaseReplaced, _fetchPool, &QGCTileFetchPool::reopenDatabase);
+    (void) connect(_worker, &QGCCacheWorker::databaseReplaced, &context, [&logEvent]() {
+        logEvent(QStringLiteral("replaced"));
+    }, Qt::DirectConnection);
+    (void) connect(_worker, &QGCCacheWorker::databaseReplaced, _fetchPool, &QGCTileFetchPool::reopenDatabase, Qt::DirectConnection);
+
+    enqueueFetches(QStringLiteral("inflight"));
+    QVERIFY(_worker->enqueueTask(new QGCImportTileTask(importPath, true)));
+
+    const auto answerCount = [&mutex, &events]() {
+        const QMutexLocker locker(&mutex);
+        return std::count_if(events.cbegin(), events.cend(), [](const QString &event) { return event.contains(QLatin1Char(':')); });
+    };
+    QTRY_COMPARE_WITH_TIMEOUT(answerCount(), 2 * fetchCount, 10000);
+
+    const QMutexLocker locker(&mutex);
+    const qsizetype aboutToBeReplacedIndex = events.indexOf(QStringLiteral("aboutToBeReplaced"));
+    const qsizetype replacedIndex = events.indexOf(QStringLiteral("replaced"));
+    QVERIFY(aboutToBeReplacedIndex >= 0);
+
+    // Nothing is answered while the pool is suspended
+    QCOMPARE(replacedIndex, aboutToBeReplacedIndex + 1);
+
+    // Fetches in flight are answered from whichever database was in place, never with an error. The held ones are
+    // answered once the pool resumes, from the imported database.
+    for (qsizetype i = 0; i < events.size(); i++) {
+        const QString &event = events[i];
+        QVERIFY2(!event.endsWith(QStringLiteral(":error")), qPrintable(event));
+        if (event.startsWith(QStringLiteral("held:"))) {
+            QCOMPARE(event, QStringLiteral("held:imported"));
+        } else if (event.startsWith(QStringLiteral("inflight:"))) {
+            QCOMPARE(event, (i < aboutToBeReplacedIndex) ? QStringLiteral("inflight:old") : QStringLiteral("inflight:imported"));
+        }
+    }
+}
+
+void QGCTileCacheWorkerTest::_benchmarkSaveTiles()
+{
+    constexpr int tileCount = 5000;
+    constexpr qsizetype tileSize = 16 * 1024;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < tileCount; i++) {
+        _saveTile(QStringLiteral("tile-%1").arg(i), _tileImage(i, tileSize));
+    }
+    QCOMPARE(_fetchTile(QStringLiteral("tile-%1").arg(tileCount - 1)), _tileImage(tileCount - 1, tileSize));
+
+    const qint64 elapsed = qMax<qint64>(1, timer.elapsed());
+    qInfo() << "Saved" << tileCount << "tiles in" << elapsed << "msecs," << ((tileCount * 1000) / elapsed) << "tiles per second";
+}
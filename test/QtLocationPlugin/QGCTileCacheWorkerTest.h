@@ -0,0 +1,54 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+class QGCCacheWorker;
+class QGCTileFetchPool;
+class QTemporaryDir;
+
+class QGCTileCacheWorkerTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init() final;
+    void cleanup() final;
+
+    void _testSaveAndFetch();
+    void _testDuplicateInBatch();
+    void _testFetchPool();
+    void _testFetchPoolCanceled();
+    void _testFetchPoolReopen();
+    void _testImportReplaceDuringFetches();
+    void _benchmarkSaveTiles();
+
+private:
+    QString _databasePath() const;
+    /// Starts the worker and the fetch pool on the database, connected as in QGCMapEngine
+    void _startWorker();
+    void _stopWorker();
+    void _saveTile(const QString &hash, const QByteArray &img);
+    /// Fetches the tile through the worker, which also waits for all previously queued saves
+    ///     @return Empty if the tile is not in the database
+    QByteArray _fetchTile(const QString &hash) { return _fetchTile(hash, false); }
+    /// Fetches the tile through the fetch pool, queued saves are not waited for
+    QByteArray _fetchTileFromPool(const QString &hash) { return _fetchTile(hash, true); }
+    QByteArray _fetchTile(const QString &hash, bool fromPool);
+    static QByteArray _tileImage(int index, qsizetype size);
+
+    QTemporaryDir *_tempDir = nullptr;
+    QGCCacheWorker *_worker = nullptr;
+    QGCTileFetchPool *_fetchPool = nullptr;
+};
@@ -0,0 +1,247 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "TerrainTileCacheTest.h"
+#include "TerrainTileCache.h"
+#include "TerrainTile.h"
+#include "TerrainTileTest.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QSet>
+#include <QtCore/QTemporaryDir>
+#include <QtPositioning/QGeoCoordinate>
+#include <QtTest/QTest>
+
+QList<quint64> TerrainTileCacheTest::_sameStripeKeys(int count)
+{
+    const quint16 providerId = TerrainTileCache::providerId(u"Test");
+
+    QList<quint64> keys;
+    for (int x = 0; keys.size() < count; x++) {
+        const quint64 key = TerrainTileCache::tileKey(providerId, x, 0, 1);
+        if ((qHash(key) % TerrainTileCache::kStripeCount) == 0) {
+            keys.append(key);
+        }
+    }
+    return keys;
+}
+
+qint64 TerrainTileCacheTest::_tileBytes()
+{
+    return TerrainTile(TerrainTileTest::buildTile(37, 37)).byteCount();
+}
+
+int TerrainTileCacheTest::_diskFileCount(const QString &path)
+{
+    return QDir(path).entryList(QDir::Files).count();
+}
+
+void TerrainTileCacheTest::_testTileKey()
+{
+    QCOMPARE(TerrainTileCache::providerId(u"Copernicus"), TerrainTileCache::providerId(u"Copernicus"));
+    QVERIFY(TerrainTileCache::providerId(u"Copernicus") != TerrainTileCache::providerId(u"Test"));
+
+    const quint16 providerId = TerrainTileCache::providerId(u"Copernicus");
+    const quint64 key = TerrainTileCache::tileKey(providerId, 18854, 13739, 1);
+    QVERIFY(key != TerrainTileCache::tileKey(providerId, 13739, 18854, 1));
+    QVERIFY(key != TerrainTileCache::tileKey(providerId, 18854, 13739, 2));
+    QVERIFY(key != TerrainTileCache::tileKey(providerId + 1, 18854, 13739, 1));
+}
+
+void TerrainTileCacheTest::_testProviderId()
+{
+    QCOMPARE(TerrainTileCache::providerName(TerrainTileCache::providerId(u"Copernicus")), QStringLiteral("Copernicus"));
+
+    // Far more names than a 16 bit hash could tell apart without collisions
+    QSet<quint16> providerIds;
+    for (int i = 0; i < 1000; i++) {
+        (void) providerIds.insert(TerrainTileCache::providerId(QStringLiteral("Provider %1").arg(i)));
+    }
+    QCOMPARE(providerIds.count(), static_cast<qsizetype>(1000));
+
+    // The disk store is named after the provider, since the ids may differ on the next run
+    const QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    TerrainTileCache cache(TerrainTileCache::kDefaultMemoryBudget, dir.path());
+    QVERIFY(cache.insert(TerrainTileCache::tileKey(TerrainTileCache::providerId(u"Copernicus"), 18854, 13739, 1), TerrainTileTest::buildTile(37, 37)));
+    QVERIFY(cache.insert(TerrainTileCache::tileKey(TerrainTileCache::providerId(u"Test"), 18854, 13739, 1), TerrainTileTest::buildTile(37, 37)));
+    const QStringList files = QDir(dir.path()).entryList(QDir::Files, QDir::Name);
+    QCOMPARE(files.count(), static_cast<qsizetype>(2));
+    QVERIFY(files[0].startsWith(QStringLiteral("Copernicus_")));
+    QVERIFY(files[1].startsWith(QStringLiteral("Test_")));
+}
+
+void TerrainTileCacheTest::_testInvalidTile()
+{
+    const QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    TerrainTileCache cache(TerrainTileCache::kDefaultMemoryBudget, dir.path());
+    QVERIFY(!cache.insert(1, QByteArray(10, 0)));
+    QVERIFY(!cache.tile(1));
+    QVERIFY(!cache.load(1).result());
+    cache.waitForDisk();
+    QCOMPARE(cache.stats().tileCount, 0);
+    QCOMPARE(_diskFileCount(dir.path()), 0);
+}
+
+void TerrainTileCacheTest::_testMemoryLru()
+{
+    const QByteArray data = TerrainTileTest::buildTile(37, 37);
+    const QList<quint64> keys = _sameStripeKeys(4);
+
+    // Each stripe holds three tiles
+    TerrainTileCache cache(TerrainTileCache::kStripeCount * 3 * _tileBytes());
+    for (int i = 0; i < 3; i++) {
+        QVERIFY(cache.insert(keys[i], data));
+    }
+
+    // Touching the oldest tile makes the second one the least recently used
+    QVERIFY(cache.tile(keys[0]));
+    QVERIFY(cache.insert(keys[3], data));
+
+    QVERIFY(cache.tile(keys[0]));
+    QVERIFY(!cache.tile(keys[1]));
+    QVERIFY(cache.tile(keys[2]));
+    QVERIFY(cache.tile(keys[3]));
+
+    const TerrainTileCache::Stats stats = cache.stats();
+    QCOMPARE(stats.hits, Q_UINT64_C(4));
+    QCOMPARE(stats.misses, Q_UINT64_C(1));
+    QCOMPARE(stats.evictions, Q_UINT64_C(1));
+    QCOMPARE(stats.tileCount, 3);
+    QCOMPARE(stats.memoryBytes, 3 * _tileBytes());
+
+    cache.clearMemory();
+    QCOMPARE(cache.stats().tileCount, 0);
+    QCOMPARE(cache.stats().memoryBytes, Q_INT64_C(0));
+    QVERIFY(!cache.tile(keys[0]));
+}
+
+void TerrainTileCacheTest::_testEvictedTileSurvives()
+{
+    const QByteArray data = TerrainTileTest::buildTile(37, 37);
+    const QList<quint64> keys = _sameStripeKeys(2);
+
+    TerrainTileCache cache(TerrainTileCache::kStripeCount * _tileBytes());
+    const std::shared_ptr<const TerrainTile> tile = cache.insert(keys[0], data);
+    QVERIFY(tile);
+    QVERIFY(cache.insert(keys[1], data));
+    QCOMPARE(cache.stats().evictions, Q_UINT64_C(1));
+    QVERIFY(!cache.tile(keys[0]));
+
+    // Whoever still holds the evicted tile can keep using it
+    QVERIFY(tile->isValid());
+    QCOMPARE(tile->minElevation(), 100.0);
+}
+
+void TerrainTileCacheTest::_testDiskPersistence()
+{
+    const QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QByteArray data = TerrainTileTest::buildTile(37, 37);
+    const quint64 key = TerrainTileCache::tileKey(TerrainTileCache::providerId(u"Test"), 18854, 13739, 1);
+
+    {
+        TerrainTileCache cache(TerrainTileCache::kDefaultMemoryBudget, dir.path());
+        QVERIFY(cache.insert(key, data));
+    }
+    QCOMPARE(_diskFileCount(dir.path()), 1);
+
+    // A new cache, as after a restart, loads the tile from disk and then keeps it in memory
+    TerrainTileCache cache(TerrainTileCache::kDefaultMemoryBudget, dir.path());
+    QVERIFY(!cache.tile(key));
+    const std::shared_ptr<const TerrainTile> tile = cache.load(key).result();
+    QVERIFY(tile);
+    QVERIFY(tile->isValid());
+    QCOMPARE(tile->maxElevation(), 100.0 + (10 * 36) + 36);
+    QVERIFY(cache.tile(key));
+
+    const TerrainTileCache::Stats stats = cache.stats();
+    QCOMPARE(stats.diskHits, Q_UINT64_C(1));
+    QCOMPARE(stats.hits, Q_UINT64_C(1));
+    QCOMPARE(stats.misses, Q_UINT64_C(0));
+
+    // A corrupt file counts as a miss and is removed
+    QFile file(QDir(dir.path()).filePath(QDir(dir.path()).entryList(QDir::Files).first()));
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(file.write("garbage"), Q_INT64_C(7));
+    file.close();
+    cache.clearMemory();
+    QVERIFY(!cache.tile(key));
+    QVERIFY(!cache.load(key).result());
+    QCOMPARE(cache.stats().misses, Q_UINT64_C(1));
+    QCOMPARE(_diskFileCount(dir.path()), 0);
+    QCOMPARE(cache.stats().diskBytes, Q_INT64_C(0));
+
+    // So does a tile which was never stored
+    QVERIFY(!cache.load(TerrainTileCache::tileKey(TerrainTileCache::providerId(u"Test"), 1, 1, 1)).result());
+    QCOMPARE(cache.stats().misses, Q_UINT64_C(2));
+}
+
+void TerrainTileCacheTest::_testDiskPrune()
+{
+    const QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QByteArray data = TerrainTileTest::buildTile(37, 37);
+    const qint64 diskBudget = 10 * data.size();
+
+    TerrainTileCache cache(TerrainTileCache::kDefaultMemoryBudget, dir.path(), diskBudget);
+    for (int i = 0; i < 25; i++) {
+        QVERIFY(cache.insert(TerrainTileCache::tileKey(TerrainTileCache::providerId(u"Test"), i, 0, 1), data));
+        cache.waitForDisk();
+        QVERIFY(_diskFileCount(dir.path()) <= 10);
+    }
+
+    const TerrainTileCache::Stats stats = cache.stats();
+    QVERIFY(stats.diskBytes >= 0);
+    QVERIFY(stats.diskBytes <= diskBudget);
+    QCOMPARE(stats.diskBytes, static_cast<qint64>(_diskFileCount(dir.path()) * data.size()));
+
+    // Pruning only touches the disk store
+    QCOMPARE(stats.tileCount, 25);
+
+    // The newest tiles are the ones left
+    QVERIFY(cache.load(TerrainTileCache::tileKey(TerrainTileCache::providerId(u"Test"), 24, 0, 1)).result());
+    QVERIFY(!cache.load(TerrainTileCache::tileKey(TerrainTileCache::providerId(u"Test"), 0, 0, 1)).result());
+
+    // Replacing a tile does not count it twice
+    QVERIFY(cache.insert(TerrainTileCache::tileKey(TerrainTileCache::providerId(u"Test"), 24, 0, 1), data));
+    cache.waitForDisk();
+    QCOMPARE(cache.stats().diskBytes, stats.diskBytes);
+
+    // A new cache indexes what is already on disk
+    TerrainTileCache reopened(TerrainTileCache::kDefaultMemoryBudget, dir.path(), diskBudget);
+    reopened.waitForDisk();
+    QCOMPARE(reopened.stats().diskBytes, stats.diskBytes);
+}
+
+void TerrainTileCacheTest::_benchmarkLookup()
+{
+    const QByteArray data = TerrainTileTest::buildTile(37, 37);
+    const quint16 providerId = TerrainTileCache::providerId(u"Test");
+
+    TerrainTileCache cache;
+    for (int x = 0; x < 32; x++) {
+        for (int y = 0; y < 32; y++) {
+            QVERIFY(cache.insert(TerrainTileCache::tileKey(providerId, x, y, 1), data));
+        }
+    }
+
+    QBENCHMARK {
+        for (int x = 0; x < 32; x++) {
+            for (int y = 0; y < 32; y++) {
+                (void) cache.tile(TerrainTileCache::tileKey(providerId, x, y, 1));
+            }
+        }
+    }
+}
@@ -0,0 +1,35 @@
+/****************************************************************************
+ *
+ * (c) 2009-2020 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtCore/QList>
+
+class TerrainTileCacheTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void _testTileKey();
+    void _testProviderId();
+    void _testInvalidTile();
+    void _testMemoryLru();
+    void _testEvictedTileSurvives();
+    void _testDiskPersistence();
+    void _testDiskPrune();
+    void _benchmarkLookup();
+
+private:
+    /// Keys which all land in the same memory stripe, so their LRU order is fully determined by the test
+    static QList<quint64> _sameStripeKeys(int count);
+    static qint64 _tileBytes();
+    static int _diskFileCount(const QString &path);
+};
@@ -11,3 +11,162 @@
 #include "TerrainTile.h"
 
 #include <QtTest/QTest>
+
+QByteArray TerrainTileTest::buildTile(int gridSizeLat, int gridSizeLon)
+{
+    TerrainTile::TileInfo_t tileInfo{};
+    tileInfo.swLat = _swLat;
+    tileInfo.swLon = _swLon;
+    tileInfo.neLat = _swLat + _tileSize;
+    tileInfo.neLon = _swLon + _tileSize;
+    tileInfo.minElevation = 100;
+    tileInfo.maxElevation = static_cast<int16_t>(100 + (10 * (gridSizeLat - 1)) + (gridSizeLon - 1));
+    tileInfo.avgElevation = (tileInfo.minElevation + tileInfo.maxElevation) / 2.0;
+    tileInfo.gridSizeLat = static_cast<int16_t>(gridSizeLat);
+    tileInfo.gridSizeLon = static_cast<int16_t>(gridSizeLon);
+
+    QByteArray tile(sizeof(tileInfo) + (sizeof(int16_t) * gridSizeLat * gridSizeLon), Qt::Uninitialized);
+    (void) memcpy(tile.data(), &tileInfo, sizeof(tileInfo));
+
+    int16_t *const elevations = reinterpret_cast<int16_t*>(tile.data() + sizeof(tileInfo));
+    for (int row = 0; row < gridSizeLat; row++) {
+        for (int col = 0; col < gridSizeLon; col++) {
+            elevations[(row * gridSizeLon) + col] = static_cast<int16_t>(100 + (10 * row) + col);
+        }
+    }
+
+    return tile;
+}
+
+QList<QGeoCoordinate> TerrainTileTest::_pathCoordinates(int count)
+{
+    QList<QGeoCoordinate> coordinates;
+    coordinates.reserve(count);
+    for (int i = 0; i < count; i++) {
+        const double fraction = (i + 0.5) / count;
+        coordinates.append(QGeoCoordinate(_swLat + (_tileSize * fraction), _swLon + (_tileSize * (1.0 - fraction))));
+    }
+    return coordinates;
+}
+
+void TerrainTileTest::_testInvalidTile()
+{
+    const TerrainTile tooSmall(QByteArray(10, 0));
+    QVERIFY(!tooSmall.isValid());
+
+    QByteArray truncated = buildTile(10, 10);
+    truncated.chop(2);
+    const TerrainTile truncatedTile(truncated);
+    QVERIFY(!truncatedTile.isValid());
+
+    double elevation = 0;
+    truncatedTile.elevations(std::span<const QGeoCoordinate>(), std::span<double>());
+    const QGeoCoordinate coordinate(_swLat, _swLon);
+    truncatedTile.elevations(std::span<const QGeoCoordinate>(&coordinate, 1), std::span<double>(&elevation, 1));
+    QVERIFY(qIsNaN(elevation));
+}
+
+void TerrainTileTest::_testSharesTileData()
+{
+    const QByteArray data = buildTile(37, 37);
+    const TerrainTile tile(data);
+    QVERIFY(tile.isValid());
+
+    // The grid is read straight out of the cached bytes
+    QCOMPARE(reinterpret_cast<const char*>(tile._elevationData), data.constData() + sizeof(TerrainTile::TileInfo_t));
+}
+
+void TerrainTileTest::_testElevation()
+{
+    const TerrainTile tile(buildTile(10, 20));
+    QVERIFY(tile.isValid());
+    QCOMPARE(tile.minElevation(), 100.0);
+
+    const double cellLat = _tileSize / 10;
+    const double cellLon = _tileSize / 20;
+
+    // Anywhere within a cell gives that cell's value
+    QCOMPARE(tile.elevation(QGeoCoordinate(_swLat + (cellLat * 0.1), _swLon + (cellLon * 0.9))), 100.0);
+    QCOMPARE(tile.elevation(QGeoCoordinate(_swLat + (cellLat * 3.5), _swLon + (cellLon * 7.2))), 137.0);
+    QVERIFY(qIsNaN(tile.elevation(QGeoCoordinate(_swLat - cellLat, _swLon))));
+}
+
+void TerrainTileTest::_testElevationsBilinear()
+{
+    const TerrainTile tile(buildTile(10, 20));
+    const double cellLat = _tileSize / 10;
+    const double cellLon = _tileSize / 20;
+
+    const QList<QGeoCoordinate> coordinates = {
+        // Cell centers match elevation()
+        QGeoCoordinate(_swLat + (cellLat * 3.5), _swLon + (cellLon * 7.5)),
+        // Half way between cell centers
+        QGeoCoordinate(_swLat + (cellLat * 4.0), _swLon + (cellLon * 8.0)),
+        QGeoCoordinate(_swLat + (cellLat * 3.75), _swLon + (cellLon * 7.5)),
+        // Edge cells extend to the tile border
+        QGeoCoordinate(_swLat, _swLon),
+        QGeoCoordinate(_swLat + (_tileSize * 0.9999), _swLon + (_tileSize * 0.9999)),
+    };
+    QList<double> elevations(coordinates.size());
+    tile.elevations(std::span<const QGeoCoordinate>(coordinates.constData(), coordinates.size()), std::span<double>(elevations.data(), elevations.size()));
+
+    QCOMPARE(elevations[0], tile.elevation(coordinates[0]));
+    QCOMPARE(elevations[1], 100.0 + (10 * 3.5) + 7.5);
+    QCOMPARE(elevations[2], 100.0 + (10 * 3.25) + 7);
+    QCOMPARE(elevations[3], 100.0);
+    QCOMPARE(elevations[4], 100.0 + (10 * 9) + 19);
+
+    // Batch boundaries make no difference
+    const QList<QGeoCoordinate> path = _pathCoordinates(1000);
+    QList<double> pathElevations(path.size());
+    tile.elevations(std::span<const QGeoCoordinate>(path.constData(), path.size()), std::span<double>(pathElevations.data(), pathElevations.size()));
+    for (qsizetype i = 0; i < path.size(); i++) {
+        double elevation = 0;
+        tile.elevations(std::span<const QGeoCoordinate>(&path[i], 1), std::span<double>(&elevation, 1));
+        QCOMPARE(pathElevations[i], elevation);
+        QVERIFY((elevation >= tile.minElevation()) && (elevation <= tile.maxElevation()));
+    }
+}
+
+void TerrainTileTest::_testElevationsOutside()
+{
+    const TerrainTile tile(buildTile(10, 10));
+
+    const QList<QGeoCoordinate> coordinates = {
+        QGeoCoordinate(_swLat - 0.001, _swLon + 0.005),
+        QGeoCoordinate(_swLat + 0.005, _swLon + 0.005),
+        QGeoCoordinate(_swLat + 0.005, _swLon + _tileSize + 0.001),
+        QGeoCoordinate(),
+    };
+    QList<double> elevations(coordinates.size());
+    tile.elevations(std::span<const QGeoCoordinate>(coordinates.constData(), coordinates.size()), std::span<double>(elevations.data(), elevations.size()));
+
+    QVERIFY(qIsNaN(elevations[0]));
+    QVERIFY(!qIsNaN(elevations[1]));
+    QVERIFY(qIsNaN(elevations[2]));
+    QVERIFY(qIsNaN(elevations[3]));
+}
+
+void TerrainTileTest::_benchmarkElevation()
+{
+    const TerrainTile tile(buildTile(37, 37));
+    const QList<QGeoCoordinate> path = _pathCoordinates(10000);
+    QList<double> elevations(path.size());
+
+    QBENCHMARK {
+        for (qsizetype i = 0; i < path.size(); i++) {
+            elevations[i] = tile.elevation(path[i]);
+        }
+    }
+}
+
+void TerrainTileTest::_benchmarkElevations()
+{
+    const TerrainTile tile(buildTile(37, 37));
+    const QList<QGeoCoordinate> path = _pathCoordinates(10000);
+    QList<double> elevations(path.size());
+
+    QBENCHMARK {
+        tile.elevations(std::span<const QGeoCoordinate>(path.constData(), path.size()), std::span<double>(elevations.data(), elevations.size()));
+    }
+}
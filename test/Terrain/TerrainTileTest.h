@@ -11,9 +11,30 @@
 
 #include "UnitTest.h"
 
+#include <QtPositioning/QGeoCoordinate>
+
 class TerrainTileTest : public UnitTest
 {
     Q_OBJECT
 
+public:
+    /// Builds a serialized tile whose elevations rise 10m per cell to the north and 1m per cell to the east
+    static QByteArray buildTile(int gridSizeLat, int gridSizeLon);
+
 private slots:
+    void _testInvalidTile();
+    void _testSharesTileData();
+    void _testElevation();
+    void _testElevationsBilinear();
+    void _testElevationsOutside();
+    void _benchmarkElevation();
+    void _benchmarkElevations();
+
+private:
+    /// Coordinates along a diagonal path through the tile
+    static QList<QGeoCoordinate> _pathCoordinates(int count);
+
+    static constexpr double _swLat = 47.39;
+    static constexpr double _swLon = 8.54;
+    static constexpr double _tileSize = 0.01;
 };
@@ -13,12 +13,15 @@
 
 // ADSB
 #include "ADSBTest.h"
+#include "ADSBTrafficIndexTest.h"
 
 // AnalyzeView
 #include "ExifParserTest.h"
 // #include "GeoTagControllerTest.h"
 // #include "MavlinkLogTest.h"
 #include "LogDownloadTest.h"
+#include "MAVLinkChartBufferTest.h"
+#include "MAVLinkFieldDecoderTest.h"
 #include "PX4LogParserTest.h"
 // #include "ULogParserTest.h"
 
@@ -32,12 +35,19 @@
 #include "QGCCameraManagerTest.h"
 
 // Comms
+#include "LogReplayLinkTest.h"
+#include "MAVLinkForwarderTest.h"
+#include "MAVLinkParserWorkerTest.h"
 #include "QGCSerialPortInfoTest.h"
+#include "TelemetryLogWriterTest.h"
+#include "TlogIndexTest.h"
 
 // FactSystem
 #include "FactSystemTestGeneric.h"
 #include "FactSystemTestPX4.h"
+#include "FactTypedValueTest.h"
 #include "ParameterManagerTest.h"
+#include "ParameterMetaDataSnapshotTest.h"
 
 // FollowMe
 #include "FollowMeTest.h"
@@ -49,6 +59,7 @@
 #include "GpsTest.h"
 
 // MAVLink
+#include "MAVLinkFrameParserTest.h"
 #include "StatusTextHandlerTest.h"
 #include "SigningTest.h"
 
@@ -73,6 +84,7 @@
 #include "SpeedSectionTest.h"
 #include "StructureScanComplexItemTest.h"
 #include "SurveyComplexItemTest.h"
+#include "SurveyTransectGeneratorTest.h"
 #include "TransectStyleComplexItemTest.h"
 // #include "VisualMissionItemTest.h"
 
@@ -81,14 +93,20 @@
 #include "ComponentInformationTranslationTest.h"
 
 // QmlControls
+#include "ParameterSearchIndexTest.h"
+
+// QtLocationPlugin
+#include "QGCTileCacheWorkerTest.h"
 
 // Terrain
 #include "TerrainQueryTest.h"
+#include "TerrainTileCacheTest.h"
 #include "TerrainTileTest.h"
 
 // UI
 
 // Utilities
+#include "CompressedSignalTest.h"
 // Compression
 #include "DecompressionTest.h"
 #include "QGCFileDownloadTest.h"
@@ -103,7 +121,9 @@
 // #include "RequestMessageTest.h"
 // #include "SendMavCommandWithHandlerTest.h"
 // #include "SendMavCommandWithSignalingTest.h"
+#include "VehicleFactMetaDataTest.h"
 #include "VehicleLinkManagerTest.h"
+#include "VehicleMessageRoutingTest.h"
 
 // Missing
 // #include "FlightGearUnitTest.h"
@@ -117,12 +137,15 @@ int runTests(bool stress, QStringView unitTestOptions)
 {
     // ADSB
     UT_REGISTER_TEST(ADSBTest)
+    UT_REGISTER_TEST(ADSBTrafficIndexTest)
 
     // AnalyzeView
     UT_REGISTER_TEST(ExifParserTest)
     // UT_REGISTER_TEST(GeoTagControllerTest)
     // UT_REGISTER_TEST(MavlinkLogTest)
     UT_REGISTER_TEST(LogDownloadTest)
+    UT_REGISTER_TEST(MAVLinkChartBufferTest)
+    UT_REGISTER_TEST(MAVLinkFieldDecoderTest)
     UT_REGISTER_TEST(PX4LogParserTest)
     // UT_REGISTER_TEST(ULogParserTest)
 
@@ -136,12 +159,19 @@ int runTests(bool stress, QStringView unitTestOptions)
     UT_REGISTER_TEST(QGCCameraManagerTest)
 
     // Comms
+    UT_REGISTER_TEST(LogReplayLinkTest)
+    UT_REGISTER_TEST(MAVLinkForwarderTest)
+    UT_REGISTER_TEST(MAVLinkParserWorkerTest)
     UT_REGISTER_TEST(QGCSerialPortInfoTest)
+    UT_REGISTER_TEST(TelemetryLogWriterTest)
+    UT_REGISTER_TEST(TlogIndexTest)
 
     // FactSystem
     UT_REGISTER_TEST(FactSystemTestGeneric)
     UT_REGISTER_TEST(FactSystemTestPX4)
+    UT_REGISTER_TEST(FactTypedValueTest)
     UT_REGISTER_TEST(ParameterManagerTest)
+    UT_REGISTER_TEST(ParameterMetaDataSnapshotTest)
 
     // FollowMe
     UT_REGISTER_TEST(FollowMeTest)
@@ -153,6 +183,7 @@ int runTests(bool stress, QStringView unitTestOptions)
     // UT_REGISTER_TEST(GpsTest)
 
     // MAVLink
+    UT_REGISTER_TEST(MAVLinkFrameParserTest)
     UT_REGISTER_TEST(StatusTextHandlerTest)
     UT_REGISTER_TEST(SigningTest)
 
@@ -177,20 +208,27 @@ int runTests(bool stress, QStringView unitTestOptions)
     UT_REGISTER_TEST(SpeedSectionTest)
     UT_REGISTER_TEST(StructureScanComplexItemTest)
     UT_REGISTER_TEST(SurveyComplexItemTest)
+    UT_REGISTER_TEST(SurveyTransectGeneratorTest)
     UT_REGISTER_TEST(TransectStyleComplexItemTest)
     // UT_REGISTER_TEST(VisualMissionItemTest)
 
     // qgcunittest
 
     // QmlControls
+    UT_REGISTER_TEST(ParameterSearchIndexTest)
+
+    // QtLocationPlugin
+    UT_REGISTER_TEST(QGCTileCacheWorkerTest)
 
     // Terrain
     UT_REGISTER_TEST(TerrainQueryTest)
+    UT_REGISTER_TEST(TerrainTileCacheTest)
     UT_REGISTER_TEST(TerrainTileTest)
 
     // UI
 
     // Utilities
+    UT_REGISTER_TEST(CompressedSignalTest)
     // Compression
     UT_REGISTER_TEST(DecompressionTest)
     UT_REGISTER_TEST(QGCFileDownloadTest)
@@ -205,7 +243,9 @@ int runTests(bool stress, QStringView unitTestOptions)
     // UT_REGISTER_TEST(RequestMessageTest)
     // UT_REGISTER_TEST(SendMavCommandWithHandlerTest)
     // UT_REGISTER_TEST(SendMavCommandWithSignalingTest)
+    UT_REGISTER_TEST(VehicleFactMetaDataTest)
     UT_REGISTER_TEST(VehicleLinkManagerTest)
+    UT_REGISTER_TEST(VehicleMessageRoutingTest)
 
     // Missing
     // UT_REGISTER_TEST(FlightGearUnitTest)
@@ -0,0 +1,136 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "CompressedSignalTest.h"
+#include "QGCApplication.h"
+
+#include <QtTest/QTest>
+
+void CompressedSignalTest::init()
+{
+    UnitTest::init();
+
+    _compressedSignal = QMetaMethod::fromSignal(&CompressedSignalSender::compressedSignal);
+    qgcApp()->addCompressedSignal(_compressedSignal);
+}
+
+void CompressedSignalTest::cleanup()
+{
+    qgcApp()->removeCompressedSignal(_compressedSignal);
+
+    UnitTest::cleanup();
+}
+
+void CompressedSignalTest::_testCompression()
+{
+    CompressedSignalSender sender;
+    CompressedSignalReceiver receiver;
+    (void) connect(&sender, &CompressedSignalSender::compressedSignal, &receiver, &CompressedSignalReceiver::compressedSlot, Qt::QueuedConnection);
+    (void) connect(&sender, &CompressedSignalSender::uncompressedSignal, &receiver, &CompressedSignalReceiver::uncompressedSlot, Qt::QueuedConnection);
+
+    const quint64 startCount = qgcApp()->compressedSignalCount(_compressedSignal);
+
+    // Uncompressed calls in between must all still be delivered
+    for (int i=0; i<100; i++) {
+        emit sender.compressedSignal(i);
+        emit sender.uncompressedSignal(i);
+    }
+    QCoreApplication::processEvents();
+
+    QCOMPARE(receiver.compressedCalls, 1);
+    QCOMPARE(receiver.lastCompressedValue, 99);
+    QCOMPARE(receiver.uncompressedCalls, 100);
+    QCOMPARE(receiver.lastUncompressedValue, 99);
+    QCOMPARE(qgcApp()->compressedSignalCount(_compressedSignal) - startCount, quint64(99));
+}
+
+void CompressedSignalTest::_testMultipleReceivers()
+{
+    CompressedSignalSender sender1;
+    CompressedSignalSender sender2;
+    CompressedSignalReceiver receiver1;
+    CompressedSignalReceiver receiver2;
+    (void) connect(&sender1, &CompressedSignalSender::compressedSignal, &receiver1, &CompressedSignalReceiver::compressedSlot, Qt::QueuedConnection);
+    (void) connect(&sender1, &CompressedSignalSender::compressedSignal, &receiver2, &CompressedSignalReceiver::compressedSlot, Qt::QueuedConnection);
+    (void) connect(&sender2, &CompressedSignalSender::compressedSignal, &receiver2, &CompressedSignalReceiver::compressedSlot, Qt::QueuedConnection);
+
+    for (int i=0; i<10; i++) {
+        emit sender1.compressedSignal(i);
+        emit sender2.compressedSignal(100 + i);
+    }
+    QCoreApplication::processEvents();
+
+    // Each (receiver, sender) pair is compressed on its own
+    QCOMPARE(receiver1.compressedCalls, 1);
+    QCOMPARE(receiver1.lastCompressedValue, 9);
+    QCOMPARE(receiver2.compressedCalls, 2);
+    QCOMPARE(receiver2.lastCompressedValue, 109);
+}
+
+void CompressedSignalTest::_testAfterDelivery()
+{
+    CompressedSignalSender sender;
+    CompressedSignalReceiver* receiver = new CompressedSignalReceiver;
+    (void) connect(&sender, &CompressedSignalSender::compressedSignal, receiver, &CompressedSignalReceiver::compressedSlot, Qt::QueuedConnection);
+
+    // Calls posted after the previous one was delivered are not lost, and delivery drops their table entry
+    const qsizetype pendingCount = qgcApp()->_pendingCompressedEvents.size();
+    for (int i=0; i<3; i++) {
+        emit sender.compressedSignal(i);
+        QCOMPARE(qgcApp()->_pendingCompressedEvents.size(), pendingCount + 1);
+        QCoreApplication::processEvents();
+        QCOMPARE(receiver->compressedCalls, i + 1);
+        QCOMPARE(receiver->lastCompressedValue, i);
+        QCOMPARE(qgcApp()->_pendingCompressedEvents.size(), pendingCount);
+    }
+
+    // Deleting the receiver drops its pending call without touching it again on the next post
+    emit sender.compressedSignal(10);
+    delete receiver;
+    receiver = new CompressedSignalReceiver;
+    (void) connect(&sender, &CompressedSignalSender::compressedSignal, receiver, &CompressedSignalReceiver::compressedSlot, Qt::QueuedConnection);
+    emit sender.compressedSignal(11);
+    emit sender.compressedSignal(12);
+    QCoreApplication::processEvents();
+    QCOMPARE(receiver->compressedCalls, 1);
+    QCOMPARE(receiver->lastCompressedValue, 12);
+
+    delete receiver;
+}
+
+void CompressedSignalTest::_benchmarkFlood_data()
+{
+    QTest::addColumn<int>("queueDepth");
+
+    QTest::newRow("depth 100")      << 100;
+    QTest::newRow("depth 10000")    << 10000;
+}
+
+void CompressedSignalTest::_benchmarkFlood()
+{
+    QFETCH(int, queueDepth);
+
+    CompressedSignalSender sender;
+    CompressedSignalReceiver receiver;
+    (void) connect(&sender, &CompressedSignalSender::compressedSignal, &receiver, &CompressedSignalReceiver::compressedSlot, Qt::QueuedConnection);
+    (void) connect(&sender, &CompressedSignalSender::uncompressedSignal, &receiver, &CompressedSignalReceiver::uncompressedSlot, Qt::QueuedConnection);
+
+    QBENCHMARK {
+        // Deep queue of unrelated calls, flooded with compressed ones
+        for (int i=0; i<queueDepth; i++) {
+            emit sender.uncompressedSignal(i);
+        }
+        for (int i=0; i<1000; i++) {
+            emit sender.compressedSignal(i);
+        }
+        QCoreApplication::processEvents();
+    }
+
+    QCOMPARE(receiver.lastCompressedValue, 999);
+}
@@ -0,0 +1,56 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#pragma once
+
+#include "UnitTest.h"
+
+#include <QtCore/QMetaMethod>
+
+class CompressedSignalSender : public QObject
+{
+    Q_OBJECT
+
+signals:
+    void compressedSignal(int value);
+    void uncompressedSignal(int value);
+};
+
+class CompressedSignalReceiver : public QObject
+{
+    Q_OBJECT
+
+public slots:
+    void compressedSlot(int value) { compressedCalls++; lastCompressedValue = value; }
+    void uncompressedSlot(int value) { uncompressedCalls++; lastUncompressedValue = value; }
+
+public:
+    int compressedCalls = 0;
+    int lastCompressedValue = -1;
+    int uncompressedCalls = 0;
+    int lastUncompressedValue = -1;
+};
+
+class CompressedSignalTest : public UnitTest
+{
+    Q_OBJECT
+
+private slots:
+    void init() final;
+    void cleanup() final;
+
+    void _testCompression();
+    void _testMultipleReceivers();
+    void _testAfterDelivery();
+    void _benchmarkFlood_data();
+    void _benchmarkFlood();
+
+private:
+    QMetaMethod _compressedSignal;
+};
@@ -14,6 +14,9 @@
 #include "FTPManager.h"
 #include "MockLinkFTP.h"
 
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSet>
 #include <QtCore/QStandardPaths>
 #include <QtTest/QTest>
 #include <QtTest/QSignalSpy>
@@ -125,6 +128,232 @@ void FTPManagerTest::_testLostPackets(void)
     _disconnectMockLink();
 }
 
+/// Downloads with packet loss while the vehicle never answers the reads which fill in the gaps
+///     @return Offsets of the read requests sent, empty if the download didn't fail
+QList<uint32_t> FTPManagerTest::_unansweredFillReads(int maxReadsInFlight, int fileSize)
+{
+    _connectMockLinkNoInitialConnectSequence();
+
+    FTPManager*     ftpManager  = _vehicle->ftpManager();
+    MockLinkFTP*    mockLinkFTP = _mockLink->mockLinkFTP();
+    QString         filename    = QStringLiteral("%1%2").arg(MockLinkFTP::sizeFilenamePrefix).arg(fileSize);
+    QString         toDir       = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+    QString         partFile    = FTPManager::downloadFilePath(filename, toDir) + QStringLiteral(".part");
+
+    QSignalSpy spyDownloadComplete(ftpManager, &FTPManager::downloadComplete);
+
+    // The burst loses packets, which leaves gaps for the reads
+    mockLinkFTP->setDropPercent(10);
+    mockLinkFTP->setErrorMode(MockLinkFTP::errModeNoReadResponse);
+    ftpManager->setMaxReadsInFlight(maxReadsInFlight);
+    ftpManager->download(MAV_COMP_ID_AUTOPILOT1, filename, toDir);
+
+    // void downloadComplete   (const QString& file, const QString& errorMsg);
+    QList<uint32_t> offsets;
+    if (spyDownloadComplete.wait(10000) && !spyDownloadComplete.takeFirst()[1].toString().isEmpty()) {
+        offsets = mockLinkFTP->readRequestOffsets();
+    }
+
+    // The failed download is kept for a resume
+    (void) QFile::remove(partFile);
+    (void) QFile::remove(partFile + QStringLiteral(".json"));
+
+    _disconnectMockLink();
+
+    return offsets;
+}
+
+void FTPManagerTest::_testPipelinedFill(void)
+{
+    constexpr int fileSize = 64 * 1024;
+
+    // Without any read being answered a new block is never asked for, so only the first blocks are requested. Each of
+    // them is resent until the download gives up.
+    const QList<uint32_t> sequentialOffsets = _unansweredFillReads(1, fileSize);
+    QVERIFY(!sequentialOffsets.isEmpty());
+    QCOMPARE(QSet<uint32_t>(sequentialOffsets.cbegin(), sequentialOffsets.cend()).count(), 1);
+
+    // All reads in flight go out in the first round trip, one per block
+    const QList<uint32_t> pipelinedOffsets = _unansweredFillReads(FTPManager::kDefaultMaxReadsInFlight, fileSize);
+    QVERIFY(pipelinedOffsets.count() > FTPManager::kDefaultMaxReadsInFlight);
+    const QList<uint32_t> firstRoundTrip = pipelinedOffsets.first(FTPManager::kDefaultMaxReadsInFlight);
+    QCOMPARE(QSet<uint32_t>(firstRoundTrip.cbegin(), firstRoundTrip.cend()).count(), FTPManager::kDefaultMaxReadsInFlight);
+    QCOMPARE(QSet<uint32_t>(pipelinedOffsets.cbegin(), pipelinedOffsets.cend()).count(), FTPManager::kDefaultMaxReadsInFlight);
+}
+
+void FTPManagerTest::_benchmarkFillReads_data(void)
+{
+    QTest::addColumn<int>("maxReadsInFlight");
+
+    QTest::newRow("1 read in flight")   << 1;
+    QTest::newRow("4 reads in flight")  << FTPManager::kDefaultMaxReadsInFlight;
+}
+
+void FTPManagerTest::_benchmarkFillReads(void)
+{
+    QFETCH(int, maxReadsInFlight);
+
+    _connectMockLinkNoInitialConnectSequence();
+
+    FTPManager*     ftpManager  = _vehicle->ftpManager();
+    MockLinkFTP*    mockLinkFTP = _mockLink->mockLinkFTP();
+    int             fileSize    = 64 * 1024;
+    QString         filename    = QStringLiteral("%1%2").arg(MockLinkFTP::sizeFilenamePrefix).arg(fileSize);
+
+    QSignalSpy spyDownloadComplete(ftpManager, &FTPManager::downloadComplete);
+
+    ftpManager->setMaxReadsInFlight(maxReadsInFlight);
+
+    QBENCHMARK {
+        // Reseeded on every run, so each run and row loses the same packets and has the same gaps to fill
+        mockLinkFTP->setDropPercent(10);
+        ftpManager->download(MAV_COMP_ID_AUTOPILOT1, filename, QStandardPaths::writableLocation(QStandardPaths::TempLocation));
+
+        QCOMPARE(spyDownloadComplete.wait(10000), true);
+        QCOMPARE(spyDownloadComplete.count(), 1);
+
+        // void downloadComplete   (const QString& file, const QString& errorMsg);
+        QList<QVariant> arguments = spyDownloadComplete.takeFirst();
+        QVERIFY(arguments[1].toString().isEmpty());
+
+        _verifyFileSizeAndDelete(arguments[0].toString(), fileSize);
+    }
+
+    mockLinkFTP->setDropPercent(0);
+
+    _disconnectMockLink();
+}
+
+void FTPManagerTest::_testResume(void)
+{
+    _connectMockLinkNoInitialConnectSequence();
+
+    FTPManager* ftpManager  = _vehicle->ftpManager();
+    int         fileSize    = 4 * 1024;
+    QString     filename    = QStringLiteral("%1%2").arg(MockLinkFTP::sizeFilenamePrefix).arg(fileSize);
+    QString     toDir       = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+    QString     partFile    = FTPManager::downloadFilePath(filename, toDir) + QStringLiteral(".part");
+
+    QSignalSpy spyDownloadComplete(ftpManager, &FTPManager::downloadComplete);
+
+    {
+        // The vehicle stops responding after the first burst
+        QObject context;
+        (void) connect(ftpManager, &FTPManager::commandProgress, &context, [this]() {
+            _mockLink->mockLinkFTP()->setErrorMode(MockLinkFTP::errModeNoResponse);
+        });
+        ftpManager->download(MAV_COMP_ID_AUTOPILOT1, filename, toDir);
+
+        QCOMPARE(spyDownloadComplete.wait(10000), true);
+    }
+    QList<QVariant> arguments = spyDownloadComplete.takeFirst();
+    QVERIFY(!arguments[1].toString().isEmpty());
+    QVERIFY(!QFile::exists(arguments[0].toString()));
+    QVERIFY(QFile::exists(partFile));
+
+    // Downloading again only fetches what is missing
+    _mockLink->mockLinkFTP()->setErrorMode(MockLinkFTP::errModeNone);
+    QSignalSpy spyProgress(ftpManager, &FTPManager::commandProgress);
+    ftpManager->download(MAV_COMP_ID_AUTOPILOT1, filename, toDir);
+
+    QCOMPARE(spyDownloadComplete.wait(10000), true);
+    arguments = spyDownloadComplete.takeFirst();
+    QVERIFY(arguments[1].toString().isEmpty());
+    QVERIFY(!spyProgress.isEmpty());
+    QVERIFY(spyProgress.first()[1].toFloat() > 0.5f);
+    QVERIFY(!QFile::exists(partFile));
+
+    _verifyFileSizeAndDelete(arguments[0].toString(), fileSize);
+
+    _disconnectMockLink();
+}
+
+void FTPManagerTest::_testResumeChangedFile(void)
+{
+    _connectMockLinkNoInitialConnectSequence();
+
+    FTPManager* ftpManager  = _vehicle->ftpManager();
+    int         fileSize    = 4 * 1024;
+    QString     filename    = QStringLiteral("%1%2").arg(MockLinkFTP::sizeFilenamePrefix).arg(fileSize);
+    QString     toDir       = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+    QString     partFile    = FTPManager::downloadFilePath(filename, toDir) + QStringLiteral(".part");
+
+    QSignalSpy spyDownloadComplete(ftpManager, &FTPManager::downloadComplete);
+
+    {
+        // The vehicle stops responding after the first burst
+        QObject context;
+        (void) connect(ftpManager, &FTPManager::commandProgress, &context, [this]() {
+            _mockLink->mockLinkFTP()->setErrorMode(MockLinkFTP::errModeNoResponse);
+        });
+        ftpManager->download(MAV_COMP_ID_AUTOPILOT1, filename, toDir);
+
+        QCOMPARE(spyDownloadComplete.wait(10000), true);
+    }
+    QList<QVariant> arguments = spyDownloadComplete.takeFirst();
+    QVERIFY(!arguments[1].toString().isEmpty());
+    QVERIFY(QFile::exists(partFile));
+
+    // The file on the vehicle changes without changing its size
+    QFile resumeFile(partFile + QStringLiteral(".json"));
+    QVERIFY(resumeFile.open(QFile::ReadOnly));
+    QJsonObject json = QJsonDocument::fromJson(resumeFile.readAll()).object();
+    resumeFile.close();
+    QVERIFY(json.contains(QStringLiteral("crc")));
+    json[QStringLiteral("crc")] = json[QStringLiteral("crc")].toInteger() ^ 1;
+    QVERIFY(resumeFile.open(QFile::WriteOnly | QFile::Truncate));
+    QVERIFY(resumeFile.write(QJsonDocument(json).toJson()) > 0);
+    resumeFile.close();
+
+    // The partial file no longer matches, so everything is downloaded again
+    _mockLink->mockLinkFTP()->setErrorMode(MockLinkFTP::errModeNone);
+    QSignalSpy spyProgress(ftpManager, &FTPManager::commandProgress);
+    ftpManager->download(MAV_COMP_ID_AUTOPILOT1, filename, toDir);
+
+    QCOMPARE(spyDownloadComplete.wait(10000), true);
+    arguments = spyDownloadComplete.takeFirst();
+    QVERIFY(arguments[1].toString().isEmpty());
+    QVERIFY(!spyProgress.isEmpty());
+    QVERIFY(spyProgress.first()[1].toFloat() < 0.5f);
+    QVERIFY(!QFile::exists(partFile));
+    QVERIFY(!resumeFile.exists());
+
+    _verifyFileSizeAndDelete(arguments[0].toString(), fileSize);
+
+    _disconnectMockLink();
+}
+
+void FTPManagerTest::_testQueuedOperations(void)
+{
+    _connectMockLinkNoInitialConnectSequence();
+
+    FTPManager*     ftpManager  = _vehicle->ftpManager();
+    QString         toDir       = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
+    const QList<int> rgFileSizes = { 3 * 1024, 1024 };
+
+    QSignalSpy spyDownloadComplete(ftpManager, &FTPManager::downloadComplete);
+    QSignalSpy spyListDirectoryComplete(ftpManager, &FTPManager::listDirectoryComplete);
+
+    // Everything after the first operation waits its turn
+    for (int fileSize: rgFileSizes) {
+        QVERIFY(ftpManager->download(MAV_COMP_ID_AUTOPILOT1, QStringLiteral("%1%2").arg(MockLinkFTP::sizeFilenamePrefix).arg(fileSize), toDir));
+    }
+    QVERIFY(ftpManager->listDirectory(MAV_COMP_ID_AUTOPILOT1, "/"));
+
+    QTRY_COMPARE_WITH_TIMEOUT(spyListDirectoryComplete.count(), 1, 10000);
+    QCOMPARE(spyDownloadComplete.count(), rgFileSizes.count());
+    QCOMPARE(spyListDirectoryComplete.takeFirst()[0].toStringList().count(), 6);
+
+    for (int fileSize: rgFileSizes) {
+        QList<QVariant> arguments = spyDownloadComplete.takeFirst();
+        QVERIFY(arguments[1].toString().isEmpty());
+        QCOMPARE(arguments[0].toString(), FTPManager::downloadFilePath(QStringLiteral("%1%2").arg(MockLinkFTP::sizeFilenamePrefix).arg(fileSize), toDir));
+        _verifyFileSizeAndDelete(arguments[0].toString(), fileSize);
+    }
+
+    _disconnectMockLink();
+}
+
 void FTPManagerTest::_verifyFileSizeAndDelete(const QString& filename, int expectedSize)
 {
     QFileInfo fileInfo(filename);
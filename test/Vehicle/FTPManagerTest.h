@@ -17,6 +17,12 @@ class FTPManagerTest : public UnitTest
 
 private slots:
     void _testLostPackets                               (void);
+    void _testPipelinedFill                             (void);
+    void _benchmarkFillReads_data                       (void);
+    void _benchmarkFillReads                            (void);
+    void _testResume                                    (void);
+    void _testResumeChangedFile                         (void);
+    void _testQueuedOperations                          (void);
     void _testListDirectory                             (void);
     void _testListDirectoryNoResponse                   (void);
     void _testListDirectoryNakResponse                  (void);
@@ -39,6 +45,7 @@ private slots:
     void _testCaseWorker            (const TestCase_t& testCase);
     void _sizeTestCaseWorker        (int fileSize);
     void _verifyFileSizeAndDelete   (const QString& filename, int expectedSize);
+    QList<uint32_t> _unansweredFillReads(int maxReadsInFlight, int fileSize);
 
     static const TestCase_t _rgTestCases[];
 };
@@ -0,0 +1,75 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VehicleFactMetaDataTest.h"
+#include "FactMetaData.h"
+#include "Vehicle.h"
+
+#include <QtTest/QTest>
+
+void VehicleFactMetaDataTest::_testSharedMetaData()
+{
+    Vehicle *const vehicle1 = new Vehicle(MAV_AUTOPILOT_PX4, MAV_TYPE_QUADROTOR, this);
+    Vehicle *const vehicle2 = new Vehicle(MAV_AUTOPILOT_PX4, MAV_TYPE_QUADROTOR, this);
+
+    // Both vehicles use the same meta data instances for the vehicle facts and sub fact groups
+    FactMetaData *const rollMetaData = vehicle1->getFact(QStringLiteral("roll"))->metaData();
+    QVERIFY(rollMetaData->isShared());
+    QCOMPARE(vehicle2->getFact(QStringLiteral("roll"))->metaData(), rollMetaData);
+    QCOMPARE(vehicle2->gpsFactGroup()->getFact(QStringLiteral("lat"))->metaData(), vehicle1->gpsFactGroup()->getFact(QStringLiteral("lat"))->metaData());
+
+    delete vehicle1;
+
+    // Shared meta data outlives the vehicles which use it
+    QCOMPARE(vehicle2->getFact(QStringLiteral("roll"))->metaData(), rollMetaData);
+    QCOMPARE(rollMetaData->name(), QStringLiteral("roll"));
+
+    delete vehicle2;
+}
+
+void VehicleFactMetaDataTest::_testCopyOnWrite()
+{
+    Vehicle *const vehicle1 = new Vehicle(MAV_AUTOPILOT_PX4, MAV_TYPE_QUADROTOR, this);
+    Vehicle *const vehicle2 = new Vehicle(MAV_AUTOPILOT_PX4, MAV_TYPE_QUADROTOR, this);
+
+    Fact *const fact1 = vehicle1->getFact(QStringLiteral("roll"));
+    Fact *const fact2 = vehicle2->getFact(QStringLiteral("roll"));
+    FactMetaData *const sharedMetaData = fact2->metaData();
+
+    // A copy starts out equal to the shared meta data but is private
+    FactMetaData copy(*sharedMetaData);
+    QVERIFY(!copy.isShared());
+    QVERIFY(copy == *sharedMetaData);
+    copy.setShortDescription(QStringLiteral("Adjusted"));
+    QVERIFY(copy != *sharedMetaData);
+
+    // Changing a fact's meta data detaches it from the shared instance, other vehicles are unaffected
+    const QStringList enumStrings = { QStringLiteral("Level") };
+    const QVariantList enumValues = { 0 };
+    fact1->setEnumInfo(enumStrings, enumValues);
+    QVERIFY(fact1->metaData() != sharedMetaData);
+    QVERIFY(!fact1->metaData()->isShared());
+    QCOMPARE(fact1->enumStrings(), enumStrings);
+    QCOMPARE(fact2->metaData(), sharedMetaData);
+    QVERIFY(fact2->enumStrings().isEmpty());
+
+    delete vehicle1;
+    delete vehicle2;
+}
+
+void VehicleFactMetaDataTest::_benchmarkVehicleConstruction()
+{
+    // Load the shared meta data outside of the measurement
+    delete new Vehicle(MAV_AUTOPILOT_PX4, MAV_TYPE_QUADROTOR, this);
+
+    QBENCHMARK {
+        Vehicle *const vehicle = new Vehicle(MAV_AUTOPILOT_PX4, MAV_TYPE_QUADROTOR, this);
+        delete vehicle;
+    }
+}
@@ -0,0 +1,66 @@
+/****************************************************************************
+ *
+ * (c) 2009-2024 QGROUNDCONTROL PROJECT <http://www.qgroundcontrol.org>
+ *
+ * QGroundControl is licensed according to the terms in the file
+ * COPYING.md in the root of the source code directory.
+ *
+ ****************************************************************************/
+
+#include "VehicleMessageRoutingTest.h"
+#include "MultiVehicleManager.h"
+#include "Vehicle.h"
+
+#include <QtTest/QTest>
+
+void VehicleMessageRoutingTest::_testFactGroupMessageIds()
+{
+    _connectMockLinkNoInitialConnectSequence();
+
+    Vehicle *const vehicle = MultiVehicleManager::instance()->activeVehicle();
+    QVERIFY(vehicle);
+
+    QVERIFY(vehicle->gpsFactGroup()->handlesMessage(MAVLINK_MSG_ID_GPS_RAW_INT));
+    QVERIFY(!vehicle->gpsFactGroup()->handlesMessage(MAVLINK_MSG_ID_GPS2_RAW));
+    QVERIFY(vehicle->gps2FactGroup()->handlesMessage(MAVLINK_MSG_ID_GPS2_RAW));
+    QVERIFY(!vehicle->gps2FactGroup()->handlesMessage(MAVLINK_MSG_ID_GPS_RAW_INT));
+    QVERIFY(!vehicle->clockFactGroup()->handlesMessage(MAVLINK_MSG_ID_HEARTBEAT));
+    QVERIFY(!vehicle->clockFactGroup()->handlesAllMessages());
+    QVERIFY(vehicle->handlesMessage(MAVLINK_MSG_ID_ATTITUDE));
+
+    // Groups which don't register their message ids keep seeing everything
+    FactGroup factGroup(0);
+    QVERIFY(factGroup.handlesAllMessages());
+    QVERIFY(factGroup.handlesMessage(MAVLINK_MSG_ID_HEARTBEAT));
+
+    _disconnectMockLink();
+}
+
+void VehicleMessageRoutingTest::_testVehicleLookup()
+{
+    _connectMockLinkNoInitialConnectSequence();
+
+    MultiVehicleManager *const multiVehicleManager = MultiVehicleManager::instance();
+    Vehicle *const vehicle = multiVehicleManager->activeVehicle();
+    QVERIFY(vehicle);
+    QCOMPARE(multiVehicleManager->getVehicleById(vehicle->id()), vehicle);
+    QVERIFY(!multiVehicleManager->getVehicleById(vehicle->id() + 1));
+
+    const int vehicleId = vehicle->id();
+    _disconnectMockLink();
+    QVERIFY(!multiVehicleManager->getVehicleById(vehicleId));
+}
+
+void VehicleMessageRoutingTest::_testDispatchStats()
+{
+    MultiVehicleManager *const multiVehicleManager = MultiVehicleManager::instance();
+    multiVehicleManager->resetDispatchStats();
+
+    _connectMockLinkNoInitialConnectSequence();
+
+    QVERIFY(QTest::qWaitFor([multiVehicleManager]() {
+        return multiVehicleManager->dispatchStats().value(MAVLINK_MSG_ID_HEARTBEAT).count > 1;
+    }, 5000));
+
+    _disconnectMockLink();
+}